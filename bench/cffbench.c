@@ -0,0 +1,382 @@
+// libcff micro-benchmark.
+// Times the charstring kernels of libcff in isolation: the Type 2 interpreter, IL compilation,
+// IL optimization, the subroutinizer and INDEX serialization. Inputs are the CFF outlines of
+// the given fonts, or the glyphs of JSON fonts; `node tests/synthetic-font.js N cff` makes one
+// which shares enough pieces to give the subroutinizer real work. Prints the median over the
+// repetitions as CSV.
+// Usage : cffbench [-r reps] [font.otf | font.json ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "otfcc/sfnt.h"
+#include "otfcc/font.h"
+#include "otfcc/options.h"
+#include "support/util.h"
+#include "table/head.h"
+#include "table/CFF.h"
+#include "libcff/libcff.h"
+#include "libcff/charstring-il.h"
+#include "libcff/subr.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__MACH__)
+#include <mach/mach_time.h>
+#endif
+
+static int64_t nowNanoseconds() {
+#ifdef _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (int64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined(__MACH__)
+	mach_timebase_info_data_t tb;
+	mach_timebase_info(&tb);
+	return (int64_t)(mach_absolute_time() * tb.numer / tb.denom);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+typedef struct {
+	sds name;
+	table_glyf *glyphs;
+	double defaultWidthX;
+	double nominalWidthX;
+	// Charstrings fed to the interpreter. Fonts read from disk keep their file, so that local
+	// subroutines are selected per glyph as the reader does; JSON inputs use one set.
+	cff_File *file;
+	cff_Index charStrings;
+	cff_Index globalSubrs;
+	cff_Index localSubrs;
+} BenchInput;
+
+typedef struct {
+	const char *kernel;
+	size_t bytesIn;
+	size_t bytesOut;
+	int64_t *samples;
+} BenchResult;
+
+static int compareSamples(const void *a, const void *b) {
+	int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+	return (x > y) - (x < y);
+}
+
+static void report(const BenchInput *in, const BenchResult *r, uint32_t reps) {
+	qsort(r->samples, reps, sizeof(int64_t), compareSamples);
+	double median = (reps & 1) ? r->samples[reps / 2]
+	                           : (r->samples[reps / 2 - 1] + r->samples[reps / 2]) / 2.0;
+	glyphid_t n = in->glyphs->length;
+	fprintf(stdout, "%s,%s,%u,%.1f,%zu,%zu\n", in->name, r->kernel, n, n ? median / n : 0.0,
+	        r->bytesIn, r->bytesOut);
+}
+
+// Interpreter: an outline builder which only counts what it is given.
+typedef struct {
+	uint64_t randx;
+	size_t contours;
+	size_t segments;
+	size_t hints;
+} CountingOutline;
+
+static void countWidth(void *context, double width) {}
+static void countContour(void *context) {
+	((CountingOutline *)context)->contours += 1;
+}
+static void countLine(void *context, double x1, double y1) {
+	((CountingOutline *)context)->segments += 1;
+}
+static void countCurve(void *context, double x1, double y1, double x2, double y2, double x3,
+                       double y3) {
+	((CountingOutline *)context)->segments += 1;
+}
+static void countHint(void *context, bool isVertical, double position, double width) {
+	((CountingOutline *)context)->hints += 1;
+}
+static void countMask(void *context, bool isContourMask, bool *mask) {
+	((CountingOutline *)context)->hints += 1;
+	FREE(mask);
+}
+static double countRand(void *context) {
+	CountingOutline *c = (CountingOutline *)context;
+	c->randx ^= c->randx >> 12;
+	c->randx ^= c->randx << 25;
+	c->randx ^= c->randx >> 27;
+	return (double)(c->randx >> 11) / 9007199254740992.0;
+}
+static cff_IOutlineBuilder countingPass = {.setWidth = countWidth,
+                                           .newContour = countContour,
+                                           .lineTo = countLine,
+                                           .curveTo = countCurve,
+                                           .setHint = countHint,
+                                           .setMask = countMask,
+                                           .getrand = countRand};
+
+static size_t interpret(const BenchInput *in, cff_Stack *stack, const otfcc_Options *options) {
+	CountingOutline c = {0x1234567, 0, 0, 0};
+	const cff_Index *cs = in->file ? &in->file->char_strings : &in->charStrings;
+	const cff_Index *gsubrs = in->file ? &in->file->global_subr : &in->globalSubrs;
+	for (glyphid_t j = 0; j < cs->count; j++) {
+		cff_Index localSubrs;
+		cff_iIndex.init(&localSubrs);
+		if (in->file) {
+			cff_File *f = in->file;
+			cff_parseSubr(j, f->raw_data,
+			              f->fdselect.t != cff_FDSELECT_UNSPECED ? f->font_dict : f->top_dict,
+			              f->fdselect, &localSubrs);
+		}
+		stack->index = 0;
+		stack->stem = 0;
+		cff_parseOutline(cs->data + cs->offset[j] - 1, cs->offset[j + 1] - cs->offset[j], *gsubrs,
+		                 in->file ? localSubrs : in->localSubrs, stack, &c, countingPass, options);
+		cff_iIndex.dispose(&localSubrs);
+	}
+	return c.contours + c.segments + c.hints;
+}
+
+static cff_CharstringIL **compileAll(const BenchInput *in) {
+	cff_CharstringIL **ils;
+	NEW(ils, in->glyphs->length);
+	for (glyphid_t j = 0; j < in->glyphs->length; j++) {
+		ils[j] = cff_compileGlyphToIL(in->glyphs->items[j], (uint16_t)in->defaultWidthX,
+		                              (uint16_t)in->nominalWidthX);
+	}
+	return ils;
+}
+static void optimizeAll(cff_CharstringIL **ils, glyphid_t n, const otfcc_Options *options) {
+	for (glyphid_t j = 0; j < n; j++) {
+		cff_optimizeIL(ils[j], options);
+	}
+}
+static void freeAll(cff_CharstringIL **ils, glyphid_t n) {
+	for (glyphid_t j = 0; j < n; j++) {
+		FREE(ils[j]->instr);
+		FREE(ils[j]);
+	}
+	FREE(ils);
+}
+static size_t builtBytes(cff_CharstringIL **ils, glyphid_t n) {
+	size_t bytes = 0;
+	for (glyphid_t j = 0; j < n; j++) {
+		caryll_Buffer *blob = cff_build_IL(ils[j]);
+		bytes += blob->size;
+		buffree(blob);
+	}
+	return bytes;
+}
+static caryll_Buffer *buildILCallback(void *context, uint32_t j) {
+	return cff_build_IL(((cff_CharstringIL **)context)[j]);
+}
+
+static void runInput(const BenchInput *in, uint32_t reps, const otfcc_Options *options) {
+	glyphid_t n = in->glyphs->length;
+	BenchResult interpreter = {"interpret", 0, 0, NULL};
+	BenchResult compiler = {"compile", 0, 0, NULL};
+	BenchResult optimizer = {"optimize", 0, 0, NULL};
+	BenchResult subroutinizer = {"subroutinize", 0, 0, NULL};
+	BenchResult indexer = {"index", 0, 0, NULL};
+	NEW(interpreter.samples, reps);
+	NEW(compiler.samples, reps);
+	NEW(optimizer.samples, reps);
+	NEW(subroutinizer.samples, reps);
+	NEW(indexer.samples, reps);
+
+	const cff_Index *cs = in->file ? &in->file->char_strings : &in->charStrings;
+	interpreter.bytesIn = cs->count ? cs->offset[cs->count] - 1 : 0;
+	cff_Stack stack;
+	stack.max = 0x10000;
+	NEW(stack.stack, stack.max);
+
+	for (uint32_t r = 0; r < reps; r++) {
+		int64_t t0 = nowNanoseconds();
+		interpret(in, &stack, options);
+		interpreter.samples[r] = nowNanoseconds() - t0;
+
+		t0 = nowNanoseconds();
+		cff_CharstringIL **ils = compileAll(in);
+		compiler.samples[r] = nowNanoseconds() - t0;
+		if (!r) compiler.bytesOut = optimizer.bytesIn = builtBytes(ils, n);
+
+		t0 = nowNanoseconds();
+		optimizeAll(ils, n, options);
+		optimizer.samples[r] = nowNanoseconds() - t0;
+		if (!r) {
+			optimizer.bytesOut = subroutinizer.bytesIn = indexer.bytesIn = builtBytes(ils, n);
+		}
+
+		cff_SubrGraph graph;
+		cff_iSubrGraph.init(&graph);
+		graph.doSubroutinize = true;
+		caryll_Buffer *s, *gs, *ls;
+		t0 = nowNanoseconds();
+		for (glyphid_t j = 0; j < n; j++) {
+			cff_insertILToGraph(&graph, ils[j]);
+		}
+		cff_ilGraphToBuffers(&graph, &s, &gs, &ls, options);
+		subroutinizer.samples[r] = nowNanoseconds() - t0;
+		subroutinizer.bytesOut = s->size + gs->size + ls->size;
+		buffree(s), buffree(gs), buffree(ls);
+		cff_iSubrGraph.dispose(&graph);
+
+		cff_Index *index = cff_iIndex.fromCallback(ils, n, buildILCallback);
+		t0 = nowNanoseconds();
+		caryll_Buffer *blob = cff_iIndex.build(index);
+		indexer.samples[r] = nowNanoseconds() - t0;
+		indexer.bytesOut = blob->size;
+		buffree(blob);
+		cff_iIndex.free(index);
+
+		freeAll(ils, n);
+	}
+	FREE(stack.stack);
+
+	BenchResult *results[] = {&interpreter, &compiler, &optimizer, &subroutinizer, &indexer};
+	for (size_t k = 0; k < sizeof(results) / sizeof(results[0]); k++) {
+		report(in, results[k], reps);
+		FREE(results[k]->samples);
+	}
+}
+
+// Fonts on disk: the glyphs come from the CFF reader, the charstrings from the raw table.
+static bool readFontInput(const char *path, BenchInput *in, const otfcc_Options *options) {
+	FILE *file = fopen(path, "rb");
+	if (!file) return false;
+	otfcc_SplineFontContainer *sfnt = otfcc_readSFNT(file);
+	if (!sfnt || !sfnt->count) {
+		if (sfnt) otfcc_deleteSFNT(sfnt);
+		return false;
+	}
+	otfcc_Packet packet = sfnt->packets[0];
+	bool found = false;
+	for (uint16_t t = 0; t < packet.numTables; t++) {
+		otfcc_PacketPiece *piece = &packet.pieces[t];
+		if (piece->tag != 'CFF ') continue;
+		table_head *head = otfcc_readHead(packet, options);
+		table_CFFAndGlyf cffAndGlyf = otfcc_readCFFAndGlyfTables(packet, options, head);
+		if (head && cffAndGlyf.meta && cffAndGlyf.glyphs) {
+			const char *base = strrchr(path, '/');
+			in->name = sdsnew(base ? base + 1 : path);
+			in->glyphs = cffAndGlyf.glyphs;
+			if (cffAndGlyf.meta->privateDict) {
+				in->defaultWidthX = cffAndGlyf.meta->privateDict->defaultWidthX;
+				in->nominalWidthX = cffAndGlyf.meta->privateDict->nominalWidthX;
+			}
+			in->file = cff_openStream(piece->data, piece->length, options);
+			found = in->file != NULL;
+			if (!found) table_iGlyf.free(cffAndGlyf.glyphs);
+		} else if (cffAndGlyf.glyphs) {
+			table_iGlyf.free(cffAndGlyf.glyphs);
+		}
+		table_iCFF.free(cffAndGlyf.meta);
+		table_iHead.free(head);
+		break;
+	}
+	otfcc_deleteSFNT(sfnt);
+	return found;
+}
+
+// JSON fonts, such as those of tests/synthetic-font.js: the glyphs come from the JSON reader, the
+// charstrings are what the subroutinizer makes of them, so that calls are interpreted too.
+static bool readJsonInput(const char *path, BenchInput *in, const otfcc_Options *options) {
+	FILE *file = fopen(path, "rb");
+	if (!file) return false;
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	char *buffer = length > 0 ? malloc(length) : NULL;
+	bool loaded = buffer && fread(buffer, 1, length, file) == (size_t)length;
+	fclose(file);
+	json_value *root = loaded ? json_parse(buffer, length) : NULL;
+	free(buffer);
+	if (!root) return false;
+
+	otfcc_IFontBuilder *parser = otfcc_newJsonReader();
+	otfcc_Font *font = parser->read(root, 0, options);
+	parser->free(parser);
+	json_value_free(root);
+	if (!font) return false;
+	otfcc_iFont.consolidate(font, options);
+	if (!font->glyf || !font->glyf->length) {
+		otfcc_iFont.free(font);
+		return false;
+	}
+	const char *base = strrchr(path, '/');
+	in->name = sdsnew(base ? base + 1 : path);
+	in->glyphs = font->glyf;
+	font->glyf = NULL;
+	if (font->CFF_ && font->CFF_->privateDict) {
+		in->defaultWidthX = font->CFF_->privateDict->defaultWidthX;
+		in->nominalWidthX = font->CFF_->privateDict->nominalWidthX;
+	}
+	otfcc_iFont.free(font);
+
+	glyphid_t n = in->glyphs->length;
+	cff_CharstringIL **ils = compileAll(in);
+	optimizeAll(ils, n, options);
+	cff_SubrGraph graph;
+	cff_iSubrGraph.init(&graph);
+	graph.doSubroutinize = true;
+	for (glyphid_t j = 0; j < n; j++) {
+		cff_insertILToGraph(&graph, ils[j]);
+	}
+	caryll_Buffer *s, *gs, *ls;
+	cff_ilGraphToBuffers(&graph, &s, &gs, &ls, options);
+	cff_iSubrGraph.dispose(&graph);
+	freeAll(ils, n);
+	cff_iIndex.parse(s->data, 0, &in->charStrings);
+	cff_iIndex.parse(gs->data, 0, &in->globalSubrs);
+	cff_iIndex.parse(ls->data, 0, &in->localSubrs);
+	buffree(s), buffree(gs), buffree(ls);
+	return true;
+}
+
+static void disposeInput(BenchInput *in) {
+	sdsfree(in->name);
+	table_iGlyf.free(in->glyphs);
+	if (in->file) cff_close(in->file);
+	cff_iIndex.dispose(&in->charStrings);
+	cff_iIndex.dispose(&in->globalSubrs);
+	cff_iIndex.dispose(&in->localSubrs);
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t reps = 5;
+	otfcc_Options *options = otfcc_newOptions();
+	options->logger = otfcc_newLogger(otfcc_newStdErrTarget());
+	options->logger->setVerbosity(options->logger, 0);
+	otfcc_Options_optimizeTo(options, 2);
+
+	int j = 1;
+	for (; j < argc && argv[j][0] == '-'; j++) {
+		if (!strcmp(argv[j], "-r") && j + 1 < argc) {
+			reps = (uint32_t)atoi(argv[++j]);
+		} else {
+			fprintf(stderr, "Usage : cffbench [-r reps] [font.otf | font.json ...]\n");
+			return 1;
+		}
+	}
+	if (!reps) reps = 1;
+
+	fprintf(stdout, "input,kernel,glyphs,ns_per_glyph,bytes_in,bytes_out\n");
+	for (; j < argc; j++) {
+		BenchInput in;
+		memset(&in, 0, sizeof(in));
+		size_t len = strlen(argv[j]);
+		bool json = len > 5 && !strcmp(argv[j] + len - 5, ".json");
+		if (!(json ? readJsonInput : readFontInput)(argv[j], &in, options)) {
+			fprintf(stderr, "Cannot read outlines from \"%s\", skipped.\n", argv[j]);
+			continue;
+		}
+		runInput(&in, reps, options);
+		disposeInput(&in);
+	}
+	otfcc_deleteOptions(options);
+	return 0;
+}
@@ -0,0 +1,19 @@
+// The ranges of insert, copy and block count codes of the Brotli format (RFC 7932).
+
+#include "constants.h"
+
+const uint32_t brotli_insertBase[24] = {0,  1,  2,  3,  4,   5,   6,   8,    10,   14,   18,   26,
+                                        34, 50, 66, 98, 130, 194, 322, 578,  1090, 2114, 6210, 22594};
+const uint8_t brotli_insertExtra[24] = {0, 0, 0, 0, 0, 0, 1, 1, 2, 2,  3,  3,
+                                        4, 4, 5, 5, 6, 7, 8, 9, 10, 12, 14, 24};
+const uint32_t brotli_copyBase[24] = {2,  3,  4,  5,  6,  7,   8,   9,   10,  12,  14,   18,
+                                      22, 30, 38, 54, 70, 102, 134, 198, 326, 582, 1094, 2118};
+const uint8_t brotli_copyExtra[24] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2,  2,
+                                      3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 24};
+const uint32_t brotli_blockCountBase[BROTLI_BLOCK_COUNT_CODES] = {
+    1,   5,   9,   13,  17,   25,   33,   41,   49,   65,   81,   97,   113,
+    145, 177, 209, 241, 305,  369,  497,  753,  1265, 2289, 4337, 8433, 16625};
+const uint8_t brotli_blockCountExtra[BROTLI_BLOCK_COUNT_CODES] = {
+    2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 7, 8, 9, 10, 11, 12, 13, 24};
+const uint8_t brotli_codeLengthOrder[BROTLI_CODELEN_CODES] = {1, 2, 3, 4,  0,  5,  17, 6,  16,
+                                                              7, 8, 9, 10, 11, 12, 13, 14, 15};
@@ -0,0 +1,22 @@
+#ifndef CARYLL_DEP_BROTLI_COMMON_CONSTANTS_H
+#define CARYLL_DEP_BROTLI_COMMON_CONSTANTS_H
+
+#include <stdint.h>
+
+#define BROTLI_LITERAL_CODES 256
+#define BROTLI_COMMAND_CODES 704
+#define BROTLI_BLOCK_COUNT_CODES 26
+#define BROTLI_CODELEN_CODES 18
+
+// Insert lengths, copy lengths and block counts of each code: the base and the number of
+// extra bits which are added to it.
+extern const uint32_t brotli_insertBase[24];
+extern const uint8_t brotli_insertExtra[24];
+extern const uint32_t brotli_copyBase[24];
+extern const uint8_t brotli_copyExtra[24];
+extern const uint32_t brotli_blockCountBase[BROTLI_BLOCK_COUNT_CODES];
+extern const uint8_t brotli_blockCountExtra[BROTLI_BLOCK_COUNT_CODES];
+// The order code lengths of the code length code are stored in.
+extern const uint8_t brotli_codeLengthOrder[BROTLI_CODELEN_CODES];
+
+#endif
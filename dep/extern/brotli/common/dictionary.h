@@ -0,0 +1,52 @@
+#ifndef CARYLL_DEP_BROTLI_COMMON_DICTIONARY_H
+#define CARYLL_DEP_BROTLI_COMMON_DICTIONARY_H
+
+#include <stdint.h>
+
+#define BROTLI_NUM_TRANSFORMS 121
+#define BROTLI_MIN_WORD_LENGTH 4
+#define BROTLI_MAX_WORD_LENGTH 24
+
+typedef enum {
+	BROTLI_IDENTITY = 0,
+	BROTLI_OMIT_LAST_1 = 1,
+	BROTLI_OMIT_LAST_2,
+	BROTLI_OMIT_LAST_3,
+	BROTLI_OMIT_LAST_4,
+	BROTLI_OMIT_LAST_5,
+	BROTLI_OMIT_LAST_6,
+	BROTLI_OMIT_LAST_7,
+	BROTLI_OMIT_LAST_8,
+	BROTLI_OMIT_LAST_9,
+	BROTLI_UPPERCASE_FIRST = 10,
+	BROTLI_UPPERCASE_ALL = 11,
+	BROTLI_OMIT_FIRST_1 = 12,
+	BROTLI_OMIT_FIRST_2,
+	BROTLI_OMIT_FIRST_3,
+	BROTLI_OMIT_FIRST_4,
+	BROTLI_OMIT_FIRST_5,
+	BROTLI_OMIT_FIRST_6,
+	BROTLI_OMIT_FIRST_7,
+	BROTLI_OMIT_FIRST_8,
+	BROTLI_OMIT_FIRST_9
+} brotli_TransformType;
+
+typedef struct {
+	const char *prefix;
+	brotli_TransformType type;
+	const char *suffix;
+} brotli_Transform;
+
+extern const brotli_Transform brotli_transforms[BROTLI_NUM_TRANSFORMS];
+// Context ids of literals in the UTF8 mode: the first half is indexed by the last byte, the
+// second half by the one before, and the two are or-ed.
+extern const uint8_t brotli_contextUTF8[512];
+// Context groups of bytes in the signed mode; the id is group(p1) << 3 | group(p2).
+extern const uint8_t brotli_contextSigned[256];
+// The words of each length from 4 to 24 are stored one after another, in blocks of
+// 1 << brotli_dictionaryBits[length] words.
+extern const uint8_t brotli_dictionaryBits[BROTLI_MAX_WORD_LENGTH + 1];
+extern const uint32_t brotli_dictionaryOffsets[BROTLI_MAX_WORD_LENGTH + 1];
+extern const uint8_t brotli_dictionary[122784];
+
+#endif
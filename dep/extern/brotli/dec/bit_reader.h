@@ -0,0 +1,58 @@
+#ifndef CARYLL_DEP_BROTLI_DEC_BIT_READER_H
+#define CARYLL_DEP_BROTLI_DEC_BIT_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Reads bits starting from the least significant one of each byte. Past the end of the data it
+// reads zero bits, which brotli_bitsValid tells apart.
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+	size_t pos;
+	uint64_t bits;
+	uint8_t count;
+} brotli_BitReader;
+
+// Makes n bits, up to 32, available in r->bits.
+static inline void brotli_fillBits(brotli_BitReader *r, uint8_t n) {
+	while (r->count < n) {
+		if (r->pos < r->length) r->bits |= (uint64_t)r->data[r->pos] << r->count;
+		r->pos++;
+		r->count += 8;
+	}
+}
+static inline void brotli_dropBits(brotli_BitReader *r, uint8_t n) {
+	r->bits >>= n;
+	r->count -= n;
+}
+static inline uint32_t brotli_getBits(brotli_BitReader *r, uint8_t n) {
+	brotli_fillBits(r, n);
+	uint32_t value = (uint32_t)(r->bits & ((UINT64_C(1) << n) - 1));
+	brotli_dropBits(r, n);
+	return value;
+}
+// Skips to the next byte boundary.
+static inline void brotli_alignBits(brotli_BitReader *r) {
+	brotli_dropBits(r, r->count & 7);
+}
+// Whether the bits read so far lie within the data.
+static inline bool brotli_bitsValid(const brotli_BitReader *r) {
+	return r->pos * 8 - r->count <= r->length * 8;
+}
+// Copies n bytes at a byte boundary. Returns false when the data ends first.
+static inline bool brotli_getBytes(brotli_BitReader *r, uint8_t *out, size_t n) {
+	brotli_alignBits(r);
+	while (n && r->count) {
+		*out++ = (uint8_t)brotli_getBits(r, 8);
+		n--;
+	}
+	if (n > r->length - (r->pos < r->length ? r->pos : r->length)) return false;
+	memcpy(out, r->data + r->pos, n);
+	r->pos += n;
+	return brotli_bitsValid(r);
+}
+
+#endif
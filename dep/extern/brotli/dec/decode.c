@@ -0,0 +1,456 @@
+// The Brotli decoder, for streams which are decoded into memory at once.
+
+#include <stdlib.h>
+#include "brotli/decode.h"
+#include "../common/dictionary.h"
+#include "huffman.h"
+
+#define NO_BLOCK_SWITCH (1 << 24)
+
+// Insert-and-copy codes come in cells of 64, each pairing a range of 8 insert codes with one of
+// 8 copy codes; the first two cells use the last distance.
+static const uint8_t cellInsert[11] = {0, 0, 0, 0, 8, 8, 0, 16, 8, 16, 16};
+static const uint8_t cellCopy[11] = {0, 8, 0, 8, 0, 8, 16, 0, 16, 8, 16};
+// Distance codes below 16 refer to the ring of last distances, with a small adjustment.
+static const uint8_t ringBack[16] = {0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1};
+static const int8_t ringDelta[16] = {0, 0, 0, 0, -1, 1, -2, 2, -3, 3, -1, 1, -2, 2, -3, 3};
+
+typedef struct {
+	brotli_BitReader in;
+	uint8_t *out;
+	size_t length;
+	size_t produced;
+	size_t window;
+	uint32_t ring[4];
+	uint8_t ringIndex;
+	bool outputFull; // the data does not fit in the output
+} Decoder;
+
+// Block types of one category in a meta-block, and the codes switching between them
+typedef struct {
+	uint16_t count;
+	uint16_t type;
+	uint16_t previous;
+	uint32_t remaining;
+	brotli_HuffmanDecoder typeCode;
+	brotli_HuffmanDecoder countCode;
+} BlockSwitch;
+
+static uint16_t readVarLenUint8(brotli_BitReader *in) {
+	if (!brotli_getBits(in, 1)) return 0;
+	uint8_t n = (uint8_t)brotli_getBits(in, 3);
+	if (!n) return 1;
+	return (uint16_t)((1 << n) + brotli_getBits(in, n));
+}
+
+// The fixed code of code length code lengths
+static uint8_t readCodeLengthCodeLength(brotli_BitReader *in) {
+	switch (brotli_getBits(in, 2)) {
+		case 0:
+			return 0;
+		case 1:
+			return 4;
+		case 2:
+			return 3;
+		default:
+			if (!brotli_getBits(in, 1)) return 2;
+			return brotli_getBits(in, 1) ? 5 : 1;
+	}
+}
+
+static bool readSimplePrefixCode(brotli_BitReader *in, brotli_HuffmanDecoder *d,
+                                 uint16_t alphabetSize) {
+	uint8_t bits = 0;
+	while ((1u << bits) < alphabetSize) bits++;
+	uint8_t nsym = (uint8_t)brotli_getBits(in, 2) + 1;
+	uint16_t symbols[4];
+	for (uint8_t j = 0; j < nsym; j++) {
+		symbols[j] = (uint16_t)brotli_getBits(in, bits);
+		if (symbols[j] >= alphabetSize) return false;
+		for (uint8_t k = 0; k < j; k++) {
+			if (symbols[k] == symbols[j]) return false;
+		}
+	}
+	uint8_t lengths[BROTLI_COMMAND_CODES] = {0};
+	static const uint8_t simpleLengths[5][4] = {{0}, {1, 1}, {1, 2, 2}, {2, 2, 2, 2}, {1, 2, 3, 3}};
+	uint8_t shape = nsym - 1;
+	if (nsym == 4 && brotli_getBits(in, 1)) shape = 4;
+	for (uint8_t j = 0; j < nsym; j++) lengths[symbols[j]] = simpleLengths[shape][j];
+	brotli_buildHuffmanDecoder(d, lengths, alphabetSize);
+	if (nsym == 1) d->only = symbols[0];
+	return true;
+}
+
+static bool readPrefixCode(brotli_BitReader *in, brotli_HuffmanDecoder *d, uint16_t alphabetSize) {
+	uint8_t skip = (uint8_t)brotli_getBits(in, 2);
+	if (skip == 1) return readSimplePrefixCode(in, d, alphabetSize);
+
+	uint8_t clLengths[BROTLI_CODELEN_CODES] = {0};
+	int32_t space = 32;
+	uint8_t nonzero = 0, lastNonzero = 0;
+	for (uint8_t j = skip; j < BROTLI_CODELEN_CODES && space > 0; j++) {
+		uint8_t len = readCodeLengthCodeLength(in);
+		clLengths[brotli_codeLengthOrder[j]] = len;
+		if (len) {
+			space -= 32 >> len;
+			nonzero++;
+			lastNonzero = brotli_codeLengthOrder[j];
+		}
+	}
+	if (nonzero != 1 && space != 0) return false;
+	brotli_HuffmanDecoder clCode;
+	brotli_buildHuffmanDecoder(&clCode, clLengths, BROTLI_CODELEN_CODES);
+	if (nonzero == 1) clCode.only = lastNonzero;
+
+	// Code lengths; 16 repeats the last nonzero length and 17 repeats zeros, and consecutive
+	// repeat codes of the same kind make up the digits of one longer run.
+	uint8_t lengths[BROTLI_COMMAND_CODES] = {0};
+	uint8_t previous = 8, repeatLength = 0;
+	uint32_t repeat = 0;
+	space = 32768;
+	for (uint16_t j = 0; j < alphabetSize && space > 0;) {
+		int32_t code = brotli_getSymbol(in, &clCode);
+		if (code < 0 || !brotli_bitsValid(in)) return false;
+		if (code < 16) {
+			repeat = 0;
+			lengths[j++] = (uint8_t)code;
+			if (code) {
+				previous = (uint8_t)code;
+				space -= 32768 >> code;
+			}
+			continue;
+		}
+		uint8_t extraBits = code == 16 ? 2 : 3;
+		uint8_t len = code == 16 ? previous : 0;
+		if (repeatLength != len) repeat = 0, repeatLength = len;
+		uint32_t old = repeat;
+		if (repeat) repeat = (repeat - 2) << extraBits;
+		repeat += brotli_getBits(in, extraBits) + 3;
+		uint32_t delta = repeat - old;
+		if (j + delta > alphabetSize) return false;
+		for (uint32_t k = 0; k < delta; k++) lengths[j++] = len;
+		if (len) space -= (int32_t)(delta * (32768 >> len));
+	}
+	if (space != 0) return false;
+	return brotli_buildHuffmanDecoder(d, lengths, alphabetSize) == 0;
+}
+
+static uint32_t readBlockCount(brotli_BitReader *in, const brotli_HuffmanDecoder *code) {
+	int32_t symbol = brotli_getSymbol(in, code);
+	if (symbol < 0) return 0;
+	return brotli_blockCountBase[symbol] +
+	       brotli_getBits(in, brotli_blockCountExtra[symbol]);
+}
+static bool readBlockSwitch(brotli_BitReader *in, BlockSwitch *b) {
+	b->count = readVarLenUint8(in) + 1;
+	b->type = 0;
+	b->previous = 1;
+	b->remaining = NO_BLOCK_SWITCH;
+	if (b->count < 2) return true;
+	if (!readPrefixCode(in, &b->typeCode, b->count + 2)) return false;
+	if (!readPrefixCode(in, &b->countCode, BROTLI_BLOCK_COUNT_CODES)) return false;
+	b->remaining = readBlockCount(in, &b->countCode);
+	return true;
+}
+// Moves to the next block, for which none of the current one is left.
+static bool switchBlock(brotli_BitReader *in, BlockSwitch *b) {
+	if (b->count < 2) return false;
+	int32_t code = brotli_getSymbol(in, &b->typeCode);
+	if (code < 0) return false;
+	uint16_t type = code == 0 ? b->previous : code == 1 ? b->type + 1 : (uint16_t)(code - 2);
+	if (type >= b->count) type -= b->count;
+	b->previous = b->type;
+	b->type = type;
+	b->remaining = readBlockCount(in, &b->countCode);
+	return true;
+}
+
+// Context maps are run-length coded over zeros, and optionally move-to-front transformed.
+static bool readContextMap(brotli_BitReader *in, uint8_t *map, uint32_t size, uint16_t trees) {
+	if (trees < 2) return true;
+	uint8_t rleMax = brotli_getBits(in, 1) ? (uint8_t)brotli_getBits(in, 4) + 1 : 0;
+	brotli_HuffmanDecoder code;
+	if (!readPrefixCode(in, &code, trees + rleMax)) return false;
+	for (uint32_t j = 0; j < size;) {
+		int32_t symbol = brotli_getSymbol(in, &code);
+		if (symbol < 0 || !brotli_bitsValid(in)) return false;
+		if (symbol == 0) {
+			map[j++] = 0;
+		} else if (symbol <= rleMax) {
+			uint32_t run = (1u << symbol) + brotli_getBits(in, (uint8_t)symbol);
+			if (j + run > size) return false;
+			while (run--) map[j++] = 0;
+		} else {
+			map[j++] = (uint8_t)(symbol - rleMax);
+		}
+	}
+	if (brotli_getBits(in, 1)) {
+		uint8_t mtf[256];
+		for (uint16_t j = 0; j < 256; j++) mtf[j] = (uint8_t)j;
+		for (uint32_t j = 0; j < size; j++) {
+			uint8_t index = map[j], value = mtf[index];
+			map[j] = value;
+			for (; index; index--) mtf[index] = mtf[index - 1];
+			mtf[0] = value;
+		}
+	}
+	return true;
+}
+
+static inline uint8_t literalContext(uint8_t mode, uint8_t p1, uint8_t p2) {
+	switch (mode) {
+		case 0:
+			return p1 & 0x3F;
+		case 1:
+			return p1 >> 2;
+		case 2:
+			return brotli_contextUTF8[p1] | brotli_contextUTF8[256 + p2];
+		default:
+			return (uint8_t)(brotli_contextSigned[p1] << 3 | brotli_contextSigned[p2]);
+	}
+}
+
+// The uppercasing of the transforms, which works on UTF-8 sequences without decoding them
+static uint8_t toUpperCase(uint8_t *p) {
+	if (p[0] < 0xC0) {
+		if (p[0] >= 'a' && p[0] <= 'z') p[0] ^= 32;
+		return 1;
+	}
+	if (p[0] < 0xE0) {
+		p[1] ^= 32;
+		return 2;
+	}
+	p[2] ^= 5;
+	return 3;
+}
+// Writes a transformed dictionary word. Returns its length, or -1 when it is not valid or does
+// not fit.
+static int32_t writeDictionaryWord(Decoder *s, uint32_t length, uint32_t wordId) {
+	uint8_t bits = brotli_dictionaryBits[length];
+	uint32_t transformId = wordId >> bits;
+	if (transformId >= BROTLI_NUM_TRANSFORMS) return -1;
+	const brotli_Transform *t = &brotli_transforms[transformId];
+	const uint8_t *word = brotli_dictionary + brotli_dictionaryOffsets[length] +
+	                      (wordId & ((1u << bits) - 1)) * length;
+
+	uint8_t result[64] = {0};
+	int32_t n = 0;
+	for (const char *c = t->prefix; *c; c++) result[n++] = (uint8_t)*c;
+	int32_t len = (int32_t)length;
+	if (t->type <= BROTLI_OMIT_LAST_9) {
+		len -= t->type;
+	} else if (t->type >= BROTLI_OMIT_FIRST_1) {
+		int32_t skip = t->type - BROTLI_OMIT_FIRST_1 + 1;
+		word += skip;
+		len -= skip;
+	}
+	uint8_t *start = result + n;
+	for (int32_t j = 0; j < len; j++) result[n++] = word[j];
+	if (t->type == BROTLI_UPPERCASE_FIRST) {
+		toUpperCase(start);
+	} else if (t->type == BROTLI_UPPERCASE_ALL) {
+		for (uint8_t *p = start; len > 0;) {
+			uint8_t step = toUpperCase(p);
+			p += step, len -= step;
+		}
+	}
+	for (const char *c = t->suffix; *c; c++) result[n++] = (uint8_t)*c;
+
+	if ((size_t)n > s->length - s->produced) {
+		s->outputFull = true;
+		return -1;
+	}
+	memcpy(s->out + s->produced, result, n);
+	s->produced += n;
+	return n;
+}
+
+static bool readMetaBlockData(Decoder *s, uint32_t mlen) {
+	brotli_BitReader *in = &s->in;
+	bool ok = false;
+	uint8_t *modes = NULL, *literalMap = NULL, *distanceMap = NULL;
+	brotli_HuffmanDecoder *literalCodes = NULL, *commandCodes = NULL, *distanceCodes = NULL;
+	BlockSwitch *blocks = calloc(3, sizeof(BlockSwitch)); // literals, commands, distances
+	if (!blocks) return false;
+	for (uint8_t j = 0; j < 3; j++) {
+		if (!readBlockSwitch(in, &blocks[j])) goto FAIL;
+	}
+	BlockSwitch *L = &blocks[0], *I = &blocks[1], *D = &blocks[2];
+	uint8_t npostfix = (uint8_t)brotli_getBits(in, 2);
+	uint32_t ndirect = brotli_getBits(in, 4) << npostfix;
+	modes = calloc(L->count, 1);
+	if (!modes) goto FAIL;
+	for (uint16_t j = 0; j < L->count; j++) modes[j] = (uint8_t)brotli_getBits(in, 2);
+
+	uint16_t literalTrees = readVarLenUint8(in) + 1;
+	literalMap = calloc(64 * L->count, 1);
+	if (!literalMap || !readContextMap(in, literalMap, 64 * L->count, literalTrees)) goto FAIL;
+	uint16_t distanceTrees = readVarLenUint8(in) + 1;
+	distanceMap = calloc(4 * D->count, 1);
+	if (!distanceMap || !readContextMap(in, distanceMap, 4 * D->count, distanceTrees)) goto FAIL;
+	if (!brotli_bitsValid(in)) goto FAIL;
+
+	uint16_t distanceAlphabet = (uint16_t)(16 + ndirect + (48 << npostfix));
+	literalCodes = calloc(literalTrees, sizeof(brotli_HuffmanDecoder));
+	commandCodes = calloc(I->count, sizeof(brotli_HuffmanDecoder));
+	distanceCodes = calloc(distanceTrees, sizeof(brotli_HuffmanDecoder));
+	if (!literalCodes || !commandCodes || !distanceCodes) goto FAIL;
+	for (uint16_t j = 0; j < literalTrees; j++) {
+		if (!readPrefixCode(in, &literalCodes[j], BROTLI_LITERAL_CODES)) goto FAIL;
+	}
+	for (uint16_t j = 0; j < I->count; j++) {
+		if (!readPrefixCode(in, &commandCodes[j], BROTLI_COMMAND_CODES)) goto FAIL;
+	}
+	for (uint16_t j = 0; j < distanceTrees; j++) {
+		if (!readPrefixCode(in, &distanceCodes[j], distanceAlphabet)) goto FAIL;
+	}
+
+	int64_t remaining = mlen;
+	while (remaining > 0) {
+		if (!I->remaining && !switchBlock(in, I)) goto FAIL;
+		I->remaining--;
+		int32_t command = brotli_getSymbol(in, &commandCodes[I->type]);
+		if (command < 0 || !brotli_bitsValid(in)) goto FAIL;
+		uint8_t cell = (uint8_t)(command >> 6);
+		uint8_t ic = cellInsert[cell] + ((command >> 3) & 7), cc = cellCopy[cell] + (command & 7);
+		uint32_t insert = brotli_insertBase[ic] + brotli_getBits(in, brotli_insertExtra[ic]);
+		uint32_t copy = brotli_copyBase[cc] + brotli_getBits(in, brotli_copyExtra[cc]);
+
+		if (insert > s->length - s->produced) {
+			s->outputFull = true;
+			goto FAIL;
+		}
+		for (uint32_t j = 0; j < insert; j++) {
+			if (!L->remaining && !switchBlock(in, L)) goto FAIL;
+			L->remaining--;
+			uint8_t p1 = s->produced ? s->out[s->produced - 1] : 0;
+			uint8_t p2 = s->produced > 1 ? s->out[s->produced - 2] : 0;
+			uint8_t tree = literalMap[64 * L->type + literalContext(modes[L->type], p1, p2)];
+			int32_t literal = brotli_getSymbol(in, &literalCodes[tree]);
+			if (literal < 0) goto FAIL;
+			s->out[s->produced++] = (uint8_t)literal;
+		}
+		remaining -= insert;
+		if (remaining <= 0) break;
+
+		uint32_t distance;
+		int32_t dcode = 0;
+		if (command >= 128) {
+			if (!D->remaining && !switchBlock(in, D)) goto FAIL;
+			D->remaining--;
+			uint8_t tree = distanceMap[4 * D->type + (copy > 4 ? 3 : copy - 2)];
+			dcode = brotli_getSymbol(in, &distanceCodes[tree]);
+			if (dcode < 0) goto FAIL;
+		}
+		if (dcode < 16) {
+			int64_t d = (int64_t)s->ring[(s->ringIndex - 1 - ringBack[dcode]) & 3] + ringDelta[dcode];
+			if (d <= 0) goto FAIL;
+			distance = (uint32_t)d;
+		} else if ((uint32_t)dcode < 16 + ndirect) {
+			distance = dcode - 15;
+		} else {
+			uint32_t x = dcode - ndirect - 16;
+			uint8_t nbits = 1 + (uint8_t)(x >> (npostfix + 1));
+			uint32_t hcode = x >> npostfix, lcode = x & ((1u << npostfix) - 1);
+			uint32_t offset = ((2 + (hcode & 1)) << nbits) - 4;
+			distance = ((offset + brotli_getBits(in, nbits)) << npostfix) + lcode + ndirect + 1;
+		}
+		if (!brotli_bitsValid(in)) goto FAIL;
+
+		size_t maxDistance = s->produced < s->window ? s->produced : s->window;
+		if (distance > maxDistance) {
+			if (copy < BROTLI_MIN_WORD_LENGTH || copy > BROTLI_MAX_WORD_LENGTH) goto FAIL;
+			int32_t n = writeDictionaryWord(s, copy, (uint32_t)(distance - maxDistance - 1));
+			if (n < 0) goto FAIL;
+			remaining -= n;
+		} else {
+			if (dcode) s->ring[s->ringIndex++ & 3] = distance;
+			if (copy > s->length - s->produced) {
+				s->outputFull = true;
+				goto FAIL;
+			}
+			uint8_t *to = s->out + s->produced;
+			const uint8_t *from = to - distance;
+			for (uint32_t j = 0; j < copy; j++) to[j] = from[j];
+			s->produced += copy;
+			remaining -= copy;
+		}
+	}
+	ok = remaining == 0 && brotli_bitsValid(in);
+
+FAIL:
+	free(literalCodes);
+	free(commandCodes);
+	free(distanceCodes);
+	free(literalMap);
+	free(distanceMap);
+	free(modes);
+	free(blocks);
+	return ok;
+}
+
+static uint8_t readWindowBits(brotli_BitReader *in) {
+	if (!brotli_getBits(in, 1)) return 16;
+	uint8_t n = (uint8_t)brotli_getBits(in, 3);
+	if (n) return 17 + n;
+	n = (uint8_t)brotli_getBits(in, 3);
+	if (n == 1) return 0; // the large window extension
+	return n ? 8 + n : 17;
+}
+
+static bool decompress(Decoder *s) {
+	uint8_t windowBits = readWindowBits(&s->in);
+	if (!windowBits) return false;
+	s->window = ((size_t)1 << windowBits) - 16;
+
+	while (true) {
+		bool last = brotli_getBits(&s->in, 1);
+		if (last && brotli_getBits(&s->in, 1)) break; // ISLASTEMPTY
+		uint8_t nibbles = (uint8_t)brotli_getBits(&s->in, 2);
+		if (nibbles == 3) {
+			// Metadata, which is skipped
+			if (brotli_getBits(&s->in, 1)) return false;
+			uint8_t skipBytes = (uint8_t)brotli_getBits(&s->in, 2);
+			uint32_t skip = 0;
+			for (uint8_t j = 0; j < skipBytes; j++) {
+				skip |= brotli_getBits(&s->in, 8) << (8 * j);
+			}
+			if (skipBytes) skip += 1;
+			brotli_alignBits(&s->in);
+			for (uint32_t j = 0; j < skip; j++) brotli_getBits(&s->in, 8);
+		} else {
+			uint32_t mlen = brotli_getBits(&s->in, 4 * (nibbles + 4)) + 1;
+			if (mlen > s->length - s->produced) {
+				s->outputFull = true;
+				return false;
+			}
+			if (!last && brotli_getBits(&s->in, 1)) {
+				// Uncompressed
+				if (!brotli_getBytes(&s->in, s->out + s->produced, mlen)) return false;
+				s->produced += mlen;
+			} else if (!readMetaBlockData(s, mlen)) {
+				return false;
+			}
+		}
+		if (!brotli_bitsValid(&s->in)) return false;
+		if (last) break;
+	}
+	return brotli_bitsValid(&s->in);
+}
+
+BrotliDecoderResult BrotliDecoderDecompress(size_t encoded_size, const uint8_t *encoded_buffer,
+                                            size_t *decoded_size, uint8_t *decoded_buffer) {
+	Decoder s = {.in = {.data = encoded_buffer, .length = encoded_size},
+	             .out = decoded_buffer,
+	             .length = *decoded_size,
+	             .produced = 0,
+	             .ring = {16, 15, 11, 4},
+	             .ringIndex = 4};
+	if (!decompress(&s)) {
+		if (s.outputFull) return BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT;
+		if (!brotli_bitsValid(&s.in)) return BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT;
+		return BROTLI_DECODER_RESULT_ERROR;
+	}
+	*decoded_size = s.produced;
+	return BROTLI_DECODER_RESULT_SUCCESS;
+}
@@ -0,0 +1,36 @@
+#include "huffman.h"
+
+int32_t brotli_buildHuffmanDecoder(brotli_HuffmanDecoder *d, const uint8_t *lengths, uint16_t n) {
+	uint16_t offset[BROTLI_MAX_BITS + 2];
+	memset(d->count, 0, sizeof(d->count));
+	memset(d->root, 0, sizeof(d->root));
+	d->only = -1;
+	for (uint16_t j = 0; j < n; j++) d->count[lengths[j]]++;
+	int32_t left = 1;
+	for (uint8_t len = 1; len <= BROTLI_MAX_BITS; len++) {
+		left = (left << 1) - d->count[len];
+		if (left < 0) return -1;
+	}
+	offset[1] = 0;
+	for (uint8_t len = 1; len <= BROTLI_MAX_BITS; len++) {
+		offset[len + 1] = offset[len] + d->count[len];
+	}
+	for (uint16_t j = 0; j < n; j++) {
+		if (lengths[j]) d->symbol[offset[lengths[j]]++] = j;
+	}
+	// Fill the root table with the short codes, bit-reversed as they come from the stream
+	uint32_t code = 0;
+	uint16_t index = 0;
+	for (uint8_t len = 1; len <= BROTLI_ROOT_BITS; len++) {
+		for (uint16_t k = 0; k < d->count[len]; k++, code++) {
+			uint32_t reversed = 0;
+			for (uint8_t b = 0; b < len; b++) reversed |= ((code >> b) & 1) << (len - 1 - b);
+			uint16_t entry = (uint16_t)(d->symbol[index++] << 4 | len);
+			for (uint32_t fill = reversed; fill < (1 << BROTLI_ROOT_BITS); fill += 1 << len) {
+				d->root[fill] = entry;
+			}
+		}
+		code <<= 1;
+	}
+	return left;
+}
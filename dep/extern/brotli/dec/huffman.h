@@ -0,0 +1,46 @@
+#ifndef CARYLL_DEP_BROTLI_DEC_HUFFMAN_H
+#define CARYLL_DEP_BROTLI_DEC_HUFFMAN_H
+
+#include "../common/constants.h"
+#include "bit_reader.h"
+
+#define BROTLI_MAX_SYMBOLS BROTLI_COMMAND_CODES
+#define BROTLI_MAX_BITS 15
+#define BROTLI_ROOT_BITS 9
+
+// Decoding side of a canonical prefix code. Codes up to BROTLI_ROOT_BITS long are looked up in
+// a table; longer ones are decoded bit by bit from the counts of each length.
+typedef struct {
+	uint16_t count[BROTLI_MAX_BITS + 1];
+	uint16_t symbol[BROTLI_MAX_SYMBOLS];
+	uint16_t root[1 << BROTLI_ROOT_BITS]; // symbol << 4 | length, or 0 when longer
+	int32_t only; // the symbol of a code with a single zero-length entry, or -1
+} brotli_HuffmanDecoder;
+
+// Builds a decoder from the code lengths of n symbols. Returns the number of missing codes in
+// units of the longest length, 0 when the code is complete, or -1 when it is oversubscribed.
+int32_t brotli_buildHuffmanDecoder(brotli_HuffmanDecoder *d, const uint8_t *lengths, uint16_t n);
+// Decodes a symbol; returns -1 for a code which is not assigned.
+static inline int32_t brotli_getSymbol(brotli_BitReader *r, const brotli_HuffmanDecoder *d) {
+	if (d->only >= 0) return d->only;
+	brotli_fillBits(r, BROTLI_MAX_BITS);
+	uint16_t entry = d->root[r->bits & ((1 << BROTLI_ROOT_BITS) - 1)];
+	if (entry) {
+		brotli_dropBits(r, entry & 15);
+		return entry >> 4;
+	}
+	int32_t code = 0, first = 0, index = 0;
+	for (uint8_t len = 1; len <= BROTLI_MAX_BITS; len++) {
+		code |= (int32_t)(r->bits >> (len - 1)) & 1;
+		int32_t count = d->count[len];
+		if (code - first < count) {
+			brotli_dropBits(r, len);
+			return d->symbol[index + code - first];
+		}
+		index += count, first += count;
+		first <<= 1, code <<= 1;
+	}
+	return -1;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include "backward_references.h"
+
+#define HASH_BITS 15
+#define LAZY_LIMIT 32
+
+brotli_LZParser *brotli_newLZParser(const uint8_t *data, size_t length, uint32_t window,
+                                    uint32_t maxMatch, uint32_t maxChain) {
+	brotli_LZParser *parser = calloc(1, sizeof(brotli_LZParser));
+	if (!parser) return NULL;
+	parser->data = data;
+	parser->length = length;
+	parser->window = window;
+	parser->maxMatch = maxMatch;
+	parser->maxChain = maxChain;
+	// The chains only need to reach back a window, or over the whole input when it is shorter.
+	uint32_t chainSize = 1;
+	while (chainSize < window && chainSize < length) chainSize <<= 1;
+	parser->prevMask = chainSize - 1;
+	parser->head = malloc(sizeof(int32_t) << HASH_BITS);
+	parser->prev = malloc(sizeof(int32_t) * chainSize);
+	if (!parser->head || !parser->prev) {
+		brotli_deleteLZParser(parser);
+		return NULL;
+	}
+	for (size_t j = 0; j < (1 << HASH_BITS); j++) parser->head[j] = -1;
+	return parser;
+}
+void brotli_deleteLZParser(brotli_LZParser *parser) {
+	if (!parser) return;
+	free(parser->head);
+	free(parser->prev);
+	free(parser);
+}
+
+static inline uint32_t hash3(const uint8_t *p) {
+	return ((uint32_t)(p[0] | (p[1] << 8) | (p[2] << 16)) * 2654435761u) >> (32 - HASH_BITS);
+}
+static inline void insertUpTo(brotli_LZParser *m, size_t target) {
+	for (; m->inserted < target; m->inserted++) {
+		size_t p = m->inserted;
+		if (p + BROTLI_MIN_MATCH > m->length) continue;
+		uint32_t h = hash3(m->data + p);
+		m->prev[p & m->prevMask] = m->head[h];
+		m->head[h] = (int32_t)p;
+	}
+}
+static uint32_t longestMatch(const brotli_LZParser *m, size_t pos, size_t end,
+                             uint32_t *distance) {
+	if (pos + BROTLI_MIN_MATCH > end) return 0;
+	size_t maxLen = end - pos;
+	if (maxLen > m->maxMatch) maxLen = m->maxMatch;
+	const uint8_t *here = m->data + pos;
+	int32_t cand = m->head[hash3(here)];
+	uint32_t best = 0;
+	for (uint32_t chain = m->maxChain; chain && cand >= 0; chain--) {
+		size_t c = (size_t)cand;
+		if (c >= pos || pos - c > m->window) break;
+		const uint8_t *there = m->data + c;
+		if (there[best] == here[best]) {
+			size_t len = 0;
+			while (len < maxLen && there[len] == here[len]) len++;
+			if (len > best) {
+				best = (uint32_t)len;
+				*distance = (uint32_t)(pos - c);
+				if (len == maxLen) break;
+			}
+		}
+		int32_t next = m->prev[c & m->prevMask];
+		if (next >= cand) break;
+		cand = next;
+	}
+	return best >= BROTLI_MIN_MATCH ? best : 0;
+}
+
+size_t brotli_LZParse(brotli_LZParser *m, size_t end, brotli_LZSymbol *symbols,
+                      size_t capacity) {
+	size_t n = 0;
+	while (m->pos < end && n < capacity) {
+		size_t pos = m->pos;
+		uint32_t dist = 0, len;
+		insertUpTo(m, pos);
+		if (m->hasPending) {
+			len = m->pendingLength, dist = m->pendingDistance, m->hasPending = false;
+		} else {
+			len = longestMatch(m, pos, end, &dist);
+		}
+		if (len && len < LAZY_LIMIT && pos + 1 < end) {
+			insertUpTo(m, pos + 1);
+			uint32_t dist1 = 0;
+			uint32_t len1 = longestMatch(m, pos + 1, end, &dist1);
+			if (len1 > len) {
+				m->pendingLength = len1, m->pendingDistance = dist1, m->hasPending = true;
+				len = 0;
+			}
+		}
+		if (len) {
+			symbols[n].length = len, symbols[n].distance = dist;
+			m->pos += len;
+		} else {
+			symbols[n].length = m->data[pos], symbols[n].distance = 0;
+			m->pos += 1;
+		}
+		n++;
+	}
+	return n;
+}
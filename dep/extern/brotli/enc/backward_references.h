@@ -0,0 +1,42 @@
+#ifndef CARYLL_DEP_BROTLI_ENC_BACKWARD_REFERENCES_H
+#define CARYLL_DEP_BROTLI_ENC_BACKWARD_REFERENCES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BROTLI_MIN_MATCH 3
+
+// LZ77 symbols: a literal byte when distance is 0, a back reference otherwise.
+typedef struct {
+	uint32_t length;
+	uint32_t distance;
+} brotli_LZSymbol;
+
+// An LZ77 parser over hash chains of three-byte prefixes, with one-step lazy matching.
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+	uint32_t window;   // longest distance
+	uint32_t maxMatch; // longest match
+	uint32_t maxChain; // most candidates tried for a match
+	size_t pos;        // where parsing continues
+	int32_t *head;
+	int32_t *prev;
+	uint32_t prevMask;
+	size_t inserted; // positions below are in the chains
+	bool hasPending; // the match at pos, found by the lazy lookahead
+	uint32_t pendingLength;
+	uint32_t pendingDistance;
+} brotli_LZParser;
+
+// Returns NULL when memory runs out.
+brotli_LZParser *brotli_newLZParser(const uint8_t *data, size_t length, uint32_t window,
+                                    uint32_t maxMatch, uint32_t maxChain);
+void brotli_deleteLZParser(brotli_LZParser *parser);
+// Parses from parser->pos on into at most capacity symbols, and stops at end, which matches
+// do not cross. Returns the number of symbols written.
+size_t brotli_LZParse(brotli_LZParser *parser, size_t end, brotli_LZSymbol *symbols,
+                      size_t capacity);
+
+#endif
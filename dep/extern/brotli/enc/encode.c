@@ -0,0 +1,324 @@
+// The Brotli encoder. Each meta-block carries one literal, one insert-and-copy and one distance
+// prefix code, built from an LZ77 parse; it does not use the static dictionary, context
+// modeling or block switches. Meta-blocks which do not compress are stored.
+
+#include <stdlib.h>
+#include <string.h>
+#include "brotli/encode.h"
+#include "../common/constants.h"
+#include "backward_references.h"
+#include "entropy_encode.h"
+
+#define MAX_MATCH 0xFFFF
+#define METABLOCK_SIZE (1 << 18)
+
+#define DISTANCE_CODES 64 // 16 + NDIRECT + (48 << NPOSTFIX), with neither
+#define MAX_CODELEN_BITS 5
+
+// Insert-and-copy codes with an explicit distance start at these, by the ranges of their
+// insert and copy codes.
+static const uint16_t commandOffset[3][3] = {{128, 192, 384}, {256, 320, 512}, {448, 576, 640}};
+// The fixed code of code length code lengths, as written
+static const uint8_t codeLengthCodeValue[6] = {0, 7, 3, 2, 1, 15};
+static const uint8_t codeLengthCodeBits[6] = {2, 4, 3, 2, 2, 4};
+
+// A command inserts literals, then copies from a distance back.
+typedef struct {
+	size_t literals; // position of the inserted literals
+	uint32_t insert;
+	uint32_t copy; // 0 for the insert-only command which ends the data
+	uint32_t distance;
+	uint16_t code;
+	uint16_t distanceCode;
+	uint32_t distanceExtra;
+	uint8_t distanceExtraBits;
+} Command;
+
+static inline uint8_t insertCode(uint32_t len) {
+	uint8_t c = 23;
+	while (brotli_insertBase[c] > len) c--;
+	return c;
+}
+static inline uint8_t copyCode(uint32_t len) {
+	uint8_t c = 23;
+	while (brotli_copyBase[c] > len) c--;
+	return c;
+}
+// Distance codes beyond the 16 of the last-distance ring, for NPOSTFIX = NDIRECT = 0
+static inline uint16_t distanceCode(uint32_t distance, uint32_t *extra, uint8_t *extraBits) {
+	uint32_t x = distance + 3;
+	uint8_t top = 0;
+	while (x >> (top + 1)) top++;
+	uint8_t nbits = top - 1;
+	uint32_t bucket = x >> nbits; // 2 or 3
+	*extra = x - (bucket << nbits);
+	*extraBits = nbits;
+	return 16 + 2 * (nbits - 1) + (uint16_t)(bucket - 2);
+}
+
+// Run-length encoding of code lengths, with the repeat codes 16 and 17. Consecutive repeat
+// codes multiply, so a long run is written as the digits of its length, most significant first.
+static uint16_t encodeRun(uint8_t len, uint8_t previous, uint16_t run, uint8_t *symbols,
+                          uint8_t *extras, uint16_t m) {
+	uint8_t repeat = len ? 16 : 17, digitBits = len ? 2 : 3;
+	if (len && previous != len) symbols[m] = len, extras[m++] = 0, run--;
+	if (run == (len ? 7 : 11)) symbols[m] = len, extras[m++] = 0, run--;
+	if (run < 3) {
+		while (run--) symbols[m] = len, extras[m++] = 0;
+		return m;
+	}
+	uint16_t start = m;
+	run -= 3;
+	while (true) {
+		symbols[m] = repeat, extras[m++] = run & ((1 << digitBits) - 1);
+		run >>= digitBits;
+		if (!run) break;
+		run--;
+	}
+	for (uint16_t a = start, b = m - 1; a < b; a++, b--) {
+		uint8_t t = extras[a];
+		extras[a] = extras[b], extras[b] = t;
+	}
+	return m;
+}
+static uint16_t encodeCodeLengths(const uint8_t *lengths, uint16_t n, uint8_t *symbols,
+                                  uint8_t *extras) {
+	uint16_t m = 0;
+	uint8_t previous = 8;
+	for (uint16_t j = 0; j < n;) {
+		uint8_t len = lengths[j];
+		uint16_t run = 1;
+		while (j + run < n && lengths[j + run] == len) run++;
+		j += run;
+		m = encodeRun(len, previous, run, symbols, extras, m);
+		if (len) previous = len;
+	}
+	return m;
+}
+
+// A complex prefix code. The decoder stops reading lengths once the code is complete, so
+// trailing zero lengths are left out.
+static void writePrefixCode(brotli_BitWriter *w, const brotli_HuffmanCode *code, uint16_t n) {
+	while (!code->lengths[n - 1]) n--;
+	uint8_t symbols[BROTLI_COMMAND_CODES], extras[BROTLI_COMMAND_CODES];
+	uint16_t m = encodeCodeLengths(code->lengths, n, symbols, extras);
+	uint32_t freq[BROTLI_CODELEN_CODES] = {0};
+	for (uint16_t j = 0; j < m; j++) freq[symbols[j]]++;
+	brotli_HuffmanCode cl;
+	brotli_buildHuffmanCode(&cl, freq, BROTLI_CODELEN_CODES, MAX_CODELEN_BITS);
+
+	uint8_t count = BROTLI_CODELEN_CODES;
+	while (!cl.lengths[brotli_codeLengthOrder[count - 1]]) count--;
+	uint8_t skip = 0;
+	while (skip < 3 && !cl.lengths[brotli_codeLengthOrder[skip]]) skip++;
+	if (skip == 1) skip = 0; // HSKIP = 1 marks a simple code
+	brotli_putBits(w, skip, 2);
+	for (uint8_t j = skip; j < count; j++) {
+		uint8_t len = cl.lengths[brotli_codeLengthOrder[j]];
+		brotli_putBits(w, codeLengthCodeValue[len], codeLengthCodeBits[len]);
+	}
+	for (uint16_t j = 0; j < m; j++) {
+		brotli_putSymbol(w, &cl, symbols[j]);
+		if (symbols[j] == 16) brotli_putBits(w, extras[j], 2);
+		if (symbols[j] == 17) brotli_putBits(w, extras[j], 3);
+	}
+}
+
+typedef struct {
+	brotli_BitWriter w;
+	const uint8_t *data;
+	uint32_t lastDistance; // of the distance ring, 0 before the first explicit distance
+	Command *commands;
+} Encoder;
+
+// The last distance may be reused without a distance code, by the insert-and-copy codes below
+// 128, when the insert and copy codes are small enough.
+static inline uint16_t commandCode(const Command *c, bool implicitDistance) {
+	uint8_t ic = insertCode(c->insert), cc = copyCode(c->copy ? c->copy : 2);
+	uint16_t low = ((ic & 7) << 3) | (cc & 7);
+	if (implicitDistance && ic < 8 && cc < 16) return (cc < 8 ? 0 : 64) + low;
+	return commandOffset[ic >> 3][cc >> 3] + low;
+}
+
+static void writeMetaBlockHeader(brotli_BitWriter *w, uint32_t mlen, bool last,
+                                 bool uncompressed) {
+	brotli_putBits(w, last, 1);
+	if (last) brotli_putBits(w, 0, 1); // ISLASTEMPTY
+	uint8_t nibbles = 4;
+	while (nibbles < 6 && (mlen - 1) >> (4 * nibbles)) nibbles++;
+	brotli_putBits(w, nibbles - 4, 2);
+	brotli_putBits(w, mlen - 1, 4 * nibbles);
+	if (!last) brotli_putBits(w, uncompressed, 1); // ISUNCOMPRESSED
+}
+
+static void writeMetaBlock(Encoder *e, const brotli_LZSymbol *symbols, size_t n, size_t start,
+                           uint32_t mlen, bool last) {
+	// Gather the symbols into commands.
+	size_t nCommands = 0;
+	Command *c = NULL;
+	for (size_t j = 0, at = start; j < n; j++) {
+		if (!c) {
+			c = &e->commands[nCommands++];
+			c->literals = at, c->insert = 0, c->copy = 0, c->distance = 0;
+		}
+		if (symbols[j].distance) {
+			c->copy = symbols[j].length, c->distance = symbols[j].distance;
+			at += symbols[j].length;
+			c = NULL;
+		} else {
+			c->insert++, at++;
+		}
+	}
+
+	uint32_t litFreq[BROTLI_LITERAL_CODES] = {0};
+	uint32_t cmdFreq[BROTLI_COMMAND_CODES] = {0};
+	uint32_t distFreq[DISTANCE_CODES] = {0};
+	uint32_t lastDistance = e->lastDistance;
+	for (size_t k = 0; k < nCommands; k++) {
+		c = &e->commands[k];
+		for (uint32_t j = 0; j < c->insert; j++) litFreq[e->data[c->literals + j]]++;
+		// The meta-block ends before the distance of an insert-only command.
+		bool reuse = !c->copy || c->distance == lastDistance;
+		c->code = commandCode(c, reuse);
+		cmdFreq[c->code]++;
+		if (!c->copy) continue;
+		if (c->distance == lastDistance) {
+			c->distanceCode = 0, c->distanceExtraBits = 0;
+		} else {
+			c->distanceCode = distanceCode(c->distance, &c->distanceExtra, &c->distanceExtraBits);
+			lastDistance = c->distance;
+		}
+		if (c->code >= 128) distFreq[c->distanceCode]++;
+	}
+	e->lastDistance = lastDistance;
+	brotli_HuffmanCode *codes = malloc(3 * sizeof(brotli_HuffmanCode));
+	if (!codes) {
+		e->w.overflow = true; // which makes the caller store the meta-block
+		return;
+	}
+	brotli_HuffmanCode *lit = &codes[0], *cmd = &codes[1], *dist = &codes[2];
+	brotli_buildHuffmanCode(lit, litFreq, BROTLI_LITERAL_CODES, BROTLI_MAX_BITS);
+	brotli_buildHuffmanCode(cmd, cmdFreq, BROTLI_COMMAND_CODES, BROTLI_MAX_BITS);
+	brotli_buildHuffmanCode(dist, distFreq, DISTANCE_CODES, BROTLI_MAX_BITS);
+
+	brotli_BitWriter *w = &e->w;
+	writeMetaBlockHeader(w, mlen, last, false);
+	brotli_putBits(w, 0, 1); // one literal block type
+	brotli_putBits(w, 0, 1); // one insert-and-copy block type
+	brotli_putBits(w, 0, 1); // one distance block type
+	brotli_putBits(w, 0, 2); // NPOSTFIX
+	brotli_putBits(w, 0, 4); // NDIRECT
+	brotli_putBits(w, 0, 2); // literal context mode
+	brotli_putBits(w, 0, 1); // one literal prefix code
+	brotli_putBits(w, 0, 1); // one distance prefix code
+	writePrefixCode(w, lit, BROTLI_LITERAL_CODES);
+	writePrefixCode(w, cmd, BROTLI_COMMAND_CODES);
+	writePrefixCode(w, dist, DISTANCE_CODES);
+
+	for (size_t k = 0; k < nCommands; k++) {
+		c = &e->commands[k];
+		uint8_t ic = insertCode(c->insert), cc = copyCode(c->copy ? c->copy : 2);
+		brotli_putSymbol(w, cmd, c->code);
+		uint8_t insertExtra = brotli_insertExtra[ic], copyExtra = brotli_copyExtra[cc];
+		if (insertExtra) brotli_putBits(w, c->insert - brotli_insertBase[ic], insertExtra);
+		if (copyExtra) brotli_putBits(w, c->copy - brotli_copyBase[cc], copyExtra);
+		for (uint32_t j = 0; j < c->insert; j++) {
+			brotli_putSymbol(w, lit, e->data[c->literals + j]);
+		}
+		if (c->copy && c->code >= 128) {
+			brotli_putSymbol(w, dist, c->distanceCode);
+			if (c->distanceExtraBits) {
+				brotli_putBits(w, c->distanceExtra, c->distanceExtraBits);
+			}
+		}
+	}
+	free(codes);
+}
+
+// Uncompressed meta-blocks cannot be the last one, which then follows empty.
+static void writeUncompressedMetaBlock(brotli_BitWriter *w, const uint8_t *data, uint32_t mlen) {
+	writeMetaBlockHeader(w, mlen, false, true);
+	brotli_flushBits(w);
+	for (uint32_t j = 0; j < mlen; j++) brotli_putByte(w, data[j]);
+}
+
+static void writeWindowBits(brotli_BitWriter *w, int lgwin) {
+	if (lgwin == 16) {
+		brotli_putBits(w, 0, 1);
+	} else if (lgwin == 17) {
+		brotli_putBits(w, 1, 7);
+	} else if (lgwin > 17) {
+		brotli_putBits(w, (uint32_t)(lgwin - 17) << 1 | 1, 4);
+	} else {
+		brotli_putBits(w, (uint32_t)(lgwin - 8) << 4 | 1, 7);
+	}
+}
+
+size_t BrotliEncoderMaxCompressedSize(size_t input_size) {
+	// The window bits and the empty last meta-block, and the header of each stored one
+	size_t blocks = input_size / METABLOCK_SIZE + 1;
+	size_t result = input_size + 2 + 5 * blocks;
+	return result < input_size ? 0 : result;
+}
+
+BROTLI_BOOL BrotliEncoderCompress(int quality, int lgwin, BrotliEncoderMode mode,
+                                  size_t input_size, const uint8_t *input_buffer,
+                                  size_t *encoded_size, uint8_t *encoded_buffer) {
+	if (quality < BROTLI_MIN_QUALITY || quality > BROTLI_MAX_QUALITY) return BROTLI_FALSE;
+	if (lgwin < BROTLI_MIN_WINDOW_BITS || lgwin > BROTLI_MAX_WINDOW_BITS) return BROTLI_FALSE;
+	(void)mode; // without context modeling, fonts and text are encoded alike
+	Encoder e = {.w = {.out = encoded_buffer, .capacity = *encoded_size},
+	             .data = input_buffer,
+	             .lastDistance = 0};
+	writeWindowBits(&e.w, lgwin);
+
+	// Higher qualities follow longer hash chains.
+	uint32_t maxChain = quality < 2 ? 4 : quality < 5 ? 16 : quality < 10 ? 64 : 128;
+	brotli_LZParser *parser = NULL;
+	brotli_LZSymbol *symbols = NULL;
+	if (input_size) {
+		parser = brotli_newLZParser(input_buffer, input_size, (1u << lgwin) - 16, MAX_MATCH,
+		                            maxChain);
+		symbols = malloc(METABLOCK_SIZE * sizeof(brotli_LZSymbol));
+		e.commands = malloc(METABLOCK_SIZE * sizeof(Command));
+		if (!parser || !symbols || !e.commands) {
+			brotli_deleteLZParser(parser);
+			free(symbols);
+			free(e.commands);
+			return BROTLI_FALSE;
+		}
+	}
+	bool lastStored = true;
+	while (parser && parser->pos < input_size) {
+		size_t start = parser->pos;
+		size_t end = input_size - start > METABLOCK_SIZE ? start + METABLOCK_SIZE : input_size;
+		uint32_t mlen = (uint32_t)(end - start);
+		size_t n = brotli_LZParse(parser, end, symbols, METABLOCK_SIZE);
+		// Store the meta-block instead when its codes take more room than its data would with
+		// the header, the padding and the empty last meta-block of a stored one.
+		brotli_BitWriter before = e.w;
+		uint32_t lastDistance = e.lastDistance;
+		writeMetaBlock(&e, symbols, n, start, mlen, end == input_size);
+		size_t storedBits = (size_t)mlen * 8 + 40;
+		if (e.w.overflow || brotli_bitsWritten(&e.w) - brotli_bitsWritten(&before) > storedBits) {
+			e.w = before;
+			e.lastDistance = lastDistance;
+			writeUncompressedMetaBlock(&e.w, input_buffer + start, mlen);
+			lastStored = true;
+		} else {
+			lastStored = false;
+		}
+	}
+	if (lastStored) {
+		brotli_putBits(&e.w, 1, 1); // ISLAST
+		brotli_putBits(&e.w, 1, 1); // ISLASTEMPTY
+	}
+	brotli_flushBits(&e.w);
+
+	free(e.commands);
+	free(symbols);
+	brotli_deleteLZParser(parser);
+	if (e.w.overflow) return BROTLI_FALSE;
+	*encoded_size = e.w.pos;
+	return BROTLI_TRUE;
+}
@@ -0,0 +1,97 @@
+// Building the canonical Huffman codes of Brotli.
+
+#include <stdlib.h>
+#include "entropy_encode.h"
+
+typedef struct {
+	uint32_t freq;
+	uint16_t symbol;
+} HuffmanLeaf;
+
+static int byFrequency(const void *a, const void *b) {
+	const HuffmanLeaf *x = a, *y = b;
+	if (x->freq != y->freq) return x->freq < y->freq ? -1 : 1;
+	return (int)x->symbol - (int)y->symbol;
+}
+
+static void buildLengths(const uint32_t *freq, uint16_t n, uint8_t maxBits, uint8_t *lengths) {
+	HuffmanLeaf leaves[BROTLI_MAX_SYMBOLS];
+	uint16_t m = 0;
+	for (uint16_t j = 0; j < n; j++) {
+		lengths[j] = 0;
+		if (freq[j]) leaves[m].freq = freq[j], leaves[m].symbol = j, m++;
+	}
+	for (uint16_t j = 0; m < 2; j++) {
+		if (!freq[j]) leaves[m].freq = 1, leaves[m].symbol = j, m++;
+	}
+	qsort(leaves, m, sizeof(HuffmanLeaf), byFrequency);
+
+	// Merge the two lightest nodes repeatedly. Leaves are 0..m-1 and internal nodes m..2m-2,
+	// which are created in nondecreasing weight, so two queues suffice.
+	uint32_t weight[2 * BROTLI_MAX_SYMBOLS];
+	uint16_t parent[2 * BROTLI_MAX_SYMBOLS];
+	uint16_t depth[2 * BROTLI_MAX_SYMBOLS];
+	for (uint16_t j = 0; j < m; j++) weight[j] = leaves[j].freq;
+	uint16_t nextLeaf = 0, nextNode = m, total = m;
+	for (uint16_t k = 0; k < m - 1; k++) {
+		uint16_t pick[2];
+		for (uint8_t t = 0; t < 2; t++) {
+			if (nextLeaf < m && (nextNode >= total || weight[nextLeaf] <= weight[nextNode])) {
+				pick[t] = nextLeaf++;
+			} else {
+				pick[t] = nextNode++;
+			}
+		}
+		weight[total] = weight[pick[0]] + weight[pick[1]];
+		parent[pick[0]] = parent[pick[1]] = total;
+		total++;
+	}
+	depth[total - 1] = 0;
+	for (uint16_t j = total - 1; j-- > 0;) depth[j] = depth[parent[j]] + 1;
+
+	// Limit the depths, then give the longest codes to the rarest symbols.
+	uint16_t count[BROTLI_MAX_BITS + 1] = {0};
+	for (uint16_t j = 0; j < m; j++) count[depth[j] > maxBits ? maxBits : depth[j]]++;
+	uint32_t kraft = 0;
+	for (uint8_t b = 1; b <= maxBits; b++) kraft += (uint32_t)count[b] << (maxBits - b);
+	while (kraft > (1u << maxBits)) {
+		count[maxBits]--;
+		for (uint8_t b = maxBits - 1; b > 0; b--) {
+			if (count[b]) {
+				count[b]--;
+				count[b + 1] += 2;
+				break;
+			}
+		}
+		kraft--;
+	}
+	uint16_t j = 0;
+	for (uint8_t b = maxBits; b > 0; b--) {
+		for (uint16_t k = 0; k < count[b]; k++) lengths[leaves[j++].symbol] = b;
+	}
+}
+
+static void assignCodes(brotli_HuffmanCode *code, uint16_t n) {
+	uint16_t count[BROTLI_MAX_BITS + 1] = {0};
+	uint16_t next[BROTLI_MAX_BITS + 1];
+	for (uint16_t j = 0; j < n; j++) count[code->lengths[j]]++;
+	count[0] = 0;
+	uint16_t c = 0;
+	for (uint8_t b = 1; b <= BROTLI_MAX_BITS; b++) {
+		c = (c + count[b - 1]) << 1;
+		next[b] = c;
+	}
+	for (uint16_t j = 0; j < n; j++) {
+		uint8_t len = code->lengths[j];
+		if (!len) continue;
+		uint16_t v = next[len]++, r = 0;
+		for (uint8_t b = 0; b < len; b++) r |= ((v >> b) & 1) << (len - 1 - b);
+		code->codes[j] = r;
+	}
+}
+
+void brotli_buildHuffmanCode(brotli_HuffmanCode *code, const uint32_t *freq, uint16_t n,
+                             uint8_t maxBits) {
+	buildLengths(freq, n, maxBits, code->lengths);
+	assignCodes(code, n);
+}
@@ -0,0 +1,68 @@
+#ifndef CARYLL_DEP_BROTLI_ENC_ENTROPY_ENCODE_H
+#define CARYLL_DEP_BROTLI_ENC_ENTROPY_ENCODE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../common/constants.h"
+
+#define BROTLI_MAX_SYMBOLS BROTLI_COMMAND_CODES
+#define BROTLI_MAX_BITS 15
+
+// Bits are packed starting from the least significant one. Writing past the end of the output
+// sets overflow and drops the bytes; a writer copied beforehand rewinds it.
+typedef struct {
+	uint8_t *out;
+	size_t capacity;
+	size_t pos;
+	uint32_t bits;
+	uint8_t count;
+	bool overflow;
+} brotli_BitWriter;
+
+static inline void brotli_putByte(brotli_BitWriter *w, uint8_t byte) {
+	if (w->pos < w->capacity) {
+		w->out[w->pos] = byte;
+	} else {
+		w->overflow = true;
+	}
+	w->pos++;
+}
+// Writes the n lowest bits of value; n + 7 must not exceed 32.
+static inline void brotli_putBits(brotli_BitWriter *w, uint32_t value, uint8_t n) {
+	w->bits |= value << w->count;
+	w->count += n;
+	while (w->count >= 8) {
+		brotli_putByte(w, w->bits & 0xFF);
+		w->bits >>= 8;
+		w->count -= 8;
+	}
+}
+// Pads the last byte with zero bits.
+static inline void brotli_flushBits(brotli_BitWriter *w) {
+	if (w->count) brotli_putByte(w, w->bits & 0xFF);
+	w->bits = 0;
+	w->count = 0;
+}
+// The number of bits written so far.
+static inline size_t brotli_bitsWritten(const brotli_BitWriter *w) {
+	return w->pos * 8 + w->count;
+}
+
+// A canonical prefix code
+typedef struct {
+	uint8_t lengths[BROTLI_MAX_SYMBOLS];
+	uint16_t codes[BROTLI_MAX_SYMBOLS]; // bit-reversed, ready for brotli_putBits
+} brotli_HuffmanCode;
+
+// Builds a Huffman code for the frequencies of n symbols, with code lengths limited to maxBits.
+// There are always two symbols with codes at least, so the code is complete.
+void brotli_buildHuffmanCode(brotli_HuffmanCode *code, const uint32_t *freq, uint16_t n,
+                             uint8_t maxBits);
+
+static inline void brotli_putSymbol(brotli_BitWriter *w, const brotli_HuffmanCode *code,
+                                    uint16_t symbol) {
+	brotli_putBits(w, code->codes[symbol], code->lengths[symbol]);
+}
+
+#endif
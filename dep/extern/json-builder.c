@@ -40,6 +40,13 @@
 #define snprintf _snprintf
 #endif
 
+/* otfcc: values follow the JSON allocator of the thread, see otfcc/allocator.h. */
+#include "otfcc/allocator.h"
+#define malloc(n) otfcc_allocateJson((n), false)
+#define calloc(n, size) otfcc_allocateJson((n) * (size), true)
+#define realloc(p, n) otfcc_reallocateJson((p), (n))
+#define free otfcc_deallocateJson
+
 const static json_serialize_opts default_opts = {
     json_serialize_mode_single_line, 0, 3 /* indent_size */
 };
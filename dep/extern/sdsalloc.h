@@ -36,6 +36,8 @@
  * the include of your alternate allocator if needed (not needed in order
  * to use the default libc allocator). */
 
-#define s_malloc malloc
-#define s_realloc realloc
-#define s_free free
+/* otfcc: strings follow the allocator current on the thread, see otfcc/allocator.h. */
+#include "otfcc/allocator.h"
+#define s_malloc(n) otfcc_allocate((n), false, __LINE__)
+#define s_realloc(p, n) otfcc_reallocate((p), (n), __LINE__)
+#define s_free otfcc_deallocate
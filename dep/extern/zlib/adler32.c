@@ -0,0 +1,21 @@
+#include "zutil.h"
+
+#define BASE 65521
+// The most bytes which cannot overflow the sums before the modulo
+#define NMAX 5552
+
+uLong adler32(uLong adler, const Bytef *buf, size_t len) {
+	uint32_t a = adler & 0xFFFF, b = (adler >> 16) & 0xFFFF;
+	if (!buf) return 1;
+	while (len) {
+		size_t n = len < NMAX ? len : NMAX;
+		len -= n;
+		while (n--) {
+			a += *buf++;
+			b += a;
+		}
+		a %= BASE;
+		b %= BASE;
+	}
+	return (uLong)b << 16 | a;
+}
@@ -0,0 +1,348 @@
+// The DEFLATE encoder: LZ77 over hash chains of three-byte prefixes with one-step lazy matching,
+// and blocks which take the cheapest of dynamic Huffman codes, the fixed codes or storing.
+
+#include "zutil.h"
+
+#define WINDOW_SIZE 32768
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define HASH_BITS 15
+#define BLOCK_SYMBOLS 16384
+#define MAX_STORED 65535
+#define MAX_CODELEN_BITS 7
+
+// How hard each level searches: the longest hash chain it follows, the match length which
+// stops the search, and the longest match for which it still looks one byte ahead.
+typedef struct {
+	uint16_t maxChain;
+	uint16_t niceLength;
+	uint16_t maxLazy;
+} Config;
+static const Config configs[10] = {{0, 0, 0},       {4, 8, 0},        {8, 16, 0},
+                                   {32, 32, 0},     {16, 16, 16},     {32, 32, 32},
+                                   {128, 128, 128}, {256, 128, 128},  {1024, 258, 258},
+                                   {4096, 258, 258}};
+
+// LZ77 symbols: a literal byte when distance is 0, a back reference otherwise.
+typedef struct {
+	uint16_t length;
+	uint16_t distance;
+} Symbol;
+
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+	Config config;
+	size_t pos; // where parsing continues
+	int32_t *head;
+	int32_t *prev;
+	uint32_t prevMask;
+	size_t inserted; // positions below are in the chains
+	bool hasPending; // the match at pos, found by the lazy lookahead
+	uint16_t pendingLength;
+	uint16_t pendingDistance;
+} Matcher;
+
+static bool initMatcher(Matcher *m, const uint8_t *data, size_t length, int level) {
+	memset(m, 0, sizeof(*m));
+	m->data = data;
+	m->length = length;
+	m->config = configs[level];
+	// The chains only need to reach back a window, or over the whole input when it is shorter.
+	uint32_t chainSize = 1;
+	while (chainSize < WINDOW_SIZE && chainSize < length) chainSize <<= 1;
+	m->prevMask = chainSize - 1;
+	m->head = malloc(sizeof(int32_t) << HASH_BITS);
+	m->prev = malloc(sizeof(int32_t) * chainSize);
+	if (!m->head || !m->prev) return false;
+	for (size_t j = 0; j < (1 << HASH_BITS); j++) m->head[j] = -1;
+	return true;
+}
+
+static inline uint32_t hash3(const uint8_t *p) {
+	return ((uint32_t)(p[0] | (p[1] << 8) | (p[2] << 16)) * 2654435761u) >> (32 - HASH_BITS);
+}
+static inline void insertUpTo(Matcher *m, size_t target) {
+	for (; m->inserted < target; m->inserted++) {
+		size_t p = m->inserted;
+		if (p + MIN_MATCH > m->length) continue;
+		uint32_t h = hash3(m->data + p);
+		m->prev[p & m->prevMask] = m->head[h];
+		m->head[h] = (int32_t)p;
+	}
+}
+static uint16_t longestMatch(const Matcher *m, size_t pos, uint16_t *distance) {
+	if (pos + MIN_MATCH > m->length) return 0;
+	size_t maxLen = m->length - pos;
+	if (maxLen > MAX_MATCH) maxLen = MAX_MATCH;
+	const uint8_t *here = m->data + pos;
+	int32_t cand = m->head[hash3(here)];
+	size_t best = 0;
+	for (uint16_t chain = m->config.maxChain; chain && cand >= 0; chain--) {
+		size_t c = (size_t)cand;
+		if (c >= pos || pos - c > WINDOW_SIZE) break;
+		const uint8_t *there = m->data + c;
+		if (there[best] == here[best]) {
+			size_t len = 0;
+			while (len < maxLen && there[len] == here[len]) len++;
+			if (len > best) {
+				best = len;
+				*distance = (uint16_t)(pos - c);
+				if (len >= maxLen || len >= m->config.niceLength) break;
+			}
+		}
+		int32_t next = m->prev[c & m->prevMask];
+		if (next >= cand) break;
+		cand = next;
+	}
+	return best >= MIN_MATCH ? (uint16_t)best : 0;
+}
+
+// Parses from m->pos on into at most capacity symbols. Returns the number of symbols written.
+static size_t parse(Matcher *m, Symbol *symbols, size_t capacity) {
+	size_t n = 0;
+	while (m->pos < m->length && n < capacity) {
+		size_t pos = m->pos;
+		uint16_t dist = 0, len;
+		insertUpTo(m, pos);
+		if (m->hasPending) {
+			len = m->pendingLength, dist = m->pendingDistance, m->hasPending = false;
+		} else {
+			len = longestMatch(m, pos, &dist);
+		}
+		if (len && len < m->config.maxLazy && pos + 1 < m->length) {
+			insertUpTo(m, pos + 1);
+			uint16_t dist1 = 0;
+			uint16_t len1 = longestMatch(m, pos + 1, &dist1);
+			if (len1 > len) {
+				m->pendingLength = len1, m->pendingDistance = dist1, m->hasPending = true;
+				len = 0;
+			}
+		}
+		if (len) {
+			symbols[n].length = len, symbols[n].distance = dist;
+			m->pos += len;
+		} else {
+			symbols[n].length = m->data[pos], symbols[n].distance = 0;
+			m->pos += 1;
+		}
+		n++;
+	}
+	return n;
+}
+
+static inline uint8_t lengthCode(uint16_t len) {
+	uint8_t c = 28;
+	while (z_lengthBase[c] > len) c--;
+	return c;
+}
+static inline uint8_t distCode(uint16_t dist) {
+	uint8_t c = 29;
+	while (z_distBase[c] > dist) c--;
+	return c;
+}
+
+// Run-length encoding of the code lengths, with the repeat codes 16, 17 and 18.
+static uint16_t encodeCodeLengths(const uint8_t *lengths, uint16_t n, uint8_t *symbols,
+                                  uint8_t *extras) {
+	uint16_t m = 0;
+	for (uint16_t j = 0; j < n;) {
+		uint8_t len = lengths[j];
+		uint16_t run = 1;
+		while (j + run < n && lengths[j + run] == len) run++;
+		j += run;
+		if (len == 0) {
+			while (run >= 11) {
+				uint16_t r = run > 138 ? 138 : run;
+				symbols[m] = 18, extras[m++] = (uint8_t)(r - 11), run -= r;
+			}
+			if (run >= 3) symbols[m] = 17, extras[m++] = (uint8_t)(run - 3), run = 0;
+		} else {
+			symbols[m] = len, extras[m++] = 0, run--;
+			while (run >= 3) {
+				uint16_t r = run > 6 ? 6 : run;
+				symbols[m] = 16, extras[m++] = (uint8_t)(r - 3), run -= r;
+			}
+		}
+		while (run--) symbols[m] = len, extras[m++] = 0;
+	}
+	return m;
+}
+
+// The header of a block with dynamic codes, which describes the codes it uses.
+typedef struct {
+	z_HuffmanCode lit, dist, cl;
+	uint16_t hlit, hdist;
+	uint8_t hclen;
+	uint16_t nCL;
+	uint8_t clSymbols[Z_LITLEN_CODES + Z_DIST_CODES];
+	uint8_t clExtras[Z_LITLEN_CODES + Z_DIST_CODES];
+} DynamicHeader;
+
+static size_t buildDynamicHeader(DynamicHeader *h, const uint32_t *litFreq,
+                                 const uint32_t *distFreq) {
+	z_buildHuffmanCode(&h->lit, litFreq, Z_LITLEN_CODES, Z_MAX_BITS);
+	z_buildHuffmanCode(&h->dist, distFreq, Z_DIST_CODES, Z_MAX_BITS);
+	h->hlit = Z_LITLEN_CODES, h->hdist = Z_DIST_CODES;
+	while (h->hlit > 257 && !h->lit.lengths[h->hlit - 1]) h->hlit--;
+	while (h->hdist > 1 && !h->dist.lengths[h->hdist - 1]) h->hdist--;
+	uint8_t lengths[Z_LITLEN_CODES + Z_DIST_CODES];
+	memcpy(lengths, h->lit.lengths, h->hlit);
+	memcpy(lengths + h->hlit, h->dist.lengths, h->hdist);
+	h->nCL = encodeCodeLengths(lengths, h->hlit + h->hdist, h->clSymbols, h->clExtras);
+	uint32_t clFreq[Z_CODELEN_CODES] = {0};
+	for (uint16_t j = 0; j < h->nCL; j++) clFreq[h->clSymbols[j]]++;
+	z_buildHuffmanCode(&h->cl, clFreq, Z_CODELEN_CODES, MAX_CODELEN_BITS);
+	h->hclen = Z_CODELEN_CODES;
+	while (h->hclen > 4 && !h->cl.lengths[z_codeLengthOrder[h->hclen - 1]]) h->hclen--;
+
+	size_t bits = 5 + 5 + 4 + 3 * h->hclen + z_codeCost(&h->cl, clFreq, Z_CODELEN_CODES);
+	bits += 2 * clFreq[16] + 3 * clFreq[17] + 7 * clFreq[18];
+	return bits;
+}
+static void writeDynamicHeader(z_BitWriter *w, const DynamicHeader *h) {
+	z_putBits(w, h->hlit - 257, 5);
+	z_putBits(w, h->hdist - 1, 5);
+	z_putBits(w, h->hclen - 4, 4);
+	for (uint8_t j = 0; j < h->hclen; j++) z_putBits(w, h->cl.lengths[z_codeLengthOrder[j]], 3);
+	for (uint16_t j = 0; j < h->nCL; j++) {
+		uint8_t s = h->clSymbols[j];
+		z_putSymbol(w, &h->cl, s);
+		if (s == 16) z_putBits(w, h->clExtras[j], 2);
+		if (s == 17) z_putBits(w, h->clExtras[j], 3);
+		if (s == 18) z_putBits(w, h->clExtras[j], 7);
+	}
+}
+
+// The fixed codes of section 3.2.6
+static void fixedCodes(z_HuffmanCode *lit, z_HuffmanCode *dist) {
+	for (uint16_t j = 0; j < 288; j++) lit->lengths[j] = j < 144 ? 8 : j < 256 ? 9 : j < 280 ? 7 : 8;
+	for (uint16_t j = 0; j < 30; j++) dist->lengths[j] = 5;
+	z_assignCodes(lit, 288);
+	z_assignCodes(dist, 30);
+}
+
+static void writeSymbols(z_BitWriter *w, const Symbol *symbols, size_t n, const z_HuffmanCode *lit,
+                         const z_HuffmanCode *dist) {
+	for (size_t j = 0; j < n; j++) {
+		if (symbols[j].distance) {
+			uint8_t lc = lengthCode(symbols[j].length);
+			uint8_t dc = distCode(symbols[j].distance);
+			z_putSymbol(w, lit, 257 + lc);
+			if (z_lengthExtra[lc]) z_putBits(w, symbols[j].length - z_lengthBase[lc], z_lengthExtra[lc]);
+			z_putSymbol(w, dist, dc);
+			if (z_distExtra[dc]) z_putBits(w, symbols[j].distance - z_distBase[dc], z_distExtra[dc]);
+		} else {
+			z_putSymbol(w, lit, symbols[j].length);
+		}
+	}
+	z_putSymbol(w, lit, 256);
+}
+
+static void writeStored(z_BitWriter *w, const uint8_t *data, size_t length, bool final) {
+	do {
+		size_t len = length > MAX_STORED ? MAX_STORED : length;
+		length -= len;
+		z_putBits(w, final && !length, 1);
+		z_putBits(w, 0, 2);
+		z_flushBits(w);
+		z_putByte(w, len & 0xFF);
+		z_putByte(w, (uint8_t)(len >> 8));
+		z_putByte(w, ~len & 0xFF);
+		z_putByte(w, (uint8_t)(~len >> 8));
+		for (size_t j = 0; j < len; j++) z_putByte(w, data[j]);
+		data += len;
+	} while (length);
+}
+
+// Writes the symbols, which encode length bytes of data, as the cheapest kind of block.
+static void writeBlock(z_BitWriter *w, const Symbol *symbols, size_t n, const uint8_t *data,
+                       size_t length, bool final) {
+	uint32_t litFreq[Z_LITLEN_CODES] = {0};
+	uint32_t distFreq[Z_DIST_CODES] = {0};
+	size_t extraBits = 0;
+	for (size_t j = 0; j < n; j++) {
+		if (symbols[j].distance) {
+			uint8_t lc = lengthCode(symbols[j].length), dc = distCode(symbols[j].distance);
+			litFreq[257 + lc]++;
+			distFreq[dc]++;
+			extraBits += z_lengthExtra[lc] + z_distExtra[dc];
+		} else {
+			litFreq[symbols[j].length]++;
+		}
+	}
+	litFreq[256] = 1;
+
+	DynamicHeader *h = malloc(sizeof(DynamicHeader));
+	size_t dynamicBits = (size_t)-1;
+	if (h) {
+		dynamicBits = buildDynamicHeader(h, litFreq, distFreq) +
+		              z_codeCost(&h->lit, litFreq, Z_LITLEN_CODES) +
+		              z_codeCost(&h->dist, distFreq, Z_DIST_CODES) + extraBits;
+	}
+	z_HuffmanCode fixedLit, fixedDist;
+	fixedCodes(&fixedLit, &fixedDist);
+	size_t fixedBits = z_codeCost(&fixedLit, litFreq, Z_LITLEN_CODES) +
+	                   z_codeCost(&fixedDist, distFreq, Z_DIST_CODES) + extraBits;
+	// Each stored block pads to a byte and has its length twice.
+	size_t storedBlocks = length ? (length + MAX_STORED - 1) / MAX_STORED : 1;
+	size_t storedBits = 8 * length + storedBlocks * (3 + 7 + 32);
+
+	if (storedBits <= fixedBits && storedBits <= dynamicBits) {
+		writeStored(w, data, length, final);
+	} else if (fixedBits <= dynamicBits) {
+		z_putBits(w, final, 1);
+		z_putBits(w, 1, 2);
+		writeSymbols(w, symbols, n, &fixedLit, &fixedDist);
+	} else {
+		z_putBits(w, final, 1);
+		z_putBits(w, 2, 2);
+		writeDynamicHeader(w, h);
+		writeSymbols(w, symbols, n, &h->lit, &h->dist);
+	}
+	free(h);
+}
+
+uLong compressBound(uLong sourceLen) {
+	return sourceLen + (sourceLen >> 12) + (sourceLen >> 14) + (sourceLen >> 25) + 13;
+}
+
+int compress2(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen, int level) {
+	if (level == Z_DEFAULT_COMPRESSION) level = 6;
+	if (level < 0 || level > 9) return Z_STREAM_ERROR;
+	z_BitWriter w = {.out = dest, .capacity = *destLen};
+	// DEFLATE with a 32K window, and the level in the check bits
+	uint8_t cmf = 0x78, flg = (uint8_t)((level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3) << 6);
+	flg += 31 - (cmf << 8 | flg) % 31;
+	z_putByte(&w, cmf);
+	z_putByte(&w, flg);
+
+	if (level == 0) {
+		writeStored(&w, source, sourceLen, true);
+	} else {
+		Matcher m;
+		bool ready = initMatcher(&m, source, sourceLen, level);
+		Symbol *symbols = malloc(sizeof(Symbol) * BLOCK_SYMBOLS);
+		if (!ready || !symbols) {
+			free(symbols);
+			free(m.head);
+			free(m.prev);
+			return Z_MEM_ERROR;
+		}
+		do {
+			size_t start = m.pos;
+			size_t n = parse(&m, symbols, BLOCK_SYMBOLS);
+			writeBlock(&w, symbols, n, source + start, m.pos - start, m.pos >= sourceLen);
+		} while (m.pos < sourceLen && !w.overflow);
+		free(symbols);
+		free(m.head);
+		free(m.prev);
+	}
+	z_flushBits(&w);
+	uLong adler = adler32(adler32(0, NULL, 0), source, sourceLen);
+	for (int8_t shift = 24; shift >= 0; shift -= 8) z_putByte(&w, (adler >> shift) & 0xFF);
+
+	if (w.overflow) return Z_BUF_ERROR;
+	*destLen = (uLongf)w.pos;
+	return Z_OK;
+}
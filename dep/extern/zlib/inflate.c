@@ -0,0 +1,145 @@
+// The DEFLATE decoder, for streams which are decoded into memory at once.
+
+#include "zutil.h"
+
+typedef struct {
+	z_BitReader in;
+	uint8_t *out;
+	size_t length;
+	size_t produced;
+	int status; // Z_DATA_ERROR, or Z_BUF_ERROR when the output is full
+} Inflater;
+
+static bool fail(Inflater *s, int status) {
+	s->status = status;
+	return false;
+}
+
+static bool storedBlock(Inflater *s) {
+	z_alignBits(&s->in);
+	uint16_t len = (uint16_t)z_getBits(&s->in, 16);
+	uint16_t nlen = (uint16_t)z_getBits(&s->in, 16);
+	if ((len ^ nlen) != 0xFFFF) return fail(s, Z_DATA_ERROR);
+	if (len > s->length - s->produced) return fail(s, Z_BUF_ERROR);
+	// What is left in the bit buffer comes first, as whole bytes after the alignment.
+	for (; len && s->in.count; len--) s->out[s->produced++] = (uint8_t)z_getBits(&s->in, 8);
+	if (len > s->in.length - (s->in.pos < s->in.length ? s->in.pos : s->in.length)) {
+		return fail(s, Z_DATA_ERROR);
+	}
+	memcpy(s->out + s->produced, s->in.data + s->in.pos, len);
+	s->in.pos += len;
+	s->produced += len;
+	return true;
+}
+
+static bool codesBlock(Inflater *s, const z_HuffmanDecoder *lencode,
+                       const z_HuffmanDecoder *distcode) {
+	while (true) {
+		int32_t symbol = z_getSymbol(&s->in, lencode);
+		if (symbol < 0 || !z_bitsValid(&s->in)) return fail(s, Z_DATA_ERROR);
+		if (symbol < 256) {
+			if (s->produced >= s->length) return fail(s, Z_BUF_ERROR);
+			s->out[s->produced++] = (uint8_t)symbol;
+		} else if (symbol == 256) {
+			return true;
+		} else {
+			symbol -= 257;
+			if (symbol >= 29) return fail(s, Z_DATA_ERROR);
+			uint32_t len = z_lengthBase[symbol] + z_getBits(&s->in, z_lengthExtra[symbol]);
+			int32_t dsym = z_getSymbol(&s->in, distcode);
+			if (dsym < 0 || dsym >= Z_DIST_CODES) return fail(s, Z_DATA_ERROR);
+			uint32_t dist = z_distBase[dsym] + z_getBits(&s->in, z_distExtra[dsym]);
+			if (dist > s->produced) return fail(s, Z_DATA_ERROR);
+			if (len > s->length - s->produced) return fail(s, Z_BUF_ERROR);
+			uint8_t *to = s->out + s->produced;
+			const uint8_t *from = to - dist;
+			for (uint32_t j = 0; j < len; j++) to[j] = from[j];
+			s->produced += len;
+		}
+	}
+}
+
+static bool fixedBlock(Inflater *s) {
+	uint8_t lengths[288 + Z_DIST_CODES];
+	uint16_t j = 0;
+	for (; j < 144; j++) lengths[j] = 8;
+	for (; j < 256; j++) lengths[j] = 9;
+	for (; j < 280; j++) lengths[j] = 7;
+	for (; j < 288; j++) lengths[j] = 8;
+	for (; j < 288 + Z_DIST_CODES; j++) lengths[j] = 5;
+	z_HuffmanDecoder lencode, distcode;
+	z_buildHuffmanDecoder(&lencode, lengths, 288);
+	z_buildHuffmanDecoder(&distcode, lengths + 288, Z_DIST_CODES);
+	return codesBlock(s, &lencode, &distcode);
+}
+
+static bool dynamicBlock(Inflater *s) {
+	uint16_t nlen = (uint16_t)z_getBits(&s->in, 5) + 257;
+	uint16_t ndist = (uint16_t)z_getBits(&s->in, 5) + 1;
+	uint16_t ncode = (uint16_t)z_getBits(&s->in, 4) + 4;
+	if (nlen > Z_LITLEN_CODES || ndist > Z_DIST_CODES) return fail(s, Z_DATA_ERROR);
+
+	uint8_t lengths[Z_LITLEN_CODES + Z_DIST_CODES] = {0};
+	for (uint16_t j = 0; j < ncode; j++) {
+		lengths[z_codeLengthOrder[j]] = (uint8_t)z_getBits(&s->in, 3);
+	}
+	z_HuffmanDecoder lencode, distcode;
+	if (z_buildHuffmanDecoder(&lencode, lengths, Z_CODELEN_CODES) != 0) {
+		return fail(s, Z_DATA_ERROR);
+	}
+
+	for (uint16_t j = 0; j < Z_CODELEN_CODES; j++) lengths[j] = 0;
+	for (uint16_t j = 0; j < nlen + ndist;) {
+		int32_t symbol = z_getSymbol(&s->in, &lencode);
+		if (symbol < 0 || !z_bitsValid(&s->in)) return fail(s, Z_DATA_ERROR);
+		if (symbol < 16) {
+			lengths[j++] = (uint8_t)symbol;
+			continue;
+		}
+		uint8_t len = 0;
+		uint32_t repeat;
+		if (symbol == 16) {
+			if (j == 0) return fail(s, Z_DATA_ERROR);
+			len = lengths[j - 1];
+			repeat = 3 + z_getBits(&s->in, 2);
+		} else if (symbol == 17) {
+			repeat = 3 + z_getBits(&s->in, 3);
+		} else {
+			repeat = 11 + z_getBits(&s->in, 7);
+		}
+		if (j + repeat > nlen + ndist) return fail(s, Z_DATA_ERROR);
+		while (repeat--) lengths[j++] = len;
+	}
+	if (!lengths[256]) return fail(s, Z_DATA_ERROR);
+	// Incomplete codes are accepted; their missing codes fail when they occur.
+	if (z_buildHuffmanDecoder(&lencode, lengths, nlen) < 0 ||
+	    z_buildHuffmanDecoder(&distcode, lengths + nlen, ndist) < 0) {
+		return fail(s, Z_DATA_ERROR);
+	}
+	return codesBlock(s, &lencode, &distcode);
+}
+
+int uncompress(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen) {
+	if (sourceLen < 6) return Z_DATA_ERROR;
+	uint8_t cmf = source[0], flg = source[1];
+	if ((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 || (flg & 0x20)) {
+		return Z_DATA_ERROR;
+	}
+	Inflater s = {.out = dest, .length = *destLen, .produced = 0, .status = Z_OK};
+	s.in = (z_BitReader){.data = source + 2, .length = sourceLen - 6};
+	bool last;
+	do {
+		last = z_getBits(&s.in, 1);
+		uint8_t type = (uint8_t)z_getBits(&s.in, 2);
+		bool ok = type == 0 ? storedBlock(&s)
+		                    : type == 1 ? fixedBlock(&s)
+		                                : type == 2 ? dynamicBlock(&s) : fail(&s, Z_DATA_ERROR);
+		if (ok && !z_bitsValid(&s.in)) ok = fail(&s, Z_DATA_ERROR);
+		if (!ok) return s.status;
+	} while (!last);
+	const uint8_t *trailer = source + sourceLen - 4;
+	uLong adler = (uLong)trailer[0] << 24 | trailer[1] << 16 | trailer[2] << 8 | trailer[3];
+	if (adler != adler32(adler32(0, NULL, 0), dest, s.produced)) return Z_DATA_ERROR;
+	*destLen = (uLongf)s.produced;
+	return Z_OK;
+}
@@ -0,0 +1,141 @@
+// Canonical Huffman codes of DEFLATE, for both directions, and the tables of the format.
+
+#include "zutil.h"
+
+const uint16_t z_lengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,  15,  17,  19,  23, 27,
+                                   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t z_lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                   2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t z_distBase[30] = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                 33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t z_distExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t z_codeLengthOrder[Z_CODELEN_CODES] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                                    11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+typedef struct {
+	uint32_t freq;
+	uint16_t symbol;
+} HuffmanLeaf;
+
+static int byFrequency(const void *a, const void *b) {
+	const HuffmanLeaf *x = a, *y = b;
+	if (x->freq != y->freq) return x->freq < y->freq ? -1 : 1;
+	return (int)x->symbol - (int)y->symbol;
+}
+
+static void buildLengths(const uint32_t *freq, uint16_t n, uint8_t maxBits, uint8_t *lengths) {
+	HuffmanLeaf leaves[Z_MAX_SYMBOLS];
+	uint16_t m = 0;
+	for (uint16_t j = 0; j < n; j++) {
+		lengths[j] = 0;
+		if (freq[j]) leaves[m].freq = freq[j], leaves[m].symbol = j, m++;
+	}
+	for (uint16_t j = 0; m < 2; j++) {
+		if (!freq[j]) leaves[m].freq = 1, leaves[m].symbol = j, m++;
+	}
+	qsort(leaves, m, sizeof(HuffmanLeaf), byFrequency);
+
+	// Merge the two lightest nodes repeatedly. Leaves are 0..m-1 and internal nodes m..2m-2,
+	// which are created in nondecreasing weight, so two queues suffice.
+	uint32_t weight[2 * Z_MAX_SYMBOLS];
+	uint16_t parent[2 * Z_MAX_SYMBOLS];
+	uint16_t depth[2 * Z_MAX_SYMBOLS];
+	for (uint16_t j = 0; j < m; j++) weight[j] = leaves[j].freq;
+	uint16_t nextLeaf = 0, nextNode = m, total = m;
+	for (uint16_t k = 0; k < m - 1; k++) {
+		uint16_t pick[2];
+		for (uint8_t t = 0; t < 2; t++) {
+			if (nextLeaf < m && (nextNode >= total || weight[nextLeaf] <= weight[nextNode])) {
+				pick[t] = nextLeaf++;
+			} else {
+				pick[t] = nextNode++;
+			}
+		}
+		weight[total] = weight[pick[0]] + weight[pick[1]];
+		parent[pick[0]] = parent[pick[1]] = total;
+		total++;
+	}
+	depth[total - 1] = 0;
+	for (uint16_t j = total - 1; j-- > 0;) depth[j] = depth[parent[j]] + 1;
+
+	// Limit the depths, then give the longest codes to the rarest symbols.
+	uint16_t count[Z_MAX_BITS + 1] = {0};
+	for (uint16_t j = 0; j < m; j++) count[depth[j] > maxBits ? maxBits : depth[j]]++;
+	uint32_t kraft = 0;
+	for (uint8_t b = 1; b <= maxBits; b++) kraft += (uint32_t)count[b] << (maxBits - b);
+	while (kraft > (1u << maxBits)) {
+		count[maxBits]--;
+		for (uint8_t b = maxBits - 1; b > 0; b--) {
+			if (count[b]) {
+				count[b]--;
+				count[b + 1] += 2;
+				break;
+			}
+		}
+		kraft--;
+	}
+	uint16_t j = 0;
+	for (uint8_t b = maxBits; b > 0; b--) {
+		for (uint16_t k = 0; k < count[b]; k++) lengths[leaves[j++].symbol] = b;
+	}
+}
+
+void z_assignCodes(z_HuffmanCode *code, uint16_t n) {
+	uint16_t count[Z_MAX_BITS + 1] = {0};
+	uint16_t next[Z_MAX_BITS + 1];
+	for (uint16_t j = 0; j < n; j++) count[code->lengths[j]]++;
+	count[0] = 0;
+	uint16_t c = 0;
+	for (uint8_t b = 1; b <= Z_MAX_BITS; b++) {
+		c = (c + count[b - 1]) << 1;
+		next[b] = c;
+	}
+	for (uint16_t j = 0; j < n; j++) {
+		uint8_t len = code->lengths[j];
+		if (!len) continue;
+		uint16_t v = next[len]++, r = 0;
+		for (uint8_t b = 0; b < len; b++) r |= ((v >> b) & 1) << (len - 1 - b);
+		code->codes[j] = r;
+	}
+}
+
+void z_buildHuffmanCode(z_HuffmanCode *code, const uint32_t *freq, uint16_t n, uint8_t maxBits) {
+	buildLengths(freq, n, maxBits, code->lengths);
+	z_assignCodes(code, n);
+}
+
+int32_t z_buildHuffmanDecoder(z_HuffmanDecoder *d, const uint8_t *lengths, uint16_t n) {
+	uint16_t offset[Z_MAX_BITS + 2];
+	memset(d->count, 0, sizeof(d->count));
+	memset(d->root, 0, sizeof(d->root));
+	for (uint16_t j = 0; j < n; j++) d->count[lengths[j]]++;
+	int32_t left = 1;
+	for (uint8_t len = 1; len <= Z_MAX_BITS; len++) {
+		left = (left << 1) - d->count[len];
+		if (left < 0) return -1;
+	}
+	offset[1] = 0;
+	for (uint8_t len = 1; len <= Z_MAX_BITS; len++) {
+		offset[len + 1] = offset[len] + d->count[len];
+	}
+	for (uint16_t j = 0; j < n; j++) {
+		if (lengths[j]) d->symbol[offset[lengths[j]]++] = j;
+	}
+	// Fill the root table with the short codes, bit-reversed as they come from the stream
+	uint32_t code = 0;
+	uint16_t index = 0;
+	for (uint8_t len = 1; len <= Z_ROOT_BITS; len++) {
+		for (uint16_t k = 0; k < d->count[len]; k++, code++) {
+			uint32_t reversed = 0;
+			for (uint8_t b = 0; b < len; b++) reversed |= ((code >> b) & 1) << (len - 1 - b);
+			uint16_t entry = (uint16_t)(d->symbol[index++] << 4 | len);
+			for (uint32_t fill = reversed; fill < (1 << Z_ROOT_BITS); fill += 1 << len) {
+				d->root[fill] = entry;
+			}
+		}
+		code <<= 1;
+	}
+	return left;
+}
@@ -0,0 +1,153 @@
+#ifndef CARYLL_DEP_ZLIB_ZUTIL_H
+#define CARYLL_DEP_ZLIB_ZUTIL_H
+
+// Internals shared by the DEFLATE encoder and decoder.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "zlib.h"
+
+#define Z_MAX_SYMBOLS 288
+#define Z_MAX_BITS 15
+
+#define Z_LITLEN_CODES 286
+#define Z_DIST_CODES 30
+#define Z_CODELEN_CODES 19
+
+extern const uint16_t z_lengthBase[29];
+extern const uint8_t z_lengthExtra[29];
+extern const uint16_t z_distBase[30];
+extern const uint8_t z_distExtra[30];
+extern const uint8_t z_codeLengthOrder[Z_CODELEN_CODES];
+
+// Bits are packed starting from the least significant one. Writing past the end of the output
+// sets overflow and drops the bytes.
+typedef struct {
+	uint8_t *out;
+	size_t capacity;
+	size_t pos;
+	uint32_t bits;
+	uint8_t count;
+	bool overflow;
+} z_BitWriter;
+
+static inline void z_putByte(z_BitWriter *w, uint8_t byte) {
+	if (w->pos < w->capacity) {
+		w->out[w->pos] = byte;
+	} else {
+		w->overflow = true;
+	}
+	w->pos++;
+}
+// Writes the n lowest bits of value; n + 7 must not exceed 32.
+static inline void z_putBits(z_BitWriter *w, uint32_t value, uint8_t n) {
+	w->bits |= value << w->count;
+	w->count += n;
+	while (w->count >= 8) {
+		z_putByte(w, w->bits & 0xFF);
+		w->bits >>= 8;
+		w->count -= 8;
+	}
+}
+// Pads the last byte with zero bits.
+static inline void z_flushBits(z_BitWriter *w) {
+	if (w->count) z_putByte(w, w->bits & 0xFF);
+	w->bits = 0;
+	w->count = 0;
+}
+
+// A canonical prefix code
+typedef struct {
+	uint8_t lengths[Z_MAX_SYMBOLS];
+	uint16_t codes[Z_MAX_SYMBOLS]; // bit-reversed, ready for z_putBits
+} z_HuffmanCode;
+
+// Builds a Huffman code for the frequencies of n symbols, with code lengths limited to maxBits.
+// There are always two symbols with codes at least, so the code is complete.
+void z_buildHuffmanCode(z_HuffmanCode *code, const uint32_t *freq, uint16_t n, uint8_t maxBits);
+// Assigns the canonical codes of the lengths already in code.
+void z_assignCodes(z_HuffmanCode *code, uint16_t n);
+
+static inline void z_putSymbol(z_BitWriter *w, const z_HuffmanCode *code, uint16_t symbol) {
+	z_putBits(w, code->codes[symbol], code->lengths[symbol]);
+}
+// The number of bits the symbols of freq take under code.
+static inline size_t z_codeCost(const z_HuffmanCode *code, const uint32_t *freq, uint16_t n) {
+	size_t bits = 0;
+	for (uint16_t j = 0; j < n; j++) bits += (size_t)freq[j] * code->lengths[j];
+	return bits;
+}
+
+// Reads bits starting from the least significant one of each byte. Past the end of the data it
+// reads zero bits, which z_bitsValid tells apart.
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+	size_t pos;
+	uint64_t bits;
+	uint8_t count;
+} z_BitReader;
+
+static inline void z_fillBits(z_BitReader *r, uint8_t n) {
+	while (r->count < n) {
+		if (r->pos < r->length) r->bits |= (uint64_t)r->data[r->pos] << r->count;
+		r->pos++;
+		r->count += 8;
+	}
+}
+static inline void z_dropBits(z_BitReader *r, uint8_t n) {
+	r->bits >>= n;
+	r->count -= n;
+}
+static inline uint32_t z_getBits(z_BitReader *r, uint8_t n) {
+	z_fillBits(r, n);
+	uint32_t value = (uint32_t)(r->bits & ((UINT64_C(1) << n) - 1));
+	z_dropBits(r, n);
+	return value;
+}
+// Skips to the next byte boundary.
+static inline void z_alignBits(z_BitReader *r) {
+	z_dropBits(r, r->count & 7);
+}
+// Whether the bits read so far lie within the data.
+static inline bool z_bitsValid(const z_BitReader *r) {
+	return r->pos * 8 - r->count <= r->length * 8;
+}
+
+#define Z_ROOT_BITS 9
+// Decoding side of a canonical prefix code. Codes up to Z_ROOT_BITS long are looked up in a
+// table; longer ones are decoded bit by bit from the counts of each length.
+typedef struct {
+	uint16_t count[Z_MAX_BITS + 1];
+	uint16_t symbol[Z_MAX_SYMBOLS];
+	uint16_t root[1 << Z_ROOT_BITS]; // symbol << 4 | length, or 0 when longer
+} z_HuffmanDecoder;
+
+// Builds a decoder from the code lengths of n symbols. Returns the number of missing codes in
+// units of the longest length, 0 when the code is complete, or -1 when it is oversubscribed.
+int32_t z_buildHuffmanDecoder(z_HuffmanDecoder *d, const uint8_t *lengths, uint16_t n);
+// Decodes a symbol; returns -1 for a code which is not assigned.
+static inline int32_t z_getSymbol(z_BitReader *r, const z_HuffmanDecoder *d) {
+	z_fillBits(r, Z_MAX_BITS);
+	uint16_t entry = d->root[r->bits & ((1 << Z_ROOT_BITS) - 1)];
+	if (entry) {
+		z_dropBits(r, entry & 15);
+		return entry >> 4;
+	}
+	int32_t code = 0, first = 0, index = 0;
+	for (uint8_t len = 1; len <= Z_MAX_BITS; len++) {
+		code |= (int32_t)(r->bits >> (len - 1)) & 1;
+		int32_t count = d->count[len];
+		if (code - first < count) {
+			z_dropBits(r, len);
+			return d->symbol[index + code - first];
+		}
+		index += count, first += count;
+		first <<= 1, code <<= 1;
+	}
+	return -1;
+}
+
+#endif
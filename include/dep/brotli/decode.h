@@ -0,0 +1,24 @@
+#ifndef CARYLL_DEP_BROTLI_DECODE_H
+#define CARYLL_DEP_BROTLI_DECODE_H
+
+// The one-shot decoder of the Brotli interface (RFC 7932), which is all WOFF2 needs. It is
+// implemented by the sources in dep/extern/brotli, which build with the rest of the
+// dependencies on every platform.
+
+#include "types.h"
+
+typedef enum {
+	BROTLI_DECODER_RESULT_ERROR = 0,
+	BROTLI_DECODER_RESULT_SUCCESS = 1,
+	BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT = 2,
+	BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT = 3
+} BrotliDecoderResult;
+
+// Decompresses the stream in encoded_buffer into decoded_buffer, whose size *decoded_size is
+// set to the length of the data. Returns BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT when
+// decoded_buffer is too small, BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT when the stream is cut
+// short, and BROTLI_DECODER_RESULT_ERROR when it is malformed or memory runs out.
+BrotliDecoderResult BrotliDecoderDecompress(size_t encoded_size, const uint8_t *encoded_buffer,
+                                            size_t *decoded_size, uint8_t *decoded_buffer);
+
+#endif
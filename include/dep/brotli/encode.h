@@ -0,0 +1,35 @@
+#ifndef CARYLL_DEP_BROTLI_ENCODE_H
+#define CARYLL_DEP_BROTLI_ENCODE_H
+
+// The one-shot encoder of the Brotli interface (RFC 7932), which is all WOFF2 needs. It is
+// implemented by the sources in dep/extern/brotli, which build with the rest of the
+// dependencies on every platform.
+
+#include "types.h"
+
+#define BROTLI_MIN_WINDOW_BITS 10
+#define BROTLI_MAX_WINDOW_BITS 24
+#define BROTLI_MIN_QUALITY 0
+#define BROTLI_MAX_QUALITY 11
+#define BROTLI_DEFAULT_QUALITY 11
+#define BROTLI_DEFAULT_WINDOW 22
+
+typedef enum {
+	BROTLI_MODE_GENERIC = 0,
+	BROTLI_MODE_TEXT = 1,
+	BROTLI_MODE_FONT = 2
+} BrotliEncoderMode;
+
+// The longest stream BrotliEncoderCompress may produce for input_size bytes, or 0 when it does
+// not fit in a size_t.
+size_t BrotliEncoderMaxCompressedSize(size_t input_size);
+
+// Compresses input into encoded_buffer, whose size *encoded_size is set to the length of the
+// stream. Higher qualities search longer for matches; the mode is a hint about the data.
+// Returns BROTLI_FALSE when the parameters are out of range, memory runs out or the stream does
+// not fit in encoded_buffer.
+BROTLI_BOOL BrotliEncoderCompress(int quality, int lgwin, BrotliEncoderMode mode,
+                                  size_t input_size, const uint8_t *input_buffer,
+                                  size_t *encoded_size, uint8_t *encoded_buffer);
+
+#endif
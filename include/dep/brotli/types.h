@@ -0,0 +1,11 @@
+#ifndef CARYLL_DEP_BROTLI_TYPES_H
+#define CARYLL_DEP_BROTLI_TYPES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BROTLI_BOOL int
+#define BROTLI_TRUE 1
+#define BROTLI_FALSE 0
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef CARYLL_DEP_ZLIB_H
+#define CARYLL_DEP_ZLIB_H
+
+// The one-shot utility functions of the zlib interface (RFC 1950 streams of RFC 1951 DEFLATE
+// blocks), which are all WOFF needs. They are implemented by the sources in dep/extern/zlib,
+// which build with the rest of the dependencies on every platform.
+
+#include <stddef.h>
+
+typedef unsigned char Byte;
+typedef Byte Bytef;
+typedef unsigned long uLong;
+typedef uLong uLongf;
+
+#define Z_OK 0
+#define Z_STREAM_ERROR (-2)
+#define Z_DATA_ERROR (-3)
+#define Z_MEM_ERROR (-4)
+#define Z_BUF_ERROR (-5)
+
+#define Z_NO_COMPRESSION 0
+#define Z_BEST_SPEED 1
+#define Z_BEST_COMPRESSION 9
+#define Z_DEFAULT_COMPRESSION (-1)
+
+// Adler-32 checksum of buf, continuing from adler; adler32(1, NULL, 0) is its initial value.
+uLong adler32(uLong adler, const Bytef *buf, size_t len);
+
+// The longest stream compress2 may produce for sourceLen bytes.
+uLong compressBound(uLong sourceLen);
+
+// Compresses source into dest, whose size *destLen is set to the length of the stream. Returns
+// Z_BUF_ERROR when dest is too small, Z_MEM_ERROR when memory runs out, and Z_STREAM_ERROR
+// for a level outside of 0 to 9 and Z_DEFAULT_COMPRESSION.
+int compress2(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen, int level);
+
+// Decompresses the stream in source into dest, whose size *destLen is set to the length of the
+// data. Returns Z_BUF_ERROR when dest is too small, and Z_DATA_ERROR when the stream is
+// malformed, cut short or fails its checksum.
+int uncompress(Bytef *dest, uLongf *destLen, const Bytef *source, uLong sourceLen);
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef CARYLL_INCLUDE_ALLOCATOR_H
+#define CARYLL_INCLUDE_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// A pluggable allocator. Every block the library allocates is taken from the allocator which
+// is current on the allocating thread, and must be returned to the same allocator.
+// allocate, reallocate and deallocate are given together; when all three are NULL the C
+// library is used, which is useful to install a failure callback alone.
+typedef struct otfcc_IAllocator {
+	void *context;
+	void *(*allocate)(void *context, size_t n);
+	void *(*reallocate)(void *context, void *ptr, size_t n);
+	void (*deallocate)(void *context, void *ptr);
+	// Called when an allocation of n bytes fails. Return true to retry it, after making room;
+	// when it returns false the process exits. It may run on any worker thread, and with
+	// library locks held, so it must return: leaving the library with longjmp is not supported.
+	bool (*onFailure)(void *context, size_t n);
+} otfcc_IAllocator;
+
+// Makes allocator current on the calling thread and returns the previous one. NULL stands
+// for the C library. Font readers install options->allocator by themselves, and the font
+// keeps it: consolidating, serializing and freeing the font use it again. Parallel loops are
+// given the allocator of their workers. Binary output and JSON DOMs are returned in the
+// allocator of the caller. Anything else, like SFNT containers, is freed with the current
+// allocator, so install the right one around those calls.
+const otfcc_IAllocator *otfcc_useAllocator(const otfcc_IAllocator *allocator);
+const otfcc_IAllocator *otfcc_currentAllocator();
+
+// JSON DOMs belong to the caller rather than to a font. json-builder values, including the
+// ones the JSON reader puts into its input, come from the JSON allocator of the thread; the
+// JSON reader and writer set it to the allocator of their options, or to the current one when
+// that is NULL. Input DOMs are expected in the same allocator: parse them with the
+// otfcc_allocateJson family when installing an allocator.
+const otfcc_IAllocator *otfcc_useJsonAllocator(const otfcc_IAllocator *allocator);
+void *otfcc_allocateJson(size_t n, bool clean);
+void *otfcc_reallocateJson(void *ptr, size_t n);
+void otfcc_deallocateJson(void *ptr);
+
+// Allocation through the current allocator, including the failure handling. The allocation
+// macros of the library call these when an allocator is installed.
+void *otfcc_allocate(size_t n, bool clean, unsigned long line);
+void *otfcc_reallocate(void *ptr, size_t n, unsigned long line);
+void otfcc_deallocate(void *ptr);
+
+#endif
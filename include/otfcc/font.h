@@ -7,6 +7,9 @@ struct _caryll_font;
 typedef struct _caryll_font otfcc_Font;
 
 #include "otfcc/glyph-order.h"
+#include "otfcc/region.h"
+#include "otfcc/subset.h"
+#include "otfcc/instance.h"
 
 #include "otfcc/table/fvar.h"
 
@@ -91,11 +94,23 @@ struct _caryll_font {
 	table_TSI5 *TSI5;
 
 	otfcc_GlyphOrder *glyph_order;
+
+	// The allocator current when the font was created; see otfcc/allocator.h.
+	const otfcc_IAllocator *allocator;
+	// When read with options->font_region, the region which holds the whole font.
+	otfcc_Region *region;
 };
 
 extern caryll_ElementInterfaceOf(otfcc_Font) {
 	caryll_RT(otfcc_Font);
 	void (*consolidate)(otfcc_Font * font, const otfcc_Options *options);
+	// Drops the glyphs a consolidated font does not need for the retain set; see otfcc/subset.h.
+	void (*subset)(otfcc_Font * font, const otfcc_RetainSet *retain,
+	               const otfcc_Options *options);
+	// Fixes a variable font at a location of its design space and drops fvar; see
+	// otfcc/instance.h.
+	void (*instantiate)(otfcc_Font * font, const otfcc_Location *location,
+	                    const otfcc_Options *options);
 	void *(*createTable)(otfcc_Font * font, const uint32_t tag);
 	void (*deleteTable)(otfcc_Font * font, const uint32_t tag);
 }
@@ -116,5 +131,7 @@ typedef struct otfcc_IFontSerializer {
 } otfcc_IFontSerializer;
 otfcc_IFontSerializer *otfcc_newJsonWriter();
 otfcc_IFontSerializer *otfcc_newOTFWriter();
+otfcc_IFontSerializer *otfcc_newWOFFWriter();
+otfcc_IFontSerializer *otfcc_newWOFF2Writer();
 
 #endif
@@ -14,22 +14,45 @@ typedef struct {
 	sds name;
 	uint8_t orderType;
 	uint32_t orderEntry;
-	UT_hash_handle hhID;
-	UT_hash_handle hhName;
+	uint32_t hash; // cached hash of the name
 } otfcc_GlyphOrderEntry;
 
+// The glyph order keeps each entry once, reachable from three places:
+//  - entries: every entry, in insertion order (or in the order set by orderBy);
+//  - byGID: a dense array indexed by GID, NULL for unnamed GIDs;
+//  - byName: an open-addressed table of names with linear probing. Its size is a power of
+//    two and it is kept at most half full.
 typedef struct {
-	otfcc_GlyphOrderEntry *byGID;
-	otfcc_GlyphOrderEntry *byName;
+	uint32_t length;
+	uint32_t capacity;
+	otfcc_GlyphOrderEntry **entries;
+	uint32_t gidCapacity;
+	otfcc_GlyphOrderEntry **byGID;
+	uint32_t nameSlots;
+	otfcc_GlyphOrderEntry **byName;
 } otfcc_GlyphOrder;
 
+typedef int (*otfcc_GlyphOrderComparator)(const otfcc_GlyphOrderEntry *a,
+                                           const otfcc_GlyphOrderEntry *b);
+
 struct otfcc_GlyphOrderPackage {
 	caryll_RT(otfcc_GlyphOrder);
 	sds (*setByGID)(otfcc_GlyphOrder *go, glyphid_t gid, sds name);
 	bool (*setByName)(otfcc_GlyphOrder *go, sds name, glyphid_t gid);
 	bool (*nameAField_Shared)(otfcc_GlyphOrder *go, glyphid_t gid, sds *field); // return a shared name pointer
 	bool (*consolidateHandle)(otfcc_GlyphOrder *go, otfcc_GlyphHandle *h);
+	// Consolidates n handles at once. Indices of the handles which cannot be resolved are
+	// written into `missing` (room for n items, may be NULL); returns how many there are.
+	uint32_t (*consolidateHandles)(otfcc_GlyphOrder *go, otfcc_GlyphHandle *handles, uint32_t n,
+	                               OUT uint32_t *missing);
 	bool (*lookupName)(otfcc_GlyphOrder *go, sds name);
+	otfcc_GlyphOrderEntry *(*findByName)(const otfcc_GlyphOrder *go, const char *name, size_t len);
+	otfcc_GlyphOrderEntry *(*findByGID)(const otfcc_GlyphOrder *go, glyphid_t gid);
+	// Registers a name which has no GID yet and returns its entry; if the name is present
+	// already, its entry is returned and `name` is freed.
+	otfcc_GlyphOrderEntry *(*placeByName)(otfcc_GlyphOrder *go, MOVE sds name);
+	// Sorts all entries with a stable sort and numbers them 0, 1, 2, ... in that order.
+	void (*orderBy)(otfcc_GlyphOrder *go, otfcc_GlyphOrderComparator compare);
 };
 
 extern const struct otfcc_GlyphOrderPackage otfcc_pkgGlyphOrder;
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include "dep/sds.h"
 #include "caryll/ownership.h"
 #include "caryll/element.h"
@@ -15,9 +16,14 @@ typedef enum {
 	HANDLE_STATE_NAME = 2,
 	HANDLE_STATE_CONSOLIDATED = 3
 } handle_state;
+// A handle owns its name, unless it is interned: an interned name is borrowed from the
+// font's glyph order, which keeps one string per glyph and frees them all at once with the
+// font. Two interned glyph handles of a font name the same glyph iff their name pointers
+// are equal.
 struct otfcc_Handle {
 	handle_state state;
 	glyphid_t index;
+	bool interned;
 	OWNING sds name;
 };
 
@@ -33,6 +39,9 @@ struct otfcc_HandlePackage {
 	struct otfcc_Handle (*fromName)(MOVE sds s);
 	struct otfcc_Handle (*fromConsolidated)(glyphid_t id, COPY sds s);
 	void (*consolidateTo)(struct otfcc_Handle *h, glyphid_t id, sds name);
+	// Interned variants: the handle borrows `name`, which must outlive it.
+	struct otfcc_Handle (*fromInterned)(glyphid_t id, sds name);
+	void (*consolidateToInterned)(struct otfcc_Handle *h, glyphid_t id, sds name);
 };
 
 extern const struct otfcc_HandlePackage otfcc_iHandle;
@@ -0,0 +1,32 @@
+#ifndef CARYLL_INCLUDE_INSTANCE_H
+#define CARYLL_INCLUDE_INSTANCE_H
+
+#include "caryll/element.h"
+#include "caryll/vector.h"
+#include "primitives.h"
+
+// The user coordinate of one axis, named by its tag.
+typedef struct {
+	uint32_t tag;
+	pos_t value;
+} otfcc_AxisValue;
+extern caryll_ValElementInterface(otfcc_AxisValue) otfcc_iAxisValue;
+typedef caryll_Vector(otfcc_AxisValue) otfcc_AxisValueList;
+extern caryll_VectorInterface(otfcc_AxisValueList, otfcc_AxisValue) otfcc_iAxisValueList;
+
+// A location in the design space of a variable font, in the user coordinates of fvar. Axes it
+// leaves out stay at their default, and values out of an axis' range are clamped to it.
+typedef struct {
+	otfcc_AxisValueList values;
+} otfcc_Location;
+
+extern caryll_ElementInterfaceOf(otfcc_Location) {
+	caryll_RT(otfcc_Location);
+	// Adds the items of a list like "wght=700,wdth=87.5": axis tags of up to four characters,
+	// padded with spaces, each with a number, separated by commas or white space. Returns false
+	// at the first malformed item.
+	bool (*parse)(otfcc_Location * location, const char *list);
+}
+otfcc_iLocation;
+
+#endif
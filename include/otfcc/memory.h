@@ -0,0 +1,45 @@
+#ifndef CARYLL_INCLUDE_MEMORY_H
+#define CARYLL_INCLUDE_MEMORY_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Memory accounting. When it is on, every allocation made through the library's allocation
+// macros is charged to the subsystem which is current on the allocating thread, and stays
+// charged to it until it is freed, wherever that happens.
+typedef enum {
+	OTFCC_MEM_OTHER,
+	OTFCC_MEM_GLYF,
+	OTFCC_MEM_CFF,
+	OTFCC_MEM_OTL,
+	OTFCC_MEM_BK,
+	OTFCC_MEM_JSON,
+	OTFCC_MEM_SUBR,
+	OTFCC_MEM_TAGS
+} otfcc_MemoryTag;
+
+// Read on every allocation; switch it with otfcc_startMemoryAccounting only.
+extern bool otfcc_memoryAccounting;
+
+// Starts accounting. Call it before any other thread touches the library; allocations made
+// earlier are not tracked, and freeing them later is ignored.
+void otfcc_startMemoryAccounting();
+
+// Makes tag the current subsystem of the calling thread until the matching leave call.
+void otfcc_enterMemoryTag(otfcc_MemoryTag tag);
+void otfcc_leaveMemoryTag();
+otfcc_MemoryTag otfcc_currentMemoryTag();
+
+void otfcc_accountAllocation(void *ptr, size_t n);
+// A resize is accounted in two halves around the realloc() call: the old block is released
+// first, and the new one is charged to the subsystem which made the original allocation.
+otfcc_MemoryTag otfcc_accountResizeBegin(void *ptr);
+void otfcc_accountResizeEnd(void *ptr, size_t n, otfcc_MemoryTag tag);
+void otfcc_accountFree(void *ptr);
+
+// Writes current and peak bytes and allocation counts per subsystem as a text table.
+void otfcc_writeMemoryStats(FILE *file);
+
+#endif
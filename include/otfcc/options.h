@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "logger.h"
+#include "tracer.h"
+#include "allocator.h"
 
 typedef struct {
 	bool debug_wait_on_start;
@@ -23,6 +25,7 @@ typedef struct {
 	bool cff_short_vmtx;
 	bool merge_lookups;
 	bool merge_features;
+	bool split_kerning;
 	bool force_cid;
 	bool cff_rollCharString;
 	bool cff_doSubroutinize;
@@ -31,11 +34,27 @@ typedef struct {
 	bool name_glyphs_by_hash;
 	bool name_glyphs_by_gid;
 	char *glyph_name_prefix;
+	bool font_region;
+	char **include_tables; // NULL-terminated; NULL to read and write every table
+	char **exclude_tables; // NULL-terminated
+	uint16_t threads;
 	otfcc_ILogger *logger;
+	otfcc_Tracer *tracer;              // NULL unless tracing
+	const otfcc_IAllocator *allocator; // NULL for the current allocator of the calling thread
 } otfcc_Options;
 
 otfcc_Options *otfcc_newOptions();
 void otfcc_deleteOptions(otfcc_Options *options);
 void otfcc_Options_optimizeTo(otfcc_Options *options, uint8_t level);
 
+// Adds the tables of a list like "cmap,glyf,GSUB", named as in the JSON dump, to the included
+// or the excluded ones. Returns false at the first name otfcc does not know.
+bool otfcc_Options_filterTables(otfcc_Options *options, const char *list, bool exclude);
+// Whether a table, named as in the JSON dump, passes the include and exclude filters.
+bool otfcc_Options_wantsTable(const otfcc_Options *options, const char *name);
+
+// Steps are logged and, when tracing, recorded as trace spans.
+void otfcc_beginStep(const otfcc_Options *options, MOVE sds name);
+void otfcc_endStep(const otfcc_Options *options);
+
 #endif
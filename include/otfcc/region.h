@@ -0,0 +1,17 @@
+#ifndef CARYLL_INCLUDE_REGION_H
+#define CARYLL_INCLUDE_REGION_H
+
+#include "allocator.h"
+
+// A region is an allocator which hands out blocks from large chunks and releases all of them
+// at once. Freed blocks are recycled by size class, so a region does not grow much beyond
+// the peak of what is live in it. Its chunks come from the allocator which is current when
+// the region is created. Blocks may be allocated and freed from several threads.
+typedef struct otfcc_Region otfcc_Region;
+
+otfcc_Region *otfcc_newRegion();
+// Releases every block of the region, in time proportional to the number of chunks.
+void otfcc_deleteRegion(otfcc_Region *region);
+const otfcc_IAllocator *otfcc_regionAllocator(otfcc_Region *region);
+
+#endif
@@ -11,6 +11,7 @@ typedef struct {
 	uint32_t length;
 	uint32_t checksum;
 	caryll_Buffer *buffer;
+	caryll_Buffer *transformed; // the WOFF2 transform of the table, if it has one
 	UT_hash_handle hh;
 } otfcc_SFNTTableEntry;
 
@@ -24,7 +25,16 @@ typedef struct {
 otfcc_SFNTBuilder *otfcc_newSFNTBuilder(uint32_t header, const otfcc_Options *options);
 void otfcc_SFNTBuilder_pushTable(otfcc_SFNTBuilder *builder, uint32_t tag, caryll_Buffer *buffer);
 void otfcc_deleteSFNTBuilder(otfcc_SFNTBuilder *builder);
+// Attaches the WOFF2 transform of a table pushed before: glyf and loca, or hmtx.
+void otfcc_SFNTBuilder_pushTransform(otfcc_SFNTBuilder *builder, uint32_t tag,
+                                     caryll_Buffer *transformed);
 
 caryll_Buffer *otfcc_SFNTBuilder_serialize(otfcc_SFNTBuilder *builder);
+// Serializes into a WOFF 1.0 file. The tables are zlib-compressed in parallel, on as many
+// threads as the options of the builder ask for.
+caryll_Buffer *otfcc_SFNTBuilder_serializeWOFF(otfcc_SFNTBuilder *builder);
+// Serializes into a WOFF 2.0 file: the tables, transformed where a transform was pushed, are
+// concatenated and Brotli-compressed as one stream. Returns NULL when the compression fails.
+caryll_Buffer *otfcc_SFNTBuilder_serializeWOFF2(otfcc_SFNTBuilder *builder);
 
 #endif
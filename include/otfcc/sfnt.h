@@ -2,6 +2,7 @@
 #define CARYLL_INCLUDE_OTFCC_SFNT_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 typedef struct {
@@ -10,6 +11,7 @@ typedef struct {
 	uint32_t offset;
 	uint32_t length;
 	uint8_t *data;
+	bool transformed; // data is in the transformed format of WOFF2, for glyf, loca and hmtx
 } otfcc_PacketPiece;
 
 typedef struct {
@@ -28,7 +30,11 @@ typedef struct {
 	otfcc_Packet *packets;
 } otfcc_SplineFontContainer;
 
+// Reads an OpenType font or collection, or a WOFF or WOFF2 file, which is decompressed.
 otfcc_SplineFontContainer *otfcc_readSFNT(FILE *file);
 void otfcc_deleteSFNT(otfcc_SplineFontContainer *font);
 
+// Tags which WOFF2 table directories refer to by index
+extern const uint32_t otfcc_woff2KnownTags[63];
+
 #endif
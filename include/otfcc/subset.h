@@ -0,0 +1,34 @@
+#ifndef CARYLL_INCLUDE_SUBSET_H
+#define CARYLL_INCLUDE_SUBSET_H
+
+#include "dep/sds.h"
+#include "caryll/element.h"
+#include "caryll/vector.h"
+#include "primitives.h"
+
+extern caryll_ValElementInterface(unicode_t) otfcc_iUnicodeCodePoint;
+typedef caryll_Vector(unicode_t) otfcc_UnicodeList;
+extern caryll_VectorInterface(otfcc_UnicodeList, unicode_t) otfcc_iUnicodeList;
+extern caryll_ValElementInterface(sds) otfcc_iGlyphName;
+typedef caryll_Vector(sds) otfcc_GlyphNameList;
+extern caryll_VectorInterface(otfcc_GlyphNameList, sds) otfcc_iGlyphNameList;
+
+// The glyphs a subset asks for: code points, which are mapped through cmap, and glyph names.
+// Subsetting keeps them, .notdef, and every glyph they reach through GSUB, composite
+// references, COLR layers and SVG documents.
+typedef struct {
+	otfcc_UnicodeList unicodes;
+	otfcc_GlyphNameList glyphs;
+} otfcc_RetainSet;
+
+extern caryll_ElementInterfaceOf(otfcc_RetainSet) {
+	caryll_RT(otfcc_RetainSet);
+	// Adds the items of a list like "U+41-5A,U+E9,/ampersand": code points and ranges of them
+	// in hex, and glyph names after a slash, separated by commas or white space. A name no
+	// glyph of the font carries stands for its code point when it is in AGLFN. Returns false at
+	// the first malformed item.
+	bool (*parse)(otfcc_RetainSet * set, const char *list);
+}
+otfcc_iRetainSet;
+
+#endif
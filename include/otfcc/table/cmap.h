@@ -4,11 +4,19 @@
 #include "table-common.h"
 
 // We will support format 0, 4, 12 and 14 of CMAP only
+
+// Unicode mappings live in a sparse two-level table: the code space is cut into pages of
+// 256 code points, and a page is allocated when the first code point in it is mapped.
+// Iterating a page table visits the code points in increasing order.
+#define CMAP_PAGE_BITS 8
+#define CMAP_PAGE_SIZE (1 << CMAP_PAGE_BITS)
+#define CMAP_PAGE_COUNT (0x110000 >> CMAP_PAGE_BITS)
+
 typedef struct {
-	UT_hash_handle hh;
-	int unicode;
-	otfcc_GlyphHandle glyph;
-} cmap_Entry;
+	uint32_t count;
+	uint64_t present[CMAP_PAGE_SIZE / 64];
+	otfcc_GlyphHandle glyphs[CMAP_PAGE_SIZE];
+} cmap_Page;
 
 typedef struct {
 	uint32_t unicode;
@@ -22,7 +30,8 @@ typedef struct {
 } cmap_UVS_Entry;
 
 typedef struct {
-	OWNING cmap_Entry *unicodes;
+	uint32_t unicodesCount;
+	OWNING cmap_Page *unicodes[CMAP_PAGE_COUNT];
 	OWNING cmap_UVS_Entry *uvs;
 } table_cmap;
 
@@ -33,6 +42,9 @@ extern caryll_ElementInterfaceOf(table_cmap) {
 	bool (*encodeByName)(table_cmap * cmap, int c, MOVE sds name);
 	bool (*unmap)(table_cmap * cmap, int c);
 	otfcc_GlyphHandle *(*lookup)(const table_cmap *cmap, int c);
+	// Advances *c to the next mapped code point after it and returns its glyph, or returns
+	// NULL when there is none. Start with *c = -1.
+	otfcc_GlyphHandle *(*next)(const table_cmap *cmap, MODIFY int *c);
 	// uvs
 	bool (*encodeUVSByIndex)(table_cmap * cmap, cmap_UVS_key c, uint16_t gid);
 	bool (*encodeUVSByName)(table_cmap * cmap, cmap_UVS_key c, MOVE sds name);
@@ -16,6 +16,17 @@ extern caryll_ElementInterface(fvar_Instance) fvar_iInstance;
 typedef caryll_Vector(fvar_Instance) fvar_InstanceList;
 extern caryll_VectorInterface(fvar_InstanceList, fvar_Instance) fvar_iInstanceList;
 
+// avar maps the normalized coordinates of each axis through segments between these pairs.
+typedef struct {
+	pos_t fromCoordinate;
+	pos_t toCoordinate;
+} fvar_AxisValueMap;
+extern caryll_ValElementInterface(fvar_AxisValueMap) fvar_iAxisValueMap;
+typedef caryll_Vector(fvar_AxisValueMap) fvar_SegmentMap;
+extern caryll_VectorInterface(fvar_SegmentMap, fvar_AxisValueMap) fvar_iSegmentMap;
+typedef caryll_Vector(fvar_SegmentMap) fvar_SegmentMaps;
+extern caryll_VectorInterface(fvar_SegmentMaps, fvar_SegmentMap) fvar_iSegmentMaps;
+
 typedef struct {
 	sds name;
 	vq_Region *region;
@@ -27,7 +38,11 @@ typedef struct {
 	uint16_t minorVersion;
 	vf_Axes axes;
 	fvar_InstanceList instances;
+	// The segment maps of avar, one for each axis, or none when the font has no avar.
+	fvar_SegmentMaps avar;
 	fvar_Master *masters;
+	// The masters by the ID of their region, less one
+	fvar_Master **mastersByID;
 } table_fvar;
 
 extern caryll_ElementInterfaceOf(table_fvar) {
@@ -0,0 +1,29 @@
+#ifndef CARYLL_INCLUDE_TRACER_H
+#define CARYLL_INCLUDE_TRACER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "dep/sds.h"
+#include "caryll/ownership.h"
+
+// A tracer records nested spans of work on every thread and writes them out as Chrome
+// trace-event JSON, which chrome://tracing and Perfetto can open.
+typedef struct otfcc_Tracer otfcc_Tracer;
+
+otfcc_Tracer *otfcc_newTracer();
+void otfcc_deleteTracer(MOVE otfcc_Tracer *tracer);
+
+// Opens a span on the calling thread. Spans must be closed on the thread which opened them,
+// innermost first. Both calls do nothing when tracer is NULL.
+void otfcc_traceBegin(otfcc_Tracer *tracer, MOVE sds name);
+void otfcc_traceEnd(otfcc_Tracer *tracer);
+
+// Adds n to a counter of the innermost span open on the calling thread, if there is one.
+// The counters of a span are written as the arguments of its end event. key must outlive
+// the tracer; a string literal is the intended use.
+void otfcc_traceCount(const char *key, int64_t n);
+
+bool otfcc_writeTrace(const otfcc_Tracer *tracer, FILE *file);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CARYLL_VF_REGION_H
 #define CARYLL_VF_REGION_H
 
+#include <stddef.h>
 #include "caryll/element.h"
 #include "caryll/vector.h"
 #include "otfcc/primitives.h"
@@ -16,6 +17,9 @@ typedef struct {
 bool vq_AxisSpanIsOne(const vq_AxisSpan *a);
 
 typedef struct {
+	// Regions registered in fvar are interned there and numbered from 1, so that regions of the
+	// font compare by number; 0 while a region is not registered.
+	uint32_t id;
 	shapeid_t dimensions;
 	vq_AxisSpan spans[];
 } vq_Region;
@@ -30,5 +34,8 @@ void vq_showRegion(const vq_Region *r);
 
 // function macros
 #define VQ_REGION_SIZE(n) (sizeof(vq_Region) + sizeof(vq_AxisSpan) * (n))
+// What a region is, without its ID: the bytes from dimensions on
+#define VQ_REGION_KEY(r) ((const void *)&(r)->dimensions)
+#define VQ_REGION_KEY_SIZE(n) (VQ_REGION_SIZE(n) - offsetof(vq_Region, dimensions))
 
 #endif
@@ -9,14 +9,15 @@
 
 #include "region.h"
 
-typedef enum { VQ_STILL = 0, VQ_DELTA = 1 } VQSegType;
+// 0 is left for the empty shift of a VQ, see vq_ShiftList.
+typedef enum { VQ_STILL = 1, VQ_DELTA = 2 } VQSegType;
 typedef struct {
 	VQSegType type;
+	bool touched; // of deltas : false when IUP infers them
 	union {
 		pos_t still;
 		struct {
 			pos_t quantity;
-			bool touched;
 			const vq_Region *region; // non-owning : they are in FVAR
 		} delta;
 	} val;
@@ -34,10 +35,34 @@ typedef caryll_Vector(vq_Segment) vq_SegList;
 extern caryll_VectorInterface(vq_SegList, vq_Segment) vq_iSegList;
 
 // VQ
+// Static VQs have no segments, and those of a variable font usually a few, one for each master
+// moving them. A lone segment is kept in the VQ itself, and longer shifts go to the heap; the
+// first word tells these apart, being the type of the inline segment, or else VQ_SHIFT_EMPTY or
+// VQ_SHIFT_HEAP. This keeps a VQ in 32 bytes. Read the segments through vq_shiftLength and
+// vq_segments.
+#define VQ_SHIFT_EMPTY 0
+#define VQ_SHIFT_HEAP 3
+typedef union {
+	vq_Segment inlined;
+	struct {
+		VQSegType form;
+		uint32_t length;
+		vq_Segment *items;
+		uint32_t capacity;
+	} heap;
+} vq_ShiftList;
 typedef struct {
 	pos_t kernel;
-	vq_SegList shift;
+	vq_ShiftList shift;
 } VQ;
+static inline uint32_t vq_shiftLength(const VQ *v) {
+	if (v->shift.heap.form == VQ_SHIFT_HEAP) return v->shift.heap.length;
+	return v->shift.heap.form != VQ_SHIFT_EMPTY;
+}
+static inline const vq_Segment *vq_segments(const VQ *v) {
+	return v->shift.heap.form == VQ_SHIFT_HEAP ? v->shift.heap.items : &v->shift.inlined;
+}
+
 extern caryll_VectorInterfaceTypeName(VQ) {
 	caryll_VT(VQ);
 	caryll_Module(VQ, scale_t); // VQ forms a module (vector space)
@@ -56,6 +81,7 @@ extern caryll_VectorInterfaceTypeName(VQ) {
 	VQ (*pointLinearTfm)(const VQ ax, pos_t a, const VQ x, pos_t b, const VQ y);
 	void (*addDelta)(MODIFY VQ * v, const bool touched, const vq_Region *const r,
 	                 const pos_t quantity);
+	void (*addSegment)(MODIFY VQ * v, MOVE vq_Segment s);
 }
 iVQ;
 #endif
@@ -1,4 +1,6 @@
 #include "bkgraph.h"
+#include <string.h>
+#include "otfcc/tracer.h"
 
 static bk_GraphNode *_bkgraph_grow(bk_Graph *f) {
 	if (f->free) {
@@ -26,6 +28,7 @@ static uint32_t dfs_insert_cells(bk_Block *b, bk_Graph *f, uint32_t *order) {
 	}
 	bk_GraphNode *e = _bkgraph_grow(f);
 	e->alias = 0;
+	e->priority = 0;
 	e->block = b;
 	*order += 1;
 	e->order = *order;
@@ -164,7 +167,10 @@ void bk_minimizeGraph(bk_Graph *f) {
 			if (a->alias == j) {
 				for (uint32_t k = j + 1; k <= rear; k++) {
 					bk_GraphNode *b = &(f->entries[k]);
-					if (b->alias == k && compareEntry(a, b)) { b->alias = j; }
+					if (b->alias == k && compareEntry(a, b)) {
+						b->alias = j;
+						otfcc_traceCount("blocks merged", 1);
+					}
 				}
 			}
 		}
@@ -210,11 +216,6 @@ static uint32_t getoffset(size_t *offsets, bk_Block *ref, bk_Block *target, uint
 	*/
 	return (uint32_t)(offtgt - offref);
 }
-static int64_t getoffset_untangle(size_t *offsets, bk_Block *ref, bk_Block *target) {
-	size_t offref = offsets[ref->_index];
-	size_t offtgt = offsets[target->_index];
-	return (int64_t)(offtgt - offref);
-}
 static void escalate_sppointers(bk_Block *b, bk_Graph *f, uint32_t *order, uint32_t depth) {
 	if (!b) return;
 	for (uint32_t j = 0; j < b->length; j++) {
@@ -260,55 +261,6 @@ static void attract_bkgraph(bk_Graph *f) {
 	}
 }
 
-static bool try_untabgle_block(bk_Graph *f, bk_Block *b, size_t *offsets, uint16_t passes) {
-	bool didCopy = false;
-	for (uint32_t j = 0; j < b->length; j++) {
-		switch (b->cells[j].t) {
-			case p16:
-			case sp16:
-				if (b->cells[j].p) {
-					int64_t offset = getoffset_untangle(offsets, b, b->cells[j].p);
-					if (offset < 0 || offset > 0xFFFF) {
-						bk_GraphNode *e = _bkgraph_grow(f);
-						e->order = 0;
-						e->alias = 0;
-						e->block = bk_new_Block(bkcopy, b->cells[j].p, bkover);
-						b->cells[j].t = sp16;
-						b->cells[j].p = e->block;
-						didCopy = true;
-					}
-				}
-				break;
-			default:
-				break;
-		}
-	}
-	return didCopy;
-}
-
-static bool try_untangle(bk_Graph *f, uint16_t passes) {
-	size_t *offsets;
-	NEW(offsets, f->length + 1);
-	offsets[0] = 0;
-	for (uint32_t j = 0; j < f->length; j++) {
-		if (f->entries[j].block->_visitstate == VISIT_BLACK) {
-			offsets[j + 1] = offsets[j] + otfcc_bkblock_size(f->entries[j].block);
-		} else {
-			offsets[j + 1] = offsets[j];
-		}
-	}
-	uint32_t totalBlocks = f->length;
-	bool didUntangle = false;
-	for (uint32_t j = 0; j < totalBlocks; j++) {
-		if (f->entries[j].block->_visitstate == VISIT_BLACK) {
-			bool didCopy = try_untabgle_block(f, f->entries[j].block, offsets, passes);
-			didUntangle = didUntangle || didCopy;
-		}
-	}
-	FREE(offsets);
-	return didUntangle;
-}
-
 static void otfcc_build_bkblock(caryll_Buffer *buf, bk_Block *b, size_t *offsets) {
 	for (uint32_t j = 0; j < b->length; j++) {
 		switch (b->cells[j].t) {
@@ -382,29 +334,537 @@ size_t bk_estimateSizeOfGraph(bk_Graph *f) {
 	return estimatedSize;
 }
 
-void bk_untangleGraph(/*BORROW*/ bk_Graph *f) {
-	uint16_t passes = 0;
-	bool tangled = false;
+// Offset overflow repacking
+// The attracted layout is kept whenever all of its offsets fit. Otherwise the graph is
+// repacked: blocks are emitted in a topological order that always picks the ready block
+// closest to the root, where following an offset costs 64K plus the size of its target and
+// a 32-bit offset costs 4G. The subgraph behind each 32-bit offset (a "space") is isolated
+// first, so that it is laid out contiguously after the 16-bit space referring to it. The
+// overflows left are resolved a round at a time: a shared target is duplicated for the
+// overflowing parent, and an exclusive target has its priority raised, which lays it out
+// closer to its parents.
+
+#define BK_REPACK_MAX_ROUNDS 32
+#define BK_MAX_PRIORITY 3
+#define BK_NO_SPACE UINT64_MAX
+
+static bool bk_cellIs32(const bk_Cell *cell) {
+	return cell->t == p32 || cell->t == sp32;
+}
+
+static void pushIndex(uint32_t **list, uint32_t *length, uint32_t *capacity, uint32_t x) {
+	if (*length >= *capacity) {
+		*capacity += *capacity / 2 + 0x10;
+		RESIZE(*list, *capacity);
+	}
+	(*list)[(*length)++] = x;
+}
+
+// Priority queue of blocks, ordered by space, distance, then the previous layout
+typedef struct {
+	uint64_t space;
+	uint64_t distance;
+	uint32_t order;
+	uint32_t id;
+} bk_QueueItem;
+
+typedef struct {
+	uint32_t length;
+	uint32_t capacity;
+	bk_QueueItem *items;
+} bk_Queue;
+
+static bool queueItemBefore(const bk_QueueItem *a, const bk_QueueItem *b) {
+	if (a->space != b->space) return a->space < b->space;
+	if (a->distance != b->distance) return a->distance < b->distance;
+	return a->order < b->order;
+}
+static void queuePush(bk_Queue *q, bk_QueueItem item) {
+	if (q->length >= q->capacity) {
+		q->capacity += q->capacity / 2 + 0x10;
+		RESIZE(q->items, q->capacity);
+	}
+	uint32_t j = q->length++;
+	while (j > 0) {
+		uint32_t parent = (j - 1) / 2;
+		if (!queueItemBefore(&item, &q->items[parent])) break;
+		q->items[j] = q->items[parent];
+		j = parent;
+	}
+	q->items[j] = item;
+}
+static bk_QueueItem queuePop(bk_Queue *q) {
+	bk_QueueItem top = q->items[0];
+	bk_QueueItem last = q->items[--q->length];
+	uint32_t j = 0;
+	while (2 * j + 1 < q->length) {
+		uint32_t child = 2 * j + 1;
+		if (child + 1 < q->length && queueItemBefore(&q->items[child + 1], &q->items[child])) {
+			child++;
+		}
+		if (!queueItemBefore(&q->items[child], &last)) break;
+		q->items[j] = q->items[child];
+		j = child;
+	}
+	if (q->length) q->items[j] = last;
+	return top;
+}
+
+static void dfs_mark_reachable(bk_Block *b) {
+	if (!b || b->_visitstate != VISIT_WHITE) return;
+	b->_visitstate = VISIT_BLACK;
+	for (uint32_t j = 0; j < b->length; j++) {
+		bk_Cell *cell = &(b->cells[j]);
+		if (bk_cellIsPointer(cell) && cell->p) dfs_mark_reachable(cell->p);
+	}
+}
+// Index the entries and mark the blocks reachable from the root, which is entry 0.
+static void prepare_bkgraph(bk_Graph *f) {
+	for (uint32_t j = 0; j < f->length; j++) {
+		f->entries[j].block->_index = j;
+		f->entries[j].block->_visitstate = VISIT_WHITE;
+	}
+	dfs_mark_reachable(f->entries[0].block);
+}
+
+static uint32_t *countIncoming(bk_Graph *f, uint32_t capacity) {
+	uint32_t *incoming;
+	NEW(incoming, capacity);
+	for (uint32_t j = 0; j < f->length; j++) {
+		bk_Block *b = f->entries[j].block;
+		if (b->_visitstate != VISIT_BLACK) continue;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (bk_cellIsPointer(&b->cells[k]) && b->cells[k].p) {
+				incoming[b->cells[k].p->_index] += 1;
+			}
+		}
+	}
+	return incoming;
+}
+
+// Append a shallow copy of a block, sharing its targets, to the graph.
+static uint32_t cloneBlock(bk_Graph *f, uint32_t index) {
+	bk_Block *original = f->entries[index].block;
+	bk_GraphNode *e = _bkgraph_grow(f);
+	e->alias = f->length - 1;
+	e->order = 0;
+	e->height = 0;
+	e->hash = 0;
+	e->priority = 0;
+	e->block = bk_new_Block(bkcopy, original, bkover);
+	e->block->_index = f->length - 1;
+	e->block->_visitstate = VISIT_BLACK;
+	return f->length - 1;
+}
+
+typedef struct {
+	uint32_t capacity;
+	uint32_t *incoming;
+	uint32_t *inner;      // 16-bit offsets from the current space into each block
+	uint32_t *spaceMark;  // generation in which each block joined the current space
+	uint32_t *sharedMark; // generation in which each block was found shared
+	uint32_t *cloneOf;
+} bk_SpaceState;
+
+static void growIndexArray(uint32_t **a, uint32_t from, uint32_t to) {
+	RESIZE(*a, to);
+	memset(*a + from, 0, (to - from) * sizeof(uint32_t));
+}
+static void growSpaceState(bk_SpaceState *s, uint32_t n) {
+	if (n <= s->capacity) return;
+	uint32_t capacity = n + n / 2;
+	growIndexArray(&s->incoming, s->capacity, capacity);
+	growIndexArray(&s->inner, s->capacity, capacity);
+	growIndexArray(&s->spaceMark, s->capacity, capacity);
+	growIndexArray(&s->sharedMark, s->capacity, capacity);
+	growIndexArray(&s->cloneOf, s->capacity, capacity);
+	s->capacity = capacity;
+}
+
+// Give each 32-bit space its own copy of the blocks it shares with the rest of the graph,
+// so that every space can be laid out contiguously.
+static void isolate_bkspaces(bk_Graph *f) {
+	prepare_bkgraph(f);
+	const uint32_t n = f->length;
+	bool *isRoot;
+	NEW(isRoot, n);
+	bool hasSpaces = false;
+	for (uint32_t j = 0; j < n; j++) {
+		bk_Block *b = f->entries[j].block;
+		if (b->_visitstate != VISIT_BLACK) continue;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (bk_cellIs32(&b->cells[k]) && b->cells[k].p) {
+				isRoot[b->cells[k].p->_index] = true;
+				hasSpaces = true;
+			}
+		}
+	}
+	if (!hasSpaces) {
+		FREE(isRoot);
+		return;
+	}
+
+	bk_SpaceState s = {0, NULL, NULL, NULL, NULL, NULL};
+	growSpaceState(&s, n);
+	uint32_t *incoming = countIncoming(f, n);
+	memcpy(s.incoming, incoming, n * sizeof(uint32_t));
+	FREE(incoming);
+	uint32_t *members = NULL, membersLength = 0, membersCap = 0;
+	uint32_t *shared = NULL, sharedLength = 0, sharedCap = 0;
+
+	uint32_t generation = 0;
+	for (uint32_t r = 1; r < n; r++) {
+		if (!isRoot[r]) continue;
+		generation += 1;
+		// The space of r: blocks reachable from it through 16-bit offsets
+		membersLength = 0;
+		s.spaceMark[r] = generation;
+		s.inner[r] = 0;
+		pushIndex(&members, &membersLength, &membersCap, r);
+		for (uint32_t j = 0; j < membersLength; j++) {
+			bk_Block *b = f->entries[members[j]].block;
+			for (uint32_t k = 0; k < b->length; k++) {
+				if (!bk_cellIsPointer(&b->cells[k]) || bk_cellIs32(&b->cells[k])) continue;
+				if (!b->cells[k].p) continue;
+				uint32_t c = b->cells[k].p->_index;
+				if (s.spaceMark[c] == generation) {
+					s.inner[c] += 1;
+					continue;
+				}
+				s.spaceMark[c] = generation;
+				s.inner[c] = 1;
+				pushIndex(&members, &membersLength, &membersCap, c);
+			}
+		}
+		if (membersLength < 2) continue;
+
+		// Blocks referred from outside the space, and everything below them, are shared
+		sharedLength = 0;
+		for (uint32_t j = 1; j < membersLength; j++) {
+			uint32_t v = members[j];
+			if (s.incoming[v] > s.inner[v]) {
+				s.sharedMark[v] = generation;
+				pushIndex(&shared, &sharedLength, &sharedCap, v);
+			}
+		}
+		for (uint32_t j = 0; j < sharedLength; j++) {
+			bk_Block *b = f->entries[shared[j]].block;
+			for (uint32_t k = 0; k < b->length; k++) {
+				if (!bk_cellIsPointer(&b->cells[k]) || bk_cellIs32(&b->cells[k])) continue;
+				if (!b->cells[k].p) continue;
+				uint32_t c = b->cells[k].p->_index;
+				if (c == r || s.sharedMark[c] == generation) continue;
+				s.sharedMark[c] = generation;
+				pushIndex(&shared, &sharedLength, &sharedCap, c);
+			}
+		}
+		if (!sharedLength) continue;
+
+		growSpaceState(&s, f->length + sharedLength);
+		for (uint32_t j = 0; j < sharedLength; j++) {
+			uint32_t copy = cloneBlock(f, shared[j]);
+			s.cloneOf[shared[j]] = copy;
+			bk_Block *b = f->entries[copy].block;
+			for (uint32_t k = 0; k < b->length; k++) {
+				if (bk_cellIsPointer(&b->cells[k]) && b->cells[k].p) {
+					s.incoming[b->cells[k].p->_index] += 1;
+				}
+			}
+			pushIndex(&members, &membersLength, &membersCap, copy);
+		}
+		// Redirect the space, including the copies, to the copies
+		for (uint32_t j = 0; j < membersLength; j++) {
+			uint32_t u = members[j];
+			if (s.sharedMark[u] == generation) continue;
+			bk_Block *b = f->entries[u].block;
+			for (uint32_t k = 0; k < b->length; k++) {
+				if (!bk_cellIsPointer(&b->cells[k]) || bk_cellIs32(&b->cells[k])) continue;
+				if (!b->cells[k].p) continue;
+				uint32_t c = b->cells[k].p->_index;
+				if (s.sharedMark[c] != generation) continue;
+				s.incoming[c] -= 1;
+				s.incoming[s.cloneOf[c]] += 1;
+				b->cells[k].p = f->entries[s.cloneOf[c]].block;
+			}
+		}
+	}
+	FREE(members);
+	FREE(shared);
+	FREE(s.incoming);
+	FREE(s.inner);
+	FREE(s.spaceMark);
+	FREE(s.sharedMark);
+	FREE(s.cloneOf);
+	FREE(isRoot);
+}
+
+static void assignSpace(bk_Graph *f, uint32_t start, uint64_t key, uint64_t *space) {
+	if (space[start] != BK_NO_SPACE) return;
+	uint32_t *stack = NULL, stackLength = 0, stackCap = 0;
+	space[start] = key;
+	pushIndex(&stack, &stackLength, &stackCap, start);
+	while (stackLength) {
+		bk_Block *b = f->entries[stack[--stackLength]].block;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (!bk_cellIsPointer(&b->cells[k]) || bk_cellIs32(&b->cells[k])) continue;
+			if (!b->cells[k].p) continue;
+			uint32_t c = b->cells[k].p->_index;
+			if (space[c] != BK_NO_SPACE) continue;
+			space[c] = key;
+			pushIndex(&stack, &stackLength, &stackCap, c);
+		}
+	}
+	FREE(stack);
+}
+
+// The distance used for ordering. Raising the priority of a block pulls it towards its parents.
+static uint64_t modifiedDistance(const bk_GraphNode *e, uint64_t distance, uint32_t size) {
+	uint64_t pull = e->priority >= BK_MAX_PRIORITY ? distance
+	                                               : e->priority == 2 ? size
+	                                                                  : e->priority == 1 ? size / 2
+	                                                                                     : 0;
+	return pull > distance ? 0 : distance - pull;
+}
+
+// Lay out the reachable blocks in a topological order, by space and then by distance.
+static void sort_bkgraph(bk_Graph *f) {
+	prepare_bkgraph(f);
+	const uint32_t n = f->length;
+	uint32_t *size;
+	uint64_t *distance, *space;
+	bool *placed;
+	NEW(size, n);
+	NEW(distance, n);
+	NEW(space, n);
+	NEW(placed, n);
+	for (uint32_t j = 0; j < n; j++) {
+		bk_Block *b = f->entries[j].block;
+		size[j] = b->_visitstate == VISIT_BLACK ? (uint32_t)otfcc_bkblock_size(b) : 0;
+		distance[j] = UINT64_MAX;
+		space[j] = BK_NO_SPACE;
+	}
+
+	// Shortest distances from the root
+	bk_Queue q = {0, 0, NULL};
+	distance[0] = 0;
+	queuePush(&q, (bk_QueueItem){0, 0, 0, 0});
+	while (q.length) {
+		bk_QueueItem item = queuePop(&q);
+		if (item.distance > distance[item.id]) continue;
+		bk_Block *b = f->entries[item.id].block;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (!bk_cellIsPointer(&b->cells[k]) || !b->cells[k].p) continue;
+			uint32_t c = b->cells[k].p->_index;
+			uint64_t d = distance[item.id] + (bk_cellIs32(&b->cells[k]) ? 0x100000000 : 0x10000) +
+			             size[c];
+			if (d >= distance[c]) continue;
+			distance[c] = d;
+			queuePush(&q, (bk_QueueItem){0, d, c, c});
+		}
+	}
+
+	// Spaces, keyed by the distance of their roots; the root space comes first
+	assignSpace(f, 0, 0, space);
+	for (uint32_t j = 0; j < n; j++) {
+		bk_Block *b = f->entries[j].block;
+		if (b->_visitstate != VISIT_BLACK) continue;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (!bk_cellIs32(&b->cells[k]) || !b->cells[k].p) continue;
+			uint32_t c = b->cells[k].p->_index;
+			queuePush(&q, (bk_QueueItem){0, distance[c], c, c});
+		}
+	}
+	while (q.length) {
+		bk_QueueItem item = queuePop(&q);
+		assignSpace(f, item.id, item.distance, space);
+	}
+
+	// Kahn's algorithm, always emitting the closest ready block
+	uint32_t *remaining = countIncoming(f, n);
+	uint32_t *order;
+	NEW(order, n);
+	uint32_t emitted = 0;
+	queuePush(&q, (bk_QueueItem){space[0], 0, 0, 0});
+	while (q.length) {
+		uint32_t id = queuePop(&q).id;
+		order[emitted++] = id;
+		placed[id] = true;
+		bk_Block *b = f->entries[id].block;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (!bk_cellIsPointer(&b->cells[k]) || !b->cells[k].p) continue;
+			uint32_t c = b->cells[k].p->_index;
+			if (--remaining[c]) continue;
+			queuePush(&q, (bk_QueueItem){space[c],
+			                             modifiedDistance(&f->entries[c], distance[c], size[c]),
+			                             c, c});
+		}
+	}
+	FREE(q.items);
+
+	// Unplaced blocks, which are unreachable, keep their order after the reachable ones
+	bk_GraphNode *sorted;
+	NEW(sorted, f->length + f->free);
+	for (uint32_t j = 0; j < emitted; j++) {
+		sorted[j] = f->entries[order[j]];
+	}
+	for (uint32_t j = 0; j < n; j++) {
+		if (!placed[j]) sorted[emitted++] = f->entries[j];
+	}
+	FREE(f->entries);
+	f->entries = sorted;
+	for (uint32_t j = 0; j < f->length; j++) {
+		f->entries[j].block->_index = j;
+	}
+	FREE(order);
+	FREE(remaining);
+	FREE(placed);
+	FREE(space);
+	FREE(distance);
+	FREE(size);
+}
+
+typedef struct {
+	uint32_t parent;
+	uint32_t child;
+} bk_Overflow;
+
+// Find the 16-bit offsets of the current layout which do not fit. Returns the number of them;
+// fatal is set when a 32-bit offset does not fit either, which no layout can resolve.
+static uint32_t find_overflows(bk_Graph *f, bk_Overflow **overflows, bool *fatal) {
+	size_t *offsets;
+	NEW(offsets, f->length + 1);
+	offsets[0] = 0;
+	for (uint32_t j = 0; j < f->length; j++) {
+		if (f->entries[j].block->_visitstate == VISIT_BLACK) {
+			offsets[j + 1] = offsets[j] + otfcc_bkblock_size(f->entries[j].block);
+		} else {
+			offsets[j + 1] = offsets[j];
+		}
+	}
+	uint32_t n = 0, capacity = 0;
+	*fatal = false;
+	for (uint32_t j = 0; j < f->length; j++) {
+		bk_Block *b = f->entries[j].block;
+		if (b->_visitstate != VISIT_BLACK) continue;
+		for (uint32_t k = 0; k < b->length; k++) {
+			if (!bk_cellIsPointer(&b->cells[k]) || !b->cells[k].p) continue;
+			uint32_t c = b->cells[k].p->_index;
+			bool is32 = bk_cellIs32(&b->cells[k]);
+			if (offsets[c] >= offsets[j] &&
+			    offsets[c] - offsets[j] <= (is32 ? (size_t)0xFFFFFFFF : (size_t)0xFFFF)) {
+				continue;
+			}
+			if (is32) {
+				*fatal = true;
+				continue;
+			}
+			if (n >= capacity) {
+				capacity += capacity / 2 + 0x10;
+				RESIZE(*overflows, capacity);
+			}
+			(*overflows)[n].parent = j;
+			(*overflows)[n].child = c;
+			n++;
+		}
+	}
+	FREE(offsets);
+	return n;
+}
+
+// Try to resolve the overflows, at most once per parent. Returns whether anything changed.
+static bool resolve_overflows(bk_Graph *f, const bk_Overflow *overflows, uint32_t n) {
+	const uint32_t length = f->length;
+	uint32_t *incoming = countIncoming(f, length);
+	bool *resolved;
+	NEW(resolved, length);
+	bool attempted = false;
+	for (uint32_t j = 0; j < n; j++) {
+		uint32_t p = overflows[j].parent;
+		uint32_t c = overflows[j].child;
+		if (resolved[p]) continue;
+		bk_Block *parent = f->entries[p].block;
+		bk_Block *child = f->entries[c].block;
+		uint32_t links = 0;
+		for (uint32_t k = 0; k < parent->length; k++) {
+			if (bk_cellIsPointer(&parent->cells[k]) && parent->cells[k].p == child) links++;
+		}
+		if (incoming[c] > links) {
+			// The target is shared: give this parent its own copy
+			uint32_t copyIndex = cloneBlock(f, c);
+			bk_Block *copy = f->entries[copyIndex].block;
+			for (uint32_t k = 0; k < parent->length; k++) {
+				if (bk_cellIsPointer(&parent->cells[k]) && parent->cells[k].p == child) {
+					parent->cells[k].p = copy;
+				}
+			}
+			for (uint32_t k = 0; k < copy->length; k++) {
+				if (bk_cellIsPointer(&copy->cells[k]) && copy->cells[k].p) {
+					incoming[copy->cells[k].p->_index] += 1;
+				}
+			}
+			incoming[c] -= links;
+		} else if (f->entries[c].priority < BK_MAX_PRIORITY) {
+			f->entries[c].priority += 1;
+		} else {
+			continue;
+		}
+		resolved[p] = true;
+		attempted = true;
+	}
+	FREE(resolved);
+	FREE(incoming);
+	return attempted;
+}
+
+static bool repack_bkgraph(bk_Graph *f) {
+	isolate_bkspaces(f);
+	for (uint16_t round = 0;; round++) {
+		otfcc_traceCount("untangle passes", 1);
+		sort_bkgraph(f);
+		bk_Overflow *overflows = NULL;
+		bool fatal = false;
+		uint32_t n = find_overflows(f, &overflows, &fatal);
+		bool packed = !n && !fatal;
+		bool retry = !packed && !fatal && round < BK_REPACK_MAX_ROUNDS &&
+		             resolve_overflows(f, overflows, n);
+		FREE(overflows);
+		if (!retry) return packed;
+	}
+}
+
+bool bk_untangleGraph(/*BORROW*/ bk_Graph *f) {
 	attract_bkgraph(f);
-	do {
-		tangled = try_untangle(f, passes);
-		if (tangled) { attract_bkgraph(f); }
-		passes++;
-	} while (tangled && passes < 16);
+	bk_Overflow *overflows = NULL;
+	bool fatal = false;
+	uint32_t n = find_overflows(f, &overflows, &fatal);
+	FREE(overflows);
+	if (!n && !fatal) return true;
+	return repack_bkgraph(f);
 }
 
-caryll_Buffer *bk_build_Block(/*MOVE*/ bk_Block *root) {
-	bk_Graph *f = bk_newGraphFromRootBlock(root);
-	bk_minimizeGraph(f);
-	bk_untangleGraph(f);
-	caryll_Buffer *buf = bk_build_Graph(f);
-	bk_delete_Graph(f);
+caryll_Buffer *bk_build_Block_checked(/*MOVE*/ bk_Block *root, /*OUT*/ bool *packed) {
+	caryll_Buffer *buf = NULL;
+	accountedAs(OTFCC_MEM_BK) {
+		bk_Graph *f = bk_newGraphFromRootBlock(root);
+		bk_minimizeGraph(f);
+		*packed = bk_untangleGraph(f);
+		buf = bk_build_Graph(f);
+		bk_delete_Graph(f);
+	}
 	return buf;
 }
+
+caryll_Buffer *bk_build_Block(/*MOVE*/ bk_Block *root) {
+	bool packed;
+	return bk_build_Block_checked(root, &packed);
+}
 caryll_Buffer *bk_build_Block_noMinimize(/*MOVE*/ bk_Block *root) {
-	bk_Graph *f = bk_newGraphFromRootBlock(root);
-	bk_untangleGraph(f);
-	caryll_Buffer *buf = bk_build_Graph(f);
-	bk_delete_Graph(f);
+	caryll_Buffer *buf = NULL;
+	accountedAs(OTFCC_MEM_BK) {
+		bk_Graph *f = bk_newGraphFromRootBlock(root);
+		bk_untangleGraph(f);
+		buf = bk_build_Graph(f);
+		bk_delete_Graph(f);
+	}
 	return buf;
 }
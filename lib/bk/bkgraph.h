@@ -14,6 +14,7 @@ typedef struct {
 	uint32_t order;
 	uint32_t height;
 	uint32_t hash;
+	uint8_t priority;
 	bk_Block *block;
 } bk_GraphNode;
 
@@ -26,10 +27,12 @@ typedef struct {
 bk_Graph *bk_newGraphFromRootBlock(bk_Block *b);
 void bk_delete_Graph(/*MOVE*/ bk_Graph *f);
 void bk_minimizeGraph(/*BORROW*/ bk_Graph *f);
-void bk_untangleGraph(/*BORROW*/ bk_Graph *f);
+// Lay out the graph so that every offset fits. Returns false when it cannot be packed.
+bool bk_untangleGraph(/*BORROW*/ bk_Graph *f);
 caryll_Buffer *bk_build_Graph(/*BORROW*/ bk_Graph *f);
 caryll_Buffer *bk_build_Block(/*MOVE*/ bk_Block *root);
 caryll_Buffer *bk_build_Block_noMinimize(/*MOVE*/ bk_Block *root);
+caryll_Buffer *bk_build_Block_checked(/*MOVE*/ bk_Block *root, /*OUT*/ bool *packed);
 size_t bk_estimateSizeOfGraph(bk_Graph *f);
 
 #endif
@@ -263,12 +263,13 @@ void consolidateGlyf(otfcc_Font *font, const otfcc_Options *options) {
 
 void consolidateCmap(otfcc_Font *font, const otfcc_Options *options) {
 	if (font->glyph_order && font->cmap) {
-		cmap_Entry *item;
-		foreach_hash(item, font->cmap->unicodes) {
-			if (!GlyphOrder.consolidateHandle(font->glyph_order, &item->glyph)) {
+		int unicode = -1;
+		otfcc_GlyphHandle *glyph;
+		while ((glyph = table_iCmap.next(font->cmap, &unicode))) {
+			if (!GlyphOrder.consolidateHandle(font->glyph_order, glyph)) {
 				logWarning("[Consolidate] Ignored mapping U+%04X to non-existent glyph /%s.\n",
-				           item->unicode, item->glyph.name);
-				Handle.dispose(&item->glyph);
+				           unicode, glyph->name);
+				Handle.dispose(glyph);
 			}
 		}
 	}
@@ -393,13 +394,13 @@ static void consolidateOTLTable(otfcc_Font *font, table_OTL *table, const otfcc_
 }
 
 static void consolidateOTL(otfcc_Font *font, const otfcc_Options *options) {
-	loggedStep("GSUB") {
+	loggedStep("GSUB") accountedAs(OTFCC_MEM_OTL) {
 		consolidateOTLTable(font, font->GSUB, options);
 	}
-	loggedStep("GPOS") {
+	loggedStep("GPOS") accountedAs(OTFCC_MEM_OTL) {
 		consolidateOTLTable(font, font->GPOS, options);
 	}
-	loggedStep("GDEF") {
+	loggedStep("GDEF") accountedAs(OTFCC_MEM_OTL) {
 		consolidate_GDEF(font, font->GDEF, options);
 	}
 }
@@ -510,7 +511,7 @@ void otfcc_consolidateFont(otfcc_Font *font, const otfcc_Options *options) {
 		}
 		font->glyph_order = go;
 	}
-	loggedStep("glyf") {
+	loggedStep("glyf") accountedAs(OTFCC_MEM_GLYF) {
 		consolidateGlyf(font, options);
 	}
 	loggedStep("cmap") {
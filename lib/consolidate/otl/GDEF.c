@@ -35,7 +35,7 @@ void consolidate_GDEF(otfcc_Font *font, table_GDEF *gdef, const otfcc_Options *o
 				continue;
 			}
 			int gid = gdef->ligCarets.items[j].glyph.index;
-			sds gname = sdsdup(gdef->ligCarets.items[j].glyph.name);
+			sds gname = gdef->ligCarets.items[j].glyph.name;
 			if (gname) {
 				HASH_FIND_INT(h, &gid, s);
 				if (!s) {
@@ -55,11 +55,10 @@ void consolidate_GDEF(otfcc_Font *font, table_GDEF *gdef, const otfcc_Options *o
 		GDEF_ligcaret_hash *s, *tmp;
 		HASH_ITER(hh, h, s, tmp) {
 			otl_CaretValueRecord v = {
-			    .glyph = Handle.fromConsolidated(s->gid, s->name),
+			    .glyph = Handle.fromInterned(s->gid, s->name),
 			};
 			otl_iCaretValueList.move(&v.carets, &s->carets);
 			otl_iLigCaretTable.push(&gdef->ligCarets, v);
-			sdsfree(s->name);
 			HASH_DEL(h, s);
 			FREE(s);
 		}
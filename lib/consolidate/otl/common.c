@@ -1,24 +1,30 @@
 #include "common.h"
 
 void fontop_consolidateCoverage(otfcc_Font *font, otl_Coverage *coverage, const otfcc_Options *options) {
-	if (!coverage) return;
-	for (glyphid_t j = 0; j < coverage->numGlyphs; j++) {
-		glyph_handle *h = &(coverage->glyphs[j]);
-		if (!GlyphOrder.consolidateHandle(font->glyph_order, h)) {
-			logWarning("[Consolidate] Ignored missing glyph /%s.\n", h->name);
-			Handle.dispose(h);
-		}
+	if (!coverage || !coverage->numGlyphs) return;
+	uint32_t *missing;
+	NEW(missing, coverage->numGlyphs);
+	uint32_t nMissing = GlyphOrder.consolidateHandles(font->glyph_order, coverage->glyphs,
+	                                                  coverage->numGlyphs, missing);
+	for (uint32_t k = 0; k < nMissing; k++) {
+		glyph_handle *h = &(coverage->glyphs[missing[k]]);
+		logWarning("[Consolidate] Ignored missing glyph /%s.\n", h->name);
+		Handle.dispose(h);
 	}
+	FREE(missing);
 }
 
 void fontop_consolidateClassDef(otfcc_Font *font, otl_ClassDef *cd, const otfcc_Options *options) {
-	if (!cd) return;
-	for (glyphid_t j = 0; j < cd->numGlyphs; j++) {
-		glyph_handle *h = &(cd->glyphs[j]);
-		if (!GlyphOrder.consolidateHandle(font->glyph_order, h)) {
-			logWarning("[Consolidate] Ignored missing glyph /%s.\n", h->name);
-			Handle.dispose(h);
-			cd->classes[j] = 0;
-		}
+	if (!cd || !cd->numGlyphs) return;
+	uint32_t *missing;
+	NEW(missing, cd->numGlyphs);
+	uint32_t nMissing =
+	    GlyphOrder.consolidateHandles(font->glyph_order, cd->glyphs, cd->numGlyphs, missing);
+	for (uint32_t k = 0; k < nMissing; k++) {
+		glyph_handle *h = &(cd->glyphs[missing[k]]);
+		logWarning("[Consolidate] Ignored missing glyph /%s.\n", h->name);
+		Handle.dispose(h);
+		cd->classes[missing[k]] = 0;
 	}
+	FREE(missing);
 }
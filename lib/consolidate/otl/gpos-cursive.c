@@ -29,7 +29,7 @@ bool consolidate_gpos_cursive(otfcc_Font *font, table_OTL *table, otl_Subtable *
 		} else {
 			NEW(s);
 			s->fromid = subtable->items[k].target.index;
-			s->fromname = sdsdup(subtable->items[k].target.name);
+			s->fromname = subtable->items[k].target.name;
 			s->enter = subtable->items[k].enter;
 			s->exit = subtable->items[k].exit;
 			HASH_ADD_INT(h, fromid, s);
@@ -43,9 +43,8 @@ bool consolidate_gpos_cursive(otfcc_Font *font, table_OTL *table, otl_Subtable *
 	HASH_ITER(hh, h, s, tmp) {
 		iSubtable_gpos_cursive.push(
 		    subtable, ((otl_GposCursiveEntry){
-		                  .target = Handle.fromConsolidated(s->fromid, s->fromname), .enter = s->enter, .exit = s->exit,
+		                  .target = Handle.fromInterned(s->fromid, s->fromname), .enter = s->enter, .exit = s->exit,
 		              }));
-		sdsfree(s->fromname);
 		HASH_DEL(h, s);
 		FREE(s);
 	}
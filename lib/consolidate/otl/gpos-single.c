@@ -29,7 +29,7 @@ bool consolidate_gpos_single(otfcc_Font *font, table_OTL *table, otl_Subtable *_
 		} else {
 			NEW(s);
 			s->fromid = subtable->items[k].target.index;
-			s->fromname = sdsdup(subtable->items[k].target.name);
+			s->fromname = subtable->items[k].target.name;
 			s->v = subtable->items[k].value;
 			HASH_ADD_INT(h, fromid, s);
 		}
@@ -42,9 +42,8 @@ bool consolidate_gpos_single(otfcc_Font *font, table_OTL *table, otl_Subtable *_
 	HASH_ITER(hh, h, s, tmp) {
 		iSubtable_gpos_single.push(
 		    subtable, ((otl_GposSingleEntry){
-		                  .target = Handle.fromConsolidated(s->fromid, s->fromname), .value = s->v,
+		                  .target = Handle.fromInterned(s->fromid, s->fromname), .value = s->v,
 		              }));
-		sdsfree(s->fromname);
 		HASH_DEL(h, s);
 		FREE(s);
 	}
@@ -35,7 +35,7 @@ bool consolidate_gsub_multi(otfcc_Font *font, table_OTL *table, otl_Subtable *_s
 		if (!s) {
 			NEW(s);
 			s->fromid = subtable->items[k].from.index;
-			s->fromname = sdsdup(subtable->items[k].from.name);
+			s->fromname = subtable->items[k].from.name;
 			s->to = subtable->items[k].to;
 			subtable->items[k].to = NULL; // Transfer ownership
 			HASH_ADD_INT(h, fromid, s);
@@ -48,9 +48,8 @@ bool consolidate_gsub_multi(otfcc_Font *font, table_OTL *table, otl_Subtable *_s
 		HASH_ITER(hh, h, s, tmp) {
 			iSubtable_gsub_multi.push(
 			    subtable, ((otl_GsubMultiEntry){
-			                  .from = Handle.fromConsolidated(s->fromid, s->fromname), .to = s->to,
+			                  .from = Handle.fromInterned(s->fromid, s->fromname), .to = s->to,
 			              }));
-			sdsfree(s->fromname);
 			HASH_DEL(h, s);
 			FREE(s);
 		}
@@ -46,8 +46,8 @@ bool consolidate_gsub_reverse(otfcc_Font *font, table_OTL *table, otl_Subtable *
 		gsub_single_map_hash *s, *tmp;
 		glyphid_t j = 0;
 		HASH_ITER(hh, h, s, tmp) {
-			from->glyphs[j] = Handle.fromConsolidated(s->fromid, s->fromname);
-			subtable->to->glyphs[j] = Handle.fromConsolidated(s->toid, s->toname);
+			from->glyphs[j] = Handle.fromInterned(s->fromid, s->fromname);
+			subtable->to->glyphs[j] = Handle.fromInterned(s->toid, s->toname);
 			j++;
 			HASH_DEL(h, s);
 			FREE(s);
@@ -33,8 +33,8 @@ bool consolidate_gsub_single(otfcc_Font *font, table_OTL *table, otl_Subtable *_
 			NEW(s);
 			s->fromid = subtable->items[k].from.index;
 			s->toid = subtable->items[k].to.index;
-			s->fromname = sdsdup(subtable->items[k].from.name);
-			s->toname = sdsdup(subtable->items[k].to.name);
+			s->fromname = subtable->items[k].from.name;
+			s->toname = subtable->items[k].to.name;
 			HASH_ADD_INT(h, fromid, s);
 		}
 	}
@@ -45,10 +45,8 @@ bool consolidate_gsub_single(otfcc_Font *font, table_OTL *table, otl_Subtable *_
 	gsub_single_map_hash *s, *tmp;
 	HASH_ITER(hh, h, s, tmp) {
 		iSubtable_gsub_single.push(subtable,
-		                           ((otl_GsubSingleEntry){.from = Handle.fromConsolidated(s->fromid, s->fromname),
-		                                                  .to = Handle.fromConsolidated(s->toid, s->toname)}));
-		sdsfree(s->fromname);
-		sdsfree(s->toname);
+		                           ((otl_GsubSingleEntry){.from = Handle.fromInterned(s->fromid, s->fromname),
+		                                                  .to = Handle.fromInterned(s->toid, s->toname)}));
 		HASH_DEL(h, s);
 		FREE(s);
 	}
@@ -46,7 +46,7 @@ static void consolidateMarkArray(otfcc_Font *font, table_OTL *table, const otfcc
 		    markArray->items[k].markClass < classCount) {
 			NEW(s);
 			s->gid = markArray->items[k].glyph.index;
-			s->name = sdsdup(markArray->items[k].glyph.name);
+			s->name = markArray->items[k].glyph.name;
 			s->markClass = markArray->items[k].markClass;
 			s->anchor = markArray->items[k].anchor;
 			HASH_ADD_INT(hm, gid, s);
@@ -60,11 +60,10 @@ static void consolidateMarkArray(otfcc_Font *font, table_OTL *table, const otfcc
 	mark_hash *s, *tmp;
 	HASH_ITER(hh, hm, s, tmp) {
 		otl_iMarkArray.push(markArray, ((otl_MarkRecord){
-		                                   .glyph = Handle.fromConsolidated(s->gid, s->name),
+		                                   .glyph = Handle.fromInterned(s->gid, s->name),
 		                                   .markClass = s->markClass,
 		                                   .anchor = s->anchor,
 		                               }));
-		sdsfree(s->name);
 		HASH_DEL(hm, s);
 		FREE(s);
 	}
@@ -86,7 +85,7 @@ static void consolidateBaseArray(otfcc_Font *font, table_OTL *table, const otfcc
 		if (!s) {
 			NEW(s);
 			s->gid = baseArray->items[k].glyph.index;
-			s->name = sdsdup(baseArray->items[k].glyph.name);
+			s->name = baseArray->items[k].glyph.name;
 			s->anchors = baseArray->items[k].anchors;
 			baseArray->items[k].anchors = NULL; // Transfer ownership
 			HASH_ADD_INT(hm, gid, s);
@@ -101,9 +100,8 @@ static void consolidateBaseArray(otfcc_Font *font, table_OTL *table, const otfcc
 	HASH_ITER(hh, hm, s, tmp) {
 		otl_iBaseArray.push(
 		    baseArray, ((otl_BaseRecord){
-		                   .glyph = Handle.fromConsolidated(s->gid, s->name), .anchors = s->anchors,
+		                   .glyph = Handle.fromInterned(s->gid, s->name), .anchors = s->anchors,
 		               }));
-		sdsfree(s->name);
 		HASH_DEL(hm, s);
 		FREE(s);
 	}
@@ -124,7 +122,7 @@ static void consolidateLigArray(otfcc_Font *font, table_OTL *table, const otfcc_
 		if (!s) {
 			NEW(s);
 			s->gid = ligArray->items[k].glyph.index;
-			s->name = sdsdup(ligArray->items[k].glyph.name);
+			s->name = ligArray->items[k].glyph.name;
 			s->componentCount = ligArray->items[k].componentCount;
 			s->anchors = ligArray->items[k].anchors;
 			ligArray->items[k].anchors = NULL;
@@ -139,11 +137,10 @@ static void consolidateLigArray(otfcc_Font *font, table_OTL *table, const otfcc_
 	lig_hash *s, *tmp;
 	HASH_ITER(hh, hm, s, tmp) {
 		otl_iLigatureArray.push(ligArray, ((otl_LigatureBaseRecord){
-		                                      .glyph = Handle.fromConsolidated(s->gid, s->name),
+		                                      .glyph = Handle.fromInterned(s->gid, s->name),
 		                                      .componentCount = s->componentCount,
 		                                      .anchors = s->anchors,
 		                                  }));
-		sdsfree(s->name);
 		HASH_DEL(hm, s);
 		FREE(s);
 	}
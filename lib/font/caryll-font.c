@@ -3,6 +3,8 @@
 #include "table/all.h"
 #include "otfcc/sfnt-builder.h"
 #include "consolidate/consolidate.h"
+#include "subset/subset.h"
+#include "instance/instance.h"
 
 static void *createFontTable(otfcc_Font *font, const uint32_t tag) {
 	switch (tag) {
@@ -18,6 +20,9 @@ static void *createFontTable(otfcc_Font *font, const uint32_t tag) {
 
 static void deleteFontTable(otfcc_Font *font, const uint32_t tag) {
 	switch (tag) {
+		case 'fvar':
+			if (font->fvar) DELETE(table_iFvar.free, font->fvar);
+			return;
 		case 'head':
 			if (font->head) DELETE(table_iHead.free, font->head);
 			return;
@@ -121,6 +126,7 @@ static void deleteFontTable(otfcc_Font *font, const uint32_t tag) {
 
 static INLINE void initFont(otfcc_Font *font) {
 	memset(font, 0, sizeof(*font));
+	font->allocator = otfcc_currentAllocator();
 }
 static INLINE void disposeFont(otfcc_Font *font) {
 	deleteFontTable(font, 'head');
@@ -153,14 +159,49 @@ static INLINE void disposeFont(otfcc_Font *font) {
 	deleteFontTable(font, 'TSI0');
 	deleteFontTable(font, 'TSI2');
 	deleteFontTable(font, 'TSI5');
+	// Last, since the glyphs point to regions the masters of fvar own.
+	deleteFontTable(font, 'fvar');
 
 	GlyphOrder.free(font->glyph_order);
 }
-caryll_standardRefTypeFn(otfcc_Font, initFont, disposeFont);
+caryll_standardTypeFn(otfcc_Font, initFont, disposeFont);
+caryll_trivialCreate(otfcc_Font);
+// Everything reachable from a font is freed with the allocator which created the font. A font
+// held in a region is released with the region, skipping the walk over its objects.
+static void otfcc_Font_free(MOVE otfcc_Font *font) {
+	if (!font) return;
+	if (font->region) {
+		otfcc_deleteRegion(font->region);
+		return;
+	}
+	const otfcc_IAllocator *previous = otfcc_useAllocator(font->allocator);
+	otfcc_Font_dispose(font);
+	FREE(font);
+	otfcc_useAllocator(previous);
+}
+static void consolidateFont(otfcc_Font *font, const otfcc_Options *options) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(font->allocator);
+	otfcc_consolidateFont(font, options);
+	otfcc_useAllocator(previous);
+}
+static void subsetFont(otfcc_Font *font, const otfcc_RetainSet *retain,
+                       const otfcc_Options *options) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(font->allocator);
+	otfcc_subsetFont(font, retain, options);
+	otfcc_useAllocator(previous);
+}
+static void instantiateFont(otfcc_Font *font, const otfcc_Location *location,
+                            const otfcc_Options *options) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(font->allocator);
+	otfcc_instantiateFont(font, location, options);
+	otfcc_useAllocator(previous);
+}
 
 caryll_ElementInterfaceOf(otfcc_Font) otfcc_iFont = {
     caryll_standardRefTypeMethods(otfcc_Font),
     .createTable = createFontTable,
     .deleteTable = deleteFontTable,
-    .consolidate = otfcc_consolidateFont,
+    .consolidate = consolidateFont,
+    .subset = subsetFont,
+    .instantiate = instantiateFont,
 };
@@ -1,5 +1,9 @@
 #include "support/util.h"
 #include "otfcc/sfnt-builder.h"
+#include "otfcc/sfnt.h"
+#include "support/deflate/deflate.h"
+#include "support/brotli/brotli.h"
+#include "support/thread-pool/thread-pool.h"
 
 static uint32_t buf_checksum(caryll_Buffer *buffer) {
 	uint32_t actualLength = (uint32_t)buflen(buffer);
@@ -51,6 +55,7 @@ void otfcc_deleteSFNTBuilder(otfcc_SFNTBuilder *builder) {
 	HASH_ITER(hh, builder->tables, item, tmp) {
 		HASH_DEL(builder->tables, item);
 		buffree(item->buffer);
+		buffree(item->transformed);
 		FREE(item);
 	}
 	FREE(builder);
@@ -71,6 +76,18 @@ void otfcc_SFNTBuilder_pushTable(otfcc_SFNTBuilder *builder, uint32_t tag, caryl
 	}
 }
 
+void otfcc_SFNTBuilder_pushTransform(otfcc_SFNTBuilder *builder, uint32_t tag,
+                                     caryll_Buffer *transformed) {
+	if (!builder || !transformed) return;
+	otfcc_SFNTTableEntry *item;
+	HASH_FIND_INT(builder->tables, &tag, item);
+	if (item && !item->transformed) {
+		item->transformed = transformed;
+	} else {
+		buffree(transformed);
+	}
+}
+
 static int byTag(otfcc_SFNTTableEntry *a, otfcc_SFNTTableEntry *b) {
 	return (a->tag - b->tag);
 }
@@ -111,3 +128,234 @@ caryll_Buffer *otfcc_SFNTBuilder_serialize(otfcc_SFNTBuilder *builder) {
 	bufwrite32b(buffer, 0xB1B0AFBA - wholeChecksum);
 	return buffer;
 }
+
+// WOFF 1.0
+typedef struct {
+	otfcc_SFNTTableEntry **tables;
+	caryll_Buffer **compressed;
+} WOFFCompressionEnv;
+
+static void compressTableJob(void *_env, size_t j) {
+	WOFFCompressionEnv *env = (WOFFCompressionEnv *)_env;
+	otfcc_SFNTTableEntry *table = env->tables[j];
+	caryll_Buffer *z = otfcc_zlibCompress(table->buffer->data, table->length);
+	if (buflen(z) < table->length) {
+		env->compressed[j] = z;
+	} else {
+		// Tables which do not shrink are stored as they are.
+		buffree(z);
+	}
+}
+
+// Sorts the tables of a web font, and computes head.checksumAdjust for the sfnt it decodes into.
+// Returns the tables in order, their count in *n and the size of the sfnt in *sfntSize.
+static otfcc_SFNTTableEntry **sfntTables(otfcc_SFNTBuilder *builder, uint16_t *n,
+                                         uint32_t *sfntSize, otfcc_SFNTTableEntry **head) {
+	uint16_t nTables = HASH_COUNT(builder->tables);
+	HASH_SORT(builder->tables, byTag);
+	otfcc_SFNTTableEntry **tables;
+	NEW(tables, nTables + 1);
+	uint16_t searchRange = (nTables < 16 ? 8 : nTables < 32 ? 16 : nTables < 64 ? 32 : 64) * 16;
+	caryll_Buffer *sfntHeader = bufnew();
+	bufwrite32b(sfntHeader, builder->header);
+	bufwrite16b(sfntHeader, nTables);
+	bufwrite16b(sfntHeader, searchRange);
+	bufwrite16b(sfntHeader, (nTables < 16 ? 3 : nTables < 32 ? 4 : nTables < 64 ? 5 : 6));
+	bufwrite16b(sfntHeader, nTables * 16 - searchRange);
+	uint32_t size = 12 + nTables * 16;
+	uint32_t wholeChecksum = 0;
+	*head = NULL;
+	{
+		otfcc_SFNTTableEntry *table;
+		uint16_t j = 0;
+		foreach_hash(table, builder->tables) {
+			tables[j++] = table;
+			bufwrite32b(sfntHeader, table->tag);
+			bufwrite32b(sfntHeader, table->checksum);
+			bufwrite32b(sfntHeader, size);
+			bufwrite32b(sfntHeader, table->length);
+			size += (uint32_t)buflen(table->buffer);
+			wholeChecksum += table->checksum;
+			if (table->tag == 'head') *head = table;
+		}
+	}
+	wholeChecksum += buf_checksum(sfntHeader);
+	buffree(sfntHeader);
+	if (*head && (*head)->length >= 12) {
+		bufseek((*head)->buffer, 8);
+		bufwrite32b((*head)->buffer, 0xB1B0AFBA - wholeChecksum);
+	}
+	*n = nTables;
+	*sfntSize = size;
+	return tables;
+}
+
+// The version of a web font follows head.fontRevision.
+static void writeFontVersion(caryll_Buffer *buffer, const otfcc_SFNTTableEntry *head) {
+	if (head && head->length >= 8) {
+		bufwrite_bytes(buffer, 4, head->buffer->data + 4);
+	} else {
+		bufwrite32b(buffer, 0x00010000);
+	}
+}
+
+caryll_Buffer *otfcc_SFNTBuilder_serializeWOFF(otfcc_SFNTBuilder *builder) {
+	caryll_Buffer *buffer = bufnew();
+	if (!builder) return buffer;
+	const otfcc_Options *options = builder->options;
+	uint16_t nTables;
+	uint32_t sfntSize;
+	otfcc_SFNTTableEntry *head;
+	otfcc_SFNTTableEntry **tables = sfntTables(builder, &nTables, &sfntSize, &head);
+
+	caryll_Buffer **compressed;
+	NEW(compressed, nTables + 1);
+	tracedStep("compress tables") {
+		WOFFCompressionEnv env = {.tables = tables, .compressed = compressed};
+		otfcc_parallelFor(nTables, options->threads, otfcc_currentAllocator(), compressTableJob,
+		                  &env);
+	}
+
+	bufwrite32b(buffer, 'wOFF');
+	bufwrite32b(buffer, builder->header);
+	bufwrite32b(buffer, 0); // length, filled below
+	bufwrite16b(buffer, nTables);
+	bufwrite16b(buffer, 0);
+	bufwrite32b(buffer, sfntSize);
+	writeFontVersion(buffer, head);
+	bufwrite32b(buffer, 0); // no metadata
+	bufwrite32b(buffer, 0);
+	bufwrite32b(buffer, 0);
+	bufwrite32b(buffer, 0); // no private data
+	bufwrite32b(buffer, 0);
+
+	size_t offset = 44 + nTables * 20;
+	for (uint16_t j = 0; j < nTables; j++) {
+		otfcc_SFNTTableEntry *table = tables[j];
+		uint32_t compLength = compressed[j] ? (uint32_t)buflen(compressed[j]) : table->length;
+		bufwrite32b(buffer, table->tag);
+		bufwrite32b(buffer, (uint32_t)offset);
+		bufwrite32b(buffer, compLength);
+		bufwrite32b(buffer, table->length);
+		bufwrite32b(buffer, table->checksum);
+		size_t cp = buffer->cursor;
+		bufseek(buffer, offset);
+		if (compressed[j]) {
+			bufwrite_buf(buffer, compressed[j]);
+		} else {
+			bufwrite_bytes(buffer, table->length, table->buffer->data);
+		}
+		buflongalign(buffer);
+		offset = buflen(buffer);
+		bufseek(buffer, cp);
+		buffree(compressed[j]);
+	}
+	bufseek(buffer, 8);
+	bufwrite32b(buffer, (uint32_t)buflen(buffer));
+
+	FREE(compressed);
+	FREE(tables);
+	return buffer;
+}
+
+// WOFF 2.0
+static void writeUIntBase128(caryll_Buffer *buffer, uint32_t value) {
+	uint8_t digits = 1;
+	while (digits < 5 && value >> (7 * digits)) digits++;
+	for (uint8_t j = digits; j-- > 0;) {
+		bufwrite8(buffer, ((value >> (7 * j)) & 0x7F) | (j ? 0x80 : 0));
+	}
+}
+
+caryll_Buffer *otfcc_SFNTBuilder_serializeWOFF2(otfcc_SFNTBuilder *builder) {
+	caryll_Buffer *buffer = bufnew();
+	if (!builder) return buffer;
+	const otfcc_Options *options = builder->options;
+
+	// glyf and loca are transformed together or not at all.
+	otfcc_SFNTTableEntry *glyf, *loca, *head;
+	uint32_t tag = 'glyf';
+	HASH_FIND_INT(builder->tables, &tag, glyf);
+	tag = 'loca';
+	HASH_FIND_INT(builder->tables, &tag, loca);
+	bool glyfTransformed = glyf && loca && glyf->transformed && loca->transformed;
+	// A transformed font sets bit 11 of head.flags.
+	tag = 'head';
+	HASH_FIND_INT(builder->tables, &tag, head);
+	if (glyfTransformed && head && head->length >= 18) {
+		uint16_t flags = (head->buffer->data[16] << 8) | head->buffer->data[17];
+		bufseek(head->buffer, 16);
+		bufwrite16b(head->buffer, flags | 0x800);
+		head->checksum = buf_checksum(head->buffer);
+	}
+
+	uint16_t nTables;
+	uint32_t sfntSize;
+	otfcc_SFNTTableEntry **tables = sfntTables(builder, &nTables, &sfntSize, &head);
+
+	caryll_Buffer *directory = bufnew();
+	caryll_Buffer *stream = bufnew();
+	for (uint16_t j = 0; j < nTables; j++) {
+		otfcc_SFNTTableEntry *table = tables[j];
+		bool isGlyf = table->tag == 'glyf' || table->tag == 'loca';
+		// hmtx is rebuilt from the bounding boxes in the transformed glyf.
+		bool transformed = isGlyf ? glyfTransformed
+		                          : table->transformed && (table->tag != 'hmtx' || glyfTransformed);
+		// Transform version 0 is the transform for glyf and loca, and the null one elsewhere.
+		uint8_t version = isGlyf ? (transformed ? 0 : 3) : (transformed ? 1 : 0);
+		uint8_t known = 63;
+		for (uint8_t k = 0; k < 63; k++) {
+			if (otfcc_woff2KnownTags[k] == (uint32_t)table->tag) {
+				known = k;
+				break;
+			}
+		}
+		bufwrite8(directory, known | (version << 6));
+		if (known == 63) bufwrite32b(directory, table->tag);
+		writeUIntBase128(directory, table->length);
+		if (transformed) {
+			writeUIntBase128(directory, (uint32_t)buflen(table->transformed));
+			bufwrite_buf(stream, table->transformed);
+		} else {
+			bufwrite_bytes(stream, table->length, table->buffer->data);
+		}
+	}
+	caryll_Buffer *compressed;
+	tracedStep("compress tables") {
+		compressed = otfcc_brotliCompress(stream->data, buflen(stream));
+	}
+	if (!compressed) {
+		logError("Cannot compress the tables with Brotli.\n");
+		buffree(stream);
+		buffree(directory);
+		FREE(tables);
+		buffree(buffer);
+		return NULL;
+	}
+
+	bufwrite32b(buffer, 'wOF2');
+	bufwrite32b(buffer, builder->header);
+	bufwrite32b(buffer, 0); // length, filled below
+	bufwrite16b(buffer, nTables);
+	bufwrite16b(buffer, 0);
+	bufwrite32b(buffer, sfntSize);
+	bufwrite32b(buffer, (uint32_t)buflen(compressed));
+	writeFontVersion(buffer, head);
+	bufwrite32b(buffer, 0); // no metadata
+	bufwrite32b(buffer, 0);
+	bufwrite32b(buffer, 0);
+	bufwrite32b(buffer, 0); // no private data
+	bufwrite32b(buffer, 0);
+	bufwrite_buf(buffer, directory);
+	bufwrite_buf(buffer, compressed);
+	buflongalign(buffer);
+	size_t length = buflen(buffer);
+	bufseek(buffer, 8);
+	bufwrite32b(buffer, (uint32_t)length);
+
+	buffree(compressed);
+	buffree(stream);
+	buffree(directory);
+	FREE(tables);
+	return buffer;
+}
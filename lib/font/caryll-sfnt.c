@@ -1,5 +1,30 @@
 #include "support/util.h"
 #include "otfcc/sfnt.h"
+#include "support/deflate/deflate.h"
+#include "support/brotli/brotli.h"
+#include "support/thread-pool/thread-pool.h"
+
+const uint32_t otfcc_woff2KnownTags[63] = {
+    'cmap', 'head', 'hhea', 'hmtx', 'maxp', 'name', 'OS/2', 'post', 'cvt ', 'fpgm', 'glyf',
+    'loca', 'prep', 'CFF ', 'VORG', 'EBDT', 'EBLC', 'gasp', 'hdmx', 'kern', 'LTSH', 'PCLT',
+    'VDMX', 'vhea', 'vmtx', 'BASE', 'GDEF', 'GPOS', 'GSUB', 'EBSC', 'JSTF', 'MATH', 'CBDT',
+    'CBLC', 'COLR', 'CPAL', 'SVG ', 'sbix', 'acnt', 'avar', 'bdat', 'bloc', 'bsln', 'cvar',
+    'fdsc', 'feat', 'fmtx', 'fvar', 'gvar', 'hsty', 'just', 'lcar', 'mort', 'morx', 'opbd',
+    'prop', 'trak', 'Zapf', 'Silf', 'Glat', 'Gloc', 'Feat', 'Sill'};
+
+static void deletePackets(otfcc_SplineFontContainer *font) {
+	if (font->packets) {
+		for (uint32_t count = 0; count < font->count; count++) {
+			if (!font->packets[count].pieces) continue;
+			for (int i = 0; i < font->packets[count].numTables; i++) {
+				FREE(font->packets[count].pieces[i].data);
+			}
+			FREE(font->packets[count].pieces);
+		}
+		FREE(font->packets);
+	}
+	FREE(font->offsets);
+}
 
 static void otfcc_read_packets(otfcc_SplineFontContainer *font, FILE *file) {
 	for (uint32_t count = 0; count < font->count; count++) {
@@ -28,6 +53,234 @@ static void otfcc_read_packets(otfcc_SplineFontContainer *font, FILE *file) {
 	}
 }
 
+// Web fonts are read whole and decompressed into the pieces of their packets.
+static uint8_t *readWholeFile(FILE *file, size_t *length) {
+	(void)fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	if (size <= 0) return NULL;
+	(void)fseek(file, 0, SEEK_SET);
+	uint8_t *data;
+	NEW(data, size);
+	*length = fread(data, 1, size, file);
+	return data;
+}
+static void initPacket(otfcc_Packet *packet, uint32_t flavor, uint16_t numTables) {
+	uint16_t entrySelector = 0;
+	while ((2 << entrySelector) <= numTables) entrySelector++;
+	packet->sfnt_version = flavor;
+	packet->numTables = numTables;
+	packet->searchRange = (1 << entrySelector) * 16;
+	packet->entrySelector = entrySelector;
+	packet->rangeShift = numTables * 16 - packet->searchRange;
+	NEW(packet->pieces, numTables);
+}
+
+// WOFF: tables are compressed with zlib one by one, so they are inflated in parallel.
+typedef struct {
+	const uint8_t *data;
+	otfcc_PacketPiece *pieces;
+	const uint32_t *compLengths;
+	bool *failed;
+} WOFFInflateEnv;
+static void inflateTableJob(void *_env, size_t j) {
+	WOFFInflateEnv *env = (WOFFInflateEnv *)_env;
+	otfcc_PacketPiece *piece = &env->pieces[j];
+	const uint8_t *source = env->data + piece->offset;
+	if (env->compLengths[j] == piece->length) {
+		memcpy(piece->data, source, piece->length);
+	} else {
+		env->failed[j] =
+		    !otfcc_zlibDecompress(source, env->compLengths[j], piece->data, piece->length);
+	}
+}
+static bool readWOFF(otfcc_SplineFontContainer *font, const uint8_t *data, size_t length) {
+	if (length < 44) return false;
+	uint16_t numTables = read_16u(data + 12);
+	if (44 + 20 * (size_t)numTables > length) return false;
+	font->count = 1;
+	NEW(font->offsets, font->count);
+	NEW(font->packets, font->count);
+	otfcc_Packet *packet = &font->packets[0];
+	initPacket(packet, read_32u(data + 4), numTables);
+
+	bool ok = true;
+	uint32_t *compLengths;
+	bool *failed;
+	NEW(compLengths, numTables);
+	NEW(failed, numTables);
+	for (uint16_t j = 0; j < numTables; j++) {
+		const uint8_t *entry = data + 44 + 20 * j;
+		otfcc_PacketPiece *piece = &packet->pieces[j];
+		piece->tag = read_32u(entry);
+		piece->offset = read_32u(entry + 4);
+		compLengths[j] = read_32u(entry + 8);
+		piece->length = read_32u(entry + 12);
+		piece->checkSum = read_32u(entry + 16);
+		if ((size_t)piece->offset + compLengths[j] > length || compLengths[j] > piece->length) {
+			ok = false;
+			piece->length = 0;
+		}
+		NEW(piece->data, piece->length);
+	}
+	if (ok) {
+		WOFFInflateEnv env = {
+		    .data = data, .pieces = packet->pieces, .compLengths = compLengths, .failed = failed};
+		otfcc_parallelFor(numTables, 0, otfcc_currentAllocator(), inflateTableJob, &env);
+		for (uint16_t j = 0; j < numTables; j++) {
+			if (failed[j]) ok = false;
+		}
+	}
+	FREE(compLengths);
+	FREE(failed);
+	return ok;
+}
+
+// WOFF2: the tables are one Brotli stream, where glyf, loca and hmtx may be transformed. Those
+// are left as they are, for the table readers to decode.
+typedef struct {
+	uint32_t tag;
+	uint32_t offset; // in the decompressed stream
+	uint32_t length;
+	bool transformed;
+} WOFF2Table;
+static bool readUIntBase128(const uint8_t *data, size_t length, size_t *cursor, uint32_t *value) {
+	uint32_t result = 0;
+	for (uint8_t j = 0; j < 5; j++) {
+		if (*cursor >= length) return false;
+		uint8_t byte = data[(*cursor)++];
+		if (j == 0 && byte == 0x80) return false; // leading zeros
+		if (result & 0xFE000000) return false;
+		result = (result << 7) | (byte & 0x7F);
+		if (!(byte & 0x80)) {
+			*value = result;
+			return true;
+		}
+	}
+	return false;
+}
+static bool read255UShort(const uint8_t *data, size_t length, size_t *cursor, uint16_t *value) {
+	if (*cursor >= length) return false;
+	uint8_t code = data[(*cursor)++];
+	if (code == 253) {
+		if (*cursor + 2 > length) return false;
+		*value = read_16u(data + *cursor);
+		*cursor += 2;
+	} else if (code >= 254) {
+		if (*cursor >= length) return false;
+		*value = data[(*cursor)++] + (code == 255 ? 253 : 506);
+	} else {
+		*value = code;
+	}
+	return true;
+}
+static void fillWOFF2Packet(otfcc_Packet *packet, uint32_t flavor, uint16_t numTables,
+                            const uint16_t *indices, const WOFF2Table *tables,
+                            const uint8_t *stream) {
+	initPacket(packet, flavor, numTables);
+	for (uint16_t j = 0; j < numTables; j++) {
+		const WOFF2Table *table = &tables[indices ? indices[j] : j];
+		otfcc_PacketPiece *piece = &packet->pieces[j];
+		piece->tag = table->tag;
+		piece->offset = table->offset;
+		piece->length = table->length;
+		piece->transformed = table->transformed;
+		NEW(piece->data, piece->length);
+		if (piece->length) memcpy(piece->data, stream + table->offset, piece->length);
+	}
+}
+static bool readWOFF2(otfcc_SplineFontContainer *font, const uint8_t *data, size_t length) {
+	if (length < 48) return false;
+	uint32_t flavor = read_32u(data + 4);
+	uint16_t numTables = read_16u(data + 12);
+	uint32_t compressedLength = read_32u(data + 20);
+	size_t cursor = 48;
+
+	bool ok = false;
+	uint8_t *stream = NULL;
+	uint16_t *indices = NULL;
+	WOFF2Table *tables;
+	NEW(tables, numTables);
+	size_t streamLength = 0;
+	for (uint16_t j = 0; j < numTables; j++) {
+		WOFF2Table *table = &tables[j];
+		if (cursor >= length) goto FAIL;
+		uint8_t flags = data[cursor++];
+		if ((flags & 0x3F) == 63) {
+			if (cursor + 4 > length) goto FAIL;
+			table->tag = read_32u(data + cursor);
+			cursor += 4;
+		} else {
+			table->tag = otfcc_woff2KnownTags[flags & 0x3F];
+		}
+		// Transform version 0 is the transform for glyf and loca, and the null one elsewhere.
+		uint8_t version = flags >> 6;
+		bool isGlyf = table->tag == 'glyf' || table->tag == 'loca';
+		if (isGlyf ? version != 0 && version != 3 : version > 1) goto FAIL;
+		if (!isGlyf && version == 1 && table->tag != 'hmtx') goto FAIL;
+		table->transformed = isGlyf ? version == 0 : version == 1;
+		if (!readUIntBase128(data, length, &cursor, &table->length)) goto FAIL;
+		if (table->transformed && !readUIntBase128(data, length, &cursor, &table->length)) {
+			goto FAIL;
+		}
+		table->offset = (uint32_t)streamLength;
+		streamLength += table->length;
+		if (streamLength > 0xFFFFFFFF) goto FAIL;
+	}
+
+	uint32_t numFonts = 1;
+	uint16_t *fontTables = NULL;
+	uint32_t *flavors = NULL;
+	if (flavor == 'ttcf') {
+		// A collection lists the tables of each font, which share the directory above.
+		cursor += 4; // version
+		uint16_t n;
+		if (!read255UShort(data, length, &cursor, &n) || !n) goto FAIL;
+		numFonts = n;
+		NEW(fontTables, numFonts);
+		NEW(flavors, numFonts);
+		NEW(indices, (size_t)numFonts * numTables);
+		for (uint32_t f = 0; f < numFonts; f++) {
+			if (!read255UShort(data, length, &cursor, &fontTables[f])) goto FAIL_COLLECTION;
+			if (fontTables[f] > numTables || cursor + 4 > length) goto FAIL_COLLECTION;
+			flavors[f] = read_32u(data + cursor);
+			cursor += 4;
+			for (uint16_t j = 0; j < fontTables[f]; j++) {
+				uint16_t *index = &indices[f * numTables + j];
+				if (!read255UShort(data, length, &cursor, index) || *index >= numTables) {
+					goto FAIL_COLLECTION;
+				}
+			}
+		}
+	}
+
+	if (cursor + compressedLength > length) goto FAIL_COLLECTION;
+	NEW(stream, streamLength);
+	if (!otfcc_brotliDecompress(data + cursor, compressedLength, stream, streamLength)) {
+		goto FAIL_COLLECTION;
+	}
+	font->count = numFonts;
+	NEW(font->offsets, font->count);
+	NEW(font->packets, font->count);
+	for (uint32_t f = 0; f < numFonts; f++) {
+		if (flavors) {
+			fillWOFF2Packet(&font->packets[f], flavors[f], fontTables[f],
+			                indices + f * numTables, tables, stream);
+		} else {
+			fillWOFF2Packet(&font->packets[f], flavor, numTables, NULL, tables, stream);
+		}
+	}
+	ok = true;
+
+FAIL_COLLECTION:
+	FREE(fontTables);
+	FREE(flavors);
+FAIL:
+	FREE(indices);
+	FREE(stream);
+	FREE(tables);
+	return ok;
+}
+
 otfcc_SplineFontContainer *otfcc_readSFNT(FILE *file) {
 	if (!file) return NULL;
 	otfcc_SplineFontContainer *font;
@@ -60,6 +313,20 @@ otfcc_SplineFontContainer *otfcc_readSFNT(FILE *file) {
 			otfcc_read_packets(font, file);
 			break;
 
+		case 'wOFF':
+		case 'wOF2': {
+			size_t length = 0;
+			uint8_t *data = readWholeFile(file, &length);
+			bool ok = data && (font->type == 'wOFF' ? readWOFF(font, data, length)
+			                                         : readWOFF2(font, data, length));
+			FREE(data);
+			if (!ok) {
+				deletePackets(font);
+				font->count = 0;
+			}
+			break;
+		}
+
 		default:
 			font->count = 0;
 			font->offsets = NULL;
@@ -74,15 +341,6 @@ otfcc_SplineFontContainer *otfcc_readSFNT(FILE *file) {
 
 void otfcc_deleteSFNT(otfcc_SplineFontContainer *font) {
 	if (!font) return;
-	if (font->count > 0) {
-		for (uint32_t count = 0; count < font->count; count++) {
-			for (int i = 0; i < font->packets[count].numTables; i++) {
-				FREE(font->packets[count].pieces[i].data);
-			}
-			FREE(font->packets[count].pieces);
-		}
-		FREE(font->packets);
-	}
-	FREE(font->offsets);
+	deletePackets(font);
 	FREE(font);
 }
@@ -0,0 +1,158 @@
+#include "instance.h"
+#include "support/util.h"
+
+// Locations
+
+caryll_standardValType(otfcc_AxisValue, otfcc_iAxisValue);
+caryll_standardVectorImpl(otfcc_AxisValueList, otfcc_AxisValue, otfcc_iAxisValue,
+                          otfcc_iAxisValueList);
+
+static INLINE void initLocation(otfcc_Location *location) {
+	otfcc_iAxisValueList.init(&location->values);
+}
+static INLINE void disposeLocation(otfcc_Location *location) {
+	otfcc_iAxisValueList.dispose(&location->values);
+}
+caryll_standardRefTypeFn(otfcc_Location, initLocation, disposeLocation);
+
+static bool isSeparator(char c) {
+	return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+static bool parseLocation(otfcc_Location *location, const char *list) {
+	const char *p = list;
+	while (*p) {
+		if (isSeparator(*p)) {
+			p++;
+			continue;
+		}
+		const char *eq = p;
+		while (*eq && *eq != '=' && !isSeparator(*eq))
+			eq++;
+		if (*eq != '=' || eq == p || eq - p > 4) return false;
+		uint32_t tag = 0;
+		for (uint8_t j = 0; j < 4; j++) {
+			tag = tag << 8 | (uint8_t)(p + j < eq ? p[j] : ' ');
+		}
+		char *end = NULL;
+		double value = strtod(eq + 1, &end);
+		if (end == eq + 1 || isSeparator(eq[1]) || !isfinite(value)) return false;
+		if (*end && !isSeparator(*end)) return false;
+		otfcc_iAxisValueList.push(&location->values,
+		                          (otfcc_AxisValue){.tag = tag, .value = value});
+		p = end;
+	}
+	return true;
+}
+
+caryll_ElementInterfaceOf(otfcc_Location) otfcc_iLocation = {
+    caryll_standardRefTypeMethods(otfcc_Location),
+    .parse = parseLocation,
+};
+
+// Instancing
+
+// Maps a normalized coordinate through the segments of an avar map, which it holds linearly in
+// between their ends. Without pairs the coordinate stays.
+static pos_t mapThroughSegments(const fvar_SegmentMap *map, pos_t n) {
+	if (!map->length) return n;
+	const fvar_AxisValueMap *first = &map->items[0];
+	if (n <= first->fromCoordinate) return n - first->fromCoordinate + first->toCoordinate;
+	for (size_t j = 1; j < map->length; j++) {
+		const fvar_AxisValueMap *a = &map->items[j - 1];
+		const fvar_AxisValueMap *b = &map->items[j];
+		if (n > b->fromCoordinate) continue;
+		if (b->fromCoordinate == a->fromCoordinate) return b->toCoordinate;
+		return a->toCoordinate + (b->toCoordinate - a->toCoordinate) *
+		                             (n - a->fromCoordinate) /
+		                             (b->fromCoordinate - a->fromCoordinate);
+	}
+	const fvar_AxisValueMap *last = &map->items[map->length - 1];
+	return n - last->fromCoordinate + last->toCoordinate;
+}
+
+// Maps the location to the normalized coordinates of the regions: -1 at the minimum of an
+// axis, 0 at its default and 1 at its maximum, linearly on each side of the default and then
+// through the segment map of avar, in F2DOT14 precision.
+static VV normalizeLocation(const table_fvar *fvar, const otfcc_Location *location,
+                            const otfcc_Options *options) {
+	VV coords = iVV.neutral(fvar->axes.length);
+	foreach (otfcc_AxisValue *v, location->values) {
+		bool found = false;
+		for (tableid_t j = 0; j < fvar->axes.length; j++) {
+			const vf_Axis *axis = &fvar->axes.items[j];
+			if (axis->tag != v->tag) continue;
+			found = true;
+			pos_t x = v->value;
+			if (x < axis->minValue) x = axis->minValue;
+			if (x > axis->maxValue) x = axis->maxValue;
+			pos_t n = 0;
+			if (x < axis->defaultValue) {
+				n = (x - axis->defaultValue) / (axis->defaultValue - axis->minValue);
+			} else if (x > axis->defaultValue) {
+				n = (x - axis->defaultValue) / (axis->maxValue - axis->defaultValue);
+			}
+			n = otfcc_from_f2dot14(otfcc_to_f2dot14(n));
+			if (j < fvar->avar.length) n = mapThroughSegments(&fvar->avar.items[j], n);
+			coords.items[j] = otfcc_from_f2dot14(otfcc_to_f2dot14(n));
+		}
+		if (!found) {
+			logWarning("Axis '%c%c%c%c' is not in fvar, and ignored.\n", (v->tag >> 24) & 0xFF,
+			           (v->tag >> 16) & 0xFF, (v->tag >> 8) & 0xFF, v->tag & 0xFF);
+		}
+	}
+	return coords;
+}
+
+static INLINE void collapseVq(MODIFY VQ *v, const VV *coords) {
+	uint32_t n = vq_shiftLength(v);
+	if (!n) return;
+	pos_t x = v->kernel;
+	const vq_Segment *segments = vq_segments(v);
+	for (uint32_t j = 0; j < n; j++) {
+		const vq_Segment *s = &segments[j];
+		switch (s->type) {
+			case VQ_STILL:
+				x += s->val.still;
+				break;
+			case VQ_DELTA:
+				x += s->val.delta.quantity * vq_regionGetWeight(s->val.delta.region, coords);
+				break;
+		}
+	}
+	iVQ.replace(v, iVQ.createStill(x));
+}
+
+static void instantiateGlyph(MODIFY glyf_Glyph *g, const VV *coords) {
+	foreach (glyf_Contour *c, g->contours) {
+		foreach (glyf_Point *z, *c) {
+			collapseVq(&z->x, coords);
+			collapseVq(&z->y, coords);
+		}
+	}
+	foreach (glyf_ComponentReference *r, g->references) {
+		collapseVq(&r->x, coords);
+		collapseVq(&r->y, coords);
+	}
+	collapseVq(&g->horizontalOrigin, coords);
+	collapseVq(&g->advanceWidth, coords);
+	collapseVq(&g->verticalOrigin, coords);
+	collapseVq(&g->advanceHeight, coords);
+}
+
+// Every variable quantity of the font lives in its glyphs, so one walk over them fixes the font
+// at the location. fvar goes last, since its masters own the regions the deltas point to.
+void otfcc_instantiateFont(otfcc_Font *font, const otfcc_Location *location,
+                           const otfcc_Options *options) {
+	if (!font->fvar) {
+		logWarning("The font has no 'fvar' table and is not variable.\n");
+		return;
+	}
+	VV coords = normalizeLocation(font->fvar, location, options);
+	if (font->glyf) {
+		for (glyphid_t j = 0; j < font->glyf->length; j++) {
+			if (font->glyf->items[j]) instantiateGlyph(font->glyf->items[j], &coords);
+		}
+	}
+	iVV.dispose(&coords);
+	otfcc_iFont.deleteTable(font, 'fvar');
+}
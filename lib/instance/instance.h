@@ -0,0 +1,11 @@
+#ifndef CARYLL_INSTANCE_H
+#define CARYLL_INSTANCE_H
+
+#include "support/util.h"
+#include "otfcc/font.h"
+#include "otfcc/instance.h"
+
+void otfcc_instantiateFont(otfcc_Font *font, const otfcc_Location *location,
+                           const otfcc_Options *options);
+
+#endif
@@ -15,22 +15,15 @@ enum { ORD_GLYPHORDER = 1, ORD_NOTDEF = 2, ORD_CMAP = 3, ORD_GLYF = 4 };
 
 // Register a name->(orderType, orderEntry) map.
 static void setOrderByName(otfcc_GlyphOrder *go, sds name, uint8_t orderType, uint32_t orderEntry) {
-	otfcc_GlyphOrderEntry *s = NULL;
-	HASH_FIND(hhName, go->byName, name, sdslen(name), s);
-	if (!s) {
-		NEW(s);
-		s->gid = -1;
-		s->name = name;
-		s->orderType = orderType;
-		s->orderEntry = orderEntry;
-		HASH_ADD(hhName, go->byName, name[0], sdslen(s->name), s);
-	} else if (s->orderType > orderType) {
+	bool fresh = !GlyphOrder.lookupName(go, name);
+	otfcc_GlyphOrderEntry *s = GlyphOrder.placeByName(go, name);
+	if (fresh || s->orderType > orderType) {
 		s->orderType = orderType;
 		s->orderEntry = orderEntry;
 	}
 }
 
-static int _byOrder(otfcc_GlyphOrderEntry *a, otfcc_GlyphOrderEntry *b) {
+static int _byOrder(const otfcc_GlyphOrderEntry *a, const otfcc_GlyphOrderEntry *b) {
 	if (a->orderType < b->orderType) return (-1);
 	if (a->orderType > b->orderType) return (1);
 	if (a->orderEntry < b->orderEntry) return (-1);
@@ -40,20 +33,12 @@ static int _byOrder(otfcc_GlyphOrderEntry *a, otfcc_GlyphOrderEntry *b) {
 
 // Complete ClyphOrder
 static void orderGlyphs(otfcc_GlyphOrder *go) {
-	HASH_SRT(hhName, go->byName, _byOrder);
-	otfcc_GlyphOrderEntry *current, *temp;
-	glyphid_t gid = 0;
-	HASH_ITER(hhName, go->byName, current, temp) {
-		current->gid = gid;
-		HASH_ADD(hhID, go->byGID, gid, sizeof(glyphid_t), current);
-		gid += 1;
-	}
+	GlyphOrder.orderBy(go, _byOrder);
 }
 
 static void escalateGlyphOrderByName(otfcc_GlyphOrder *go, sds name, uint8_t orderType,
                                      uint32_t orderEntry) {
-	otfcc_GlyphOrderEntry *s = NULL;
-	HASH_FIND(hhName, go->byName, name, sdslen(name), s);
+	otfcc_GlyphOrderEntry *s = GlyphOrder.findByName(go, name, sdslen(name));
 	if (s && s->orderType > orderType) {
 		s->orderType = orderType;
 		s->orderEntry = orderEntry;
@@ -129,53 +114,87 @@ static otfcc_GlyphOrder *parseGlyphOrder(const json_value *root, const otfcc_Opt
 	return go;
 }
 
+#define WANTS(name) otfcc_Options_wantsTable(options, name)
+
 static otfcc_Font *readJson(void *_root, uint32_t index, const otfcc_Options *options) {
 	const json_value *root = (json_value *)_root;
 	otfcc_Font *font = otfcc_iFont.create();
 	if (!font) return NULL;
 	font->subtype = otfcc_decideFontSubtypeFromJson(root);
 	font->glyph_order = parseGlyphOrder(root, options);
-	font->glyf = otfcc_parseGlyf(root, font->glyph_order, options);
-	font->CFF_ = otfcc_parseCFF(root, options);
-	font->head = otfcc_parseHead(root, options);
-	font->hhea = otfcc_parseHhea(root, options);
-	font->OS_2 = otfcc_parseOS_2(root, options);
-	font->maxp = otfcc_parseMaxp(root, options);
-	font->post = otfcc_parsePost(root, options);
-	font->name = otfcc_parseName(root, options);
-	font->meta = otfcc_parseMeta(root, options);
-	font->cmap = otfcc_parseCmap(root, options);
+	// The metrics live in the glyphs, so hmtx and vmtx are read from glyf as well.
+	if (WANTS("glyf") || WANTS("hmtx") || WANTS("vmtx")) {
+		accountedAs(OTFCC_MEM_GLYF) {
+			font->glyf = otfcc_parseGlyf(root, font->glyph_order, options);
+		}
+	}
+	if (WANTS("CFF_")) {
+		accountedAs(OTFCC_MEM_CFF) {
+			font->CFF_ = otfcc_parseCFF(root, options);
+		}
+	}
+	if (WANTS("head")) font->head = otfcc_parseHead(root, options);
+	if (WANTS("hhea")) font->hhea = otfcc_parseHhea(root, options);
+	if (WANTS("OS_2")) font->OS_2 = otfcc_parseOS_2(root, options);
+	if (WANTS("maxp")) font->maxp = otfcc_parseMaxp(root, options);
+	if (WANTS("post")) font->post = otfcc_parsePost(root, options);
+	if (WANTS("name")) font->name = otfcc_parseName(root, options);
+	if (WANTS("meta")) font->meta = otfcc_parseMeta(root, options);
+	if (WANTS("cmap")) font->cmap = otfcc_parseCmap(root, options);
 	if (!options->ignore_hints) {
-		font->fpgm = otfcc_parseFpgmPrep(root, options, "fpgm");
-		font->prep = otfcc_parseFpgmPrep(root, options, "prep");
-		font->cvt_ = otfcc_parseCvt(root, options, "cvt_");
-		font->gasp = otfcc_parseGasp(root, options);
+		if (WANTS("fpgm")) font->fpgm = otfcc_parseFpgmPrep(root, options, "fpgm");
+		if (WANTS("prep")) font->prep = otfcc_parseFpgmPrep(root, options, "prep");
+		if (WANTS("cvt_")) font->cvt_ = otfcc_parseCvt(root, options, "cvt_");
+		if (WANTS("gasp")) font->gasp = otfcc_parseGasp(root, options);
 	}
-	font->VDMX = otfcc_parseVDMX(root, options);
-	font->vhea = otfcc_parseVhea(root, options);
+	if (WANTS("VDMX")) font->VDMX = otfcc_parseVDMX(root, options);
+	if (WANTS("vhea")) font->vhea = otfcc_parseVhea(root, options);
 	if (font->glyf) {
-		font->GSUB = otfcc_parseOtl(root, options, "GSUB");
-		font->GPOS = otfcc_parseOtl(root, options, "GPOS");
-		font->GDEF = otfcc_parseGDEF(root, options);
+		accountedAs(OTFCC_MEM_OTL) {
+			if (WANTS("GSUB")) font->GSUB = otfcc_parseOtl(root, options, "GSUB");
+			if (WANTS("GPOS")) font->GPOS = otfcc_parseOtl(root, options, "GPOS");
+			if (WANTS("GDEF")) font->GDEF = otfcc_parseGDEF(root, options);
+		}
 	}
-	font->BASE = otfcc_parseBASE(root, options);
-	font->CPAL = otfcc_parseCPAL(root, options);
-	font->COLR = otfcc_parseCOLR(root, options);
-	font->SVG_ = otfcc_parseSVG(root, options);
+	if (WANTS("BASE")) font->BASE = otfcc_parseBASE(root, options);
+	if (WANTS("CPAL")) font->CPAL = otfcc_parseCPAL(root, options);
+	if (WANTS("COLR")) font->COLR = otfcc_parseCOLR(root, options);
+	if (WANTS("SVG_")) font->SVG_ = otfcc_parseSVG(root, options);
 
-	font->TSI_01 = otfcc_parseTSI(root, options, "TSI_01");
-	font->TSI_23 = otfcc_parseTSI(root, options, "TSI_23");
-	font->TSI5 = otfcc_parseTSI5(root, options);
+	if (WANTS("TSI_01")) font->TSI_01 = otfcc_parseTSI(root, options, "TSI_01");
+	if (WANTS("TSI_23")) font->TSI_23 = otfcc_parseTSI(root, options, "TSI_23");
+	if (WANTS("TSI5")) font->TSI5 = otfcc_parseTSI5(root, options);
 
 	return font;
 }
+// The font is read with the allocator of the options, and keeps it. With font_region, the
+// font is read into a region of its own, carved from that allocator. The DOM stays with the
+// allocator of the options.
+static otfcc_Font *readJsonWithAllocator(void *root, uint32_t index, const otfcc_Options *options) {
+	const otfcc_IAllocator *previous = __caryll_enterAllocator(options->allocator);
+	const otfcc_IAllocator *previousJson = otfcc_useJsonAllocator(otfcc_currentAllocator());
+	otfcc_Region *region = NULL;
+	if (options->font_region) {
+		region = otfcc_newRegion();
+		otfcc_useAllocator(otfcc_regionAllocator(region));
+	}
+	otfcc_Font *font = readJson(root, index, options);
+	otfcc_useJsonAllocator(previousJson);
+	otfcc_useAllocator(previous);
+	if (font) {
+		font->region = region;
+	} else {
+		otfcc_deleteRegion(region);
+	}
+	return font;
+}
 static INLINE void freeReader(otfcc_IFontBuilder *self) {
-	free(self);
+	FREE(self);
 }
 otfcc_IFontBuilder *otfcc_newJsonReader() {
 	otfcc_IFontBuilder *reader;
 	NEW(reader);
-	reader->read = readJson;
+	reader->read = readJsonWithAllocator;
 	reader->free = freeReader;
 	return reader;
 }
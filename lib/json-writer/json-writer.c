@@ -2,55 +2,72 @@
 #include "otfcc/font.h"
 #include "table/all.h"
 
+#define WANTS(name) otfcc_Options_wantsTable(options, name)
+
 static void *serializeToJson(otfcc_Font *font, const otfcc_Options *options) {
 	json_value *root = json_object_new(48);
 	if (!root) return NULL;
-	otfcc_dumpFvar(font->fvar, root, options);
-	otfcc_dumpHead(font->head, root, options);
-	otfcc_dumpHhea(font->hhea, root, options);
-	otfcc_dumpMaxp(font->maxp, root, options);
-	otfcc_dumpVhea(font->vhea, root, options);
-	otfcc_dumpPost(font->post, root, options);
-	otfcc_dumpOS_2(font->OS_2, root, options);
-	otfcc_dumpName(font->name, root, options);
-	otfcc_dumpMeta(font->meta, root, options);
-	otfcc_dumpCmap(font->cmap, root, options);
-	otfcc_dumpCFF(font->CFF_, root, options);
+	if (WANTS("fvar")) otfcc_dumpFvar(font->fvar, root, options);
+	if (WANTS("head")) otfcc_dumpHead(font->head, root, options);
+	if (WANTS("hhea")) otfcc_dumpHhea(font->hhea, root, options);
+	if (WANTS("maxp")) otfcc_dumpMaxp(font->maxp, root, options);
+	if (WANTS("vhea")) otfcc_dumpVhea(font->vhea, root, options);
+	if (WANTS("post")) otfcc_dumpPost(font->post, root, options);
+	if (WANTS("OS_2")) otfcc_dumpOS_2(font->OS_2, root, options);
+	if (WANTS("name")) otfcc_dumpName(font->name, root, options);
+	if (WANTS("meta")) otfcc_dumpMeta(font->meta, root, options);
+	if (WANTS("cmap")) otfcc_dumpCmap(font->cmap, root, options);
+	if (WANTS("CFF_")) otfcc_dumpCFF(font->CFF_, root, options);
 
-	GlyfIOContext ctx = {.locaIsLong = font->head->indexToLocFormat,
-	                     .numGlyphs = font->maxp->numGlyphs,
-	                     .nPhantomPoints = 4,
-	                     .hasVerticalMetrics = !!(font->vhea),
-	                     .exportFDSelect = font->CFF_ && font->CFF_->isCID,
-	                     .fvar = font->fvar};
-	otfcc_dumpGlyf(font->glyf, root, options, &ctx);
+	if (WANTS("glyf") || WANTS("hmtx") || WANTS("vmtx")) {
+		GlyfIOContext ctx = {.locaIsLong = font->head->indexToLocFormat,
+		                     .numGlyphs = font->maxp->numGlyphs,
+		                     .nPhantomPoints = 4,
+		                     .hasVerticalMetrics = font->vhea && WANTS("vmtx"),
+		                     .exportOutlines = WANTS("glyf"),
+		                     .exportHorizontalMetrics = WANTS("hmtx"),
+		                     .exportFDSelect = font->CFF_ && font->CFF_->isCID,
+		                     .fvar = font->fvar};
+		otfcc_dumpGlyf(font->glyf, root, options, &ctx);
+	}
 	if (!options->ignore_hints) {
-		table_dumpTableFpgmPrep(font->fpgm, root, options, "fpgm");
-		table_dumpTableFpgmPrep(font->prep, root, options, "prep");
-		otfcc_dumpCvt(font->cvt_, root, options, "cvt_");
-		otfcc_dumpGasp(font->gasp, root, options);
+		if (WANTS("fpgm")) table_dumpTableFpgmPrep(font->fpgm, root, options, "fpgm");
+		if (WANTS("prep")) table_dumpTableFpgmPrep(font->prep, root, options, "prep");
+		if (WANTS("cvt_")) otfcc_dumpCvt(font->cvt_, root, options, "cvt_");
+		if (WANTS("gasp")) otfcc_dumpGasp(font->gasp, root, options);
 	}
-	otfcc_dumpVDMX(font->VDMX, root, options);
-	otfcc_dumpOtl(font->GSUB, root, options, "GSUB");
-	otfcc_dumpOtl(font->GPOS, root, options, "GPOS");
-	otfcc_dumpGDEF(font->GDEF, root, options);
-	otfcc_dumpBASE(font->BASE, root, options);
+	if (WANTS("VDMX")) otfcc_dumpVDMX(font->VDMX, root, options);
+	if (WANTS("GSUB")) otfcc_dumpOtl(font->GSUB, root, options, "GSUB");
+	if (WANTS("GPOS")) otfcc_dumpOtl(font->GPOS, root, options, "GPOS");
+	if (WANTS("GDEF")) otfcc_dumpGDEF(font->GDEF, root, options);
+	if (WANTS("BASE")) otfcc_dumpBASE(font->BASE, root, options);
 
-	otfcc_dumpCPAL(font->CPAL, root, options);
-	otfcc_dumpCOLR(font->COLR, root, options);
-	otfcc_dumpSVG(font->SVG_, root, options);
-	otfcc_dumpTSI(font->TSI_01, root, options, "TSI_01");
-	otfcc_dumpTSI(font->TSI_23, root, options, "TSI_23");
-	otfcc_dumpTSI5(font->TSI5, root, options);
+	if (WANTS("CPAL")) otfcc_dumpCPAL(font->CPAL, root, options);
+	if (WANTS("COLR")) otfcc_dumpCOLR(font->COLR, root, options);
+	if (WANTS("SVG_")) otfcc_dumpSVG(font->SVG_, root, options);
+	if (WANTS("TSI_01")) otfcc_dumpTSI(font->TSI_01, root, options, "TSI_01");
+	if (WANTS("TSI_23")) otfcc_dumpTSI(font->TSI_23, root, options, "TSI_23");
+	if (WANTS("TSI5")) otfcc_dumpTSI5(font->TSI5, root, options);
+	return root;
+}
+// The DOM is returned in the allocator of the options, or of the caller; the rest follows the
+// allocator of the font.
+static void *serializeToJsonWithAllocator(otfcc_Font *font, const otfcc_Options *options) {
+	const otfcc_IAllocator *previousJson = otfcc_useJsonAllocator(
+	    options->allocator ? options->allocator : otfcc_currentAllocator());
+	const otfcc_IAllocator *previous = otfcc_useAllocator(font->allocator);
+	void *root = serializeToJson(font, options);
+	otfcc_useAllocator(previous);
+	otfcc_useJsonAllocator(previousJson);
 	return root;
 }
 static void freeJsonWriter(otfcc_IFontSerializer *self) {
-	free(self);
+	FREE(self);
 }
 otfcc_IFontSerializer *otfcc_newJsonWriter() {
 	otfcc_IFontSerializer *writer;
 	NEW(writer);
-	writer->serialize = serializeToJson;
+	writer->serialize = serializeToJsonWithAllocator;
 	writer->free = freeJsonWriter;
 	return writer;
 }
@@ -591,6 +591,7 @@ void cff_ilGraphToBuffers(cff_SubrGraph *g, caryll_Buffer **s, caryll_Buffer **g
 	cff_statHeight(g->root, 0);
 	uint32_t maxSubroutines = cff_numberSubroutines(g);
 	logProgress("[libcff] Total %d subroutines extracted.", maxSubroutines);
+	otfcc_traceCount("subroutines extracted", maxSubroutines);
 	uint32_t maxLSubrs = maxSubroutines;
 	uint32_t maxGSubrs = 0;
 	{
@@ -9,6 +9,8 @@ typedef struct Logger {
 	uint16_t levelCap;
 	sds *indents;
 	uint8_t verbosityLimit;
+	// The logger outlives the calls it logs, so it keeps the allocator which created it.
+	const otfcc_IAllocator *allocator;
 } Logger;
 
 const char *otfcc_LoggerTypeNames[3] = {"[ERROR]", "[WARNING]", "[NOTE]"};
@@ -20,8 +22,10 @@ static void loggerIndentSDS(otfcc_ILogger *_self, MOVE sds segment) {
 	Logger *self = (Logger *)_self;
 	uint8_t newLevel = self->level + 1;
 	if (newLevel > self->levelCap) {
+		const otfcc_IAllocator *previous = otfcc_useAllocator(self->allocator);
 		self->levelCap += self->levelCap / 2 + 1;
 		RESIZE(self->indents, self->levelCap);
+		otfcc_useAllocator(previous);
 	}
 	self->level++;
 	self->indents[self->level - 1] = segment;
@@ -94,6 +98,7 @@ static void loggerSetVerbosity(otfcc_ILogger *_self, uint8_t verbosity) {
 static INLINE void loggerDispose(otfcc_ILogger *_self) {
 	Logger *self = (Logger *)_self;
 	if (!self) return;
+	const otfcc_IAllocator *previous = otfcc_useAllocator(self->allocator);
 	otfcc_ILoggerTarget *target = _self->getTarget(_self);
 	target->dispose(target);
 	for (uint16_t level = 0; level < self->level; level++) {
@@ -101,6 +106,7 @@ static INLINE void loggerDispose(otfcc_ILogger *_self) {
 	}
 	FREE(self->indents);
 	FREE(self);
+	otfcc_useAllocator(previous);
 }
 
 const otfcc_ILogger VTABLE_LOGGER = {.dispose = loggerDispose,
@@ -120,6 +126,7 @@ otfcc_ILogger *otfcc_newLogger(otfcc_ILoggerTarget *target) {
 	NEW(logger);
 	logger->target = target;
 	logger->vtable = VTABLE_LOGGER;
+	logger->allocator = otfcc_currentAllocator();
 	return (otfcc_ILogger *)logger;
 }
 
@@ -0,0 +1,203 @@
+#include "support/util.h"
+#include "otfcc/tracer.h"
+
+#include "support/threads.h"
+#ifdef __MACH__
+#include <mach/mach_time.h>
+#endif
+
+#define TRACE_MAX_DEPTH 32
+#define TRACE_MAX_COUNTERS 8
+
+typedef struct {
+	const char *key;
+	int64_t value;
+} TraceCounter;
+
+typedef struct {
+	char phase; // 'B' or 'E'
+	uint32_t tid;
+	int64_t ts; // nanoseconds since the tracer was created
+	sds name;   // begin events only
+	uint8_t nCounters;
+	TraceCounter counters[TRACE_MAX_COUNTERS];
+} TraceEvent;
+
+struct otfcc_Tracer {
+	otfcc_Mutex mutex;
+	int64_t start;
+	uint32_t nThreads;
+	size_t length;
+	size_t capacity;
+	TraceEvent *events;
+	// The tracer outlives the calls it traces, so it keeps the allocator which created it.
+	const otfcc_IAllocator *allocator;
+};
+
+// What a thread knows about its own open spans. Counters are gathered here without locking
+// and only copied into the tracer when the span closes.
+typedef struct {
+	uint8_t nCounters;
+	TraceCounter counters[TRACE_MAX_COUNTERS];
+} TraceFrame;
+
+typedef struct {
+	const otfcc_Tracer *tracer;
+	uint32_t tid;
+	uint32_t depth;
+	TraceFrame frames[TRACE_MAX_DEPTH];
+} TraceThread;
+
+static THREAD_LOCAL TraceThread currentThread;
+
+static int64_t nowNanoseconds() {
+#ifdef _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (int64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined(__MACH__)
+	mach_timebase_info_data_t tb;
+	mach_timebase_info(&tb);
+	return (int64_t)(mach_absolute_time() * tb.numer / tb.denom);
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+otfcc_Tracer *otfcc_newTracer() {
+	otfcc_Tracer *tracer;
+	NEW(tracer);
+	otfcc_initMutex(&tracer->mutex);
+	tracer->start = nowNanoseconds();
+	tracer->allocator = otfcc_currentAllocator();
+	return tracer;
+}
+void otfcc_deleteTracer(MOVE otfcc_Tracer *tracer) {
+	if (!tracer) return;
+	const otfcc_IAllocator *previous = otfcc_useAllocator(tracer->allocator);
+	for (size_t j = 0; j < tracer->length; j++) {
+		sdsfree(tracer->events[j].name);
+	}
+	FREE(tracer->events);
+	otfcc_destroyMutex(&tracer->mutex);
+	FREE(tracer);
+	otfcc_useAllocator(previous);
+}
+
+static TraceThread *enterThread(otfcc_Tracer *tracer) {
+	TraceThread *thread = &currentThread;
+	if (thread->tracer != tracer) {
+		otfcc_lock(&tracer->mutex);
+		thread->tid = ++tracer->nThreads;
+		otfcc_unlock(&tracer->mutex);
+		thread->tracer = tracer;
+		thread->depth = 0;
+	}
+	return thread;
+}
+
+static void pushEvent(otfcc_Tracer *tracer, const TraceEvent *event) {
+	otfcc_lock(&tracer->mutex);
+	if (tracer->length >= tracer->capacity) {
+		const otfcc_IAllocator *previous = otfcc_useAllocator(tracer->allocator);
+		tracer->capacity += tracer->capacity / 2 + 0x100;
+		RESIZE(tracer->events, tracer->capacity);
+		otfcc_useAllocator(previous);
+	}
+	tracer->events[tracer->length++] = *event;
+	otfcc_unlock(&tracer->mutex);
+}
+
+void otfcc_traceBegin(otfcc_Tracer *tracer, MOVE sds name) {
+	if (!tracer) {
+		sdsfree(name);
+		return;
+	}
+	if (tracer->allocator != otfcc_currentAllocator()) {
+		const otfcc_IAllocator *previous = otfcc_useAllocator(tracer->allocator);
+		sds kept = sdsdup(name);
+		otfcc_useAllocator(previous);
+		sdsfree(name);
+		name = kept;
+	}
+	TraceThread *thread = enterThread(tracer);
+	if (thread->depth < TRACE_MAX_DEPTH) thread->frames[thread->depth].nCounters = 0;
+	thread->depth += 1;
+	TraceEvent event = {.phase = 'B', .tid = thread->tid, .name = name};
+	event.ts = nowNanoseconds() - tracer->start;
+	pushEvent(tracer, &event);
+}
+
+void otfcc_traceEnd(otfcc_Tracer *tracer) {
+	if (!tracer) return;
+	TraceThread *thread = enterThread(tracer);
+	if (!thread->depth) return;
+	thread->depth -= 1;
+	TraceEvent event = {.phase = 'E', .tid = thread->tid};
+	event.ts = nowNanoseconds() - tracer->start;
+	if (thread->depth < TRACE_MAX_DEPTH) {
+		const TraceFrame *frame = &thread->frames[thread->depth];
+		event.nCounters = frame->nCounters;
+		memcpy(event.counters, frame->counters, frame->nCounters * sizeof(TraceCounter));
+	}
+	pushEvent(tracer, &event);
+}
+
+void otfcc_traceCount(const char *key, int64_t n) {
+	TraceThread *thread = &currentThread;
+	if (!thread->tracer || !thread->depth || thread->depth > TRACE_MAX_DEPTH) return;
+	TraceFrame *frame = &thread->frames[thread->depth - 1];
+	for (uint8_t j = 0; j < frame->nCounters; j++) {
+		if (strcmp(frame->counters[j].key, key) == 0) {
+			frame->counters[j].value += n;
+			return;
+		}
+	}
+	if (frame->nCounters >= TRACE_MAX_COUNTERS) return;
+	frame->counters[frame->nCounters].key = key;
+	frame->counters[frame->nCounters].value = n;
+	frame->nCounters += 1;
+}
+
+bool otfcc_writeTrace(const otfcc_Tracer *tracer, FILE *file) {
+	if (!tracer || !file) return false;
+	json_value *events = json_array_new(tracer->length);
+	for (size_t j = 0; j < tracer->length; j++) {
+		const TraceEvent *event = &tracer->events[j];
+		json_value *e = json_object_new(6);
+		if (event->name) {
+			json_object_push(e, "name",
+			                 json_string_new_length((uint32_t)sdslen(event->name), event->name));
+		}
+		json_object_push(e, "ph", json_string_new_length(1, &event->phase));
+		json_object_push(e, "ts", json_double_new(event->ts / 1e3));
+		json_object_push(e, "pid", json_integer_new(1));
+		json_object_push(e, "tid", json_integer_new(event->tid));
+		if (event->nCounters) {
+			json_value *args = json_object_new(event->nCounters);
+			for (uint8_t k = 0; k < event->nCounters; k++) {
+				json_object_push(args, event->counters[k].key,
+				                 json_integer_new(event->counters[k].value));
+			}
+			json_object_push(e, "args", args);
+		}
+		json_array_push(events, e);
+	}
+	json_value *root = json_object_new(2);
+	json_object_push(root, "traceEvents", events);
+	json_object_push(root, "displayTimeUnit", json_string_new("ms"));
+
+	json_serialize_opts opts = {.mode = json_serialize_mode_packed, .opts = 0, .indent_size = 0};
+	size_t length = json_measure_ex(root, opts);
+	char *buf;
+	NEW(buf, length);
+	json_serialize_ex(buf, root, opts);
+	json_builder_free(root);
+	size_t written = strlen(buf);
+	bool ok = fwrite(buf, 1, written, file) == written;
+	FREE(buf);
+	return ok;
+}
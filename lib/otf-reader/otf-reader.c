@@ -12,6 +12,17 @@ static otfcc_font_subtype decideFontSubtypeOTF(otfcc_SplineFontContainer *sfnt,
 	return FONTTYPE_TTF;
 }
 
+// Glyphs without outlines, standing in for glyf when only the glyph names are needed.
+static table_glyf *readGlyphStubs(glyphid_t numGlyphs) {
+	table_glyf *glyf = table_iGlyf.create();
+	for (glyphid_t j = 0; j < numGlyphs; j++) {
+		table_iGlyf.push(glyf, otfcc_newGlyf_glyph());
+	}
+	return glyf;
+}
+
+#define WANTS(name) otfcc_Options_wantsTable(options, name)
+
 static otfcc_Font *readOtf(void *_sfnt, uint32_t index, const otfcc_Options *options) {
 	otfcc_SplineFontContainer *sfnt = (otfcc_SplineFontContainer *)_sfnt;
 	if (sfnt->count - 1 < index) {
@@ -20,70 +31,188 @@ static otfcc_Font *readOtf(void *_sfnt, uint32_t index, const otfcc_Options *opt
 		otfcc_Font *font = otfcc_iFont.create();
 		otfcc_Packet packet = sfnt->packets[index];
 		font->subtype = decideFontSubtypeOTF(sfnt, index);
-		font->fvar = otfcc_readFvar(packet, options);
-		font->head = otfcc_readHead(packet, options);
-		font->maxp = otfcc_readMaxp(packet, options);
-		font->name = otfcc_readName(packet, options);
-		font->meta = otfcc_readMeta(packet, options);
-		font->OS_2 = otfcc_readOS_2(packet, options);
-		font->post = otfcc_readPost(packet, options);
-		font->hhea = otfcc_readHhea(packet, options);
-		font->cmap = otfcc_readCmap(packet, options);
+
+		// Tables left out by the filters are not decoded, except when a wanted one depends on
+		// them: glyph names come from post, cmap and, in CFF fonts, the charset, and metrics
+		// are merged into glyf, whose bounding boxes are enough for them. head and maxp are
+		// always read.
+		bool wantsHmtx = WANTS("hmtx");
+		bool wantsVmtx = WANTS("vmtx");
+		bool needsNames = WANTS("glyf") || WANTS("CFF_") || WANTS("cmap") || WANTS("GSUB") ||
+		                  WANTS("GPOS") || WANTS("GDEF") || WANTS("COLR") || WANTS("TSI_01") ||
+		                  WANTS("TSI_23") || WANTS("TSI5") || wantsHmtx || wantsVmtx;
+		bool needsOutlines =
+		    WANTS("glyf") || WANTS("CFF_") || (font->subtype == FONTTYPE_CFF && needsNames);
+
+		if (needsOutlines || wantsHmtx || wantsVmtx || WANTS("fvar")) {
+			tracedStep("read fvar") { font->fvar = otfcc_readFvar(packet, options); }
+		}
+		tracedStep("read head") { font->head = otfcc_readHead(packet, options); }
+		tracedStep("read maxp") { font->maxp = otfcc_readMaxp(packet, options); }
+		if (WANTS("name")) {
+			tracedStep("read name") { font->name = otfcc_readName(packet, options); }
+		}
+		if (WANTS("meta")) {
+			tracedStep("read meta") { font->meta = otfcc_readMeta(packet, options); }
+		}
+		if (WANTS("OS_2")) {
+			tracedStep("read OS_2") { font->OS_2 = otfcc_readOS_2(packet, options); }
+		}
+		if (needsNames || WANTS("post")) {
+			tracedStep("read post") { font->post = otfcc_readPost(packet, options); }
+		}
+		if (needsOutlines || wantsHmtx || WANTS("hhea")) {
+			tracedStep("read hhea") { font->hhea = otfcc_readHhea(packet, options); }
+		}
+		if (needsNames) {
+			tracedStep("read cmap") { font->cmap = otfcc_readCmap(packet, options); }
+		}
 		if (font->subtype == FONTTYPE_TTF) {
-			font->hmtx = otfcc_readHmtx(packet, options, font->hhea, font->maxp);
-			font->vhea = otfcc_readVhea(packet, options);
-			if (font->vhea) font->vmtx = otfcc_readVmtx(packet, options, font->vhea, font->maxp);
-			font->fpgm = otfcc_readFpgmPrep(packet, options, 'fpgm');
-			font->prep = otfcc_readFpgmPrep(packet, options, 'prep');
-			font->cvt_ = otfcc_readCvt(packet, options, 'cvt ');
-			font->gasp = otfcc_readGasp(packet, options);
-			font->VDMX = otfcc_readVDMX(packet, options);
-			font->LTSH = otfcc_readLTSH(packet, options);
+			if (needsOutlines || wantsVmtx || WANTS("vhea")) {
+				tracedStep("read vhea") { font->vhea = otfcc_readVhea(packet, options); }
+			}
+			if (wantsVmtx && font->vhea) {
+				tracedStep("read vmtx") {
+					font->vmtx = otfcc_readVmtx(packet, options, font->vhea, font->maxp);
+				}
+			}
+			if (WANTS("fpgm")) {
+				tracedStep("read fpgm") {
+					font->fpgm = otfcc_readFpgmPrep(packet, options, 'fpgm');
+				}
+			}
+			if (WANTS("prep")) {
+				tracedStep("read prep") {
+					font->prep = otfcc_readFpgmPrep(packet, options, 'prep');
+				}
+			}
+			if (WANTS("cvt_")) {
+				tracedStep("read cvt") { font->cvt_ = otfcc_readCvt(packet, options, 'cvt '); }
+			}
+			if (WANTS("gasp")) {
+				tracedStep("read gasp") { font->gasp = otfcc_readGasp(packet, options); }
+			}
+			if (WANTS("VDMX")) {
+				tracedStep("read VDMX") { font->VDMX = otfcc_readVDMX(packet, options); }
+			}
+			if (needsOutlines) {
+				tracedStep("read LTSH") { font->LTSH = otfcc_readLTSH(packet, options); }
+			}
 
-			GlyfIOContext ctx = {.locaIsLong = font->head->indexToLocFormat,
-			                     .numGlyphs = font->maxp->numGlyphs,
-			                     .nPhantomPoints = 4, // Since MS rasterizer v1.7,
-			                                          // it would always add 4 phantom points
-			                     .fvar = font->fvar};
-			font->glyf = otfcc_readGlyf(packet, options, &ctx);
-		} else {
-			table_CFFAndGlyf cffpr = otfcc_readCFFAndGlyfTables(packet, options, font->head);
-			font->CFF_ = cffpr.meta;
-			font->glyf = cffpr.glyphs;
-			font->vhea = otfcc_readVhea(packet, options);
-			if (font->vhea) {
-				font->vmtx = otfcc_readVmtx(packet, options, font->vhea, font->maxp);
-				font->VORG = otfcc_readVORG(packet, options);
+			// The metrics merged into the glyphs need their bounding boxes, which the glyph
+			// headers carry; a variable font is read whole, for the deltas of the phantom points.
+			if (needsOutlines || wantsHmtx || wantsVmtx) {
+				GlyfIOContext ctx = {.locaIsLong = font->head->indexToLocFormat,
+				                     .numGlyphs = font->maxp->numGlyphs,
+				                     .nPhantomPoints = 4, // Since MS rasterizer v1.7,
+				                                          // it would always add 4 phantom points
+				                     .boxesOnly = !needsOutlines && !font->fvar,
+				                     .fvar = font->fvar};
+				tracedStep("read glyf") accountedAs(OTFCC_MEM_GLYF) {
+					font->glyf = otfcc_readGlyf(packet, options, &ctx);
+				}
+			} else if (needsNames && font->maxp) {
+				font->glyf = readGlyphStubs(font->maxp->numGlyphs);
+			}
+			// hmtx follows glyf, whose bounding boxes its WOFF2 transform leaves out.
+			if (wantsHmtx && font->glyf) {
+				tracedStep("read hmtx") {
+					font->hmtx =
+					    otfcc_readHmtx(packet, options, font->hhea, font->maxp, font->glyf);
+				}
+			}
+		} else if (needsOutlines) {
+			tracedStep("read CFF") accountedAs(OTFCC_MEM_CFF) {
+				table_CFFAndGlyf cffpr = otfcc_readCFFAndGlyfTables(packet, options, font->head);
+				font->CFF_ = cffpr.meta;
+				font->glyf = cffpr.glyphs;
 			}
+			tracedStep("read vhea") { font->vhea = otfcc_readVhea(packet, options); }
+			if (wantsVmtx && font->vhea) {
+				tracedStep("read vmtx") {
+					font->vmtx = otfcc_readVmtx(packet, options, font->vhea, font->maxp);
+				}
+				tracedStep("read VORG") { font->VORG = otfcc_readVORG(packet, options); }
+			}
+		} else if (wantsVmtx || WANTS("vhea")) {
+			tracedStep("read vhea") { font->vhea = otfcc_readVhea(packet, options); }
 		}
 		if (font->glyf) {
-			font->GSUB = otfcc_readOtl(packet, options, 'GSUB', font->glyf->length);
-			font->GPOS = otfcc_readOtl(packet, options, 'GPOS', font->glyf->length);
-			font->GDEF = otfcc_readGDEF(packet, options);
+			if (WANTS("GSUB")) {
+				tracedStep("read GSUB") accountedAs(OTFCC_MEM_OTL) {
+					font->GSUB = otfcc_readOtl(packet, options, 'GSUB', font->glyf->length);
+				}
+			}
+			if (WANTS("GPOS")) {
+				tracedStep("read GPOS") accountedAs(OTFCC_MEM_OTL) {
+					font->GPOS = otfcc_readOtl(packet, options, 'GPOS', font->glyf->length);
+				}
+			}
+			if (WANTS("GDEF")) {
+				tracedStep("read GDEF") accountedAs(OTFCC_MEM_OTL) {
+					font->GDEF = otfcc_readGDEF(packet, options);
+				}
+			}
+		}
+		if (WANTS("BASE")) {
+			tracedStep("read BASE") { font->BASE = otfcc_readBASE(packet, options); }
 		}
-		font->BASE = otfcc_readBASE(packet, options);
 
 		// Color font
-		font->CPAL = otfcc_readCPAL(packet, options);
-		font->COLR = otfcc_readCOLR(packet, options);
-		font->SVG_ = otfcc_readSVG(packet, options);
+		if (WANTS("CPAL")) {
+			tracedStep("read CPAL") { font->CPAL = otfcc_readCPAL(packet, options); }
+		}
+		if (WANTS("COLR")) {
+			tracedStep("read COLR") { font->COLR = otfcc_readCOLR(packet, options); }
+		}
+		if (WANTS("SVG_")) {
+			tracedStep("read SVG") { font->SVG_ = otfcc_readSVG(packet, options); }
+		}
 
 		// VTT TSI entries
-		font->TSI_01 = otfcc_readTSI(packet, options, 'TSI0', 'TSI1');
-		font->TSI_23 = otfcc_readTSI(packet, options, 'TSI2', 'TSI3');
-		font->TSI5 = otfcc_readTSI5(packet, options);
+		if (WANTS("TSI_01")) {
+			tracedStep("read TSI_01") {
+				font->TSI_01 = otfcc_readTSI(packet, options, 'TSI0', 'TSI1');
+			}
+		}
+		if (WANTS("TSI_23")) {
+			tracedStep("read TSI_23") {
+				font->TSI_23 = otfcc_readTSI(packet, options, 'TSI2', 'TSI3');
+			}
+		}
+		if (WANTS("TSI5")) {
+			tracedStep("read TSI5") { font->TSI5 = otfcc_readTSI5(packet, options); }
+		}
 
-		otfcc_unconsolidateFont(font, options);
+		tracedStep("unconsolidate") { otfcc_unconsolidateFont(font, options); }
 		return font;
 	}
 }
+// The font is read with the allocator of the options, and keeps it. With font_region, the
+// font is read into a region of its own, carved from that allocator.
+static otfcc_Font *readOtfWithAllocator(void *sfnt, uint32_t index, const otfcc_Options *options) {
+	const otfcc_IAllocator *previous = __caryll_enterAllocator(options->allocator);
+	otfcc_Region *region = NULL;
+	if (options->font_region) {
+		region = otfcc_newRegion();
+		otfcc_useAllocator(otfcc_regionAllocator(region));
+	}
+	otfcc_Font *font = readOtf(sfnt, index, options);
+	otfcc_useAllocator(previous);
+	if (font) {
+		font->region = region;
+	} else {
+		otfcc_deleteRegion(region);
+	}
+	return font;
+}
 static INLINE void freeReader(otfcc_IFontBuilder *self) {
-	free(self);
+	FREE(self);
 }
 otfcc_IFontBuilder *otfcc_newOTFReader() {
 	otfcc_IFontBuilder *reader;
 	NEW(reader);
-	reader->read = readOtf;
+	reader->read = readOtfWithAllocator;
 	reader->free = freeReader;
 	return reader;
 }
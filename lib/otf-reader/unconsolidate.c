@@ -7,7 +7,7 @@ typedef struct {
 	uint8_t hash[SHA1_BLOCK_SIZE];
 } GlyphHash;
 static void hashVQS(caryll_Buffer *buf, vq_Segment s) {
-	bufwrite8(buf, s.type);
+	bufwrite8(buf, s.type - VQ_STILL); // from 0, keeping the names of earlier versions
 	switch (s.type) {
 		case VQ_STILL:
 			bufwrite32b(buf, otfcc_to_fixed(s.val.still));
@@ -26,9 +26,11 @@ static void hashVQS(caryll_Buffer *buf, vq_Segment s) {
 
 static void hashVQ(caryll_Buffer *buf, VQ x) {
 	bufwrite32b(buf, otfcc_to_fixed(x.kernel));
-	bufwrite32b(buf, (uint32_t)x.shift.length);
-	for (size_t j = 0; j < x.shift.length; j++) {
-		hashVQS(buf, x.shift.items[j]);
+	uint32_t n = vq_shiftLength(&x);
+	bufwrite32b(buf, n);
+	const vq_Segment *segments = vq_segments(&x);
+	for (uint32_t j = 0; j < n; j++) {
+		hashVQS(buf, segments[j]);
 	}
 }
 
@@ -195,8 +197,9 @@ static otfcc_GlyphOrder *createGlyphOrder(otfcc_Font *font, const otfcc_Options
 	// pass 2: Map to `post` names
 	if (font->post != NULL && font->post->post_name_map != NULL && !options->ignore_glyph_order &&
 	    !options->name_glyphs_by_gid) {
-		otfcc_GlyphOrderEntry *s, *tmp;
-		HASH_ITER(hhID, font->post->post_name_map->byGID, s, tmp) {
+		otfcc_GlyphOrder *postNames = font->post->post_name_map;
+		for (uint32_t j = 0; j < postNames->length; j++) {
+			otfcc_GlyphOrderEntry *s = postNames->entries[j];
 			sds gname = sdscatprintf(sdsempty(), "%s%s", prefix, s->name);
 			GlyphOrder.setByGID(glyph_order, s->gid, gname);
 		}
@@ -204,24 +207,20 @@ static otfcc_GlyphOrder *createGlyphOrder(otfcc_Font *font, const otfcc_Options
 
 	// pass 3: Map to AGLFN & Unicode
 	if (font->cmap && !options->name_glyphs_by_gid) {
-		otfcc_GlyphOrder *aglfn = GlyphOrder.create();
-		aglfn_setupNames(aglfn);
-
-		cmap_Entry *s;
-		foreach_hash(s, font->cmap->unicodes) if (s->glyph.index > 0) {
-			sds name = NULL;
-			if (s->unicode > 0 && s->unicode < 0xFFFF) {
-				GlyphOrder.nameAField_Shared(aglfn, s->unicode, &name);
-			}
-			if (name == NULL) {
-				name = sdscatprintf(sdsempty(), "%suni%04X", prefix, s->unicode);
+		int unicode = -1;
+		otfcc_GlyphHandle *glyph;
+		while ((glyph = table_iCmap.next(font->cmap, &unicode))) {
+			if (glyph->index == 0) continue;
+			const char *aglfnName = NULL;
+			if (unicode > 0 && unicode < 0xFFFF) aglfnName = aglfn_nameOf(unicode);
+			sds name;
+			if (aglfnName == NULL) {
+				name = sdscatprintf(sdsempty(), "%suni%04X", prefix, unicode);
 			} else {
-				name = sdscatprintf(sdsempty(), "%s%s", prefix, name);
+				name = sdscatprintf(sdsempty(), "%s%s", prefix, aglfnName);
 			}
-			GlyphOrder.setByGID(glyph_order, s->glyph.index, name);
+			GlyphOrder.setByGID(glyph_order, glyph->index, name);
 		}
-
-		GlyphOrder.free(aglfn);
 	}
 
 	// pass 4 : Map to GID
@@ -396,4 +395,7 @@ void otfcc_unconsolidateFont(otfcc_Font *font, const otfcc_Options *options) {
 		nameGlyphs(font, gord);
 		GlyphOrder.free(gord);
 	}
+	// Drop the tables read only to name glyphs
+	if (!otfcc_Options_wantsTable(options, "cmap")) otfcc_iFont.deleteTable(font, 'cmap');
+	if (!otfcc_Options_wantsTable(options, "post")) otfcc_iFont.deleteTable(font, 'post');
 }
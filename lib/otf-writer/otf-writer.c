@@ -4,79 +4,151 @@
 #include "otfcc/sfnt-builder.h"
 #include "stat.h"
 
-static void *serializeToOTF(otfcc_Font *font, const otfcc_Options *options) {
+#define WANTS(name) otfcc_Options_wantsTable(options, name)
+
+typedef struct {
+	caryll_Buffer *(*serialize)(otfcc_SFNTBuilder *builder);
+	bool woff2Transforms; // push the WOFF2 transforms of glyf, loca and hmtx
+} SFNTContainer;
+
+static void *serializeToOTF(otfcc_Font *font, const otfcc_Options *options,
+                            const SFNTContainer *container) {
 	// do stat before serialize
-	otfcc_statFont(font, options);
+	tracedStep("stat") { otfcc_statFont(font, options); }
 
 	otfcc_SFNTBuilder *builder =
 	    otfcc_newSFNTBuilder(font->subtype == FONTTYPE_CFF ? 'OTTO' : 0x00010000, options);
 	// Outline data
 	if (font->subtype == FONTTYPE_TTF) {
-		table_GlyfAndLocaBuffers pair = otfcc_buildGlyf(font->glyf, font->head, options);
-		otfcc_SFNTBuilder_pushTable(builder, 'glyf', pair.glyf);
-		otfcc_SFNTBuilder_pushTable(builder, 'loca', pair.loca);
+		if (WANTS("glyf")) {
+			tracedStep("build glyf") accountedAs(OTFCC_MEM_GLYF) {
+				table_GlyfAndLocaBuffers pair = otfcc_buildGlyf(font->glyf, font->head, options);
+				otfcc_SFNTBuilder_pushTable(builder, 'glyf', pair.glyf);
+				otfcc_SFNTBuilder_pushTable(builder, 'loca', pair.loca);
+				if (container->woff2Transforms) {
+					otfcc_SFNTBuilder_pushTransform(
+					    builder, 'glyf', otfcc_buildGlyfWOFF2(font->glyf, font->head, options));
+					otfcc_SFNTBuilder_pushTransform(builder, 'loca', bufnew());
+				}
+			}
+		}
 	} else {
-		table_CFFAndGlyf r = {font->CFF_, font->glyf};
-		otfcc_SFNTBuilder_pushTable(builder, 'CFF ', otfcc_buildCFF(r, options));
+		tracedStep("build CFF") accountedAs(OTFCC_MEM_CFF) {
+			table_CFFAndGlyf r = {font->CFF_, font->glyf};
+			otfcc_SFNTBuilder_pushTable(builder, 'CFF ', otfcc_buildCFF(r, options));
+		}
 	}
 
-	otfcc_SFNTBuilder_pushTable(builder, 'head', otfcc_buildHead(font->head, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'hhea', otfcc_buildHhea(font->hhea, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'OS/2', otfcc_buildOS_2(font->OS_2, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'maxp', otfcc_buildMaxp(font->maxp, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'name', otfcc_buildName(font->name, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'meta', otfcc_buildMeta(font->meta, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'post',
-	                            otfcc_buildPost(font->post, font->glyph_order, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'cmap', otfcc_buildCmap(font->cmap, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'gasp', otfcc_buildGasp(font->gasp, options));
+	tracedStep("build head") {
+		otfcc_SFNTBuilder_pushTable(builder, 'head', otfcc_buildHead(font->head, options));
+	}
+	tracedStep("build hhea") {
+		otfcc_SFNTBuilder_pushTable(builder, 'hhea', otfcc_buildHhea(font->hhea, options));
+	}
+	tracedStep("build OS/2") {
+		otfcc_SFNTBuilder_pushTable(builder, 'OS/2', otfcc_buildOS_2(font->OS_2, options));
+	}
+	tracedStep("build maxp") {
+		otfcc_SFNTBuilder_pushTable(builder, 'maxp', otfcc_buildMaxp(font->maxp, options));
+	}
+	tracedStep("build name") {
+		otfcc_SFNTBuilder_pushTable(builder, 'name', otfcc_buildName(font->name, options));
+	}
+	tracedStep("build meta") {
+		otfcc_SFNTBuilder_pushTable(builder, 'meta', otfcc_buildMeta(font->meta, options));
+	}
+	tracedStep("build post") {
+		otfcc_SFNTBuilder_pushTable(builder, 'post',
+		                            otfcc_buildPost(font->post, font->glyph_order, options));
+	}
+	tracedStep("build cmap") {
+		otfcc_SFNTBuilder_pushTable(builder, 'cmap', otfcc_buildCmap(font->cmap, options));
+	}
+	tracedStep("build gasp") {
+		otfcc_SFNTBuilder_pushTable(builder, 'gasp', otfcc_buildGasp(font->gasp, options));
+	}
 
 	if (font->subtype == FONTTYPE_TTF) {
-		otfcc_SFNTBuilder_pushTable(builder, 'fpgm', otfcc_buildFpgmPrep(font->fpgm, options));
-		otfcc_SFNTBuilder_pushTable(builder, 'prep', otfcc_buildFpgmPrep(font->prep, options));
-		otfcc_SFNTBuilder_pushTable(builder, 'cvt ', otfcc_buildCvt(font->cvt_, options));
-		otfcc_SFNTBuilder_pushTable(builder, 'LTSH', otfcc_buildLTSH(font->LTSH, options));
-		otfcc_SFNTBuilder_pushTable(builder, 'VDMX', otfcc_buildVDMX(font->VDMX, options));
+		tracedStep("build instructions") {
+			otfcc_SFNTBuilder_pushTable(builder, 'fpgm', otfcc_buildFpgmPrep(font->fpgm, options));
+			otfcc_SFNTBuilder_pushTable(builder, 'prep', otfcc_buildFpgmPrep(font->prep, options));
+			otfcc_SFNTBuilder_pushTable(builder, 'cvt ', otfcc_buildCvt(font->cvt_, options));
+		}
+		tracedStep("build LTSH") {
+			otfcc_SFNTBuilder_pushTable(builder, 'LTSH', otfcc_buildLTSH(font->LTSH, options));
+		}
+		tracedStep("build VDMX") {
+			otfcc_SFNTBuilder_pushTable(builder, 'VDMX', otfcc_buildVDMX(font->VDMX, options));
+		}
 	}
 
-	if (font->hhea && font->maxp && font->hmtx) {
-		uint16_t hmtx_counta = font->hhea->numberOfMetrics;
-		uint16_t hmtx_countk = font->maxp->numGlyphs - font->hhea->numberOfMetrics;
-		otfcc_SFNTBuilder_pushTable(builder, 'hmtx',
-		                            otfcc_buildHmtx(font->hmtx, hmtx_counta, hmtx_countk, options));
+	if (font->hhea && font->maxp && font->hmtx && WANTS("hmtx")) {
+		tracedStep("build hmtx") {
+			uint16_t hmtx_counta = font->hhea->numberOfMetrics;
+			uint16_t hmtx_countk = font->maxp->numGlyphs - font->hhea->numberOfMetrics;
+			caryll_Buffer *buf = otfcc_buildHmtx(font->hmtx, hmtx_counta, hmtx_countk, options);
+			otfcc_SFNTBuilder_pushTable(builder, 'hmtx', buf);
+			if (container->woff2Transforms && font->subtype == FONTTYPE_TTF) {
+				otfcc_SFNTBuilder_pushTransform(
+				    builder, 'hmtx', otfcc_buildHmtxWOFF2(font->hmtx, hmtx_counta, hmtx_countk,
+				                                          font->glyf, options));
+			}
+		}
 	}
 
-	otfcc_SFNTBuilder_pushTable(builder, 'vhea', otfcc_buildVhea(font->vhea, options));
-	if (font->vhea && font->maxp && font->vmtx) {
-		uint16_t vmtx_counta = font->vhea->numOfLongVerMetrics;
-		uint16_t vmtx_countk = font->maxp->numGlyphs - font->vhea->numOfLongVerMetrics;
-		otfcc_SFNTBuilder_pushTable(builder, 'vmtx',
-		                            otfcc_buildVmtx(font->vmtx, vmtx_counta, vmtx_countk, options));
-	}
-	otfcc_SFNTBuilder_pushTable(builder, 'VORG', otfcc_buildVORG(font->VORG, options));
-
-	otfcc_SFNTBuilder_pushTable(builder, 'GSUB', otfcc_buildOtl(font->GSUB, options, "GSUB"));
-	otfcc_SFNTBuilder_pushTable(builder, 'GPOS', otfcc_buildOtl(font->GPOS, options, "GPOS"));
-	otfcc_SFNTBuilder_pushTable(builder, 'GDEF', otfcc_buildGDEF(font->GDEF, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'BASE', otfcc_buildBASE(font->BASE, options));
+	tracedStep("build vhea") {
+		otfcc_SFNTBuilder_pushTable(builder, 'vhea', otfcc_buildVhea(font->vhea, options));
+	}
+	if (font->vhea && font->maxp && font->vmtx && WANTS("vmtx")) {
+		tracedStep("build vmtx") {
+			uint16_t vmtx_counta = font->vhea->numOfLongVerMetrics;
+			uint16_t vmtx_countk = font->maxp->numGlyphs - font->vhea->numOfLongVerMetrics;
+			caryll_Buffer *buf = otfcc_buildVmtx(font->vmtx, vmtx_counta, vmtx_countk, options);
+			otfcc_SFNTBuilder_pushTable(builder, 'vmtx', buf);
+		}
+	}
+	tracedStep("build VORG") {
+		otfcc_SFNTBuilder_pushTable(builder, 'VORG', otfcc_buildVORG(font->VORG, options));
+	}
 
-	otfcc_SFNTBuilder_pushTable(builder, 'CPAL', otfcc_buildCPAL(font->CPAL, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'COLR', otfcc_buildCOLR(font->COLR, options));
-	otfcc_SFNTBuilder_pushTable(builder, 'SVG ', otfcc_buildSVG(font->SVG_, options));
+	tracedStep("build GSUB") accountedAs(OTFCC_MEM_OTL) {
+		otfcc_SFNTBuilder_pushTable(builder, 'GSUB', otfcc_buildOtl(font->GSUB, options, "GSUB"));
+	}
+	tracedStep("build GPOS") accountedAs(OTFCC_MEM_OTL) {
+		otfcc_SFNTBuilder_pushTable(builder, 'GPOS', otfcc_buildOtl(font->GPOS, options, "GPOS"));
+	}
+	tracedStep("build GDEF") accountedAs(OTFCC_MEM_OTL) {
+		otfcc_SFNTBuilder_pushTable(builder, 'GDEF', otfcc_buildGDEF(font->GDEF, options));
+	}
+	tracedStep("build BASE") {
+		otfcc_SFNTBuilder_pushTable(builder, 'BASE', otfcc_buildBASE(font->BASE, options));
+	}
 
-	{
-		tsi_BuildTarget target = otfcc_buildTSI(font->TSI_01, options);
-		otfcc_SFNTBuilder_pushTable(builder, 'TSI0', target.indexPart);
-		otfcc_SFNTBuilder_pushTable(builder, 'TSI1', target.textPart);
+	tracedStep("build CPAL") {
+		otfcc_SFNTBuilder_pushTable(builder, 'CPAL', otfcc_buildCPAL(font->CPAL, options));
 	}
-	{
-		tsi_BuildTarget target = otfcc_buildTSI(font->TSI_23, options);
-		otfcc_SFNTBuilder_pushTable(builder, 'TSI2', target.indexPart);
-		otfcc_SFNTBuilder_pushTable(builder, 'TSI3', target.textPart);
+	tracedStep("build COLR") {
+		otfcc_SFNTBuilder_pushTable(builder, 'COLR', otfcc_buildCOLR(font->COLR, options));
 	}
-	if (font->glyf) {
-		otfcc_SFNTBuilder_pushTable(builder, 'TSI5',
-		                            otfcc_buildTSI5(font->TSI5, options, font->glyf->length));
+	tracedStep("build SVG") {
+		otfcc_SFNTBuilder_pushTable(builder, 'SVG ', otfcc_buildSVG(font->SVG_, options));
+	}
+
+	tracedStep("build TSI") {
+		{
+			tsi_BuildTarget target = otfcc_buildTSI(font->TSI_01, options);
+			otfcc_SFNTBuilder_pushTable(builder, 'TSI0', target.indexPart);
+			otfcc_SFNTBuilder_pushTable(builder, 'TSI1', target.textPart);
+		}
+		{
+			tsi_BuildTarget target = otfcc_buildTSI(font->TSI_23, options);
+			otfcc_SFNTBuilder_pushTable(builder, 'TSI2', target.indexPart);
+			otfcc_SFNTBuilder_pushTable(builder, 'TSI3', target.textPart);
+		}
+		if (font->glyf) {
+			otfcc_SFNTBuilder_pushTable(builder, 'TSI5',
+			                            otfcc_buildTSI5(font->TSI5, options, font->glyf->length));
+		}
 	}
 
 	if (options->dummy_DSIG) {
@@ -87,18 +159,62 @@ static void *serializeToOTF(otfcc_Font *font, const otfcc_Options *options) {
 		otfcc_SFNTBuilder_pushTable(builder, 'DSIG', dsig);
 	}
 
-	caryll_Buffer *otf = otfcc_SFNTBuilder_serialize(builder);
+	caryll_Buffer *otf;
+	tracedStep("serialize") { otf = container->serialize(builder); }
 	otfcc_deleteSFNTBuilder(builder);
 	otfcc_unstatFont(font, options);
 	return otf;
 }
+// Serializing modifies the font on the way, so it runs with the allocator of the font. The
+// buffer is handed over in the allocator of the caller, since it may outlive a font region.
+static void *serializeWithAllocator(otfcc_Font *font, const otfcc_Options *options,
+                                    const SFNTContainer *container) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(font->allocator);
+	caryll_Buffer *otf = serializeToOTF(font, options, container);
+	otfcc_useAllocator(previous);
+	if (otf && font->allocator != previous) {
+		caryll_Buffer *copy = bufnew();
+		bufwrite_buf(copy, otf);
+		otfcc_useAllocator(font->allocator);
+		buffree(otf);
+		otfcc_useAllocator(previous);
+		otf = copy;
+	}
+	return otf;
+}
+static const SFNTContainer otfContainer = {otfcc_SFNTBuilder_serialize, false};
+static const SFNTContainer woffContainer = {otfcc_SFNTBuilder_serializeWOFF, false};
+static const SFNTContainer woff2Container = {otfcc_SFNTBuilder_serializeWOFF2, true};
+static void *serializeToOTFWithAllocator(otfcc_Font *font, const otfcc_Options *options) {
+	return serializeWithAllocator(font, options, &otfContainer);
+}
+static void *serializeToWOFFWithAllocator(otfcc_Font *font, const otfcc_Options *options) {
+	return serializeWithAllocator(font, options, &woffContainer);
+}
+static void *serializeToWOFF2WithAllocator(otfcc_Font *font, const otfcc_Options *options) {
+	return serializeWithAllocator(font, options, &woff2Container);
+}
 static void freeFontWriter(otfcc_IFontSerializer *self) {
-	free(self);
+	FREE(self);
 }
 otfcc_IFontSerializer *otfcc_newOTFWriter() {
 	otfcc_IFontSerializer *writer;
 	NEW(writer);
-	writer->serialize = serializeToOTF;
+	writer->serialize = serializeToOTFWithAllocator;
+	writer->free = freeFontWriter;
+	return writer;
+}
+otfcc_IFontSerializer *otfcc_newWOFFWriter() {
+	otfcc_IFontSerializer *writer;
+	NEW(writer);
+	writer->serialize = serializeToWOFFWithAllocator;
+	writer->free = freeFontWriter;
+	return writer;
+}
+otfcc_IFontSerializer *otfcc_newWOFF2Writer() {
+	otfcc_IFontSerializer *writer;
+	NEW(writer);
+	writer->serialize = serializeToWOFF2WithAllocator;
 	writer->free = freeFontWriter;
 	return writer;
 }
@@ -3,19 +3,119 @@
 #include <time.h>
 #include <float.h>
 #include "support/util.h"
+#include "support/thread-pool/thread-pool.h"
 
 // Stating
 // Calculate necessary values for SFNT
 
 typedef enum { stat_not_started = 0, stat_doing = 1, stat_completed = 2 } stat_status;
 
-glyf_GlyphStat stat_single_glyph(table_glyf *table, glyf_ComponentReference *gr,
-                                 stat_status *stated, uint8_t depth, glyphid_t topj,
-                                 const otfcc_Options *options) {
+typedef struct {
+	pos_t x;
+	pos_t y;
+} stat_Vertex;
+
+// The part of a glyph's statistics which does not depend on where it is placed: the size of
+// its own outline and the convex hull of its points. An affine map takes its extrema on the
+// hull, so a transformed bounding box only needs the hull vertices.
+typedef struct {
+	uint16_t nPoints;
+	uint32_t nHull;
+	OWNING stat_Vertex *hull;
+} stat_Outline;
+
+typedef struct {
+	scale_t a;
+	scale_t b;
+	scale_t c;
+	scale_t d;
+	pos_t x;
+	pos_t y;
+} stat_Transform;
+
+typedef struct {
+	table_glyf *table;
+	stat_Outline *outlines;
+	glyf_GlyphStat *stats;
+	const otfcc_Options *options;
+} stat_GlyfContext;
+
+static int byVertex(const void *_a, const void *_b) {
+	const stat_Vertex *a = _a, *b = _b;
+	if (a->x != b->x) return a->x < b->x ? -1 : 1;
+	if (a->y != b->y) return a->y < b->y ? -1 : 1;
+	return 0;
+}
+static INLINE pos_t turn(const stat_Vertex *o, const stat_Vertex *a, const stat_Vertex *b) {
+	return (a->x - o->x) * (b->y - o->y) - (a->y - o->y) * (b->x - o->x);
+}
+
+// Monotone chain. Collinear boundary points are kept, so the hull never loses a point which
+// could tie for an extremum.
+static void statOutline(const glyf_Glyph *g, stat_Outline *outline) {
+	uint32_t n = 0;
+	for (shapeid_t c = 0; c < g->contours.length; c++) {
+		n += g->contours.items[c].length;
+	}
+	outline->nPoints = (uint16_t)n;
+	outline->nHull = 0;
+	outline->hull = NULL;
+	if (!n) return;
+
+	stat_Vertex *points;
+	NEW(points, n);
+	uint32_t k = 0;
+	for (shapeid_t c = 0; c < g->contours.length; c++) {
+		for (shapeid_t pj = 0; pj < g->contours.items[c].length; pj++) {
+			const glyf_Point *p = &(g->contours.items[c].items[pj]);
+			points[k].x = iVQ.getStill(p->x);
+			points[k].y = iVQ.getStill(p->y);
+			k++;
+		}
+	}
+	qsort(points, n, sizeof(stat_Vertex), byVertex);
+	uint32_t m = 1;
+	for (uint32_t j = 1; j < n; j++) {
+		if (byVertex(&points[j], &points[m - 1])) points[m++] = points[j];
+	}
+	if (m <= 3) {
+		outline->nHull = m;
+		outline->hull = points;
+		return;
+	}
+
+	stat_Vertex *hull;
+	NEW(hull, 2 * m);
+	uint32_t h = 0;
+	for (uint32_t j = 0; j < m; j++) {
+		while (h >= 2 && turn(&hull[h - 2], &hull[h - 1], &points[j]) < 0)
+			h--;
+		hull[h++] = points[j];
+	}
+	for (uint32_t j = m - 1, lower = h + 1; j-- > 0;) {
+		while (h >= lower && turn(&hull[h - 2], &hull[h - 1], &points[j]) < 0)
+			h--;
+		hull[h++] = points[j];
+	}
+	FREE(points);
+	outline->nHull = h;
+	outline->hull = hull;
+}
+
+static void statOutlineJob(void *_ctx, size_t j) {
+	stat_GlyfContext *ctx = _ctx;
+	statOutline(ctx->table->items[j], &ctx->outlines[j]);
+}
+
+// Stats glyph j placed by tf. stated tracks the glyphs being visited and is only needed when
+// the reference graph may have cycles; pass NULL when it is known not to.
+static glyf_GlyphStat statPlacedGlyph(const stat_GlyfContext *ctx, glyphid_t j,
+                                      const stat_Transform *tf, stat_status *stated,
+                                      uint8_t depth, glyphid_t topj) {
+	const otfcc_Options *options = ctx->options;
 	glyf_GlyphStat stat = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-	glyphid_t j = gr->glyph.index;
 	if (depth >= 0xFF) return stat;
-	if (stated[j] == stat_doing) {
+	if (stated && stated[j] == stat_doing) {
 		// We have a circular reference
 		logWarning("[Stat] Circular glyph reference found in gid %d to gid %d. The reference will "
 		           "be dropped.\n",
@@ -24,50 +124,40 @@ glyf_GlyphStat stat_single_glyph(table_glyf *table, glyf_ComponentReference *gr,
 		return stat;
 	}
 
-	glyf_Glyph *g = table->items[j];
-	stated[j] = stat_doing;
+	glyf_Glyph *g = ctx->table->items[j];
+	const stat_Outline *outline = &ctx->outlines[j];
+	if (stated) stated[j] = stat_doing;
 	pos_t xmin = POS_MAX;
 	pos_t xmax = -POS_MAX;
 	pos_t ymin = POS_MAX;
 	pos_t ymax = -POS_MAX;
 	uint16_t nestDepth = 0;
-	uint16_t nPoints = 0;
-	uint16_t nCompositePoints = 0;
-	uint16_t nCompositeContours = 0;
+	uint16_t nCompositePoints = outline->nPoints;
+	uint16_t nCompositeContours = g->contours.length;
 	// Stat xmin, xmax, ymin, ymax
-	for (shapeid_t c = 0; c < g->contours.length; c++) {
-		for (shapeid_t pj = 0; pj < g->contours.items[c].length; pj++) {
-			// Stat point coordinates USING the matrix transformation
-			glyf_Point *p = &(g->contours.items[c].items[pj]);
-			pos_t x = round(iVQ.getStill(gr->x) + gr->a * iVQ.getStill(p->x) +
-			                gr->b * iVQ.getStill(p->y));
-			pos_t y = round(iVQ.getStill(gr->y) + gr->c * iVQ.getStill(p->x) +
-			                gr->d * iVQ.getStill(p->y));
-			if (x < xmin) xmin = x;
-			if (x > xmax) xmax = x;
-			if (y < ymin) ymin = y;
-			if (y > ymax) ymax = y;
-			nPoints += 1;
-		}
+	for (uint32_t k = 0; k < outline->nHull; k++) {
+		// Stat point coordinates USING the matrix transformation
+		const stat_Vertex *v = &outline->hull[k];
+		pos_t x = round(tf->x + tf->a * v->x + tf->b * v->y);
+		pos_t y = round(tf->y + tf->c * v->x + tf->d * v->y);
+		if (x < xmin) xmin = x;
+		if (x > xmax) xmax = x;
+		if (y < ymin) ymin = y;
+		if (y > ymax) ymax = y;
 	}
-	nCompositePoints = nPoints;
-	nCompositeContours = g->contours.length;
 	for (shapeid_t r = 0; r < g->references.length; r++) {
-		glyf_ComponentReference ref;
-		glyf_iComponentReference.init(&ref);
-		glyf_ComponentReference *rr = &(g->references.items[r]);
+		const glyf_ComponentReference *rr = &(g->references.items[r]);
 		// composite affine transformations
-		Handle.replace(&ref.glyph, Handle.fromIndex(g->references.items[r].glyph.index));
-		ref.a = gr->a * rr->a + rr->b * gr->c;
-		ref.b = rr->a * gr->b + rr->b * gr->d;
-		ref.c = gr->a * rr->c + gr->c * rr->d;
-		ref.d = gr->b * rr->c + rr->d * gr->d;
-		iVQ.replace(&ref.x, iVQ.createStill(iVQ.getStill(rr->x) + rr->a * iVQ.getStill(gr->x) +
-		                                    rr->b * iVQ.getStill(gr->y)));
-		iVQ.replace(&ref.y, iVQ.createStill(iVQ.getStill(rr->y) + rr->c * iVQ.getStill(gr->x) +
-		                                    rr->d * iVQ.getStill(gr->y)));
-
-		glyf_GlyphStat thatstat = stat_single_glyph(table, &ref, stated, depth + 1, topj, options);
+		stat_Transform ref;
+		ref.a = tf->a * rr->a + rr->b * tf->c;
+		ref.b = rr->a * tf->b + rr->b * tf->d;
+		ref.c = tf->a * rr->c + tf->c * rr->d;
+		ref.d = tf->b * rr->c + rr->d * tf->d;
+		ref.x = iVQ.getStill(rr->x) + rr->a * tf->x + rr->b * tf->y;
+		ref.y = iVQ.getStill(rr->y) + rr->c * tf->x + rr->d * tf->y;
+
+		glyf_GlyphStat thatstat =
+		    statPlacedGlyph(ctx, rr->glyph.index, &ref, stated, depth + 1, topj);
 		if (thatstat.xMin < xmin) xmin = thatstat.xMin;
 		if (thatstat.xMax > xmax) xmax = thatstat.xMax;
 		if (thatstat.yMin < ymin) ymin = thatstat.yMin;
@@ -86,32 +176,69 @@ glyf_GlyphStat stat_single_glyph(table_glyf *table, glyf_ComponentReference *gr,
 	stat.yMin = ymin;
 	stat.yMax = ymax;
 	stat.nestDepth = nestDepth;
-	stat.nPoints = nPoints;
+	stat.nPoints = outline->nPoints;
 	stat.nContours = g->contours.length;
 	stat.nCompositePoints = nCompositePoints;
 	stat.nCompositeContours = nCompositeContours;
-	stated[j] = stat_completed;
+	if (stated) stated[j] = stat_completed;
 	return stat;
 }
 
+static const stat_Transform identityTransform = {1, 0, 0, 1, 0, 0};
+
+static void statGlyphJob(void *_ctx, size_t j) {
+	stat_GlyfContext *ctx = _ctx;
+	ctx->stats[j] = statPlacedGlyph(ctx, (glyphid_t)j, &identityTransform, NULL, 0, (glyphid_t)j);
+}
+
+// Whether the references below glyph j form a tree shallower than the stat depth limit.
+static bool isRegularReferenceTree(const table_glyf *table, glyphid_t j, stat_status *visit,
+                                   uint8_t depth) {
+	if (visit[j] == stat_completed) return true;
+	if (visit[j] == stat_doing || depth >= 0xFF) return false;
+	visit[j] = stat_doing;
+	const glyf_Glyph *g = table->items[j];
+	for (shapeid_t r = 0; r < g->references.length; r++) {
+		if (!isRegularReferenceTree(table, g->references.items[r].glyph.index, visit, depth + 1))
+			return false;
+	}
+	visit[j] = stat_completed;
+	return true;
+}
+
 void statGlyf(otfcc_Font *font, const otfcc_Options *options) {
+	table_glyf *table = font->glyf;
+	stat_GlyfContext ctx = {.table = table, .options = options};
+	NEW(ctx.outlines, table->length);
+	NEW(ctx.stats, table->length);
+	otfcc_parallelFor(table->length, options->threads, font->allocator, statOutlineJob, &ctx);
+
 	stat_status *stated;
-	NEW(stated, font->glyf->length);
+	NEW(stated, table->length);
+	bool regular = true;
+	for (glyphid_t j = 0; j < table->length && regular; j++) {
+		regular = isRegularReferenceTree(table, j, stated, 0);
+	}
+	if (regular) {
+		// Without cycles every glyph is stated independently.
+		otfcc_parallelFor(table->length, options->threads, font->allocator, statGlyphJob,
+		                  &ctx);
+	} else {
+		// Circular references are reported and dropped in glyph order, which needs the
+		// shared visiting state.
+		memset(stated, 0, table->length * sizeof(stat_status));
+		for (glyphid_t j = 0; j < table->length; j++) {
+			ctx.stats[j] = statPlacedGlyph(&ctx, j, &identityTransform, stated, 0, j);
+		}
+	}
+	FREE(stated);
+
 	pos_t xmin = 0xFFFFFFFF;
 	pos_t xmax = -0xFFFFFFFF;
 	pos_t ymin = 0xFFFFFFFF;
 	pos_t ymax = -0xFFFFFFFF;
-	for (glyphid_t j = 0; j < font->glyf->length; j++) {
-		glyf_ComponentReference gr;
-		gr.glyph = Handle.fromIndex(j);
-		gr.x = iVQ.createStill(0);
-		gr.y = iVQ.createStill(0);
-		gr.a = 1;
-		gr.b = 0;
-		gr.c = 0;
-		gr.d = 1;
-		glyf_GlyphStat thatstat = font->glyf->items[j]->stat =
-		    stat_single_glyph(font->glyf, &gr, stated, 0, j, options);
+	for (glyphid_t j = 0; j < table->length; j++) {
+		glyf_GlyphStat thatstat = table->items[j]->stat = ctx.stats[j];
 		if (thatstat.xMin < xmin) xmin = thatstat.xMin;
 		if (thatstat.xMax > xmax) xmax = thatstat.xMax;
 		if (thatstat.yMin < ymin) ymin = thatstat.yMin;
@@ -121,7 +248,12 @@ void statGlyf(otfcc_Font *font, const otfcc_Options *options) {
 	font->head->xMax = xmax;
 	font->head->yMin = ymin;
 	font->head->yMax = ymax;
-	FREE(stated);
+
+	for (glyphid_t j = 0; j < table->length; j++) {
+		FREE(ctx.outlines[j].hull);
+	}
+	FREE(ctx.outlines);
+	FREE(ctx.stats);
 }
 
 void statMaxp(otfcc_Font *font) {
@@ -259,7 +391,6 @@ static void statVmtx(otfcc_Font *font, const otfcc_Options *options) {
 	font->vmtx = vmtx;
 }
 static void statOS_2UnicodeRanges(otfcc_Font *font, const otfcc_Options *options) {
-	cmap_Entry *item;
 	// Stat for OS/2.ulUnicodeRange.
 	uint32_t u1 = 0;
 	uint32_t u2 = 0;
@@ -267,8 +398,8 @@ static void statOS_2UnicodeRanges(otfcc_Font *font, const otfcc_Options *options
 	uint32_t u4 = 0;
 	int32_t minUnicode = 0xFFFF;
 	int32_t maxUnicode = 0;
-	foreach_hash(item, font->cmap->unicodes) {
-		int u = item->unicode;
+	int u = -1;
+	while (table_iCmap.next(font->cmap, &u)) {
 		// Stat for minimium and maximium unicode
 		if (u < minUnicode) minUnicode = u;
 		if (u > maxUnicode) maxUnicode = u;
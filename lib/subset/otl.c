@@ -0,0 +1,531 @@
+#include "subset.h"
+#include "table/otl.h"
+#include "table/GDEF.h"
+
+// Closure: GSUB lookups are followed regardless of the features and contexts which would
+// apply them, so the closure may keep a few glyphs more than strictly reachable.
+
+static bool closeOverSingle(const subtable_gsub_single *subtable, subset_Plan *plan) {
+	bool added = false;
+	foreach (otl_GsubSingleEntry *e, *subtable) {
+		if (subset_isKept(plan, &e->from)) added |= subset_keep(plan, &e->to);
+	}
+	return added;
+}
+static bool closeOverMulti(const subtable_gsub_multi *subtable, subset_Plan *plan) {
+	bool added = false;
+	foreach (otl_GsubMultiEntry *e, *subtable) {
+		if (!subset_isKept(plan, &e->from)) continue;
+		for (glyphid_t k = 0; k < e->to->numGlyphs; k++) {
+			added |= subset_keep(plan, &e->to->glyphs[k]);
+		}
+	}
+	return added;
+}
+static bool closeOverLigature(const subtable_gsub_ligature *subtable, subset_Plan *plan) {
+	bool added = false;
+	foreach (otl_GsubLigatureEntry *e, *subtable) {
+		bool all = true;
+		for (glyphid_t k = 0; k < e->from->numGlyphs && all; k++) {
+			all = subset_isKept(plan, &e->from->glyphs[k]);
+		}
+		if (all) added |= subset_keep(plan, &e->to);
+	}
+	return added;
+}
+static bool closeOverReverse(const subtable_gsub_reverse *subtable, subset_Plan *plan) {
+	bool added = false;
+	if (subtable->inputIndex >= subtable->matchCount) return false;
+	const otl_Coverage *from = subtable->match[subtable->inputIndex];
+	for (glyphid_t k = 0; k < from->numGlyphs && k < subtable->to->numGlyphs; k++) {
+		if (subset_isKept(plan, &from->glyphs[k])) {
+			added |= subset_keep(plan, &subtable->to->glyphs[k]);
+		}
+	}
+	return added;
+}
+
+bool subset_closeOverGSUB(const table_OTL *gsub, subset_Plan *plan) {
+	if (!gsub) return false;
+	bool added = false;
+	for (tableid_t j = 0; j < gsub->lookups.length; j++) {
+		const otl_Lookup *lookup = gsub->lookups.items[j];
+		for (tableid_t k = 0; k < lookup->subtables.length; k++) {
+			const otl_Subtable *st = lookup->subtables.items[k];
+			if (!st) continue;
+			switch (lookup->type) {
+				case otl_type_gsub_single:
+					added |= closeOverSingle(&st->gsub_single, plan);
+					break;
+				case otl_type_gsub_multiple:
+				case otl_type_gsub_alternate:
+					added |= closeOverMulti(&st->gsub_multi, plan);
+					break;
+				case otl_type_gsub_ligature:
+					added |= closeOverLigature(&st->gsub_ligature, plan);
+					break;
+				case otl_type_gsub_reverse:
+					added |= closeOverReverse(&st->gsub_reverse, plan);
+					break;
+				default:;
+			}
+		}
+	}
+	return added;
+}
+
+// Pruning. Every function below drops the glyphs which are not kept, moves the rest to
+// their new GIDs, and returns whether the subtable became empty.
+
+void subset_pruneCoverage(otl_Coverage *coverage, const subset_Plan *plan) {
+	if (!coverage) return;
+	glyphid_t n = 0;
+	for (glyphid_t j = 0; j < coverage->numGlyphs; j++) {
+		otfcc_GlyphHandle *h = &coverage->glyphs[j];
+		if (subset_isKept(plan, h)) {
+			subset_remap(plan, h);
+			coverage->glyphs[n++] = *h;
+		} else {
+			Handle.dispose(h);
+		}
+	}
+	coverage->numGlyphs = n;
+}
+void subset_pruneClassDef(otl_ClassDef *cd, const subset_Plan *plan) {
+	if (!cd) return;
+	glyphid_t n = 0;
+	for (glyphid_t j = 0; j < cd->numGlyphs; j++) {
+		otfcc_GlyphHandle *h = &cd->glyphs[j];
+		if (subset_isKept(plan, h)) {
+			subset_remap(plan, h);
+			cd->glyphs[n] = *h;
+			cd->classes[n] = cd->classes[j];
+			n++;
+		} else {
+			Handle.dispose(h);
+		}
+	}
+	cd->numGlyphs = n;
+}
+// Sequences, like the components of a ligature, survive only as a whole.
+static bool sequenceIsKept(const otl_Coverage *seq, const subset_Plan *plan) {
+	for (glyphid_t k = 0; k < seq->numGlyphs; k++) {
+		if (!subset_isKept(plan, &seq->glyphs[k])) return false;
+	}
+	return true;
+}
+static void remapSequence(otl_Coverage *seq, const subset_Plan *plan) {
+	for (glyphid_t k = 0; k < seq->numGlyphs; k++) {
+		subset_remap(plan, &seq->glyphs[k]);
+	}
+}
+
+static bool gsubSingleIsKept(const otl_GsubSingleEntry *e, void *plan) {
+	return subset_isKept(plan, &e->from) && subset_isKept(plan, &e->to);
+}
+static bool pruneGsubSingle(subtable_gsub_single *subtable, const subset_Plan *plan) {
+	iSubtable_gsub_single.filterEnv(subtable, gsubSingleIsKept, (void *)plan);
+	foreach (otl_GsubSingleEntry *e, *subtable) {
+		subset_remap(plan, &e->from);
+		subset_remap(plan, &e->to);
+	}
+	return !subtable->length;
+}
+
+static bool gsubMultiIsKept(const otl_GsubMultiEntry *e, void *plan) {
+	return subset_isKept(plan, &e->from) && sequenceIsKept(e->to, plan);
+}
+static bool pruneGsubMulti(subtable_gsub_multi *subtable, const subset_Plan *plan) {
+	iSubtable_gsub_multi.filterEnv(subtable, gsubMultiIsKept, (void *)plan);
+	foreach (otl_GsubMultiEntry *e, *subtable) {
+		subset_remap(plan, &e->from);
+		remapSequence(e->to, plan);
+	}
+	return !subtable->length;
+}
+
+static bool gsubLigatureIsKept(const otl_GsubLigatureEntry *e, void *plan) {
+	return subset_isKept(plan, &e->to) && sequenceIsKept(e->from, plan);
+}
+static bool pruneGsubLigature(subtable_gsub_ligature *subtable, const subset_Plan *plan) {
+	iSubtable_gsub_ligature.filterEnv(subtable, gsubLigatureIsKept, (void *)plan);
+	foreach (otl_GsubLigatureEntry *e, *subtable) {
+		remapSequence(e->from, plan);
+		subset_remap(plan, &e->to);
+	}
+	return !subtable->length;
+}
+
+static bool pruneChaining(subtable_chaining *subtable, const subset_Plan *plan) {
+	// Subtables are canonical after consolidation.
+	if (subtable->type != otl_chaining_canonical) return false;
+	otl_ChainingRule *rule = &subtable->rule;
+	bool possible = true;
+	for (tableid_t j = 0; j < rule->matchCount; j++) {
+		subset_pruneCoverage(rule->match[j], plan);
+		possible = possible && rule->match[j]->numGlyphs > 0;
+	}
+	return !possible;
+}
+
+static bool pruneGsubReverse(subtable_gsub_reverse *subtable, const subset_Plan *plan) {
+	if (subtable->inputIndex >= subtable->matchCount) return true;
+	// The input coverage and the replacements are parallel; they are pruned together.
+	otl_Coverage *from = subtable->match[subtable->inputIndex];
+	otl_Coverage *to = subtable->to;
+	glyphid_t n = 0;
+	for (glyphid_t k = 0; k < from->numGlyphs && k < to->numGlyphs; k++) {
+		if (subset_isKept(plan, &from->glyphs[k]) && subset_isKept(plan, &to->glyphs[k])) {
+			subset_remap(plan, &from->glyphs[k]);
+			subset_remap(plan, &to->glyphs[k]);
+			from->glyphs[n] = from->glyphs[k];
+			to->glyphs[n] = to->glyphs[k];
+			n++;
+		} else {
+			Handle.dispose(&from->glyphs[k]);
+			Handle.dispose(&to->glyphs[k]);
+		}
+	}
+	for (glyphid_t k = n; k < from->numGlyphs; k++) {
+		Handle.dispose(&from->glyphs[k]);
+	}
+	for (glyphid_t k = n; k < to->numGlyphs; k++) {
+		Handle.dispose(&to->glyphs[k]);
+	}
+	from->numGlyphs = to->numGlyphs = n;
+	bool possible = n > 0;
+	for (tableid_t j = 0; j < subtable->matchCount; j++) {
+		if (j == subtable->inputIndex) continue;
+		subset_pruneCoverage(subtable->match[j], plan);
+		possible = possible && subtable->match[j]->numGlyphs > 0;
+	}
+	return !possible;
+}
+
+static bool gposSingleIsKept(const otl_GposSingleEntry *e, void *plan) {
+	return subset_isKept(plan, &e->target);
+}
+static bool pruneGposSingle(subtable_gpos_single *subtable, const subset_Plan *plan) {
+	iSubtable_gpos_single.filterEnv(subtable, gposSingleIsKept, (void *)plan);
+	foreach (otl_GposSingleEntry *e, *subtable) {
+		subset_remap(plan, &e->target);
+	}
+	return !subtable->length;
+}
+
+// Classes which lose all their glyphs are dropped and the value matrices are rebuilt, since
+// the pair builder expects every class up to maxclass to be present. Class 0 always stays.
+static glyphclass_t compactClasses(otl_ClassDef *cd, glyphclass_t *newClass) {
+	for (glyphclass_t c = 1; c <= cd->maxclass; c++) {
+		newClass[c] = 0xFFFF;
+	}
+	newClass[0] = 0;
+	for (glyphid_t j = 0; j < cd->numGlyphs; j++) {
+		if (cd->classes[j] <= cd->maxclass) newClass[cd->classes[j]] = 0;
+	}
+	glyphclass_t n = 1;
+	for (glyphclass_t c = 1; c <= cd->maxclass; c++) {
+		if (!newClass[c]) newClass[c] = n++;
+	}
+	for (glyphid_t j = 0; j < cd->numGlyphs; j++) {
+		if (cd->classes[j] <= cd->maxclass) cd->classes[j] = newClass[cd->classes[j]];
+	}
+	return n;
+}
+static otl_PositionValue **compactMatrix(otl_PositionValue **values, glyphclass_t rows,
+                                         glyphclass_t columns, const glyphclass_t *newRow,
+                                         glyphclass_t newRows, const glyphclass_t *newColumn,
+                                         glyphclass_t newColumns) {
+	otl_PositionValue **compacted;
+	NEW(compacted, newRows);
+	for (glyphclass_t j = 0; j < newRows; j++) {
+		NEW(compacted[j], newColumns);
+	}
+	for (glyphclass_t j = 0; j < rows; j++) {
+		if (newRow[j] != 0xFFFF) {
+			for (glyphclass_t k = 0; k < columns; k++) {
+				if (newColumn[k] != 0xFFFF) compacted[newRow[j]][newColumn[k]] = values[j][k];
+			}
+		}
+		FREE(values[j]);
+	}
+	FREE(values);
+	return compacted;
+}
+static bool pruneGposPair(subtable_gpos_pair *subtable, const subset_Plan *plan) {
+	subset_pruneClassDef(subtable->first, plan);
+	subset_pruneClassDef(subtable->second, plan);
+	if (!subtable->first->numGlyphs) return true;
+	glyphclass_t rows = subtable->first->maxclass + 1;
+	glyphclass_t columns = subtable->second->maxclass + 1;
+	glyphclass_t *newRow, *newColumn;
+	NEW(newRow, rows);
+	NEW(newColumn, columns);
+	glyphclass_t newRows = compactClasses(subtable->first, newRow);
+	glyphclass_t newColumns = compactClasses(subtable->second, newColumn);
+	subtable->firstValues = compactMatrix(subtable->firstValues, rows, columns, newRow, newRows,
+	                                      newColumn, newColumns);
+	subtable->secondValues = compactMatrix(subtable->secondValues, rows, columns, newRow,
+	                                       newRows, newColumn, newColumns);
+	subtable->first->maxclass = newRows - 1;
+	subtable->second->maxclass = newColumns - 1;
+	FREE(newRow);
+	FREE(newColumn);
+	return false;
+}
+
+static bool gposCursiveIsKept(const otl_GposCursiveEntry *e, void *plan) {
+	return subset_isKept(plan, &e->target);
+}
+static bool pruneGposCursive(subtable_gpos_cursive *subtable, const subset_Plan *plan) {
+	iSubtable_gpos_cursive.filterEnv(subtable, gposCursiveIsKept, (void *)plan);
+	foreach (otl_GposCursiveEntry *e, *subtable) {
+		subset_remap(plan, &e->target);
+	}
+	return !subtable->length;
+}
+
+static bool markIsKept(const otl_MarkRecord *e, void *plan) {
+	return subset_isKept(plan, &e->glyph);
+}
+// Mark classes which lose all their marks are dropped, so that no anchor is left without a
+// class. Classes keep their order, so the anchors of a base move down in place.
+static glyphclass_t pruneMarkArray(otl_MarkArray *marks, glyphclass_t classCount,
+                                   glyphclass_t *newClass, const subset_Plan *plan) {
+	otl_iMarkArray.filterEnv(marks, markIsKept, (void *)plan);
+	for (glyphclass_t c = 0; c < classCount; c++) {
+		newClass[c] = 0xFFFF;
+	}
+	foreach (otl_MarkRecord *e, *marks) {
+		subset_remap(plan, &e->glyph);
+		if (e->markClass < classCount) newClass[e->markClass] = 0;
+	}
+	glyphclass_t n = 0;
+	for (glyphclass_t c = 0; c < classCount; c++) {
+		if (!newClass[c]) newClass[c] = n++;
+	}
+	foreach (otl_MarkRecord *e, *marks) {
+		if (e->markClass < classCount) e->markClass = newClass[e->markClass];
+	}
+	return n;
+}
+static void compactAnchors(otl_Anchor *anchors, glyphclass_t classCount,
+                           const glyphclass_t *newClass) {
+	for (glyphclass_t c = 0; c < classCount; c++) {
+		if (newClass[c] != 0xFFFF) anchors[newClass[c]] = anchors[c];
+	}
+}
+static bool baseIsKept(const otl_BaseRecord *e, void *plan) {
+	return subset_isKept(plan, &e->glyph);
+}
+static bool pruneMarkToSingle(subtable_gpos_markToSingle *subtable, const subset_Plan *plan) {
+	glyphclass_t *newClass;
+	NEW(newClass, subtable->classCount + 1);
+	glyphclass_t n = pruneMarkArray(&subtable->markArray, subtable->classCount, newClass, plan);
+	otl_iBaseArray.filterEnv(&subtable->baseArray, baseIsKept, (void *)plan);
+	foreach (otl_BaseRecord *e, subtable->baseArray) {
+		subset_remap(plan, &e->glyph);
+		compactAnchors(e->anchors, subtable->classCount, newClass);
+	}
+	subtable->classCount = n;
+	FREE(newClass);
+	return !subtable->markArray.length || !subtable->baseArray.length;
+}
+static bool ligatureBaseIsKept(const otl_LigatureBaseRecord *e, void *plan) {
+	return subset_isKept(plan, &e->glyph);
+}
+static bool pruneMarkToLigature(subtable_gpos_markToLigature *subtable,
+                                const subset_Plan *plan) {
+	glyphclass_t *newClass;
+	NEW(newClass, subtable->classCount + 1);
+	glyphclass_t n = pruneMarkArray(&subtable->markArray, subtable->classCount, newClass, plan);
+	otl_iLigatureArray.filterEnv(&subtable->ligArray, ligatureBaseIsKept, (void *)plan);
+	foreach (otl_LigatureBaseRecord *e, subtable->ligArray) {
+		subset_remap(plan, &e->glyph);
+		for (glyphid_t k = 0; k < e->componentCount; k++) {
+			compactAnchors(e->anchors[k], subtable->classCount, newClass);
+		}
+	}
+	subtable->classCount = n;
+	FREE(newClass);
+	return !subtable->markArray.length || !subtable->ligArray.length;
+}
+
+static bool pruneSubtable(const otl_Lookup *lookup, otl_Subtable *st, const subset_Plan *plan) {
+	switch (lookup->type) {
+		case otl_type_gsub_single:
+			return pruneGsubSingle(&st->gsub_single, plan);
+		case otl_type_gsub_multiple:
+		case otl_type_gsub_alternate:
+			return pruneGsubMulti(&st->gsub_multi, plan);
+		case otl_type_gsub_ligature:
+			return pruneGsubLigature(&st->gsub_ligature, plan);
+		case otl_type_gsub_chaining:
+		case otl_type_gpos_chaining:
+			return pruneChaining(&st->chaining, plan);
+		case otl_type_gsub_reverse:
+			return pruneGsubReverse(&st->gsub_reverse, plan);
+		case otl_type_gpos_single:
+			return pruneGposSingle(&st->gpos_single, plan);
+		case otl_type_gpos_pair:
+			return pruneGposPair(&st->gpos_pair, plan);
+		case otl_type_gpos_cursive:
+			return pruneGposCursive(&st->gpos_cursive, plan);
+		case otl_type_gpos_markToBase:
+		case otl_type_gpos_markToMark:
+			return pruneMarkToSingle(&st->gpos_markToSingle, plan);
+		case otl_type_gpos_markToLigature:
+			return pruneMarkToLigature(&st->gpos_markToLigature, plan);
+		default:
+			return false;
+	}
+}
+
+static void pruneLookup(otl_Lookup *lookup, const subset_Plan *plan) {
+	otl_SubtableList dropped;
+	otl_iSubtableList.init(&dropped);
+	tableid_t n = 0;
+	for (tableid_t j = 0; j < lookup->subtables.length; j++) {
+		otl_Subtable *st = lookup->subtables.items[j];
+		if (!st) continue;
+		if (pruneSubtable(lookup, st, plan)) {
+			otl_iSubtableList.push(&dropped, st);
+		} else {
+			lookup->subtables.items[n++] = st;
+		}
+	}
+	lookup->subtables.length = n;
+	otl_iSubtableList.disposeDependent(&dropped, lookup);
+}
+
+static bool isChaining(const otl_Lookup *lookup) {
+	return lookup->type == otl_type_gsub_chaining || lookup->type == otl_type_gpos_chaining;
+}
+// Whether a chaining subtable loses all its applications once the lookups marked in dead are
+// removed. A rule which had none to begin with is kept.
+static bool chainingDies(const subtable_chaining *subtable, const bool *dead) {
+	if (subtable->type != otl_chaining_canonical) return false;
+	const otl_ChainingRule *rule = &subtable->rule;
+	if (!rule->applyCount) return false;
+	for (tableid_t j = 0; j < rule->applyCount; j++) {
+		const otl_ChainLookupApplication *a = &rule->apply[j];
+		if (a->lookup.state != HANDLE_STATE_EMPTY && !dead[a->lookup.index]) return false;
+	}
+	return true;
+}
+// Drops the applications of removed lookups, and moves the rest to the new lookup indices.
+// Returns whether the subtable became empty, which chainingDies has predicted.
+static bool relinkChaining(subtable_chaining *subtable, const tableid_t *newIndex) {
+	if (subtable->type != otl_chaining_canonical) return false;
+	otl_ChainingRule *rule = &subtable->rule;
+	if (!rule->applyCount) return false;
+	tableid_t n = 0;
+	for (tableid_t j = 0; j < rule->applyCount; j++) {
+		otl_ChainLookupApplication *a = &rule->apply[j];
+		if (a->lookup.state == HANDLE_STATE_EMPTY || newIndex[a->lookup.index] == 0xFFFF) {
+			Handle.dispose(&a->lookup);
+		} else {
+			a->lookup.index = newIndex[a->lookup.index];
+			rule->apply[n++] = *a;
+		}
+	}
+	rule->applyCount = n;
+	return !n;
+}
+
+static bool lookupRefIsNotEmpty(const otl_LookupRef *rLut, void *env) {
+	return rLut && *rLut && (*rLut)->subtables.length > 0;
+}
+static bool featureRefIsNotEmpty(const otl_FeatureRef *rFeat, void *env) {
+	return rFeat && *rFeat && (*rFeat)->lookups.length > 0;
+}
+static bool lookupIsNotEmpty(const otl_LookupPtr *rLut, void *env) {
+	return rLut && *rLut && (*rLut)->subtables.length > 0;
+}
+static bool featureIsNotEmpty(const otl_FeaturePtr *rFeat, void *env) {
+	return rFeat && *rFeat && (*rFeat)->lookups.length > 0;
+}
+static bool languageIsNotEmpty(const otl_LanguageSystemPtr *rLang, void *env) {
+	return rLang && *rLang && ((*rLang)->features.length > 0 || (*rLang)->requiredFeature);
+}
+
+void subset_pruneOTL(table_OTL *table, const subset_Plan *plan) {
+	if (!table) return;
+	for (tableid_t j = 0; j < table->lookups.length; j++) {
+		pruneLookup(table->lookups.items[j], plan);
+	}
+	// Removing a lookup may empty a chaining rule which applies it, and so the chaining lookup
+	// itself. Find every lookup which ends up empty first, so that the indices are moved once.
+	tableid_t nLookups = table->lookups.length;
+	bool *dead;
+	NEW(dead, nLookups);
+	for (tableid_t j = 0; j < nLookups; j++) {
+		dead[j] = !table->lookups.items[j]->subtables.length;
+	}
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (tableid_t j = 0; j < nLookups; j++) {
+			otl_Lookup *lookup = table->lookups.items[j];
+			if (dead[j] || !isChaining(lookup)) continue;
+			bool dies = true;
+			for (tableid_t k = 0; k < lookup->subtables.length && dies; k++) {
+				dies = chainingDies(&lookup->subtables.items[k]->chaining, dead);
+			}
+			if (dies) dead[j] = changed = true;
+		}
+	}
+	tableid_t *newIndex;
+	NEW(newIndex, nLookups);
+	tableid_t n = 0;
+	for (tableid_t j = 0; j < nLookups; j++) {
+		newIndex[j] = dead[j] ? 0xFFFF : n++;
+	}
+	FREE(dead);
+
+	for (tableid_t j = 0; j < nLookups; j++) {
+		otl_Lookup *lookup = table->lookups.items[j];
+		if (!isChaining(lookup)) continue;
+		otl_SubtableList dropped;
+		otl_iSubtableList.init(&dropped);
+		tableid_t k = 0;
+		for (tableid_t m = 0; m < lookup->subtables.length; m++) {
+			otl_Subtable *st = lookup->subtables.items[m];
+			if (relinkChaining(&st->chaining, newIndex)) {
+				otl_iSubtableList.push(&dropped, st);
+			} else {
+				lookup->subtables.items[k++] = st;
+			}
+		}
+		lookup->subtables.length = k;
+		otl_iSubtableList.disposeDependent(&dropped, lookup);
+	}
+	FREE(newIndex);
+	if (n == nLookups) return;
+
+	foreach (otl_FeaturePtr *feature, table->features) {
+		otl_iLookupRefList.filterEnv(&(*feature)->lookups, lookupRefIsNotEmpty, NULL);
+	}
+	foreach (otl_LanguageSystemPtr *lang, table->languages) {
+		otl_iFeatureRefList.filterEnv(&(*lang)->features, featureRefIsNotEmpty, NULL);
+		if ((*lang)->requiredFeature && !(*lang)->requiredFeature->lookups.length) {
+			(*lang)->requiredFeature = NULL;
+		}
+	}
+	otl_iLangSystemList.filterEnv(&table->languages, languageIsNotEmpty, NULL);
+	otl_iLookupList.filterEnv(&table->lookups, lookupIsNotEmpty, NULL);
+	otl_iFeatureList.filterEnv(&table->features, featureIsNotEmpty, NULL);
+}
+
+static bool caretsAreKept(const otl_CaretValueRecord *e, void *plan) {
+	return subset_isKept(plan, &e->glyph);
+}
+void subset_pruneGDEF(table_GDEF *gdef, const subset_Plan *plan) {
+	if (!gdef) return;
+	subset_pruneClassDef(gdef->glyphClassDef, plan);
+	subset_pruneClassDef(gdef->markAttachClassDef, plan);
+	otl_iLigCaretTable.filterEnv(&gdef->ligCarets, caretsAreKept, (void *)plan);
+	foreach (otl_CaretValueRecord *e, gdef->ligCarets) {
+		subset_remap(plan, &e->glyph);
+	}
+}
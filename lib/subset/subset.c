@@ -0,0 +1,349 @@
+#include <ctype.h>
+#include "subset.h"
+#include "support/util.h"
+#include "support/aglfn/aglfn.h"
+
+// Retain sets
+
+caryll_standardValType(unicode_t, otfcc_iUnicodeCodePoint);
+caryll_standardVectorImpl(otfcc_UnicodeList, unicode_t, otfcc_iUnicodeCodePoint,
+                          otfcc_iUnicodeList);
+
+static INLINE void initGlyphName(sds *name) {
+	*name = NULL;
+}
+static INLINE void copyGlyphName(sds *dst, const sds *src) {
+	*dst = *src ? sdsdup(*src) : NULL;
+}
+static INLINE void disposeGlyphName(sds *name) {
+	if (*name) sdsfree(*name);
+	*name = NULL;
+}
+caryll_standardValType(sds, otfcc_iGlyphName, initGlyphName, copyGlyphName, disposeGlyphName);
+caryll_standardVectorImpl(otfcc_GlyphNameList, sds, otfcc_iGlyphName, otfcc_iGlyphNameList);
+
+static INLINE void initRetainSet(otfcc_RetainSet *set) {
+	otfcc_iUnicodeList.init(&set->unicodes);
+	otfcc_iGlyphNameList.init(&set->glyphs);
+}
+static INLINE void disposeRetainSet(otfcc_RetainSet *set) {
+	otfcc_iUnicodeList.dispose(&set->unicodes);
+	otfcc_iGlyphNameList.dispose(&set->glyphs);
+}
+caryll_standardRefTypeFn(otfcc_RetainSet, initRetainSet, disposeRetainSet);
+
+static bool isSeparator(char c) {
+	return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+static bool parseCodePoint(const char **s, const char *end, unicode_t *u) {
+	const char *p = *s;
+	if (end - p > 2 && (p[0] == 'U' || p[0] == 'u') && p[1] == '+') p += 2;
+	unicode_t v = 0;
+	const char *start = p;
+	for (; p < end && isxdigit((unsigned char)*p) && p - start < 6; p++) {
+		v = v * 16 + (unicode_t)(isdigit((unsigned char)*p) ? *p - '0' : (*p | 0x20) - 'a' + 10);
+	}
+	if (p == start || v > 0x10FFFF) return false;
+	*s = p;
+	*u = v;
+	return true;
+}
+static bool parseRetainSet(otfcc_RetainSet *set, const char *list) {
+	const char *p = list;
+	while (*p) {
+		if (isSeparator(*p)) {
+			p++;
+			continue;
+		}
+		const char *end = p;
+		while (*end && !isSeparator(*end))
+			end++;
+		if (*p == '/') {
+			if (end - p < 2) return false;
+			otfcc_iGlyphNameList.push(&set->glyphs, sdsnewlen(p + 1, end - p - 1));
+		} else {
+			unicode_t first, last;
+			if (!parseCodePoint(&p, end, &first)) return false;
+			last = first;
+			if (p < end && *p == '-') {
+				p++;
+				if (!parseCodePoint(&p, end, &last) || last < first) return false;
+			}
+			if (p != end) return false;
+			for (unicode_t u = first; u <= last; u++) {
+				otfcc_iUnicodeList.push(&set->unicodes, u);
+			}
+		}
+		p = end;
+	}
+	return true;
+}
+
+caryll_ElementInterfaceOf(otfcc_RetainSet) otfcc_iRetainSet = {
+    caryll_standardRefTypeMethods(otfcc_RetainSet),
+    .parse = parseRetainSet,
+};
+
+// Closure
+
+#define UNICODE_WORDS (0x110000 >> 6)
+static INLINE bool hasUnicode(const uint64_t *unicodes, unicode_t u) {
+	return u < 0x110000 && (unicodes[u >> 6] >> (u & 63)) & 1;
+}
+
+// A name no glyph carries may still be an AGLFN name, which stands for its code point.
+static void seedPlan(subset_Plan *plan, const otfcc_Font *font, const otfcc_RetainSet *retain,
+                     uint64_t *unicodes, otfcc_GlyphSet *named, const otfcc_Options *options) {
+	subset_keepGID(plan, 0);
+	foreach (sds *name, retain->glyphs) {
+		otfcc_GlyphOrderEntry *e = GlyphOrder.findByName(font->glyph_order, *name, sdslen(*name));
+		if (e && e->gid < plan->numGlyphs) {
+			subset_keepGID(plan, e->gid);
+			otfcc_glyphsetAdd(named, e->gid);
+			continue;
+		}
+		int32_t u = aglfn_unicodeOf(*name, sdslen(*name));
+		otfcc_GlyphHandle *h = (u >= 0 && font->cmap) ? table_iCmap.lookup(font->cmap, u) : NULL;
+		if (h) {
+			subset_keep(plan, h);
+			unicodes[u >> 6] |= (uint64_t)1 << (u & 63);
+		} else {
+			logWarning("[Subset] Ignored missing glyph /%s.\n", *name);
+		}
+	}
+	if (font->cmap) {
+		foreach (unicode_t *u, retain->unicodes) {
+			otfcc_GlyphHandle *h = table_iCmap.lookup(font->cmap, *u);
+			if (h) subset_keep(plan, h);
+		}
+		cmap_UVS_Entry *item;
+		foreach_hash(item, font->cmap->uvs) {
+			if (hasUnicode(unicodes, item->key.unicode)) subset_keep(plan, &item->glyph);
+		}
+	}
+}
+
+// Visits the glyphs kept since the last call: their components are kept as well.
+static bool closeOverReferences(subset_Plan *plan, const table_glyf *glyf) {
+	bool added = false;
+	while (plan->pending) {
+		const glyf_Glyph *g = glyf->items[plan->worklist[--plan->pending]];
+		foreach (glyf_ComponentReference *r, g->references) {
+			added |= subset_keep(plan, &r->glyph);
+		}
+	}
+	return added;
+}
+static bool closeOverCOLR(subset_Plan *plan, const table_COLR *colr) {
+	if (!colr) return false;
+	bool added = false;
+	foreach (colr_Mapping *m, *colr) {
+		if (!subset_isKept(plan, &m->glyph)) continue;
+		foreach (colr_Layer *layer, m->layers) {
+			added |= subset_keep(plan, &layer->glyph);
+		}
+	}
+	return added;
+}
+// An SVG document refers to its glyphs by GID, so it is kept or dropped as a whole.
+static bool closeOverSVG(subset_Plan *plan, const table_SVG *svg) {
+	if (!svg) return false;
+	bool added = false;
+	foreach (svg_Assignment *a, *svg) {
+		if (a->end >= plan->numGlyphs || a->start > a->end) continue;
+		bool any = false;
+		for (uint32_t gid = a->start; gid <= a->end && !any; gid++) {
+			any = otfcc_glyphsetHas(plan->keep, gid);
+		}
+		if (!any) continue;
+		for (uint32_t gid = a->start; gid <= a->end; gid++) {
+			added |= subset_keepGID(plan, gid);
+		}
+	}
+	return added;
+}
+
+static void closePlan(subset_Plan *plan, const otfcc_Font *font) {
+	bool added;
+	do {
+		closeOverReferences(plan, font->glyf);
+		added = closeOverCOLR(plan, font->COLR);
+		added |= closeOverSVG(plan, font->SVG_);
+		added |= subset_closeOverGSUB(font->GSUB, plan);
+	} while (added || plan->pending);
+}
+
+// Pruning
+
+static void pruneGlyf(table_glyf *glyf, const subset_Plan *plan) {
+	glyphid_t n = 0;
+	for (glyphid_t j = 0; j < glyf->length; j++) {
+		glyf_Glyph *g = glyf->items[j];
+		if (!otfcc_glyphsetHas(plan->keep, j)) {
+			glyf_iGlyphPtr.dispose(&g);
+			continue;
+		}
+		foreach (glyf_ComponentReference *r, g->references) {
+			subset_remap(plan, &r->glyph);
+		}
+		glyf->items[n++] = g;
+	}
+	glyf->length = n;
+}
+
+static void pruneCmap(table_cmap *cmap, const subset_Plan *plan, const uint64_t *unicodes,
+                      const otfcc_GlyphSet *named) {
+	int unicode = -1;
+	otfcc_GlyphHandle *glyph;
+	while ((glyph = table_iCmap.next(cmap, &unicode))) {
+		if (subset_isKept(plan, glyph) &&
+		    (hasUnicode(unicodes, unicode) || otfcc_glyphsetHas(named, glyph->index))) {
+			subset_remap(plan, glyph);
+		} else {
+			table_iCmap.unmap(cmap, unicode);
+		}
+	}
+	cmap_UVS_Entry *item, *tmp;
+	HASH_ITER(hh, cmap->uvs, item, tmp) {
+		if (subset_isKept(plan, &item->glyph) && hasUnicode(unicodes, item->key.unicode)) {
+			subset_remap(plan, &item->glyph);
+		} else {
+			table_iCmap.unmapUVS(cmap, item->key);
+		}
+	}
+}
+
+static bool colrMappingIsKept(const colr_Mapping *m, void *plan) {
+	return subset_isKept(plan, &m->glyph);
+}
+static void pruneCOLR(table_COLR *colr, const subset_Plan *plan) {
+	table_iCOLR.filterEnv(colr, colrMappingIsKept, (void *)plan);
+	foreach (colr_Mapping *m, *colr) {
+		subset_remap(plan, &m->glyph);
+		foreach (colr_Layer *layer, m->layers) {
+			subset_remap(plan, &layer->glyph);
+		}
+	}
+}
+
+static bool svgAssignmentIsKept(const svg_Assignment *a, void *_plan) {
+	const subset_Plan *plan = _plan;
+	return a->start <= a->end && a->end < plan->numGlyphs &&
+	       otfcc_glyphsetHas(plan->keep, a->start);
+}
+// Rewrites the id="glyphN" attributes of a document to the new GIDs. Compressed documents
+// are left alone.
+static void renumberSVGDocument(caryll_Buffer *doc, const svg_Assignment *a,
+                                const subset_Plan *plan) {
+	static const char prefix[] = "id=\"glyph";
+	const size_t prefixLength = sizeof(prefix) - 1;
+	if (doc->size >= 2 && doc->data[0] == 0x1F && doc->data[1] == 0x8B) return;
+	caryll_Buffer *out = bufnew();
+	size_t copied = 0;
+	for (size_t j = 0; j + prefixLength < doc->size; j++) {
+		if (memcmp(doc->data + j, prefix, prefixLength) != 0) continue;
+		size_t k = j + prefixLength;
+		uint32_t gid = 0;
+		while (k < doc->size && isdigit(doc->data[k]) && gid <= 0xFFFF) {
+			gid = gid * 10 + (doc->data[k++] - '0');
+		}
+		if (k == j + prefixLength || k >= doc->size || doc->data[k] != '"') continue;
+		if (gid < a->start || gid > a->end) continue;
+		bufwrite_bytes(out, j + prefixLength - copied, doc->data + copied);
+		sds id = sdsfromlonglong(plan->newGID[gid]);
+		bufwrite_sds(out, id);
+		sdsfree(id);
+		copied = j = k;
+	}
+	bufwrite_bytes(out, doc->size - copied, doc->data + copied);
+	bufclear(doc);
+	bufwrite_bufdel(doc, out);
+}
+static void pruneSVG(table_SVG *svg, const subset_Plan *plan) {
+	table_iSVG.filterEnv(svg, svgAssignmentIsKept, (void *)plan);
+	foreach (svg_Assignment *a, *svg) {
+		if (a->document) renumberSVGDocument(a->document, a, plan);
+		a->start = plan->newGID[a->start];
+		a->end = plan->newGID[a->end];
+	}
+}
+
+static bool tsiEntryIsKept(const tsi_Entry *e, void *plan) {
+	return e->type != TSI_GLYPH || subset_isKept(plan, &e->glyph);
+}
+static void pruneTSI(table_TSI *tsi, const subset_Plan *plan) {
+	if (!tsi) return;
+	table_iTSI.filterEnv(tsi, tsiEntryIsKept, (void *)plan);
+	foreach (tsi_Entry *e, *tsi) {
+		if (e->type == TSI_GLYPH) subset_remap(plan, &e->glyph);
+	}
+}
+
+// The names of the kept glyphs move to the new order, so that the handles interned to them
+// stay valid; the old order goes with the names of the removed glyphs.
+static otfcc_GlyphOrder *pruneGlyphOrder(otfcc_GlyphOrder *go, const subset_Plan *plan) {
+	otfcc_GlyphOrder *pruned = GlyphOrder.create();
+	for (uint32_t j = 0; j < go->length; j++) {
+		otfcc_GlyphOrderEntry *e = go->entries[j];
+		if (e->gid >= plan->numGlyphs || !otfcc_glyphsetHas(plan->keep, e->gid)) continue;
+		GlyphOrder.setByName(pruned, e->name, plan->newGID[e->gid]);
+		e->name = NULL;
+	}
+	GlyphOrder.free(go);
+	return pruned;
+}
+
+void otfcc_subsetFont(otfcc_Font *font, const otfcc_RetainSet *retain,
+                      const otfcc_Options *options) {
+	if (!font->glyf || !font->glyph_order || !retain) return;
+	subset_Plan plan;
+	plan.numGlyphs = font->glyf->length;
+	plan.keep = otfcc_newGlyphSet();
+	plan.pending = 0;
+	NEW(plan.worklist, plan.numGlyphs + 1);
+	NEW(plan.newGID, plan.numGlyphs + 1);
+	uint64_t *unicodes;
+	NEW(unicodes, UNICODE_WORDS);
+	foreach (unicode_t *u, retain->unicodes) {
+		if (*u < 0x110000) unicodes[*u >> 6] |= (uint64_t)1 << (*u & 63);
+	}
+	otfcc_GlyphSet *named = otfcc_newGlyphSet();
+
+	loggedStep("Closure") {
+		seedPlan(&plan, font, retain, unicodes, named, options);
+		closePlan(&plan, font);
+		glyphid_t n = 0;
+		for (glyphid_t j = 0; j < plan.numGlyphs; j++) {
+			if (otfcc_glyphsetHas(plan.keep, j)) plan.newGID[j] = n++;
+		}
+		logProgress("%d of %d glyphs kept.\n", n, plan.numGlyphs);
+	}
+	loggedStep("Prune") {
+		if (font->cmap) pruneCmap(font->cmap, &plan, unicodes, named);
+		accountedAs(OTFCC_MEM_OTL) {
+			subset_pruneOTL(font->GSUB, &plan);
+			subset_pruneOTL(font->GPOS, &plan);
+			subset_pruneGDEF(font->GDEF, &plan);
+		}
+		if (font->COLR) pruneCOLR(font->COLR, &plan);
+		if (font->SVG_) pruneSVG(font->SVG_, &plan);
+		pruneTSI(font->TSI_01, &plan);
+		pruneTSI(font->TSI_23, &plan);
+		subset_pruneClassDef(font->TSI5, &plan);
+		accountedAs(OTFCC_MEM_GLYF) { pruneGlyf(font->glyf, &plan); }
+		// Per-glyph tables are rebuilt from the glyphs when the font is written.
+		otfcc_iFont.deleteTable(font, 'hmtx');
+		otfcc_iFont.deleteTable(font, 'vmtx');
+		otfcc_iFont.deleteTable(font, 'VORG');
+		otfcc_iFont.deleteTable(font, 'LTSH');
+		otfcc_iFont.deleteTable(font, 'hdmx');
+		if (font->maxp) font->maxp->numGlyphs = font->glyf->length;
+		font->glyph_order = pruneGlyphOrder(font->glyph_order, &plan);
+	}
+
+	otfcc_deleteGlyphSet(named);
+	FREE(unicodes);
+	FREE(plan.newGID);
+	FREE(plan.worklist);
+	otfcc_deleteGlyphSet(plan.keep);
+}
@@ -0,0 +1,51 @@
+#ifndef CARYLL_SUBSET_H
+#define CARYLL_SUBSET_H
+
+#include "support/util.h"
+#include "otfcc/font.h"
+#include "otfcc/subset.h"
+#include "support/glyph-set/glyph-set.h"
+
+// The glyphs which survive a subset, and where they move to. Glyphs are kept in their
+// original order, so the new GIDs are increasing and sorted coverages stay sorted.
+typedef struct {
+	glyphid_t numGlyphs;
+	otfcc_GlyphSet *keep;
+	glyphid_t *newGID; // valid for kept glyphs, after the closure
+	// Glyphs kept but not visited by the closure yet
+	uint32_t pending;
+	glyphid_t *worklist;
+} subset_Plan;
+
+// Handles of a consolidated font carry their GID.
+static INLINE bool subset_hasGlyph(const subset_Plan *plan, const otfcc_GlyphHandle *h) {
+	return (h->state == HANDLE_STATE_CONSOLIDATED || h->state == HANDLE_STATE_INDEX) &&
+	       h->index < plan->numGlyphs;
+}
+static INLINE bool subset_isKept(const subset_Plan *plan, const otfcc_GlyphHandle *h) {
+	return subset_hasGlyph(plan, h) && otfcc_glyphsetHas(plan->keep, h->index);
+}
+// Returns whether the glyph was not kept before.
+static INLINE bool subset_keepGID(subset_Plan *plan, glyphid_t gid) {
+	if (gid >= plan->numGlyphs || !otfcc_glyphsetAdd(plan->keep, gid)) return false;
+	plan->worklist[plan->pending++] = gid;
+	return true;
+}
+static INLINE bool subset_keep(subset_Plan *plan, const otfcc_GlyphHandle *h) {
+	return subset_hasGlyph(plan, h) && subset_keepGID(plan, h->index);
+}
+// Call on kept glyphs only.
+static INLINE void subset_remap(const subset_Plan *plan, otfcc_GlyphHandle *h) {
+	h->index = plan->newGID[h->index];
+}
+
+bool subset_closeOverGSUB(const table_OTL *gsub, subset_Plan *plan);
+void subset_pruneOTL(table_OTL *table, const subset_Plan *plan);
+void subset_pruneGDEF(table_GDEF *gdef, const subset_Plan *plan);
+void subset_pruneCoverage(otl_Coverage *coverage, const subset_Plan *plan);
+void subset_pruneClassDef(otl_ClassDef *cd, const subset_Plan *plan);
+
+void otfcc_subsetFont(otfcc_Font *font, const otfcc_RetainSet *retain,
+                      const otfcc_Options *options);
+
+#endif
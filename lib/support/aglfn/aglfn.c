@@ -1,592 +1,848 @@
 #include "aglfn.h"
-#define GlyphOrder otfcc_pkgGlyphOrder
+#include <string.h>
+#include "support/otfcc-alloc.h"
 
-// This table contains standard AGLFN 1.7 glyph names, mapped to Unicode.
-void aglfn_setupNames(otfcc_GlyphOrder *map) {
-	GlyphOrder.setByGID(map, 0x0041, sdsnew("A"));
-	GlyphOrder.setByGID(map, 0x00C6, sdsnew("AE"));
-	GlyphOrder.setByGID(map, 0x01FC, sdsnew("AEacute"));
-	GlyphOrder.setByGID(map, 0x00C1, sdsnew("Aacute"));
-	GlyphOrder.setByGID(map, 0x0102, sdsnew("Abreve"));
-	GlyphOrder.setByGID(map, 0x00C2, sdsnew("Acircumflex"));
-	GlyphOrder.setByGID(map, 0x00C4, sdsnew("Adieresis"));
-	GlyphOrder.setByGID(map, 0x00C0, sdsnew("Agrave"));
-	GlyphOrder.setByGID(map, 0x0391, sdsnew("Alpha"));
-	GlyphOrder.setByGID(map, 0x0386, sdsnew("Alphatonos"));
-	GlyphOrder.setByGID(map, 0x0100, sdsnew("Amacron"));
-	GlyphOrder.setByGID(map, 0x0104, sdsnew("Aogonek"));
-	GlyphOrder.setByGID(map, 0x00C5, sdsnew("Aring"));
-	GlyphOrder.setByGID(map, 0x01FA, sdsnew("Aringacute"));
-	GlyphOrder.setByGID(map, 0x00C3, sdsnew("Atilde"));
-	GlyphOrder.setByGID(map, 0x0042, sdsnew("B"));
-	GlyphOrder.setByGID(map, 0x0392, sdsnew("Beta"));
-	GlyphOrder.setByGID(map, 0x0043, sdsnew("C"));
-	GlyphOrder.setByGID(map, 0x0106, sdsnew("Cacute"));
-	GlyphOrder.setByGID(map, 0x010C, sdsnew("Ccaron"));
-	GlyphOrder.setByGID(map, 0x00C7, sdsnew("Ccedilla"));
-	GlyphOrder.setByGID(map, 0x0108, sdsnew("Ccircumflex"));
-	GlyphOrder.setByGID(map, 0x010A, sdsnew("Cdotaccent"));
-	GlyphOrder.setByGID(map, 0x03A7, sdsnew("Chi"));
-	GlyphOrder.setByGID(map, 0x0044, sdsnew("D"));
-	GlyphOrder.setByGID(map, 0x010E, sdsnew("Dcaron"));
-	GlyphOrder.setByGID(map, 0x0110, sdsnew("Dcroat"));
-	GlyphOrder.setByGID(map, 0x2206, sdsnew("Delta"));
-	GlyphOrder.setByGID(map, 0x0045, sdsnew("E"));
-	GlyphOrder.setByGID(map, 0x00C9, sdsnew("Eacute"));
-	GlyphOrder.setByGID(map, 0x0114, sdsnew("Ebreve"));
-	GlyphOrder.setByGID(map, 0x011A, sdsnew("Ecaron"));
-	GlyphOrder.setByGID(map, 0x00CA, sdsnew("Ecircumflex"));
-	GlyphOrder.setByGID(map, 0x00CB, sdsnew("Edieresis"));
-	GlyphOrder.setByGID(map, 0x0116, sdsnew("Edotaccent"));
-	GlyphOrder.setByGID(map, 0x00C8, sdsnew("Egrave"));
-	GlyphOrder.setByGID(map, 0x0112, sdsnew("Emacron"));
-	GlyphOrder.setByGID(map, 0x014A, sdsnew("Eng"));
-	GlyphOrder.setByGID(map, 0x0118, sdsnew("Eogonek"));
-	GlyphOrder.setByGID(map, 0x0395, sdsnew("Epsilon"));
-	GlyphOrder.setByGID(map, 0x0388, sdsnew("Epsilontonos"));
-	GlyphOrder.setByGID(map, 0x0397, sdsnew("Eta"));
-	GlyphOrder.setByGID(map, 0x0389, sdsnew("Etatonos"));
-	GlyphOrder.setByGID(map, 0x00D0, sdsnew("Eth"));
-	GlyphOrder.setByGID(map, 0x20AC, sdsnew("Euro"));
-	GlyphOrder.setByGID(map, 0x0046, sdsnew("F"));
-	GlyphOrder.setByGID(map, 0x0047, sdsnew("G"));
-	GlyphOrder.setByGID(map, 0x0393, sdsnew("Gamma"));
-	GlyphOrder.setByGID(map, 0x011E, sdsnew("Gbreve"));
-	GlyphOrder.setByGID(map, 0x01E6, sdsnew("Gcaron"));
-	GlyphOrder.setByGID(map, 0x011C, sdsnew("Gcircumflex"));
-	GlyphOrder.setByGID(map, 0x0120, sdsnew("Gdotaccent"));
-	GlyphOrder.setByGID(map, 0x0048, sdsnew("H"));
-	GlyphOrder.setByGID(map, 0x25CF, sdsnew("H18533"));
-	GlyphOrder.setByGID(map, 0x25AA, sdsnew("H18543"));
-	GlyphOrder.setByGID(map, 0x25AB, sdsnew("H18551"));
-	GlyphOrder.setByGID(map, 0x25A1, sdsnew("H22073"));
-	GlyphOrder.setByGID(map, 0x0126, sdsnew("Hbar"));
-	GlyphOrder.setByGID(map, 0x0124, sdsnew("Hcircumflex"));
-	GlyphOrder.setByGID(map, 0x0049, sdsnew("I"));
-	GlyphOrder.setByGID(map, 0x0132, sdsnew("IJ"));
-	GlyphOrder.setByGID(map, 0x00CD, sdsnew("Iacute"));
-	GlyphOrder.setByGID(map, 0x012C, sdsnew("Ibreve"));
-	GlyphOrder.setByGID(map, 0x00CE, sdsnew("Icircumflex"));
-	GlyphOrder.setByGID(map, 0x00CF, sdsnew("Idieresis"));
-	GlyphOrder.setByGID(map, 0x0130, sdsnew("Idotaccent"));
-	GlyphOrder.setByGID(map, 0x2111, sdsnew("Ifraktur"));
-	GlyphOrder.setByGID(map, 0x00CC, sdsnew("Igrave"));
-	GlyphOrder.setByGID(map, 0x012A, sdsnew("Imacron"));
-	GlyphOrder.setByGID(map, 0x012E, sdsnew("Iogonek"));
-	GlyphOrder.setByGID(map, 0x0399, sdsnew("Iota"));
-	GlyphOrder.setByGID(map, 0x03AA, sdsnew("Iotadieresis"));
-	GlyphOrder.setByGID(map, 0x038A, sdsnew("Iotatonos"));
-	GlyphOrder.setByGID(map, 0x0128, sdsnew("Itilde"));
-	GlyphOrder.setByGID(map, 0x004A, sdsnew("J"));
-	GlyphOrder.setByGID(map, 0x0134, sdsnew("Jcircumflex"));
-	GlyphOrder.setByGID(map, 0x004B, sdsnew("K"));
-	GlyphOrder.setByGID(map, 0x039A, sdsnew("Kappa"));
-	GlyphOrder.setByGID(map, 0x004C, sdsnew("L"));
-	GlyphOrder.setByGID(map, 0x0139, sdsnew("Lacute"));
-	GlyphOrder.setByGID(map, 0x039B, sdsnew("Lambda"));
-	GlyphOrder.setByGID(map, 0x013D, sdsnew("Lcaron"));
-	GlyphOrder.setByGID(map, 0x013F, sdsnew("Ldot"));
-	GlyphOrder.setByGID(map, 0x0141, sdsnew("Lslash"));
-	GlyphOrder.setByGID(map, 0x004D, sdsnew("M"));
-	GlyphOrder.setByGID(map, 0x039C, sdsnew("Mu"));
-	GlyphOrder.setByGID(map, 0x004E, sdsnew("N"));
-	GlyphOrder.setByGID(map, 0x0143, sdsnew("Nacute"));
-	GlyphOrder.setByGID(map, 0x0147, sdsnew("Ncaron"));
-	GlyphOrder.setByGID(map, 0x00D1, sdsnew("Ntilde"));
-	GlyphOrder.setByGID(map, 0x039D, sdsnew("Nu"));
-	GlyphOrder.setByGID(map, 0x004F, sdsnew("O"));
-	GlyphOrder.setByGID(map, 0x0152, sdsnew("OE"));
-	GlyphOrder.setByGID(map, 0x00D3, sdsnew("Oacute"));
-	GlyphOrder.setByGID(map, 0x014E, sdsnew("Obreve"));
-	GlyphOrder.setByGID(map, 0x00D4, sdsnew("Ocircumflex"));
-	GlyphOrder.setByGID(map, 0x00D6, sdsnew("Odieresis"));
-	GlyphOrder.setByGID(map, 0x00D2, sdsnew("Ograve"));
-	GlyphOrder.setByGID(map, 0x01A0, sdsnew("Ohorn"));
-	GlyphOrder.setByGID(map, 0x0150, sdsnew("Ohungarumlaut"));
-	GlyphOrder.setByGID(map, 0x014C, sdsnew("Omacron"));
-	GlyphOrder.setByGID(map, 0x2126, sdsnew("Omega"));
-	GlyphOrder.setByGID(map, 0x038F, sdsnew("Omegatonos"));
-	GlyphOrder.setByGID(map, 0x039F, sdsnew("Omicron"));
-	GlyphOrder.setByGID(map, 0x038C, sdsnew("Omicrontonos"));
-	GlyphOrder.setByGID(map, 0x00D8, sdsnew("Oslash"));
-	GlyphOrder.setByGID(map, 0x01FE, sdsnew("Oslashacute"));
-	GlyphOrder.setByGID(map, 0x00D5, sdsnew("Otilde"));
-	GlyphOrder.setByGID(map, 0x0050, sdsnew("P"));
-	GlyphOrder.setByGID(map, 0x03A6, sdsnew("Phi"));
-	GlyphOrder.setByGID(map, 0x03A0, sdsnew("Pi"));
-	GlyphOrder.setByGID(map, 0x03A8, sdsnew("Psi"));
-	GlyphOrder.setByGID(map, 0x0051, sdsnew("Q"));
-	GlyphOrder.setByGID(map, 0x0052, sdsnew("R"));
-	GlyphOrder.setByGID(map, 0x0154, sdsnew("Racute"));
-	GlyphOrder.setByGID(map, 0x0158, sdsnew("Rcaron"));
-	GlyphOrder.setByGID(map, 0x211C, sdsnew("Rfraktur"));
-	GlyphOrder.setByGID(map, 0x03A1, sdsnew("Rho"));
-	GlyphOrder.setByGID(map, 0x0053, sdsnew("S"));
-	GlyphOrder.setByGID(map, 0x250C, sdsnew("SF010000"));
-	GlyphOrder.setByGID(map, 0x2514, sdsnew("SF020000"));
-	GlyphOrder.setByGID(map, 0x2510, sdsnew("SF030000"));
-	GlyphOrder.setByGID(map, 0x2518, sdsnew("SF040000"));
-	GlyphOrder.setByGID(map, 0x253C, sdsnew("SF050000"));
-	GlyphOrder.setByGID(map, 0x252C, sdsnew("SF060000"));
-	GlyphOrder.setByGID(map, 0x2534, sdsnew("SF070000"));
-	GlyphOrder.setByGID(map, 0x251C, sdsnew("SF080000"));
-	GlyphOrder.setByGID(map, 0x2524, sdsnew("SF090000"));
-	GlyphOrder.setByGID(map, 0x2500, sdsnew("SF100000"));
-	GlyphOrder.setByGID(map, 0x2502, sdsnew("SF110000"));
-	GlyphOrder.setByGID(map, 0x2561, sdsnew("SF190000"));
-	GlyphOrder.setByGID(map, 0x2562, sdsnew("SF200000"));
-	GlyphOrder.setByGID(map, 0x2556, sdsnew("SF210000"));
-	GlyphOrder.setByGID(map, 0x2555, sdsnew("SF220000"));
-	GlyphOrder.setByGID(map, 0x2563, sdsnew("SF230000"));
-	GlyphOrder.setByGID(map, 0x2551, sdsnew("SF240000"));
-	GlyphOrder.setByGID(map, 0x2557, sdsnew("SF250000"));
-	GlyphOrder.setByGID(map, 0x255D, sdsnew("SF260000"));
-	GlyphOrder.setByGID(map, 0x255C, sdsnew("SF270000"));
-	GlyphOrder.setByGID(map, 0x255B, sdsnew("SF280000"));
-	GlyphOrder.setByGID(map, 0x255E, sdsnew("SF360000"));
-	GlyphOrder.setByGID(map, 0x255F, sdsnew("SF370000"));
-	GlyphOrder.setByGID(map, 0x255A, sdsnew("SF380000"));
-	GlyphOrder.setByGID(map, 0x2554, sdsnew("SF390000"));
-	GlyphOrder.setByGID(map, 0x2569, sdsnew("SF400000"));
-	GlyphOrder.setByGID(map, 0x2566, sdsnew("SF410000"));
-	GlyphOrder.setByGID(map, 0x2560, sdsnew("SF420000"));
-	GlyphOrder.setByGID(map, 0x2550, sdsnew("SF430000"));
-	GlyphOrder.setByGID(map, 0x256C, sdsnew("SF440000"));
-	GlyphOrder.setByGID(map, 0x2567, sdsnew("SF450000"));
-	GlyphOrder.setByGID(map, 0x2568, sdsnew("SF460000"));
-	GlyphOrder.setByGID(map, 0x2564, sdsnew("SF470000"));
-	GlyphOrder.setByGID(map, 0x2565, sdsnew("SF480000"));
-	GlyphOrder.setByGID(map, 0x2559, sdsnew("SF490000"));
-	GlyphOrder.setByGID(map, 0x2558, sdsnew("SF500000"));
-	GlyphOrder.setByGID(map, 0x2552, sdsnew("SF510000"));
-	GlyphOrder.setByGID(map, 0x2553, sdsnew("SF520000"));
-	GlyphOrder.setByGID(map, 0x256B, sdsnew("SF530000"));
-	GlyphOrder.setByGID(map, 0x256A, sdsnew("SF540000"));
-	GlyphOrder.setByGID(map, 0x015A, sdsnew("Sacute"));
-	GlyphOrder.setByGID(map, 0x0160, sdsnew("Scaron"));
-	GlyphOrder.setByGID(map, 0x015E, sdsnew("Scedilla"));
-	GlyphOrder.setByGID(map, 0x015C, sdsnew("Scircumflex"));
-	GlyphOrder.setByGID(map, 0x03A3, sdsnew("Sigma"));
-	GlyphOrder.setByGID(map, 0x0054, sdsnew("T"));
-	GlyphOrder.setByGID(map, 0x03A4, sdsnew("Tau"));
-	GlyphOrder.setByGID(map, 0x0166, sdsnew("Tbar"));
-	GlyphOrder.setByGID(map, 0x0164, sdsnew("Tcaron"));
-	GlyphOrder.setByGID(map, 0x0398, sdsnew("Theta"));
-	GlyphOrder.setByGID(map, 0x00DE, sdsnew("Thorn"));
-	GlyphOrder.setByGID(map, 0x0055, sdsnew("U"));
-	GlyphOrder.setByGID(map, 0x00DA, sdsnew("Uacute"));
-	GlyphOrder.setByGID(map, 0x016C, sdsnew("Ubreve"));
-	GlyphOrder.setByGID(map, 0x00DB, sdsnew("Ucircumflex"));
-	GlyphOrder.setByGID(map, 0x00DC, sdsnew("Udieresis"));
-	GlyphOrder.setByGID(map, 0x00D9, sdsnew("Ugrave"));
-	GlyphOrder.setByGID(map, 0x01AF, sdsnew("Uhorn"));
-	GlyphOrder.setByGID(map, 0x0170, sdsnew("Uhungarumlaut"));
-	GlyphOrder.setByGID(map, 0x016A, sdsnew("Umacron"));
-	GlyphOrder.setByGID(map, 0x0172, sdsnew("Uogonek"));
-	GlyphOrder.setByGID(map, 0x03A5, sdsnew("Upsilon"));
-	GlyphOrder.setByGID(map, 0x03D2, sdsnew("Upsilon1"));
-	GlyphOrder.setByGID(map, 0x03AB, sdsnew("Upsilondieresis"));
-	GlyphOrder.setByGID(map, 0x038E, sdsnew("Upsilontonos"));
-	GlyphOrder.setByGID(map, 0x016E, sdsnew("Uring"));
-	GlyphOrder.setByGID(map, 0x0168, sdsnew("Utilde"));
-	GlyphOrder.setByGID(map, 0x0056, sdsnew("V"));
-	GlyphOrder.setByGID(map, 0x0057, sdsnew("W"));
-	GlyphOrder.setByGID(map, 0x1E82, sdsnew("Wacute"));
-	GlyphOrder.setByGID(map, 0x0174, sdsnew("Wcircumflex"));
-	GlyphOrder.setByGID(map, 0x1E84, sdsnew("Wdieresis"));
-	GlyphOrder.setByGID(map, 0x1E80, sdsnew("Wgrave"));
-	GlyphOrder.setByGID(map, 0x0058, sdsnew("X"));
-	GlyphOrder.setByGID(map, 0x039E, sdsnew("Xi"));
-	GlyphOrder.setByGID(map, 0x0059, sdsnew("Y"));
-	GlyphOrder.setByGID(map, 0x00DD, sdsnew("Yacute"));
-	GlyphOrder.setByGID(map, 0x0176, sdsnew("Ycircumflex"));
-	GlyphOrder.setByGID(map, 0x0178, sdsnew("Ydieresis"));
-	GlyphOrder.setByGID(map, 0x1EF2, sdsnew("Ygrave"));
-	GlyphOrder.setByGID(map, 0x005A, sdsnew("Z"));
-	GlyphOrder.setByGID(map, 0x0179, sdsnew("Zacute"));
-	GlyphOrder.setByGID(map, 0x017D, sdsnew("Zcaron"));
-	GlyphOrder.setByGID(map, 0x017B, sdsnew("Zdotaccent"));
-	GlyphOrder.setByGID(map, 0x0396, sdsnew("Zeta"));
-	GlyphOrder.setByGID(map, 0x0061, sdsnew("a"));
-	GlyphOrder.setByGID(map, 0x00E1, sdsnew("aacute"));
-	GlyphOrder.setByGID(map, 0x0103, sdsnew("abreve"));
-	GlyphOrder.setByGID(map, 0x00E2, sdsnew("acircumflex"));
-	GlyphOrder.setByGID(map, 0x00B4, sdsnew("acute"));
-	GlyphOrder.setByGID(map, 0x0301, sdsnew("acutecomb"));
-	GlyphOrder.setByGID(map, 0x00E4, sdsnew("adieresis"));
-	GlyphOrder.setByGID(map, 0x00E6, sdsnew("ae"));
-	GlyphOrder.setByGID(map, 0x01FD, sdsnew("aeacute"));
-	GlyphOrder.setByGID(map, 0x00E0, sdsnew("agrave"));
-	GlyphOrder.setByGID(map, 0x2135, sdsnew("aleph"));
-	GlyphOrder.setByGID(map, 0x03B1, sdsnew("alpha"));
-	GlyphOrder.setByGID(map, 0x03AC, sdsnew("alphatonos"));
-	GlyphOrder.setByGID(map, 0x0101, sdsnew("amacron"));
-	GlyphOrder.setByGID(map, 0x0026, sdsnew("ampersand"));
-	GlyphOrder.setByGID(map, 0x2220, sdsnew("angle"));
-	GlyphOrder.setByGID(map, 0x2329, sdsnew("angleleft"));
-	GlyphOrder.setByGID(map, 0x232A, sdsnew("angleright"));
-	GlyphOrder.setByGID(map, 0x0387, sdsnew("anoteleia"));
-	GlyphOrder.setByGID(map, 0x0105, sdsnew("aogonek"));
-	GlyphOrder.setByGID(map, 0x2248, sdsnew("approxequal"));
-	GlyphOrder.setByGID(map, 0x00E5, sdsnew("aring"));
-	GlyphOrder.setByGID(map, 0x01FB, sdsnew("aringacute"));
-	GlyphOrder.setByGID(map, 0x2194, sdsnew("arrowboth"));
-	GlyphOrder.setByGID(map, 0x21D4, sdsnew("arrowdblboth"));
-	GlyphOrder.setByGID(map, 0x21D3, sdsnew("arrowdbldown"));
-	GlyphOrder.setByGID(map, 0x21D0, sdsnew("arrowdblleft"));
-	GlyphOrder.setByGID(map, 0x21D2, sdsnew("arrowdblright"));
-	GlyphOrder.setByGID(map, 0x21D1, sdsnew("arrowdblup"));
-	GlyphOrder.setByGID(map, 0x2193, sdsnew("arrowdown"));
-	GlyphOrder.setByGID(map, 0x2190, sdsnew("arrowleft"));
-	GlyphOrder.setByGID(map, 0x2192, sdsnew("arrowright"));
-	GlyphOrder.setByGID(map, 0x2191, sdsnew("arrowup"));
-	GlyphOrder.setByGID(map, 0x2195, sdsnew("arrowupdn"));
-	GlyphOrder.setByGID(map, 0x21A8, sdsnew("arrowupdnbse"));
-	GlyphOrder.setByGID(map, 0x005E, sdsnew("asciicircum"));
-	GlyphOrder.setByGID(map, 0x007E, sdsnew("asciitilde"));
-	GlyphOrder.setByGID(map, 0x002A, sdsnew("asterisk"));
-	GlyphOrder.setByGID(map, 0x2217, sdsnew("asteriskmath"));
-	GlyphOrder.setByGID(map, 0x0040, sdsnew("at"));
-	GlyphOrder.setByGID(map, 0x00E3, sdsnew("atilde"));
-	GlyphOrder.setByGID(map, 0x0062, sdsnew("b"));
-	GlyphOrder.setByGID(map, 0x005C, sdsnew("backslash"));
-	GlyphOrder.setByGID(map, 0x007C, sdsnew("bar"));
-	GlyphOrder.setByGID(map, 0x03B2, sdsnew("beta"));
-	GlyphOrder.setByGID(map, 0x2588, sdsnew("block"));
-	GlyphOrder.setByGID(map, 0x007B, sdsnew("braceleft"));
-	GlyphOrder.setByGID(map, 0x007D, sdsnew("braceright"));
-	GlyphOrder.setByGID(map, 0x005B, sdsnew("bracketleft"));
-	GlyphOrder.setByGID(map, 0x005D, sdsnew("bracketright"));
-	GlyphOrder.setByGID(map, 0x02D8, sdsnew("breve"));
-	GlyphOrder.setByGID(map, 0x00A6, sdsnew("brokenbar"));
-	GlyphOrder.setByGID(map, 0x2022, sdsnew("bullet"));
-	GlyphOrder.setByGID(map, 0x0063, sdsnew("c"));
-	GlyphOrder.setByGID(map, 0x0107, sdsnew("cacute"));
-	GlyphOrder.setByGID(map, 0x02C7, sdsnew("caron"));
-	GlyphOrder.setByGID(map, 0x21B5, sdsnew("carriagereturn"));
-	GlyphOrder.setByGID(map, 0x010D, sdsnew("ccaron"));
-	GlyphOrder.setByGID(map, 0x00E7, sdsnew("ccedilla"));
-	GlyphOrder.setByGID(map, 0x0109, sdsnew("ccircumflex"));
-	GlyphOrder.setByGID(map, 0x010B, sdsnew("cdotaccent"));
-	GlyphOrder.setByGID(map, 0x00B8, sdsnew("cedilla"));
-	GlyphOrder.setByGID(map, 0x00A2, sdsnew("cent"));
-	GlyphOrder.setByGID(map, 0x03C7, sdsnew("chi"));
-	GlyphOrder.setByGID(map, 0x25CB, sdsnew("circle"));
-	GlyphOrder.setByGID(map, 0x2297, sdsnew("circlemultiply"));
-	GlyphOrder.setByGID(map, 0x2295, sdsnew("circleplus"));
-	GlyphOrder.setByGID(map, 0x02C6, sdsnew("circumflex"));
-	GlyphOrder.setByGID(map, 0x2663, sdsnew("club"));
-	GlyphOrder.setByGID(map, 0x003A, sdsnew("colon"));
-	GlyphOrder.setByGID(map, 0x20A1, sdsnew("colonmonetary"));
-	GlyphOrder.setByGID(map, 0x002C, sdsnew("comma"));
-	GlyphOrder.setByGID(map, 0x2245, sdsnew("congruent"));
-	GlyphOrder.setByGID(map, 0x00A9, sdsnew("copyright"));
-	GlyphOrder.setByGID(map, 0x00A4, sdsnew("currency"));
-	GlyphOrder.setByGID(map, 0x0064, sdsnew("d"));
-	GlyphOrder.setByGID(map, 0x2020, sdsnew("dagger"));
-	GlyphOrder.setByGID(map, 0x2021, sdsnew("daggerdbl"));
-	GlyphOrder.setByGID(map, 0x010F, sdsnew("dcaron"));
-	GlyphOrder.setByGID(map, 0x0111, sdsnew("dcroat"));
-	GlyphOrder.setByGID(map, 0x00B0, sdsnew("degree"));
-	GlyphOrder.setByGID(map, 0x03B4, sdsnew("delta"));
-	GlyphOrder.setByGID(map, 0x2666, sdsnew("diamond"));
-	GlyphOrder.setByGID(map, 0x00A8, sdsnew("dieresis"));
-	GlyphOrder.setByGID(map, 0x0385, sdsnew("dieresistonos"));
-	GlyphOrder.setByGID(map, 0x00F7, sdsnew("divide"));
-	GlyphOrder.setByGID(map, 0x2593, sdsnew("dkshade"));
-	GlyphOrder.setByGID(map, 0x2584, sdsnew("dnblock"));
-	GlyphOrder.setByGID(map, 0x0024, sdsnew("dollar"));
-	GlyphOrder.setByGID(map, 0x20AB, sdsnew("dong"));
-	GlyphOrder.setByGID(map, 0x02D9, sdsnew("dotaccent"));
-	GlyphOrder.setByGID(map, 0x0323, sdsnew("dotbelowcomb"));
-	GlyphOrder.setByGID(map, 0x0131, sdsnew("dotlessi"));
-	GlyphOrder.setByGID(map, 0x22C5, sdsnew("dotmath"));
-	GlyphOrder.setByGID(map, 0x0065, sdsnew("e"));
-	GlyphOrder.setByGID(map, 0x00E9, sdsnew("eacute"));
-	GlyphOrder.setByGID(map, 0x0115, sdsnew("ebreve"));
-	GlyphOrder.setByGID(map, 0x011B, sdsnew("ecaron"));
-	GlyphOrder.setByGID(map, 0x00EA, sdsnew("ecircumflex"));
-	GlyphOrder.setByGID(map, 0x00EB, sdsnew("edieresis"));
-	GlyphOrder.setByGID(map, 0x0117, sdsnew("edotaccent"));
-	GlyphOrder.setByGID(map, 0x00E8, sdsnew("egrave"));
-	GlyphOrder.setByGID(map, 0x0038, sdsnew("eight"));
-	GlyphOrder.setByGID(map, 0x2208, sdsnew("element"));
-	GlyphOrder.setByGID(map, 0x2026, sdsnew("ellipsis"));
-	GlyphOrder.setByGID(map, 0x0113, sdsnew("emacron"));
-	GlyphOrder.setByGID(map, 0x2014, sdsnew("emdash"));
-	GlyphOrder.setByGID(map, 0x2205, sdsnew("emptyset"));
-	GlyphOrder.setByGID(map, 0x2013, sdsnew("endash"));
-	GlyphOrder.setByGID(map, 0x014B, sdsnew("eng"));
-	GlyphOrder.setByGID(map, 0x0119, sdsnew("eogonek"));
-	GlyphOrder.setByGID(map, 0x03B5, sdsnew("epsilon"));
-	GlyphOrder.setByGID(map, 0x03AD, sdsnew("epsilontonos"));
-	GlyphOrder.setByGID(map, 0x003D, sdsnew("equal"));
-	GlyphOrder.setByGID(map, 0x2261, sdsnew("equivalence"));
-	GlyphOrder.setByGID(map, 0x212E, sdsnew("estimated"));
-	GlyphOrder.setByGID(map, 0x03B7, sdsnew("eta"));
-	GlyphOrder.setByGID(map, 0x03AE, sdsnew("etatonos"));
-	GlyphOrder.setByGID(map, 0x00F0, sdsnew("eth"));
-	GlyphOrder.setByGID(map, 0x0021, sdsnew("exclam"));
-	GlyphOrder.setByGID(map, 0x203C, sdsnew("exclamdbl"));
-	GlyphOrder.setByGID(map, 0x00A1, sdsnew("exclamdown"));
-	GlyphOrder.setByGID(map, 0x2203, sdsnew("existential"));
-	GlyphOrder.setByGID(map, 0x0066, sdsnew("f"));
-	GlyphOrder.setByGID(map, 0x2640, sdsnew("female"));
-	GlyphOrder.setByGID(map, 0x2012, sdsnew("figuredash"));
-	GlyphOrder.setByGID(map, 0x25A0, sdsnew("filledbox"));
-	GlyphOrder.setByGID(map, 0x25AC, sdsnew("filledrect"));
-	GlyphOrder.setByGID(map, 0x0035, sdsnew("five"));
-	GlyphOrder.setByGID(map, 0x215D, sdsnew("fiveeighths"));
-	GlyphOrder.setByGID(map, 0x0192, sdsnew("florin"));
-	GlyphOrder.setByGID(map, 0x0034, sdsnew("four"));
-	GlyphOrder.setByGID(map, 0x2044, sdsnew("fraction"));
-	GlyphOrder.setByGID(map, 0x20A3, sdsnew("franc"));
-	GlyphOrder.setByGID(map, 0x0067, sdsnew("g"));
-	GlyphOrder.setByGID(map, 0x03B3, sdsnew("gamma"));
-	GlyphOrder.setByGID(map, 0x011F, sdsnew("gbreve"));
-	GlyphOrder.setByGID(map, 0x01E7, sdsnew("gcaron"));
-	GlyphOrder.setByGID(map, 0x011D, sdsnew("gcircumflex"));
-	GlyphOrder.setByGID(map, 0x0121, sdsnew("gdotaccent"));
-	GlyphOrder.setByGID(map, 0x00DF, sdsnew("germandbls"));
-	GlyphOrder.setByGID(map, 0x2207, sdsnew("gradient"));
-	GlyphOrder.setByGID(map, 0x0060, sdsnew("grave"));
-	GlyphOrder.setByGID(map, 0x0300, sdsnew("gravecomb"));
-	GlyphOrder.setByGID(map, 0x003E, sdsnew("greater"));
-	GlyphOrder.setByGID(map, 0x2265, sdsnew("greaterequal"));
-	GlyphOrder.setByGID(map, 0x00AB, sdsnew("guillemotleft"));
-	GlyphOrder.setByGID(map, 0x00BB, sdsnew("guillemotright"));
-	GlyphOrder.setByGID(map, 0x2039, sdsnew("guilsinglleft"));
-	GlyphOrder.setByGID(map, 0x203A, sdsnew("guilsinglright"));
-	GlyphOrder.setByGID(map, 0x0068, sdsnew("h"));
-	GlyphOrder.setByGID(map, 0x0127, sdsnew("hbar"));
-	GlyphOrder.setByGID(map, 0x0125, sdsnew("hcircumflex"));
-	GlyphOrder.setByGID(map, 0x2665, sdsnew("heart"));
-	GlyphOrder.setByGID(map, 0x0309, sdsnew("hookabovecomb"));
-	GlyphOrder.setByGID(map, 0x2302, sdsnew("house"));
-	GlyphOrder.setByGID(map, 0x02DD, sdsnew("hungarumlaut"));
-	GlyphOrder.setByGID(map, 0x002D, sdsnew("hyphen"));
-	GlyphOrder.setByGID(map, 0x0069, sdsnew("i"));
-	GlyphOrder.setByGID(map, 0x00ED, sdsnew("iacute"));
-	GlyphOrder.setByGID(map, 0x012D, sdsnew("ibreve"));
-	GlyphOrder.setByGID(map, 0x00EE, sdsnew("icircumflex"));
-	GlyphOrder.setByGID(map, 0x00EF, sdsnew("idieresis"));
-	GlyphOrder.setByGID(map, 0x00EC, sdsnew("igrave"));
-	GlyphOrder.setByGID(map, 0x0133, sdsnew("ij"));
-	GlyphOrder.setByGID(map, 0x012B, sdsnew("imacron"));
-	GlyphOrder.setByGID(map, 0x221E, sdsnew("infinity"));
-	GlyphOrder.setByGID(map, 0x222B, sdsnew("integral"));
-	GlyphOrder.setByGID(map, 0x2321, sdsnew("integralbt"));
-	GlyphOrder.setByGID(map, 0x2320, sdsnew("integraltp"));
-	GlyphOrder.setByGID(map, 0x2229, sdsnew("intersection"));
-	GlyphOrder.setByGID(map, 0x25D8, sdsnew("invbullet"));
-	GlyphOrder.setByGID(map, 0x25D9, sdsnew("invcircle"));
-	GlyphOrder.setByGID(map, 0x263B, sdsnew("invsmileface"));
-	GlyphOrder.setByGID(map, 0x012F, sdsnew("iogonek"));
-	GlyphOrder.setByGID(map, 0x03B9, sdsnew("iota"));
-	GlyphOrder.setByGID(map, 0x03CA, sdsnew("iotadieresis"));
-	GlyphOrder.setByGID(map, 0x0390, sdsnew("iotadieresistonos"));
-	GlyphOrder.setByGID(map, 0x03AF, sdsnew("iotatonos"));
-	GlyphOrder.setByGID(map, 0x0129, sdsnew("itilde"));
-	GlyphOrder.setByGID(map, 0x006A, sdsnew("j"));
-	GlyphOrder.setByGID(map, 0x0135, sdsnew("jcircumflex"));
-	GlyphOrder.setByGID(map, 0x006B, sdsnew("k"));
-	GlyphOrder.setByGID(map, 0x03BA, sdsnew("kappa"));
-	GlyphOrder.setByGID(map, 0x0138, sdsnew("kgreenlandic"));
-	GlyphOrder.setByGID(map, 0x006C, sdsnew("l"));
-	GlyphOrder.setByGID(map, 0x013A, sdsnew("lacute"));
-	GlyphOrder.setByGID(map, 0x03BB, sdsnew("lambda"));
-	GlyphOrder.setByGID(map, 0x013E, sdsnew("lcaron"));
-	GlyphOrder.setByGID(map, 0x0140, sdsnew("ldot"));
-	GlyphOrder.setByGID(map, 0x003C, sdsnew("less"));
-	GlyphOrder.setByGID(map, 0x2264, sdsnew("lessequal"));
-	GlyphOrder.setByGID(map, 0x258C, sdsnew("lfblock"));
-	GlyphOrder.setByGID(map, 0x20A4, sdsnew("lira"));
-	GlyphOrder.setByGID(map, 0x2227, sdsnew("logicaland"));
-	GlyphOrder.setByGID(map, 0x00AC, sdsnew("logicalnot"));
-	GlyphOrder.setByGID(map, 0x2228, sdsnew("logicalor"));
-	GlyphOrder.setByGID(map, 0x017F, sdsnew("longs"));
-	GlyphOrder.setByGID(map, 0x25CA, sdsnew("lozenge"));
-	GlyphOrder.setByGID(map, 0x0142, sdsnew("lslash"));
-	GlyphOrder.setByGID(map, 0x2591, sdsnew("ltshade"));
-	GlyphOrder.setByGID(map, 0x006D, sdsnew("m"));
-	GlyphOrder.setByGID(map, 0x00AF, sdsnew("macron"));
-	GlyphOrder.setByGID(map, 0x2642, sdsnew("male"));
-	GlyphOrder.setByGID(map, 0x2212, sdsnew("minus"));
-	GlyphOrder.setByGID(map, 0x2032, sdsnew("minute"));
-	GlyphOrder.setByGID(map, 0x00B5, sdsnew("mu"));
-	GlyphOrder.setByGID(map, 0x00D7, sdsnew("multiply"));
-	GlyphOrder.setByGID(map, 0x266A, sdsnew("musicalnote"));
-	GlyphOrder.setByGID(map, 0x266B, sdsnew("musicalnotedbl"));
-	GlyphOrder.setByGID(map, 0x006E, sdsnew("n"));
-	GlyphOrder.setByGID(map, 0x0144, sdsnew("nacute"));
-	GlyphOrder.setByGID(map, 0x0149, sdsnew("napostrophe"));
-	GlyphOrder.setByGID(map, 0x0148, sdsnew("ncaron"));
-	GlyphOrder.setByGID(map, 0x0039, sdsnew("nine"));
-	GlyphOrder.setByGID(map, 0x2209, sdsnew("notelement"));
-	GlyphOrder.setByGID(map, 0x2260, sdsnew("notequal"));
-	GlyphOrder.setByGID(map, 0x2284, sdsnew("notsubset"));
-	GlyphOrder.setByGID(map, 0x00F1, sdsnew("ntilde"));
-	GlyphOrder.setByGID(map, 0x03BD, sdsnew("nu"));
-	GlyphOrder.setByGID(map, 0x0023, sdsnew("numbersign"));
-	GlyphOrder.setByGID(map, 0x006F, sdsnew("o"));
-	GlyphOrder.setByGID(map, 0x00F3, sdsnew("oacute"));
-	GlyphOrder.setByGID(map, 0x014F, sdsnew("obreve"));
-	GlyphOrder.setByGID(map, 0x00F4, sdsnew("ocircumflex"));
-	GlyphOrder.setByGID(map, 0x00F6, sdsnew("odieresis"));
-	GlyphOrder.setByGID(map, 0x0153, sdsnew("oe"));
-	GlyphOrder.setByGID(map, 0x02DB, sdsnew("ogonek"));
-	GlyphOrder.setByGID(map, 0x00F2, sdsnew("ograve"));
-	GlyphOrder.setByGID(map, 0x01A1, sdsnew("ohorn"));
-	GlyphOrder.setByGID(map, 0x0151, sdsnew("ohungarumlaut"));
-	GlyphOrder.setByGID(map, 0x014D, sdsnew("omacron"));
-	GlyphOrder.setByGID(map, 0x03C9, sdsnew("omega"));
-	GlyphOrder.setByGID(map, 0x03D6, sdsnew("omega1"));
-	GlyphOrder.setByGID(map, 0x03CE, sdsnew("omegatonos"));
-	GlyphOrder.setByGID(map, 0x03BF, sdsnew("omicron"));
-	GlyphOrder.setByGID(map, 0x03CC, sdsnew("omicrontonos"));
-	GlyphOrder.setByGID(map, 0x0031, sdsnew("one"));
-	GlyphOrder.setByGID(map, 0x2024, sdsnew("onedotenleader"));
-	GlyphOrder.setByGID(map, 0x215B, sdsnew("oneeighth"));
-	GlyphOrder.setByGID(map, 0x00BD, sdsnew("onehalf"));
-	GlyphOrder.setByGID(map, 0x00BC, sdsnew("onequarter"));
-	GlyphOrder.setByGID(map, 0x2153, sdsnew("onethird"));
-	GlyphOrder.setByGID(map, 0x25E6, sdsnew("openbullet"));
-	GlyphOrder.setByGID(map, 0x00AA, sdsnew("ordfeminine"));
-	GlyphOrder.setByGID(map, 0x00BA, sdsnew("ordmasculine"));
-	GlyphOrder.setByGID(map, 0x221F, sdsnew("orthogonal"));
-	GlyphOrder.setByGID(map, 0x00F8, sdsnew("oslash"));
-	GlyphOrder.setByGID(map, 0x01FF, sdsnew("oslashacute"));
-	GlyphOrder.setByGID(map, 0x00F5, sdsnew("otilde"));
-	GlyphOrder.setByGID(map, 0x0070, sdsnew("p"));
-	GlyphOrder.setByGID(map, 0x00B6, sdsnew("paragraph"));
-	GlyphOrder.setByGID(map, 0x0028, sdsnew("parenleft"));
-	GlyphOrder.setByGID(map, 0x0029, sdsnew("parenright"));
-	GlyphOrder.setByGID(map, 0x2202, sdsnew("partialdiff"));
-	GlyphOrder.setByGID(map, 0x0025, sdsnew("percent"));
-	GlyphOrder.setByGID(map, 0x002E, sdsnew("period"));
-	GlyphOrder.setByGID(map, 0x00B7, sdsnew("periodcentered"));
-	GlyphOrder.setByGID(map, 0x22A5, sdsnew("perpendicular"));
-	GlyphOrder.setByGID(map, 0x2030, sdsnew("perthousand"));
-	GlyphOrder.setByGID(map, 0x20A7, sdsnew("peseta"));
-	GlyphOrder.setByGID(map, 0x03C6, sdsnew("phi"));
-	GlyphOrder.setByGID(map, 0x03D5, sdsnew("phi1"));
-	GlyphOrder.setByGID(map, 0x03C0, sdsnew("pi"));
-	GlyphOrder.setByGID(map, 0x002B, sdsnew("plus"));
-	GlyphOrder.setByGID(map, 0x00B1, sdsnew("plusminus"));
-	GlyphOrder.setByGID(map, 0x211E, sdsnew("prescription"));
-	GlyphOrder.setByGID(map, 0x220F, sdsnew("product"));
-	GlyphOrder.setByGID(map, 0x2282, sdsnew("propersubset"));
-	GlyphOrder.setByGID(map, 0x2283, sdsnew("propersuperset"));
-	GlyphOrder.setByGID(map, 0x221D, sdsnew("proportional"));
-	GlyphOrder.setByGID(map, 0x03C8, sdsnew("psi"));
-	GlyphOrder.setByGID(map, 0x0071, sdsnew("q"));
-	GlyphOrder.setByGID(map, 0x003F, sdsnew("question"));
-	GlyphOrder.setByGID(map, 0x00BF, sdsnew("questiondown"));
-	GlyphOrder.setByGID(map, 0x0022, sdsnew("quotedbl"));
-	GlyphOrder.setByGID(map, 0x201E, sdsnew("quotedblbase"));
-	GlyphOrder.setByGID(map, 0x201C, sdsnew("quotedblleft"));
-	GlyphOrder.setByGID(map, 0x201D, sdsnew("quotedblright"));
-	GlyphOrder.setByGID(map, 0x2018, sdsnew("quoteleft"));
-	GlyphOrder.setByGID(map, 0x201B, sdsnew("quotereversed"));
-	GlyphOrder.setByGID(map, 0x2019, sdsnew("quoteright"));
-	GlyphOrder.setByGID(map, 0x201A, sdsnew("quotesinglbase"));
-	GlyphOrder.setByGID(map, 0x0027, sdsnew("quotesingle"));
-	GlyphOrder.setByGID(map, 0x0072, sdsnew("r"));
-	GlyphOrder.setByGID(map, 0x0155, sdsnew("racute"));
-	GlyphOrder.setByGID(map, 0x221A, sdsnew("radical"));
-	GlyphOrder.setByGID(map, 0x0159, sdsnew("rcaron"));
-	GlyphOrder.setByGID(map, 0x2286, sdsnew("reflexsubset"));
-	GlyphOrder.setByGID(map, 0x2287, sdsnew("reflexsuperset"));
-	GlyphOrder.setByGID(map, 0x00AE, sdsnew("registered"));
-	GlyphOrder.setByGID(map, 0x2310, sdsnew("revlogicalnot"));
-	GlyphOrder.setByGID(map, 0x03C1, sdsnew("rho"));
-	GlyphOrder.setByGID(map, 0x02DA, sdsnew("ring"));
-	GlyphOrder.setByGID(map, 0x2590, sdsnew("rtblock"));
-	GlyphOrder.setByGID(map, 0x0073, sdsnew("s"));
-	GlyphOrder.setByGID(map, 0x015B, sdsnew("sacute"));
-	GlyphOrder.setByGID(map, 0x0161, sdsnew("scaron"));
-	GlyphOrder.setByGID(map, 0x015F, sdsnew("scedilla"));
-	GlyphOrder.setByGID(map, 0x015D, sdsnew("scircumflex"));
-	GlyphOrder.setByGID(map, 0x2033, sdsnew("second"));
-	GlyphOrder.setByGID(map, 0x00A7, sdsnew("section"));
-	GlyphOrder.setByGID(map, 0x003B, sdsnew("semicolon"));
-	GlyphOrder.setByGID(map, 0x0037, sdsnew("seven"));
-	GlyphOrder.setByGID(map, 0x215E, sdsnew("seveneighths"));
-	GlyphOrder.setByGID(map, 0x2592, sdsnew("shade"));
-	GlyphOrder.setByGID(map, 0x03C3, sdsnew("sigma"));
-	GlyphOrder.setByGID(map, 0x03C2, sdsnew("sigma1"));
-	GlyphOrder.setByGID(map, 0x223C, sdsnew("similar"));
-	GlyphOrder.setByGID(map, 0x0036, sdsnew("six"));
-	GlyphOrder.setByGID(map, 0x002F, sdsnew("slash"));
-	GlyphOrder.setByGID(map, 0x263A, sdsnew("smileface"));
-	GlyphOrder.setByGID(map, 0x0020, sdsnew("space"));
-	GlyphOrder.setByGID(map, 0x2660, sdsnew("spade"));
-	GlyphOrder.setByGID(map, 0x00A3, sdsnew("sterling"));
-	GlyphOrder.setByGID(map, 0x220B, sdsnew("suchthat"));
-	GlyphOrder.setByGID(map, 0x2211, sdsnew("summation"));
-	GlyphOrder.setByGID(map, 0x263C, sdsnew("sun"));
-	GlyphOrder.setByGID(map, 0x0074, sdsnew("t"));
-	GlyphOrder.setByGID(map, 0x03C4, sdsnew("tau"));
-	GlyphOrder.setByGID(map, 0x0167, sdsnew("tbar"));
-	GlyphOrder.setByGID(map, 0x0165, sdsnew("tcaron"));
-	GlyphOrder.setByGID(map, 0x2234, sdsnew("therefore"));
-	GlyphOrder.setByGID(map, 0x03B8, sdsnew("theta"));
-	GlyphOrder.setByGID(map, 0x03D1, sdsnew("theta1"));
-	GlyphOrder.setByGID(map, 0x00FE, sdsnew("thorn"));
-	GlyphOrder.setByGID(map, 0x0033, sdsnew("three"));
-	GlyphOrder.setByGID(map, 0x215C, sdsnew("threeeighths"));
-	GlyphOrder.setByGID(map, 0x00BE, sdsnew("threequarters"));
-	GlyphOrder.setByGID(map, 0x02DC, sdsnew("tilde"));
-	GlyphOrder.setByGID(map, 0x0303, sdsnew("tildecomb"));
-	GlyphOrder.setByGID(map, 0x0384, sdsnew("tonos"));
-	GlyphOrder.setByGID(map, 0x2122, sdsnew("trademark"));
-	GlyphOrder.setByGID(map, 0x25BC, sdsnew("triagdn"));
-	GlyphOrder.setByGID(map, 0x25C4, sdsnew("triaglf"));
-	GlyphOrder.setByGID(map, 0x25BA, sdsnew("triagrt"));
-	GlyphOrder.setByGID(map, 0x25B2, sdsnew("triagup"));
-	GlyphOrder.setByGID(map, 0x0032, sdsnew("two"));
-	GlyphOrder.setByGID(map, 0x2025, sdsnew("twodotenleader"));
-	GlyphOrder.setByGID(map, 0x2154, sdsnew("twothirds"));
-	GlyphOrder.setByGID(map, 0x0075, sdsnew("u"));
-	GlyphOrder.setByGID(map, 0x00FA, sdsnew("uacute"));
-	GlyphOrder.setByGID(map, 0x016D, sdsnew("ubreve"));
-	GlyphOrder.setByGID(map, 0x00FB, sdsnew("ucircumflex"));
-	GlyphOrder.setByGID(map, 0x00FC, sdsnew("udieresis"));
-	GlyphOrder.setByGID(map, 0x00F9, sdsnew("ugrave"));
-	GlyphOrder.setByGID(map, 0x01B0, sdsnew("uhorn"));
-	GlyphOrder.setByGID(map, 0x0171, sdsnew("uhungarumlaut"));
-	GlyphOrder.setByGID(map, 0x016B, sdsnew("umacron"));
-	GlyphOrder.setByGID(map, 0x005F, sdsnew("underscore"));
-	GlyphOrder.setByGID(map, 0x2017, sdsnew("underscoredbl"));
-	GlyphOrder.setByGID(map, 0x222A, sdsnew("union"));
-	GlyphOrder.setByGID(map, 0x2200, sdsnew("universal"));
-	GlyphOrder.setByGID(map, 0x0173, sdsnew("uogonek"));
-	GlyphOrder.setByGID(map, 0x2580, sdsnew("upblock"));
-	GlyphOrder.setByGID(map, 0x03C5, sdsnew("upsilon"));
-	GlyphOrder.setByGID(map, 0x03CB, sdsnew("upsilondieresis"));
-	GlyphOrder.setByGID(map, 0x03B0, sdsnew("upsilondieresistonos"));
-	GlyphOrder.setByGID(map, 0x03CD, sdsnew("upsilontonos"));
-	GlyphOrder.setByGID(map, 0x016F, sdsnew("uring"));
-	GlyphOrder.setByGID(map, 0x0169, sdsnew("utilde"));
-	GlyphOrder.setByGID(map, 0x0076, sdsnew("v"));
-	GlyphOrder.setByGID(map, 0x0077, sdsnew("w"));
-	GlyphOrder.setByGID(map, 0x1E83, sdsnew("wacute"));
-	GlyphOrder.setByGID(map, 0x0175, sdsnew("wcircumflex"));
-	GlyphOrder.setByGID(map, 0x1E85, sdsnew("wdieresis"));
-	GlyphOrder.setByGID(map, 0x2118, sdsnew("weierstrass"));
-	GlyphOrder.setByGID(map, 0x1E81, sdsnew("wgrave"));
-	GlyphOrder.setByGID(map, 0x0078, sdsnew("x"));
-	GlyphOrder.setByGID(map, 0x03BE, sdsnew("xi"));
-	GlyphOrder.setByGID(map, 0x0079, sdsnew("y"));
-	GlyphOrder.setByGID(map, 0x00FD, sdsnew("yacute"));
-	GlyphOrder.setByGID(map, 0x0177, sdsnew("ycircumflex"));
-	GlyphOrder.setByGID(map, 0x00FF, sdsnew("ydieresis"));
-	GlyphOrder.setByGID(map, 0x00A5, sdsnew("yen"));
-	GlyphOrder.setByGID(map, 0x1EF3, sdsnew("ygrave"));
-	GlyphOrder.setByGID(map, 0x007A, sdsnew("z"));
-	GlyphOrder.setByGID(map, 0x017A, sdsnew("zacute"));
-	GlyphOrder.setByGID(map, 0x017E, sdsnew("zcaron"));
-	GlyphOrder.setByGID(map, 0x017C, sdsnew("zdotaccent"));
-	GlyphOrder.setByGID(map, 0x0030, sdsnew("zero"));
-	GlyphOrder.setByGID(map, 0x03B6, sdsnew("zeta"));
+// This table contains standard AGLFN 1.7 glyph names, mapped to Unicode. It is generated by
+// tools/aglfn/generate.js from tools/aglfn/aglfn.txt; edit those instead.
+//
+// Both directions are looked up through two-level perfect hashes: a key is first hashed with
+// seed 0 into one of AGLFN_BUCKETS buckets, then hashed again with its bucket's seed into one
+// of AGLFN_SLOTS slots, which holds the index of its entry (0xFFFF when empty). The seeds are
+// searched so that no two entries share a slot; since any key may be looked up, the entry
+// found is still compared against the key.
+
+#define AGLFN_ENTRIES 586
+#define AGLFN_BUCKETS 128
+#define AGLFN_SLOTS 1024
+#define AGLFN_EMPTY 0xFFFF
+
+typedef struct {
+	uint16_t unicode;
+	const char *name;
+} aglfn_Entry;
+
+static const aglfn_Entry aglfnEntries[AGLFN_ENTRIES] = {
+	{0x0041, "A"},
+	{0x00C6, "AE"},
+	{0x01FC, "AEacute"},
+	{0x00C1, "Aacute"},
+	{0x0102, "Abreve"},
+	{0x00C2, "Acircumflex"},
+	{0x00C4, "Adieresis"},
+	{0x00C0, "Agrave"},
+	{0x0391, "Alpha"},
+	{0x0386, "Alphatonos"},
+	{0x0100, "Amacron"},
+	{0x0104, "Aogonek"},
+	{0x00C5, "Aring"},
+	{0x01FA, "Aringacute"},
+	{0x00C3, "Atilde"},
+	{0x0042, "B"},
+	{0x0392, "Beta"},
+	{0x0043, "C"},
+	{0x0106, "Cacute"},
+	{0x010C, "Ccaron"},
+	{0x00C7, "Ccedilla"},
+	{0x0108, "Ccircumflex"},
+	{0x010A, "Cdotaccent"},
+	{0x03A7, "Chi"},
+	{0x0044, "D"},
+	{0x010E, "Dcaron"},
+	{0x0110, "Dcroat"},
+	{0x2206, "Delta"},
+	{0x0045, "E"},
+	{0x00C9, "Eacute"},
+	{0x0114, "Ebreve"},
+	{0x011A, "Ecaron"},
+	{0x00CA, "Ecircumflex"},
+	{0x00CB, "Edieresis"},
+	{0x0116, "Edotaccent"},
+	{0x00C8, "Egrave"},
+	{0x0112, "Emacron"},
+	{0x014A, "Eng"},
+	{0x0118, "Eogonek"},
+	{0x0395, "Epsilon"},
+	{0x0388, "Epsilontonos"},
+	{0x0397, "Eta"},
+	{0x0389, "Etatonos"},
+	{0x00D0, "Eth"},
+	{0x20AC, "Euro"},
+	{0x0046, "F"},
+	{0x0047, "G"},
+	{0x0393, "Gamma"},
+	{0x011E, "Gbreve"},
+	{0x01E6, "Gcaron"},
+	{0x011C, "Gcircumflex"},
+	{0x0120, "Gdotaccent"},
+	{0x0048, "H"},
+	{0x25CF, "H18533"},
+	{0x25AA, "H18543"},
+	{0x25AB, "H18551"},
+	{0x25A1, "H22073"},
+	{0x0126, "Hbar"},
+	{0x0124, "Hcircumflex"},
+	{0x0049, "I"},
+	{0x0132, "IJ"},
+	{0x00CD, "Iacute"},
+	{0x012C, "Ibreve"},
+	{0x00CE, "Icircumflex"},
+	{0x00CF, "Idieresis"},
+	{0x0130, "Idotaccent"},
+	{0x2111, "Ifraktur"},
+	{0x00CC, "Igrave"},
+	{0x012A, "Imacron"},
+	{0x012E, "Iogonek"},
+	{0x0399, "Iota"},
+	{0x03AA, "Iotadieresis"},
+	{0x038A, "Iotatonos"},
+	{0x0128, "Itilde"},
+	{0x004A, "J"},
+	{0x0134, "Jcircumflex"},
+	{0x004B, "K"},
+	{0x039A, "Kappa"},
+	{0x004C, "L"},
+	{0x0139, "Lacute"},
+	{0x039B, "Lambda"},
+	{0x013D, "Lcaron"},
+	{0x013F, "Ldot"},
+	{0x0141, "Lslash"},
+	{0x004D, "M"},
+	{0x039C, "Mu"},
+	{0x004E, "N"},
+	{0x0143, "Nacute"},
+	{0x0147, "Ncaron"},
+	{0x00D1, "Ntilde"},
+	{0x039D, "Nu"},
+	{0x004F, "O"},
+	{0x0152, "OE"},
+	{0x00D3, "Oacute"},
+	{0x014E, "Obreve"},
+	{0x00D4, "Ocircumflex"},
+	{0x00D6, "Odieresis"},
+	{0x00D2, "Ograve"},
+	{0x01A0, "Ohorn"},
+	{0x0150, "Ohungarumlaut"},
+	{0x014C, "Omacron"},
+	{0x2126, "Omega"},
+	{0x038F, "Omegatonos"},
+	{0x039F, "Omicron"},
+	{0x038C, "Omicrontonos"},
+	{0x00D8, "Oslash"},
+	{0x01FE, "Oslashacute"},
+	{0x00D5, "Otilde"},
+	{0x0050, "P"},
+	{0x03A6, "Phi"},
+	{0x03A0, "Pi"},
+	{0x03A8, "Psi"},
+	{0x0051, "Q"},
+	{0x0052, "R"},
+	{0x0154, "Racute"},
+	{0x0158, "Rcaron"},
+	{0x211C, "Rfraktur"},
+	{0x03A1, "Rho"},
+	{0x0053, "S"},
+	{0x250C, "SF010000"},
+	{0x2514, "SF020000"},
+	{0x2510, "SF030000"},
+	{0x2518, "SF040000"},
+	{0x253C, "SF050000"},
+	{0x252C, "SF060000"},
+	{0x2534, "SF070000"},
+	{0x251C, "SF080000"},
+	{0x2524, "SF090000"},
+	{0x2500, "SF100000"},
+	{0x2502, "SF110000"},
+	{0x2561, "SF190000"},
+	{0x2562, "SF200000"},
+	{0x2556, "SF210000"},
+	{0x2555, "SF220000"},
+	{0x2563, "SF230000"},
+	{0x2551, "SF240000"},
+	{0x2557, "SF250000"},
+	{0x255D, "SF260000"},
+	{0x255C, "SF270000"},
+	{0x255B, "SF280000"},
+	{0x255E, "SF360000"},
+	{0x255F, "SF370000"},
+	{0x255A, "SF380000"},
+	{0x2554, "SF390000"},
+	{0x2569, "SF400000"},
+	{0x2566, "SF410000"},
+	{0x2560, "SF420000"},
+	{0x2550, "SF430000"},
+	{0x256C, "SF440000"},
+	{0x2567, "SF450000"},
+	{0x2568, "SF460000"},
+	{0x2564, "SF470000"},
+	{0x2565, "SF480000"},
+	{0x2559, "SF490000"},
+	{0x2558, "SF500000"},
+	{0x2552, "SF510000"},
+	{0x2553, "SF520000"},
+	{0x256B, "SF530000"},
+	{0x256A, "SF540000"},
+	{0x015A, "Sacute"},
+	{0x0160, "Scaron"},
+	{0x015E, "Scedilla"},
+	{0x015C, "Scircumflex"},
+	{0x03A3, "Sigma"},
+	{0x0054, "T"},
+	{0x03A4, "Tau"},
+	{0x0166, "Tbar"},
+	{0x0164, "Tcaron"},
+	{0x0398, "Theta"},
+	{0x00DE, "Thorn"},
+	{0x0055, "U"},
+	{0x00DA, "Uacute"},
+	{0x016C, "Ubreve"},
+	{0x00DB, "Ucircumflex"},
+	{0x00DC, "Udieresis"},
+	{0x00D9, "Ugrave"},
+	{0x01AF, "Uhorn"},
+	{0x0170, "Uhungarumlaut"},
+	{0x016A, "Umacron"},
+	{0x0172, "Uogonek"},
+	{0x03A5, "Upsilon"},
+	{0x03D2, "Upsilon1"},
+	{0x03AB, "Upsilondieresis"},
+	{0x038E, "Upsilontonos"},
+	{0x016E, "Uring"},
+	{0x0168, "Utilde"},
+	{0x0056, "V"},
+	{0x0057, "W"},
+	{0x1E82, "Wacute"},
+	{0x0174, "Wcircumflex"},
+	{0x1E84, "Wdieresis"},
+	{0x1E80, "Wgrave"},
+	{0x0058, "X"},
+	{0x039E, "Xi"},
+	{0x0059, "Y"},
+	{0x00DD, "Yacute"},
+	{0x0176, "Ycircumflex"},
+	{0x0178, "Ydieresis"},
+	{0x1EF2, "Ygrave"},
+	{0x005A, "Z"},
+	{0x0179, "Zacute"},
+	{0x017D, "Zcaron"},
+	{0x017B, "Zdotaccent"},
+	{0x0396, "Zeta"},
+	{0x0061, "a"},
+	{0x00E1, "aacute"},
+	{0x0103, "abreve"},
+	{0x00E2, "acircumflex"},
+	{0x00B4, "acute"},
+	{0x0301, "acutecomb"},
+	{0x00E4, "adieresis"},
+	{0x00E6, "ae"},
+	{0x01FD, "aeacute"},
+	{0x00E0, "agrave"},
+	{0x2135, "aleph"},
+	{0x03B1, "alpha"},
+	{0x03AC, "alphatonos"},
+	{0x0101, "amacron"},
+	{0x0026, "ampersand"},
+	{0x2220, "angle"},
+	{0x2329, "angleleft"},
+	{0x232A, "angleright"},
+	{0x0387, "anoteleia"},
+	{0x0105, "aogonek"},
+	{0x2248, "approxequal"},
+	{0x00E5, "aring"},
+	{0x01FB, "aringacute"},
+	{0x2194, "arrowboth"},
+	{0x21D4, "arrowdblboth"},
+	{0x21D3, "arrowdbldown"},
+	{0x21D0, "arrowdblleft"},
+	{0x21D2, "arrowdblright"},
+	{0x21D1, "arrowdblup"},
+	{0x2193, "arrowdown"},
+	{0x2190, "arrowleft"},
+	{0x2192, "arrowright"},
+	{0x2191, "arrowup"},
+	{0x2195, "arrowupdn"},
+	{0x21A8, "arrowupdnbse"},
+	{0x005E, "asciicircum"},
+	{0x007E, "asciitilde"},
+	{0x002A, "asterisk"},
+	{0x2217, "asteriskmath"},
+	{0x0040, "at"},
+	{0x00E3, "atilde"},
+	{0x0062, "b"},
+	{0x005C, "backslash"},
+	{0x007C, "bar"},
+	{0x03B2, "beta"},
+	{0x2588, "block"},
+	{0x007B, "braceleft"},
+	{0x007D, "braceright"},
+	{0x005B, "bracketleft"},
+	{0x005D, "bracketright"},
+	{0x02D8, "breve"},
+	{0x00A6, "brokenbar"},
+	{0x2022, "bullet"},
+	{0x0063, "c"},
+	{0x0107, "cacute"},
+	{0x02C7, "caron"},
+	{0x21B5, "carriagereturn"},
+	{0x010D, "ccaron"},
+	{0x00E7, "ccedilla"},
+	{0x0109, "ccircumflex"},
+	{0x010B, "cdotaccent"},
+	{0x00B8, "cedilla"},
+	{0x00A2, "cent"},
+	{0x03C7, "chi"},
+	{0x25CB, "circle"},
+	{0x2297, "circlemultiply"},
+	{0x2295, "circleplus"},
+	{0x02C6, "circumflex"},
+	{0x2663, "club"},
+	{0x003A, "colon"},
+	{0x20A1, "colonmonetary"},
+	{0x002C, "comma"},
+	{0x2245, "congruent"},
+	{0x00A9, "copyright"},
+	{0x00A4, "currency"},
+	{0x0064, "d"},
+	{0x2020, "dagger"},
+	{0x2021, "daggerdbl"},
+	{0x010F, "dcaron"},
+	{0x0111, "dcroat"},
+	{0x00B0, "degree"},
+	{0x03B4, "delta"},
+	{0x2666, "diamond"},
+	{0x00A8, "dieresis"},
+	{0x0385, "dieresistonos"},
+	{0x00F7, "divide"},
+	{0x2593, "dkshade"},
+	{0x2584, "dnblock"},
+	{0x0024, "dollar"},
+	{0x20AB, "dong"},
+	{0x02D9, "dotaccent"},
+	{0x0323, "dotbelowcomb"},
+	{0x0131, "dotlessi"},
+	{0x22C5, "dotmath"},
+	{0x0065, "e"},
+	{0x00E9, "eacute"},
+	{0x0115, "ebreve"},
+	{0x011B, "ecaron"},
+	{0x00EA, "ecircumflex"},
+	{0x00EB, "edieresis"},
+	{0x0117, "edotaccent"},
+	{0x00E8, "egrave"},
+	{0x0038, "eight"},
+	{0x2208, "element"},
+	{0x2026, "ellipsis"},
+	{0x0113, "emacron"},
+	{0x2014, "emdash"},
+	{0x2205, "emptyset"},
+	{0x2013, "endash"},
+	{0x014B, "eng"},
+	{0x0119, "eogonek"},
+	{0x03B5, "epsilon"},
+	{0x03AD, "epsilontonos"},
+	{0x003D, "equal"},
+	{0x2261, "equivalence"},
+	{0x212E, "estimated"},
+	{0x03B7, "eta"},
+	{0x03AE, "etatonos"},
+	{0x00F0, "eth"},
+	{0x0021, "exclam"},
+	{0x203C, "exclamdbl"},
+	{0x00A1, "exclamdown"},
+	{0x2203, "existential"},
+	{0x0066, "f"},
+	{0x2640, "female"},
+	{0x2012, "figuredash"},
+	{0x25A0, "filledbox"},
+	{0x25AC, "filledrect"},
+	{0x0035, "five"},
+	{0x215D, "fiveeighths"},
+	{0x0192, "florin"},
+	{0x0034, "four"},
+	{0x2044, "fraction"},
+	{0x20A3, "franc"},
+	{0x0067, "g"},
+	{0x03B3, "gamma"},
+	{0x011F, "gbreve"},
+	{0x01E7, "gcaron"},
+	{0x011D, "gcircumflex"},
+	{0x0121, "gdotaccent"},
+	{0x00DF, "germandbls"},
+	{0x2207, "gradient"},
+	{0x0060, "grave"},
+	{0x0300, "gravecomb"},
+	{0x003E, "greater"},
+	{0x2265, "greaterequal"},
+	{0x00AB, "guillemotleft"},
+	{0x00BB, "guillemotright"},
+	{0x2039, "guilsinglleft"},
+	{0x203A, "guilsinglright"},
+	{0x0068, "h"},
+	{0x0127, "hbar"},
+	{0x0125, "hcircumflex"},
+	{0x2665, "heart"},
+	{0x0309, "hookabovecomb"},
+	{0x2302, "house"},
+	{0x02DD, "hungarumlaut"},
+	{0x002D, "hyphen"},
+	{0x0069, "i"},
+	{0x00ED, "iacute"},
+	{0x012D, "ibreve"},
+	{0x00EE, "icircumflex"},
+	{0x00EF, "idieresis"},
+	{0x00EC, "igrave"},
+	{0x0133, "ij"},
+	{0x012B, "imacron"},
+	{0x221E, "infinity"},
+	{0x222B, "integral"},
+	{0x2321, "integralbt"},
+	{0x2320, "integraltp"},
+	{0x2229, "intersection"},
+	{0x25D8, "invbullet"},
+	{0x25D9, "invcircle"},
+	{0x263B, "invsmileface"},
+	{0x012F, "iogonek"},
+	{0x03B9, "iota"},
+	{0x03CA, "iotadieresis"},
+	{0x0390, "iotadieresistonos"},
+	{0x03AF, "iotatonos"},
+	{0x0129, "itilde"},
+	{0x006A, "j"},
+	{0x0135, "jcircumflex"},
+	{0x006B, "k"},
+	{0x03BA, "kappa"},
+	{0x0138, "kgreenlandic"},
+	{0x006C, "l"},
+	{0x013A, "lacute"},
+	{0x03BB, "lambda"},
+	{0x013E, "lcaron"},
+	{0x0140, "ldot"},
+	{0x003C, "less"},
+	{0x2264, "lessequal"},
+	{0x258C, "lfblock"},
+	{0x20A4, "lira"},
+	{0x2227, "logicaland"},
+	{0x00AC, "logicalnot"},
+	{0x2228, "logicalor"},
+	{0x017F, "longs"},
+	{0x25CA, "lozenge"},
+	{0x0142, "lslash"},
+	{0x2591, "ltshade"},
+	{0x006D, "m"},
+	{0x00AF, "macron"},
+	{0x2642, "male"},
+	{0x2212, "minus"},
+	{0x2032, "minute"},
+	{0x00B5, "mu"},
+	{0x00D7, "multiply"},
+	{0x266A, "musicalnote"},
+	{0x266B, "musicalnotedbl"},
+	{0x006E, "n"},
+	{0x0144, "nacute"},
+	{0x0149, "napostrophe"},
+	{0x0148, "ncaron"},
+	{0x0039, "nine"},
+	{0x2209, "notelement"},
+	{0x2260, "notequal"},
+	{0x2284, "notsubset"},
+	{0x00F1, "ntilde"},
+	{0x03BD, "nu"},
+	{0x0023, "numbersign"},
+	{0x006F, "o"},
+	{0x00F3, "oacute"},
+	{0x014F, "obreve"},
+	{0x00F4, "ocircumflex"},
+	{0x00F6, "odieresis"},
+	{0x0153, "oe"},
+	{0x02DB, "ogonek"},
+	{0x00F2, "ograve"},
+	{0x01A1, "ohorn"},
+	{0x0151, "ohungarumlaut"},
+	{0x014D, "omacron"},
+	{0x03C9, "omega"},
+	{0x03D6, "omega1"},
+	{0x03CE, "omegatonos"},
+	{0x03BF, "omicron"},
+	{0x03CC, "omicrontonos"},
+	{0x0031, "one"},
+	{0x2024, "onedotenleader"},
+	{0x215B, "oneeighth"},
+	{0x00BD, "onehalf"},
+	{0x00BC, "onequarter"},
+	{0x2153, "onethird"},
+	{0x25E6, "openbullet"},
+	{0x00AA, "ordfeminine"},
+	{0x00BA, "ordmasculine"},
+	{0x221F, "orthogonal"},
+	{0x00F8, "oslash"},
+	{0x01FF, "oslashacute"},
+	{0x00F5, "otilde"},
+	{0x0070, "p"},
+	{0x00B6, "paragraph"},
+	{0x0028, "parenleft"},
+	{0x0029, "parenright"},
+	{0x2202, "partialdiff"},
+	{0x0025, "percent"},
+	{0x002E, "period"},
+	{0x00B7, "periodcentered"},
+	{0x22A5, "perpendicular"},
+	{0x2030, "perthousand"},
+	{0x20A7, "peseta"},
+	{0x03C6, "phi"},
+	{0x03D5, "phi1"},
+	{0x03C0, "pi"},
+	{0x002B, "plus"},
+	{0x00B1, "plusminus"},
+	{0x211E, "prescription"},
+	{0x220F, "product"},
+	{0x2282, "propersubset"},
+	{0x2283, "propersuperset"},
+	{0x221D, "proportional"},
+	{0x03C8, "psi"},
+	{0x0071, "q"},
+	{0x003F, "question"},
+	{0x00BF, "questiondown"},
+	{0x0022, "quotedbl"},
+	{0x201E, "quotedblbase"},
+	{0x201C, "quotedblleft"},
+	{0x201D, "quotedblright"},
+	{0x2018, "quoteleft"},
+	{0x201B, "quotereversed"},
+	{0x2019, "quoteright"},
+	{0x201A, "quotesinglbase"},
+	{0x0027, "quotesingle"},
+	{0x0072, "r"},
+	{0x0155, "racute"},
+	{0x221A, "radical"},
+	{0x0159, "rcaron"},
+	{0x2286, "reflexsubset"},
+	{0x2287, "reflexsuperset"},
+	{0x00AE, "registered"},
+	{0x2310, "revlogicalnot"},
+	{0x03C1, "rho"},
+	{0x02DA, "ring"},
+	{0x2590, "rtblock"},
+	{0x0073, "s"},
+	{0x015B, "sacute"},
+	{0x0161, "scaron"},
+	{0x015F, "scedilla"},
+	{0x015D, "scircumflex"},
+	{0x2033, "second"},
+	{0x00A7, "section"},
+	{0x003B, "semicolon"},
+	{0x0037, "seven"},
+	{0x215E, "seveneighths"},
+	{0x2592, "shade"},
+	{0x03C3, "sigma"},
+	{0x03C2, "sigma1"},
+	{0x223C, "similar"},
+	{0x0036, "six"},
+	{0x002F, "slash"},
+	{0x263A, "smileface"},
+	{0x0020, "space"},
+	{0x2660, "spade"},
+	{0x00A3, "sterling"},
+	{0x220B, "suchthat"},
+	{0x2211, "summation"},
+	{0x263C, "sun"},
+	{0x0074, "t"},
+	{0x03C4, "tau"},
+	{0x0167, "tbar"},
+	{0x0165, "tcaron"},
+	{0x2234, "therefore"},
+	{0x03B8, "theta"},
+	{0x03D1, "theta1"},
+	{0x00FE, "thorn"},
+	{0x0033, "three"},
+	{0x215C, "threeeighths"},
+	{0x00BE, "threequarters"},
+	{0x02DC, "tilde"},
+	{0x0303, "tildecomb"},
+	{0x0384, "tonos"},
+	{0x2122, "trademark"},
+	{0x25BC, "triagdn"},
+	{0x25C4, "triaglf"},
+	{0x25BA, "triagrt"},
+	{0x25B2, "triagup"},
+	{0x0032, "two"},
+	{0x2025, "twodotenleader"},
+	{0x2154, "twothirds"},
+	{0x0075, "u"},
+	{0x00FA, "uacute"},
+	{0x016D, "ubreve"},
+	{0x00FB, "ucircumflex"},
+	{0x00FC, "udieresis"},
+	{0x00F9, "ugrave"},
+	{0x01B0, "uhorn"},
+	{0x0171, "uhungarumlaut"},
+	{0x016B, "umacron"},
+	{0x005F, "underscore"},
+	{0x2017, "underscoredbl"},
+	{0x222A, "union"},
+	{0x2200, "universal"},
+	{0x0173, "uogonek"},
+	{0x2580, "upblock"},
+	{0x03C5, "upsilon"},
+	{0x03CB, "upsilondieresis"},
+	{0x03B0, "upsilondieresistonos"},
+	{0x03CD, "upsilontonos"},
+	{0x016F, "uring"},
+	{0x0169, "utilde"},
+	{0x0076, "v"},
+	{0x0077, "w"},
+	{0x1E83, "wacute"},
+	{0x0175, "wcircumflex"},
+	{0x1E85, "wdieresis"},
+	{0x2118, "weierstrass"},
+	{0x1E81, "wgrave"},
+	{0x0078, "x"},
+	{0x03BE, "xi"},
+	{0x0079, "y"},
+	{0x00FD, "yacute"},
+	{0x0177, "ycircumflex"},
+	{0x00FF, "ydieresis"},
+	{0x00A5, "yen"},
+	{0x1EF3, "ygrave"},
+	{0x007A, "z"},
+	{0x017A, "zacute"},
+	{0x017E, "zcaron"},
+	{0x017C, "zdotaccent"},
+	{0x0030, "zero"},
+	{0x03B6, "zeta"},
+};
+
+static const uint8_t byUnicodeSeeds[128] = {
+	2, 1, 3, 6, 2, 4, 12, 1, 4, 12, 3, 5, 5, 1, 5, 2,
+	13, 4, 1, 15, 1, 3, 11, 28, 4, 1, 26, 1, 1, 0, 1, 16,
+	3, 5, 3, 6, 3, 9, 2, 1, 3, 2, 2, 2, 34, 3, 3, 1,
+	1, 2, 2, 14, 2, 1, 5, 7, 1, 3, 16, 5, 7, 3, 2, 8,
+	6, 3, 1, 1, 1, 5, 21, 14, 1, 1, 11, 1, 5, 3, 5, 3,
+	1, 16, 20, 6, 4, 0, 6, 12, 3, 9, 8, 5, 2, 12, 4, 2,
+	15, 6, 2, 3, 4, 2, 2, 6, 10, 17, 14, 9, 1, 9, 10, 2,
+	19, 31, 5, 23, 4, 1, 12, 31, 5, 11, 12, 12, 17, 2, 5, 7,
+};
+
+static const uint16_t byUnicodeSlots[1024] = {
+	0xFFFF, 0xFFFF, 0x01CF, 0x0100, 0xFFFF, 0x010C, 0x018D, 0xFFFF, 0x0096, 0xFFFF, 0xFFFF, 0x017D,
+	0x0046, 0x00F8, 0x0123, 0x010B, 0x000E, 0x010D, 0xFFFF, 0xFFFF, 0x022D, 0xFFFF, 0x01E7, 0xFFFF,
+	0x01BF, 0x0210, 0x0037, 0x0047, 0x0177, 0x0081, 0x016E, 0x00B5, 0x0013, 0xFFFF, 0x01A3, 0xFFFF,
+	0xFFFF, 0x00B6, 0x002D, 0x0195, 0x0188, 0x000F, 0x010F, 0x01CD, 0x01DF, 0xFFFF, 0x01F9, 0x00CD,
+	0x01F0, 0x01A1, 0x016F, 0xFFFF, 0x00B4, 0xFFFF, 0x00EE, 0x0121, 0x01C0, 0xFFFF, 0x00F3, 0x0065,
+	0x0190, 0x006C, 0x0127, 0x0217, 0x01C6, 0xFFFF, 0xFFFF, 0x0136, 0x002A, 0xFFFF, 0x00EA, 0xFFFF,
+	0x0192, 0xFFFF, 0xFFFF, 0x021E, 0x00E4, 0x0153, 0x003F, 0x0118, 0xFFFF, 0x01E8, 0xFFFF, 0xFFFF,
+	0x00FA, 0xFFFF, 0xFFFF, 0x017E, 0xFFFF, 0xFFFF, 0x0050, 0xFFFF, 0x021A, 0xFFFF, 0x021C, 0xFFFF,
+	0xFFFF, 0x0165, 0x0051, 0x0111, 0x01FE, 0x0236, 0x01AF, 0xFFFF, 0x019B, 0xFFFF, 0xFFFF, 0x00ED,
+	0xFFFF, 0x0197, 0x01A9, 0xFFFF, 0x00DF, 0x015B, 0x00CC, 0xFFFF, 0xFFFF, 0x0036, 0xFFFF, 0x0106,
+	0xFFFF, 0x0091, 0x0191, 0xFFFF, 0x00D3, 0xFFFF, 0x005F, 0x01F2, 0xFFFF, 0xFFFF, 0xFFFF, 0x00BB,
+	0x0172, 0x01AC, 0x00A9, 0x022A, 0xFFFF, 0x0110, 0xFFFF, 0x0064, 0x0203, 0xFFFF, 0xFFFF, 0x009A,
+	0x00E5, 0x0147, 0xFFFF, 0x01C1, 0x01D7, 0xFFFF, 0xFFFF, 0x01DE, 0xFFFF, 0xFFFF, 0xFFFF, 0x0184,
+	0x00F7, 0x01D2, 0x0087, 0xFFFF, 0x0015, 0xFFFF, 0xFFFF, 0x01CC, 0xFFFF, 0x01C3, 0xFFFF, 0x01FC,
+	0x0223, 0xFFFF, 0x0094, 0x010E, 0xFFFF, 0xFFFF, 0x0021, 0x0075, 0xFFFF, 0xFFFF, 0xFFFF, 0x005A,
+	0xFFFF, 0x0033, 0x0030, 0x000C, 0x00AE, 0x00B7, 0x00A7, 0x0245, 0x01B9, 0xFFFF, 0x00A6, 0x006A,
+	0xFFFF, 0xFFFF, 0xFFFF, 0x00D7, 0x00C8, 0xFFFF, 0xFFFF, 0x018C, 0xFFFF, 0xFFFF, 0xFFFF, 0x00AD,
+	0xFFFF, 0x013C, 0xFFFF, 0x01FB, 0xFFFF, 0x0242, 0x01D0, 0xFFFF, 0x0156, 0xFFFF, 0x0045, 0xFFFF,
+	0x0171, 0x00F5, 0x01DB, 0xFFFF, 0x0079, 0x0207, 0x0011, 0xFFFF, 0x011E, 0xFFFF, 0xFFFF, 0x0007,
+	0xFFFF, 0xFFFF, 0x0098, 0xFFFF, 0x01E3, 0x0176, 0x0170, 0xFFFF, 0x018E, 0xFFFF, 0x01DD, 0x023F,
+	0x001A, 0x00C0, 0xFFFF, 0xFFFF, 0xFFFF, 0x00EF, 0xFFFF, 0x01D9, 0xFFFF, 0xFFFF, 0x009D, 0xFFFF,
+	0x0108, 0xFFFF, 0x004D, 0x01EC, 0xFFFF, 0x0097, 0x006D, 0xFFFF, 0x0002, 0xFFFF, 0xFFFF, 0x00BD,
+	0xFFFF, 0xFFFF, 0xFFFF, 0x0012, 0x0232, 0xFFFF, 0x0246, 0xFFFF, 0x0040, 0xFFFF, 0xFFFF, 0x0139,
+	0xFFFF, 0x01AA, 0x0063, 0xFFFF, 0x01D6, 0xFFFF, 0x013B, 0x01A5, 0x011C, 0xFFFF, 0xFFFF, 0x0031,
+	0xFFFF, 0x0175, 0x017F, 0x004B, 0x00A2, 0xFFFF, 0x002B, 0xFFFF, 0xFFFF, 0x00A0, 0xFFFF, 0x018A,
+	0xFFFF, 0xFFFF, 0x00DD, 0x0070, 0xFFFF, 0xFFFF, 0x0043, 0x00C4, 0x008D, 0x0107, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x0061, 0x00B1, 0xFFFF, 0xFFFF, 0xFFFF, 0x020B, 0x016D, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x00D8, 0xFFFF, 0x012A, 0x007C, 0x001F, 0x0157, 0x0069, 0x022C, 0x00F1, 0x004E, 0xFFFF, 0xFFFF,
+	0x0145, 0xFFFF, 0x014C, 0xFFFF, 0x01B8, 0x0115, 0xFFFF, 0x01B3, 0xFFFF, 0xFFFF, 0x0249, 0x0039,
+	0xFFFF, 0x01C4, 0x0014, 0x0233, 0x00D2, 0x005E, 0xFFFF, 0xFFFF, 0x0032, 0x009E, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x0010, 0xFFFF, 0x00F0, 0x0020, 0x0125, 0x0224, 0x00C5, 0x01B0, 0xFFFF, 0x0162, 0x012B,
+	0xFFFF, 0x0130, 0xFFFF, 0x0158, 0xFFFF, 0x01F3, 0xFFFF, 0x01D4, 0x0003, 0x01A2, 0xFFFF, 0x00B9,
+	0xFFFF, 0xFFFF, 0x0166, 0x0215, 0x021D, 0x0143, 0x003E, 0xFFFF, 0xFFFF, 0x0225, 0x020A, 0x0066,
+	0x00CF, 0x0169, 0x0240, 0xFFFF, 0xFFFF, 0xFFFF, 0x00E2, 0x0154, 0x00E3, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x01C2, 0x0055, 0x017B, 0xFFFF, 0x00D5, 0x007A, 0x020C, 0x01EE, 0x00EC, 0xFFFF,
+	0x0027, 0x0149, 0xFFFF, 0xFFFF, 0xFFFF, 0x0133, 0xFFFF, 0xFFFF, 0x0028, 0x01D1, 0xFFFF, 0x00D9,
+	0xFFFF, 0x0230, 0x00D6, 0x008B, 0x00FC, 0xFFFF, 0xFFFF, 0x0009, 0x0239, 0xFFFF, 0x000A, 0x0185,
+	0xFFFF, 0x01F5, 0x0101, 0xFFFF, 0x015C, 0x00C1, 0x0008, 0xFFFF, 0xFFFF, 0x0086, 0xFFFF, 0xFFFF,
+	0x0105, 0xFFFF, 0xFFFF, 0x01E6, 0x00EB, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x021B, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x01B1, 0x014E, 0x01F8, 0xFFFF, 0xFFFF, 0xFFFF, 0x00DB, 0x0035, 0xFFFF, 0x01DC,
+	0x008A, 0x0112, 0xFFFF, 0xFFFF, 0x0228, 0xFFFF, 0xFFFF, 0x0200, 0x0164, 0xFFFF, 0x011D, 0x0206,
+	0x023E, 0x0089, 0x013A, 0x00C6, 0x016B, 0x015E, 0x000D, 0x0004, 0xFFFF, 0x01C8, 0xFFFF, 0x010A,
+	0xFFFF, 0x0048, 0x0155, 0x001E, 0x0187, 0x00AB, 0x01E4, 0xFFFF, 0x0088, 0xFFFF, 0xFFFF, 0x0198,
+	0x022F, 0x0180, 0x013F, 0x003D, 0x0218, 0x0022, 0x00B3, 0x01EB, 0xFFFF, 0x0026, 0x0220, 0x0148,
+	0xFFFF, 0x019D, 0x00F4, 0x01B4, 0x0237, 0xFFFF, 0xFFFF, 0x00E6, 0x023D, 0x019C, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x0049, 0xFFFF, 0xFFFF, 0x0056, 0xFFFF, 0xFFFF, 0x020F, 0xFFFF, 0x009C, 0x018F, 0xFFFF,
+	0xFFFF, 0x0060, 0x0189, 0x01E9, 0x00C7, 0xFFFF, 0xFFFF, 0x01F4, 0x001B, 0x0017, 0xFFFF, 0x0029,
+	0x0146, 0x007B, 0x00CB, 0xFFFF, 0x0054, 0x01A8, 0xFFFF, 0x019F, 0x0117, 0x0072, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x0134, 0x0099, 0x0216, 0xFFFF, 0xFFFF, 0xFFFF, 0x004F, 0x023A, 0xFFFF, 0xFFFF,
+	0x020E, 0x01DA, 0xFFFF, 0x0041, 0xFFFF, 0x0025, 0xFFFF, 0xFFFF, 0x00F6, 0x00DA, 0xFFFF, 0x003B,
+	0x0138, 0xFFFF, 0xFFFF, 0x002E, 0x01BD, 0x0212, 0xFFFF, 0xFFFF, 0x01B7, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x014B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0129, 0xFFFF, 0xFFFF, 0xFFFF, 0x0159, 0x00DE,
+	0x01FF, 0x0018, 0xFFFF, 0x0160, 0x0044, 0x0076, 0x0238, 0x0119, 0x023B, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x0016, 0x0024, 0xFFFF, 0xFFFF, 0x00AF, 0x00FF, 0xFFFF, 0x001D, 0xFFFF, 0x000B, 0x0068, 0x0114,
+	0x0152, 0x00E8, 0x0193, 0xFFFF, 0xFFFF, 0xFFFF, 0x004A, 0xFFFF, 0x00CA, 0x0071, 0x0109, 0x013E,
+	0xFFFF, 0x0090, 0xFFFF, 0xFFFF, 0x005B, 0xFFFF, 0xFFFF, 0xFFFF, 0x00AA, 0xFFFF, 0xFFFF, 0x006E,
+	0x0023, 0xFFFF, 0xFFFF, 0xFFFF, 0x0093, 0x00FE, 0x0226, 0x01ED, 0x0135, 0x0231, 0xFFFF, 0x0248,
+	0x00F2, 0x00B0, 0xFFFF, 0x023C, 0x0053, 0xFFFF, 0x01C7, 0x0052, 0x0067, 0x013D, 0xFFFF, 0xFFFF,
+	0x0082, 0xFFFF, 0x00D0, 0xFFFF, 0xFFFF, 0xFFFF, 0x0080, 0x022E, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x01E2, 0x005C, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x01A6, 0xFFFF,
+	0x0213, 0xFFFF, 0x0150, 0xFFFF, 0x0168, 0x01E0, 0xFFFF, 0xFFFF, 0x0219, 0x022B, 0xFFFF, 0xFFFF,
+	0x009B, 0x0131, 0x0247, 0x0222, 0xFFFF, 0xFFFF, 0x01BE, 0x0124, 0xFFFF, 0xFFFF, 0x01C5, 0xFFFF,
+	0x0077, 0xFFFF, 0xFFFF, 0xFFFF, 0x0132, 0xFFFF, 0x021F, 0x00D1, 0x0074, 0x0205, 0xFFFF, 0xFFFF,
+	0x017A, 0xFFFF, 0xFFFF, 0x0235, 0xFFFF, 0x0137, 0xFFFF, 0x0092, 0xFFFF, 0x0243, 0x011F, 0xFFFF,
+	0x00A3, 0x01AD, 0x00DC, 0xFFFF, 0x014F, 0x008E, 0xFFFF, 0x00E9, 0xFFFF, 0xFFFF, 0xFFFF, 0x01F6,
+	0xFFFF, 0xFFFF, 0xFFFF, 0x0201, 0x00AC, 0x01FD, 0xFFFF, 0x00C2, 0x01B6, 0x00E7, 0x01D5, 0x01F7,
+	0x0058, 0x0194, 0x0209, 0xFFFF, 0x018B, 0x0095, 0x0006, 0xFFFF, 0x0174, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0xFFFF, 0x019E, 0xFFFF, 0xFFFF, 0x0005, 0xFFFF, 0xFFFF, 0xFFFF, 0x0173, 0xFFFF,
+	0xFFFF, 0x00B2, 0x0062, 0x0234, 0x0140, 0x0202, 0xFFFF, 0x0244, 0xFFFF, 0x019A, 0xFFFF, 0x002C,
+	0x0122, 0x012C, 0x01CA, 0x01FA, 0x00A4, 0x00BE, 0x0084, 0x007D, 0x00A5, 0x00BC, 0x0073, 0x014A,
+	0xFFFF, 0x012D, 0x0178, 0xFFFF, 0x016C, 0x0229, 0xFFFF, 0xFFFF, 0xFFFF, 0x00E1, 0x01EA, 0x015A,
+	0x01A7, 0x00C9, 0xFFFF, 0xFFFF, 0xFFFF, 0x01AE, 0x0163, 0xFFFF, 0x0186, 0x01C9, 0xFFFF, 0x01A0,
+	0x00C3, 0x00CE, 0x01F1, 0x004C, 0x01B5, 0x0167, 0x0183, 0x00FD, 0x0151, 0xFFFF, 0x011B, 0x00D4,
+	0xFFFF, 0xFFFF, 0x01E1, 0x0126, 0x016A, 0xFFFF, 0xFFFF, 0xFFFF, 0x0161, 0xFFFF, 0x00BA, 0xFFFF,
+	0xFFFF, 0x0113, 0x0208, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x01BB, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x012F, 0x01CB, 0x0227, 0xFFFF, 0xFFFF, 0x007E, 0x01D8, 0x0103, 0x0204, 0xFFFF, 0x00A8, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x0057, 0xFFFF, 0x0182, 0x0179, 0x00BF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00FB, 0x015F,
+	0x017C, 0x01B2, 0x00F9, 0x015D, 0xFFFF, 0xFFFF, 0xFFFF, 0x01A4, 0x01BA, 0x005D, 0xFFFF, 0x0078,
+	0xFFFF, 0x0001, 0x0038, 0x01AB, 0x009F, 0xFFFF, 0xFFFF, 0xFFFF, 0x003A, 0x0000, 0x01D3, 0xFFFF,
+	0xFFFF, 0x0116, 0xFFFF, 0x008C, 0x0034, 0xFFFF, 0xFFFF, 0x0214, 0x0211, 0x01CE, 0xFFFF, 0xFFFF,
+	0x006F, 0x001C, 0xFFFF, 0x0181, 0xFFFF, 0x0128, 0xFFFF, 0x008F, 0x0104, 0x003C, 0x01E5, 0xFFFF,
+	0xFFFF, 0x0141, 0x00A1, 0x0196, 0x002F, 0x0241, 0x0019, 0x0059, 0x01EF, 0x0102, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x0221, 0x0042, 0xFFFF, 0x011A, 0x0142, 0xFFFF, 0xFFFF, 0xFFFF, 0x0085, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x0144, 0xFFFF, 0x007F, 0x014D, 0x012E, 0x00B8, 0x01BC, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x00E0, 0x020D, 0x0199, 0x0083, 0xFFFF, 0x006B, 0x0120, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+};
+
+static const uint8_t byNameSeeds[128] = {
+	3, 1, 3, 1, 1, 6, 1, 2, 10, 9, 22, 11, 1, 5, 3, 16,
+	15, 16, 7, 9, 1, 2, 2, 7, 8, 4, 1, 3, 4, 7, 11, 5,
+	4, 6, 12, 2, 1, 1, 3, 8, 7, 8, 6, 1, 2, 2, 5, 2,
+	2, 7, 4, 25, 3, 2, 2, 11, 9, 12, 1, 3, 4, 2, 2, 7,
+	4, 5, 19, 10, 1, 3, 0, 0, 2, 9, 1, 1, 4, 1, 14, 2,
+	5, 1, 4, 9, 7, 2, 1, 3, 1, 5, 3, 4, 9, 13, 9, 2,
+	1, 8, 3, 1, 4, 10, 4, 1, 2, 14, 32, 20, 25, 7, 35, 10,
+	29, 2, 16, 8, 0, 3, 13, 20, 1, 4, 11, 17, 8, 10, 10, 1,
+};
+
+static const uint16_t byNameSlots[1024] = {
+	0x0102, 0x00E4, 0xFFFF, 0x0122, 0x001B, 0x008C, 0x019E, 0xFFFF, 0xFFFF, 0x018D, 0xFFFF, 0x0079,
+	0x005C, 0x00C8, 0xFFFF, 0xFFFF, 0xFFFF, 0x01F4, 0x002B, 0xFFFF, 0xFFFF, 0x018B, 0xFFFF, 0x01EF,
+	0x020F, 0xFFFF, 0xFFFF, 0xFFFF, 0x00F4, 0x0243, 0xFFFF, 0x004A, 0x0046, 0x01DC, 0x0147, 0x01C9,
+	0xFFFF, 0x016B, 0xFFFF, 0x0068, 0xFFFF, 0x023C, 0x00A0, 0xFFFF, 0x00DF, 0x00FE, 0xFFFF, 0xFFFF,
+	0x004C, 0xFFFF, 0x012E, 0x00EB, 0x0146, 0x0049, 0x0043, 0x0028, 0x0077, 0xFFFF, 0xFFFF, 0x01DB,
+	0xFFFF, 0xFFFF, 0xFFFF, 0x01BF, 0x0004, 0x009E, 0x00C3, 0xFFFF, 0xFFFF, 0x022F, 0x0108, 0x0199,
+	0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00AF, 0xFFFF, 0x0153, 0x01B0, 0xFFFF, 0x008D, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x000B, 0x00E6, 0xFFFF, 0xFFFF, 0xFFFF, 0x0218, 0xFFFF, 0xFFFF, 0x018A, 0x0104, 0x023D,
+	0x01A1, 0xFFFF, 0x01ED, 0xFFFF, 0x0080, 0xFFFF, 0xFFFF, 0xFFFF, 0x01FA, 0xFFFF, 0x01D9, 0xFFFF,
+	0x00F3, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x005E, 0x0018, 0xFFFF, 0xFFFF, 0xFFFF, 0x01C8, 0xFFFF,
+	0x0156, 0x01F8, 0x005B, 0xFFFF, 0x015E, 0x010D, 0x0155, 0xFFFF, 0x00E7, 0xFFFF, 0xFFFF, 0x014C,
+	0x020E, 0xFFFF, 0x008E, 0x01D7, 0xFFFF, 0xFFFF, 0x01FE, 0xFFFF, 0xFFFF, 0x0014, 0x0012, 0x022D,
+	0x019D, 0x0237, 0xFFFF, 0x01D8, 0x007D, 0x0093, 0x01F6, 0xFFFF, 0x0091, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x01A3, 0xFFFF, 0x001C, 0xFFFF, 0x006A, 0xFFFF, 0xFFFF, 0xFFFF, 0x0242, 0xFFFF, 0x00D3, 0x01D3,
+	0x011B, 0x013A, 0x004F, 0x0191, 0xFFFF, 0xFFFF, 0x0127, 0x000C, 0xFFFF, 0x004B, 0xFFFF, 0x0109,
+	0x005A, 0x0182, 0xFFFF, 0x0208, 0xFFFF, 0x008A, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00F6, 0x01BD,
+	0xFFFF, 0x00BA, 0x01CE, 0xFFFF, 0x0131, 0xFFFF, 0xFFFF, 0xFFFF, 0x0114, 0x0007, 0x010B, 0x01BA,
+	0x003E, 0xFFFF, 0xFFFF, 0x01D1, 0x01F2, 0x01DE, 0xFFFF, 0x01E8, 0x0239, 0x011C, 0x00B4, 0x017C,
+	0x01F7, 0x01A6, 0x0192, 0x023A, 0xFFFF, 0x0052, 0x016C, 0x0011, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x009D, 0x0238, 0xFFFF, 0x019B, 0x01DF, 0x010A, 0x004E, 0xFFFF, 0x01EC, 0x00B5, 0xFFFF,
+	0x0201, 0xFFFF, 0x00F0, 0x0029, 0x0215, 0x0185, 0x002E, 0x01D5, 0xFFFF, 0xFFFF, 0xFFFF, 0x005F,
+	0x008F, 0x0070, 0x00B8, 0x00A6, 0xFFFF, 0xFFFF, 0x0056, 0xFFFF, 0x0179, 0x0194, 0xFFFF, 0x0101,
+	0x0063, 0x000E, 0x0060, 0x021F, 0x00BD, 0xFFFF, 0x01D4, 0x01A8, 0x00FB, 0x0135, 0xFFFF, 0x01AA,
+	0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0022, 0x0221, 0x0206, 0x0037, 0x018C, 0x01E6, 0xFFFF, 0x018F,
+	0x00AC, 0xFFFF, 0x00B6, 0x0180, 0xFFFF, 0xFFFF, 0x013F, 0xFFFF, 0xFFFF, 0xFFFF, 0x0120, 0x00E3,
+	0x0209, 0x022E, 0x00A2, 0xFFFF, 0x0023, 0xFFFF, 0x00FD, 0x0064, 0x0163, 0xFFFF, 0x01C1, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x001A, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0203, 0x0097, 0xFFFF, 0x019F, 0x0075,
+	0x0066, 0x0082, 0xFFFF, 0x00B9, 0x0095, 0x0219, 0x0054, 0x002F, 0xFFFF, 0xFFFF, 0x01B7, 0xFFFF,
+	0xFFFF, 0x00EA, 0x0162, 0xFFFF, 0xFFFF, 0xFFFF, 0x011D, 0xFFFF, 0x0021, 0xFFFF, 0x00DD, 0x023B,
+	0xFFFF, 0x0092, 0x001D, 0x01DD, 0x0117, 0x0220, 0x0188, 0x0111, 0xFFFF, 0x01E9, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x006C, 0x0173, 0xFFFF, 0x0190, 0xFFFF, 0x009A, 0x0062, 0xFFFF, 0x0100, 0x011E,
+	0x0032, 0xFFFF, 0x0133, 0x0193, 0xFFFF, 0xFFFF, 0x0030, 0x0142, 0x00B1, 0x001F, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0177, 0x01F5, 0x0084, 0x0198, 0x011F, 0xFFFF, 0xFFFF,
+	0x01B9, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00B0, 0xFFFF, 0x020B, 0x00EE, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x013B, 0x0042, 0xFFFF, 0x015F, 0xFFFF, 0x01B2, 0xFFFF, 0x017E, 0xFFFF, 0xFFFF, 0x0044,
+	0xFFFF, 0x0072, 0xFFFF, 0xFFFF, 0xFFFF, 0x00DC, 0xFFFF, 0xFFFF, 0x007B, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x0225, 0xFFFF, 0xFFFF, 0x00F7, 0xFFFF, 0x0186, 0x0138, 0x011A, 0x0050, 0xFFFF, 0x0086, 0xFFFF,
+	0x01B8, 0x0247, 0x0160, 0xFFFF, 0xFFFF, 0xFFFF, 0x0005, 0x0073, 0x01E0, 0x0231, 0x00AB, 0x00D7,
+	0xFFFF, 0xFFFF, 0x00F8, 0xFFFF, 0x0229, 0x0232, 0x018E, 0xFFFF, 0xFFFF, 0xFFFF, 0x01B5, 0xFFFF,
+	0x0125, 0xFFFF, 0x00A3, 0xFFFF, 0xFFFF, 0x0158, 0xFFFF, 0x0174, 0xFFFF, 0xFFFF, 0x01F3, 0xFFFF,
+	0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x01AF, 0x01C4, 0x00A8, 0xFFFF, 0xFFFF, 0x0249, 0x0034, 0x0036,
+	0x00A7, 0x0148, 0x012F, 0xFFFF, 0x013E, 0xFFFF, 0xFFFF, 0x01B4, 0xFFFF, 0x015B, 0x0017, 0x0078,
+	0x0136, 0xFFFF, 0x0130, 0x0090, 0xFFFF, 0x0175, 0xFFFF, 0xFFFF, 0x001E, 0x013C, 0xFFFF, 0x0098,
+	0xFFFF, 0x0119, 0xFFFF, 0xFFFF, 0x021C, 0xFFFF, 0x00CF, 0x0039, 0x01BC, 0xFFFF, 0xFFFF, 0x01E2,
+	0xFFFF, 0x00E0, 0xFFFF, 0x014B, 0xFFFF, 0x019A, 0x0107, 0xFFFF, 0x01D6, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x0167, 0xFFFF, 0x0154, 0xFFFF, 0xFFFF, 0x0025, 0x0144, 0xFFFF, 0x00A5, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x0159, 0xFFFF, 0x00FC, 0x01FB, 0xFFFF, 0x00CB, 0xFFFF, 0x0214, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x0184, 0xFFFF, 0x00BB, 0xFFFF, 0xFFFF, 0x0096, 0x0112, 0x000F, 0x0116, 0x00EC, 0xFFFF,
+	0xFFFF, 0x0165, 0xFFFF, 0x0213, 0x0099, 0xFFFF, 0xFFFF, 0x016E, 0x0000, 0xFFFF, 0x0197, 0x00F2,
+	0x023E, 0x00A9, 0x00D4, 0xFFFF, 0x01C5, 0xFFFF, 0x0103, 0xFFFF, 0x003D, 0xFFFF, 0xFFFF, 0x0027,
+	0x0058, 0x01FD, 0xFFFF, 0x0055, 0x0244, 0x00AA, 0x01FF, 0xFFFF, 0x0211, 0xFFFF, 0xFFFF, 0x003C,
+	0x020C, 0x00C4, 0xFFFF, 0x0113, 0x0002, 0xFFFF, 0xFFFF, 0x0223, 0xFFFF, 0x013D, 0xFFFF, 0x01F9,
+	0xFFFF, 0xFFFF, 0x0236, 0x008B, 0x0061, 0x0143, 0x0124, 0x003A, 0xFFFF, 0x0053, 0x002A, 0x000A,
+	0x0081, 0xFFFF, 0x00EF, 0xFFFF, 0x000D, 0x0010, 0xFFFF, 0x0083, 0x015C, 0x00C9, 0x00E2, 0x01E7,
+	0xFFFF, 0x00CE, 0x01F1, 0xFFFF, 0xFFFF, 0x0087, 0x00D8, 0x00C7, 0xFFFF, 0xFFFF, 0xFFFF, 0x0170,
+	0xFFFF, 0xFFFF, 0x00CC, 0x01E1, 0xFFFF, 0x0118, 0x006B, 0xFFFF, 0x0137, 0xFFFF, 0x00CD, 0xFFFF,
+	0x01CC, 0xFFFF, 0xFFFF, 0x0094, 0x0235, 0x00E1, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x021B,
+	0xFFFF, 0xFFFF, 0x0071, 0xFFFF, 0x0134, 0xFFFF, 0x014F, 0x0166, 0xFFFF, 0xFFFF, 0x009C, 0xFFFF,
+	0xFFFF, 0x0128, 0xFFFF, 0x0126, 0x012C, 0x01EE, 0x0139, 0x0041, 0x0150, 0xFFFF, 0xFFFF, 0x01C2,
+	0x021D, 0xFFFF, 0x003F, 0xFFFF, 0xFFFF, 0x004D, 0x01EA, 0x00DB, 0x00B2, 0x01A0, 0x0123, 0x0006,
+	0xFFFF, 0x016F, 0x0205, 0xFFFF, 0xFFFF, 0x0110, 0x0216, 0x01D0, 0x002D, 0xFFFF, 0x0189, 0xFFFF,
+	0x010E, 0x0026, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x010F, 0x0069, 0x0132, 0x01B1, 0xFFFF, 0xFFFF,
+	0x014A, 0x0227, 0xFFFF, 0x002C, 0x0187, 0x01AB, 0x0226, 0x015D, 0xFFFF, 0x01C7, 0x017A, 0x00D6,
+	0x01A5, 0x0001, 0xFFFF, 0x01E4, 0x0245, 0x01AD, 0x01A4, 0x0145, 0xFFFF, 0xFFFF, 0xFFFF, 0x00E5,
+	0xFFFF, 0x007A, 0x00CA, 0x0149, 0x0210, 0xFFFF, 0x0178, 0xFFFF, 0x0157, 0xFFFF, 0x01A2, 0xFFFF,
+	0xFFFF, 0x003B, 0x0038, 0xFFFF, 0x009F, 0xFFFF, 0xFFFF, 0x0234, 0xFFFF, 0x017D, 0x01CA, 0x0033,
+	0xFFFF, 0x0020, 0x0059, 0x00FF, 0xFFFF, 0x00C5, 0x00BE, 0x0200, 0x010C, 0xFFFF, 0xFFFF, 0xFFFF,
+	0xFFFF, 0x006F, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00DA, 0xFFFF, 0xFFFF, 0x00D0, 0x0013, 0x01AC,
+	0x0161, 0x0171, 0x00B7, 0x0228, 0x0233, 0xFFFF, 0x0031, 0xFFFF, 0xFFFF, 0x0019, 0x020A, 0xFFFF,
+	0x0045, 0x00C2, 0x0204, 0xFFFF, 0x0181, 0x0047, 0x00E9, 0x012D, 0x0140, 0x00BF, 0x0240, 0x0183,
+	0x022A, 0xFFFF, 0x01C0, 0x00D2, 0xFFFF, 0xFFFF, 0x022C, 0x01FC, 0x0169, 0x017B, 0xFFFF, 0x00AD,
+	0x0074, 0x015A, 0xFFFF, 0xFFFF, 0x0048, 0xFFFF, 0xFFFF, 0xFFFF, 0x00ED, 0xFFFF, 0xFFFF, 0x0196,
+	0x016A, 0xFFFF, 0xFFFF, 0xFFFF, 0x00F1, 0x00D9, 0x006D, 0x00FA, 0x00BC, 0xFFFF, 0xFFFF, 0xFFFF,
+	0x0040, 0x0151, 0xFFFF, 0xFFFF, 0xFFFF, 0x01BB, 0xFFFF, 0xFFFF, 0x0241, 0x00D1, 0xFFFF, 0x007C,
+	0x01E3, 0x00A4, 0xFFFF, 0x00E8, 0x0172, 0xFFFF, 0xFFFF, 0xFFFF, 0x00F5, 0x0168, 0xFFFF, 0xFFFF,
+	0x00DE, 0x0164, 0x01C3, 0x01C6, 0x014E, 0x0105, 0x00D5, 0x0129, 0xFFFF, 0x00F9, 0x00AE, 0x0016,
+	0x017F, 0x0217, 0x0230, 0x0212, 0xFFFF, 0xFFFF, 0x016D, 0x007F, 0x01B6, 0x00C6, 0xFFFF, 0x01CD,
+	0x01BE, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0121, 0x007E, 0x0246, 0xFFFF, 0x01DA, 0xFFFF, 0x01CF,
+	0x0009, 0xFFFF, 0x021A, 0x021E, 0x0035, 0xFFFF, 0xFFFF, 0xFFFF, 0x0106, 0x0015, 0xFFFF, 0xFFFF,
+	0xFFFF, 0xFFFF, 0x020D, 0xFFFF, 0x022B, 0xFFFF, 0x012B, 0xFFFF, 0xFFFF, 0x0003, 0x01E5, 0x005D,
+	0xFFFF, 0x0085, 0x0067, 0xFFFF, 0x0089, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0224, 0xFFFF, 0x0115,
+	0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0024, 0x00B3, 0xFFFF, 0x014D, 0xFFFF, 0x00C1, 0x01A7, 0x0248,
+	0x0141, 0x0008, 0xFFFF, 0x01CB, 0x0207, 0x009B, 0xFFFF, 0xFFFF, 0x023F, 0xFFFF, 0x0195, 0x019C,
+	0x0088, 0x00C0, 0x0202, 0x00A1, 0x0076, 0xFFFF, 0x01AE, 0x0152, 0x0176, 0xFFFF, 0x0057, 0x0051,
+	0xFFFF, 0xFFFF, 0xFFFF, 0x01D2, 0x01A9, 0x01F0, 0xFFFF, 0x0222, 0xFFFF, 0x006E, 0xFFFF, 0x0065,
+	0x01EB, 0x012A, 0x01B3, 0xFFFF,
+};
+
+static INLINE uint32_t fmix(uint32_t h) {
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+	return h;
+}
+static INLINE uint32_t hashUnicode(uint32_t u, uint32_t seed) {
+	return fmix(u ^ (seed * 0x9E3779B9u));
+}
+static INLINE uint32_t hashName(const char *name, size_t len, uint32_t seed) {
+	uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+	for (size_t j = 0; j < len; j++) {
+		h ^= (uint8_t)name[j];
+		h *= 16777619u;
+	}
+	return fmix(h);
+}
+
+const char *aglfn_nameOf(unicode_t u) {
+	if (u > 0xFFFF) return NULL;
+	uint32_t seed = byUnicodeSeeds[hashUnicode(u, 0) % AGLFN_BUCKETS];
+	uint16_t k = byUnicodeSlots[hashUnicode(u, seed) % AGLFN_SLOTS];
+	if (k == AGLFN_EMPTY || aglfnEntries[k].unicode != u) return NULL;
+	return aglfnEntries[k].name;
+}
+
+int32_t aglfn_unicodeOf(const char *name, size_t len) {
+	uint32_t seed = byNameSeeds[hashName(name, len, 0) % AGLFN_BUCKETS];
+	uint16_t k = byNameSlots[hashName(name, len, seed) % AGLFN_SLOTS];
+	if (k == AGLFN_EMPTY) return -1;
+	const char *candidate = aglfnEntries[k].name;
+	if (strncmp(candidate, name, len) || candidate[len]) return -1;
+	return aglfnEntries[k].unicode;
 }
@@ -1,6 +1,14 @@
 #ifndef CARYLL_SUPPORT_AGLFN_H
 #define CARYLL_SUPPORT_AGLFN_H
-#include "otfcc/glyph-order.h"
+#include <stddef.h>
+#include <stdint.h>
+#include "otfcc/primitives.h"
 
-void aglfn_setupNames(otfcc_GlyphOrder *map);
+// Standard AGLFN 1.7 glyph names. The tables are static and read-only, so lookups need no
+// setup and may run on any thread.
+
+// The AGLFN name of a code point, or NULL if it has none.
+const char *aglfn_nameOf(unicode_t u);
+// The code point of an AGLFN name, or -1 if the name is not in AGLFN.
+int32_t aglfn_unicodeOf(const char *name, size_t len);
 #endif
@@ -4,10 +4,17 @@
 #include <stdint.h>
 
 #define loggedStep(...)                                                                            \
-	for (bool ___loggedstep_v = (options->logger->startSDS(options->logger,                        \
-	                                                       sdscatprintf(sdsempty(), __VA_ARGS__)), \
-	                             true);                                                            \
-	     ___loggedstep_v; ___loggedstep_v = false, options->logger->finish(options->logger))
+	for (bool ___loggedstep_v =                                                                    \
+	         (otfcc_beginStep(options, sdscatprintf(sdsempty(), __VA_ARGS__)), true);              \
+	     ___loggedstep_v; ___loggedstep_v = false, otfcc_endStep(options))
+// A step which is only traced, not logged. The name is not even formatted unless tracing.
+#define tracedStep(...)                                                                            \
+	for (bool ___tracedstep_v =                                                                    \
+	         (options->tracer                                                                      \
+	              ? otfcc_traceBegin(options->tracer, sdscatprintf(sdsempty(), __VA_ARGS__))       \
+	              : (void)0,                                                                       \
+	          true);                                                                               \
+	     ___tracedstep_v; ___tracedstep_v = false, otfcc_traceEnd(options->tracer))
 #define logError(...)                                                                              \
 	options->logger->logSDS(options->logger, log_vl_critical, log_type_error,                      \
 	                        sdscatprintf(sdsempty(), __VA_ARGS__));
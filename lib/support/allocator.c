@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "support/otfcc-alloc.h"
+
+THREAD_LOCAL const otfcc_IAllocator *otfcc_threadAllocator = NULL;
+
+const otfcc_IAllocator *otfcc_useAllocator(const otfcc_IAllocator *allocator) {
+	const otfcc_IAllocator *previous = otfcc_threadAllocator;
+	otfcc_threadAllocator = allocator;
+	return previous;
+}
+const otfcc_IAllocator *otfcc_currentAllocator() {
+	return otfcc_threadAllocator;
+}
+
+// Returns when the failure callback asks for a retry; exits otherwise.
+static void allocationFailed(const otfcc_IAllocator *a, size_t n, unsigned long line) {
+	if (a && a->onFailure && a->onFailure(a->context, n)) return;
+	fprintf(stderr, "[%ld]Out of memory(%ld bytes)\n", line, (unsigned long)n);
+	exit(EXIT_FAILURE);
+}
+
+void *otfcc_allocate(size_t n, bool clean, unsigned long line) {
+	const otfcc_IAllocator *a = otfcc_threadAllocator;
+	while (true) {
+		void *p;
+		if (a && a->allocate) {
+			p = a->allocate(a->context, n);
+			if (p && clean) memset(p, 0, n);
+		} else {
+			p = clean ? calloc(n, 1) : malloc(n);
+		}
+		if (p) return p;
+		allocationFailed(a, n, line);
+	}
+}
+
+void *otfcc_reallocate(void *ptr, size_t n, unsigned long line) {
+	const otfcc_IAllocator *a = otfcc_threadAllocator;
+	while (true) {
+		void *p = (a && a->reallocate) ? a->reallocate(a->context, ptr, n) : realloc(ptr, n);
+		if (p) return p;
+		allocationFailed(a, n, line);
+	}
+}
+
+void otfcc_deallocate(void *ptr) {
+	const otfcc_IAllocator *a = otfcc_threadAllocator;
+	if (a && a->deallocate) {
+		if (ptr) a->deallocate(a->context, ptr);
+	} else {
+		free(ptr);
+	}
+}
+
+// JSON values are allocated like anything else, with the JSON allocator swapped in. json-builder
+// takes NULL for a failure, so empty blocks are given a byte.
+static THREAD_LOCAL const otfcc_IAllocator *jsonAllocator = NULL;
+
+const otfcc_IAllocator *otfcc_useJsonAllocator(const otfcc_IAllocator *allocator) {
+	const otfcc_IAllocator *previous = jsonAllocator;
+	jsonAllocator = allocator;
+	return previous;
+}
+void *otfcc_allocateJson(size_t n, bool clean) {
+	if (!n) n = 1;
+	const otfcc_IAllocator *previous = otfcc_useAllocator(jsonAllocator);
+	void *p = clean ? __caryll_allocate_clean(n, __LINE__) : __caryll_allocate_dirty(n, __LINE__);
+	otfcc_useAllocator(previous);
+	return p;
+}
+void *otfcc_reallocateJson(void *ptr, size_t n) {
+	if (!n) n = 1;
+	const otfcc_IAllocator *previous = otfcc_useAllocator(jsonAllocator);
+	void *p = __caryll_reallocate(ptr, n, __LINE__);
+	otfcc_useAllocator(previous);
+	return p;
+}
+void otfcc_deallocateJson(void *ptr) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(jsonAllocator);
+	__caryll_deallocate(ptr);
+	otfcc_useAllocator(previous);
+}
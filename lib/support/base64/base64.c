@@ -11,8 +11,7 @@ uint8_t *base64_encode(const uint8_t *src, size_t len, size_t *out_len) {
 
 	olen = (len + 3 - 1) / 3 * 4; /* 3-byte blocks to 4-byte */
 	olen++;                       /* nul termination */
-	out = __caryll_malloc(sizeof(uint8_t) * olen);
-	if (out == NULL) return NULL;
+	NEW_DIRTY_N(out, olen);
 
 	end = src + len;
 	in = src;
@@ -58,8 +57,8 @@ uint8_t *base64_decode(const uint8_t *src, size_t len, size_t *out_len) {
 
 	if (count % 4) return NULL;
 
-	pos = out = __caryll_malloc(sizeof(uint8_t) * count);
-	if (out == NULL) return NULL;
+	NEW_DIRTY_N(out, count + 1); // never NULL, even for empty input
+	pos = out;
 
 	count = 0;
 	for (i = 0; i < len; i++) {
@@ -0,0 +1,26 @@
+#include "brotli.h"
+#include "dep/brotli/encode.h"
+#include "dep/brotli/decode.h"
+#include "support/otfcc-alloc.h"
+
+caryll_Buffer *otfcc_brotliCompress(const uint8_t *data, size_t length) {
+	size_t bound = BrotliEncoderMaxCompressedSize(length);
+	if (!bound) return NULL;
+	uint8_t *out;
+	NEW(out, bound);
+	caryll_Buffer *buf = NULL;
+	if (BrotliEncoderCompress(BROTLI_MAX_QUALITY, 22, BROTLI_MODE_FONT, length, data, &bound,
+	                          out)) {
+		buf = bufnew();
+		bufwrite_bytes(buf, bound, out);
+	}
+	FREE(out);
+	return buf;
+}
+
+bool otfcc_brotliDecompress(const uint8_t *data, size_t length, uint8_t *out, size_t outLength) {
+	size_t produced = outLength;
+	// A stream longer than outLength stops for more output, and so fails as well.
+	return BrotliDecoderDecompress(length, data, &produced, out) == BROTLI_DECODER_RESULT_SUCCESS &&
+	       produced == outLength;
+}
@@ -0,0 +1,17 @@
+#ifndef CARYLL_SUPPORT_BROTLI_H
+#define CARYLL_SUPPORT_BROTLI_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "caryll/buffer.h"
+
+// Compresses data into a Brotli stream (RFC 7932), with the Brotli encoder at its best quality
+// over a 4M window, in its mode for fonts. Returns NULL when the encoder fails.
+caryll_Buffer *otfcc_brotliCompress(const uint8_t *data, size_t length);
+
+// Decompresses a Brotli stream into exactly outLength bytes, as WOFF2 knows the size of its
+// tables beforehand. Returns false when the stream is malformed or decodes into another length.
+bool otfcc_brotliDecompress(const uint8_t *data, size_t length, uint8_t *out, size_t outLength);
+
+#endif
@@ -0,0 +1,23 @@
+#include "deflate.h"
+#include "dep/zlib.h"
+#include "support/otfcc-alloc.h"
+
+// Data which zlib fails to compress comes back as it is, so that WOFF stores it uncompressed.
+caryll_Buffer *otfcc_zlibCompress(const uint8_t *data, size_t length) {
+	caryll_Buffer *buf = bufnew();
+	uLongf bound = compressBound((uLong)length);
+	uint8_t *out;
+	NEW(out, bound);
+	if (compress2(out, &bound, data, (uLong)length, Z_BEST_COMPRESSION) == Z_OK) {
+		bufwrite_bytes(buf, bound, out);
+	} else {
+		bufwrite_bytes(buf, length, data);
+	}
+	FREE(out);
+	return buf;
+}
+
+bool otfcc_zlibDecompress(const uint8_t *data, size_t length, uint8_t *out, size_t outLength) {
+	uLongf produced = (uLongf)outLength;
+	return uncompress(out, &produced, data, (uLong)length) == Z_OK && produced == outLength;
+}
@@ -0,0 +1,16 @@
+#ifndef CARYLL_SUPPORT_DEFLATE_H
+#define CARYLL_SUPPORT_DEFLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "caryll/buffer.h"
+
+// Compresses data into a zlib stream (RFC 1950), with zlib at its best compression level.
+caryll_Buffer *otfcc_zlibCompress(const uint8_t *data, size_t length);
+
+// Decompresses a zlib stream into exactly outLength bytes, checking its Adler-32. Returns false
+// when the stream is malformed or decodes into another length.
+bool otfcc_zlibDecompress(const uint8_t *data, size_t length, uint8_t *out, size_t outLength);
+
+#endif
@@ -45,7 +45,8 @@
 	}
 #define caryll_trivialCreate(T)                                                                    \
 	static __CARYLL_INLINE__ T *T##_create() {                                                     \
-		T *x = (T *)malloc(sizeof(T));                                                             \
+		T *x;                                                                                      \
+		NEW_DIRTY(x);                                                                              \
 		T##_init(x);                                                                               \
 		return x;                                                                                  \
 	}
@@ -79,7 +80,7 @@
 	static __CARYLL_INLINE__ void T##_free(MOVE T *x) {                                            \
 		if (!x) return;                                                                            \
 		T##_dispose(x);                                                                            \
-		__caryll_free(x);                                                                          \
+		__caryll_deallocate(x);                                                                    \
 	}
 #define caryll_trivialDup(T)                                                                       \
 	static __CARYLL_INLINE__ T T##_dup(const T src) {                                              \
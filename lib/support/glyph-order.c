@@ -2,67 +2,195 @@
 #include "otfcc/glyph-order.h"
 
 static INLINE void initGlyphOrder(otfcc_GlyphOrder *go) {
+	go->length = 0;
+	go->capacity = 0;
+	go->entries = NULL;
+	go->gidCapacity = 0;
 	go->byGID = NULL;
+	go->nameSlots = 0;
 	go->byName = NULL;
 }
 static INLINE void disposeGlyphOrder(otfcc_GlyphOrder *go) {
-	otfcc_GlyphOrderEntry *current, *temp;
-	HASH_ITER(hhID, go->byGID, current, temp) {
-		if (current->name) sdsfree(current->name);
-		HASH_DELETE(hhID, go->byGID, current);
-		HASH_DELETE(hhName, go->byName, current);
-		FREE(current);
+	for (uint32_t j = 0; j < go->length; j++) {
+		if (go->entries[j]->name) sdsfree(go->entries[j]->name);
+		FREE(go->entries[j]);
 	}
+	FREE(go->entries);
+	FREE(go->byGID);
+	FREE(go->byName);
+	initGlyphOrder(go);
 }
 caryll_standardRefTypeFn(otfcc_GlyphOrder, initGlyphOrder, disposeGlyphOrder);
 
+// FNV-1a, followed by a final mix so that the low bits used for the slot index are well
+// distributed even for names which differ only in their last characters.
+static INLINE uint32_t hashName(const char *name, size_t len) {
+	uint32_t h = 2166136261u;
+	for (size_t j = 0; j < len; j++) {
+		h ^= (uint8_t)name[j];
+		h *= 16777619u;
+	}
+	h ^= h >> 16;
+	h *= 0x85EBCA6Bu;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35u;
+	h ^= h >> 16;
+	return h;
+}
+
+static INLINE otfcc_GlyphOrderEntry *findName(const otfcc_GlyphOrder *go, const char *name,
+                                              size_t len, uint32_t hash) {
+	if (!go->nameSlots) return NULL;
+	uint32_t mask = go->nameSlots - 1;
+	for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask) {
+		otfcc_GlyphOrderEntry *e = go->byName[slot];
+		if (!e) return NULL;
+		if (e->hash == hash && sdslen(e->name) == len && memcmp(e->name, name, len) == 0) {
+			return e;
+		}
+	}
+}
+
+static void insertNameSlot(otfcc_GlyphOrderEntry **slots, uint32_t nSlots,
+                           otfcc_GlyphOrderEntry *e) {
+	uint32_t mask = nSlots - 1;
+	uint32_t slot = e->hash & mask;
+	while (slots[slot])
+		slot = (slot + 1) & mask;
+	slots[slot] = e;
+}
+
+static void growNames(otfcc_GlyphOrder *go, uint32_t n) {
+	if (n * 2 <= go->nameSlots) return;
+	uint32_t nSlots = go->nameSlots ? go->nameSlots : 0x100;
+	while (n * 2 > nSlots)
+		nSlots *= 2;
+	otfcc_GlyphOrderEntry **slots;
+	NEW(slots, nSlots);
+	for (uint32_t j = 0; j < go->nameSlots; j++) {
+		if (go->byName[j]) insertNameSlot(slots, nSlots, go->byName[j]);
+	}
+	FREE(go->byName);
+	go->byName = slots;
+	go->nameSlots = nSlots;
+}
+
+static void growGIDs(otfcc_GlyphOrder *go, glyphid_t gid) {
+	if (gid < go->gidCapacity) return;
+	uint32_t capacity = go->gidCapacity ? go->gidCapacity : 0x100;
+	while (gid >= capacity)
+		capacity *= 2;
+	RESIZE(go->byGID, capacity);
+	memset(go->byGID + go->gidCapacity, 0,
+	       (capacity - go->gidCapacity) * sizeof(otfcc_GlyphOrderEntry *));
+	go->gidCapacity = capacity;
+}
+
+// Creates an entry and makes it reachable by name; the caller places it by GID.
+static otfcc_GlyphOrderEntry *addEntry(otfcc_GlyphOrder *go, MOVE sds name, uint32_t hash) {
+	otfcc_GlyphOrderEntry *e;
+	NEW(e);
+	e->name = name;
+	e->hash = hash;
+	if (go->length >= go->capacity) {
+		go->capacity = go->capacity ? go->capacity * 2 : 0x100;
+		RESIZE(go->entries, go->capacity);
+	}
+	go->entries[go->length++] = e;
+	growNames(go, go->length);
+	insertNameSlot(go->byName, go->nameSlots, e);
+	return e;
+}
+static void placeByGID(otfcc_GlyphOrder *go, otfcc_GlyphOrderEntry *e, glyphid_t gid) {
+	e->gid = gid;
+	growGIDs(go, gid);
+	go->byGID[gid] = e;
+}
+
+static otfcc_GlyphOrderEntry *gordFindByName(const otfcc_GlyphOrder *go, const char *name,
+                                             size_t len) {
+	return findName(go, name, len, hashName(name, len));
+}
+static otfcc_GlyphOrderEntry *gordFindByGID(const otfcc_GlyphOrder *go, glyphid_t gid) {
+	return gid < go->gidCapacity ? go->byGID[gid] : NULL;
+}
+
 // Register a gid->name map
 static sds otfcc_setGlyphOrderByGID(otfcc_GlyphOrder *go, glyphid_t gid, sds name) {
-	otfcc_GlyphOrderEntry *s = NULL;
-	HASH_FIND(hhID, go->byGID, &gid, sizeof(glyphid_t), s);
+	otfcc_GlyphOrderEntry *s = gordFindByGID(go, gid);
 	if (s) {
 		// gid is already in the order table.
 		// reject this naming suggestion.
 		sdsfree(name);
 		return s->name;
 	} else {
-		otfcc_GlyphOrderEntry *t = NULL;
-		HASH_FIND(hhName, go->byName, name, sdslen(name), t);
-		if (t) {
+		if (gordFindByName(go, name, sdslen(name))) {
 			// The name is already in-use.
 			sdsfree(name);
 			name = sdscatprintf(sdsempty(), "$$gid%d", gid);
 		}
-		NEW(s);
-		s->gid = gid;
-		s->name = name;
-		HASH_ADD(hhID, go->byGID, gid, sizeof(glyphid_t), s);
-		HASH_ADD(hhName, go->byName, name[0], sdslen(s->name), s);
+		s = addEntry(go, name, hashName(name, sdslen(name)));
+		placeByGID(go, s, gid);
 	}
 	return name;
 }
 
 // Register a name->gid map
 static bool otfcc_setGlyphOrderByName(otfcc_GlyphOrder *go, sds name, glyphid_t gid) {
-	otfcc_GlyphOrderEntry *s = NULL;
-	HASH_FIND(hhName, go->byName, name, sdslen(name), s);
-	if (s) {
+	uint32_t hash = hashName(name, sdslen(name));
+	if (findName(go, name, sdslen(name), hash)) {
 		// name is already mapped to a glyph
 		// reject this naming suggestion
 		return false;
 	} else {
-		NEW(s);
-		s->gid = gid;
-		s->name = name;
-		HASH_ADD(hhID, go->byGID, gid, sizeof(glyphid_t), s);
-		HASH_ADD(hhName, go->byName, name[0], sdslen(s->name), s);
+		placeByGID(go, addEntry(go, name, hash), gid);
 		return true;
 	}
 }
 
+static otfcc_GlyphOrderEntry *gordPlaceByName(otfcc_GlyphOrder *go, MOVE sds name) {
+	uint32_t hash = hashName(name, sdslen(name));
+	otfcc_GlyphOrderEntry *s = findName(go, name, sdslen(name), hash);
+	if (s) {
+		sdsfree(name);
+		return s;
+	}
+	s = addEntry(go, name, hash);
+	s->gid = -1;
+	return s;
+}
+
+typedef struct {
+	otfcc_GlyphOrderEntry *entry;
+	uint32_t position;
+	otfcc_GlyphOrderComparator compare;
+} OrderRecord;
+static int byOrderRecord(const void *_a, const void *_b) {
+	const OrderRecord *a = _a, *b = _b;
+	int r = a->compare(a->entry, b->entry);
+	if (r) return r;
+	return a->position < b->position ? -1 : a->position > b->position ? 1 : 0;
+}
+static void gordOrderBy(otfcc_GlyphOrder *go, otfcc_GlyphOrderComparator compare) {
+	if (!go->length) return;
+	OrderRecord *records;
+	NEW(records, go->length);
+	for (uint32_t j = 0; j < go->length; j++) {
+		records[j].entry = go->entries[j];
+		records[j].position = j;
+		records[j].compare = compare;
+	}
+	qsort(records, go->length, sizeof(OrderRecord), byOrderRecord);
+	if (go->byGID) memset(go->byGID, 0, go->gidCapacity * sizeof(otfcc_GlyphOrderEntry *));
+	for (uint32_t j = 0; j < go->length; j++) {
+		go->entries[j] = records[j].entry;
+		placeByGID(go, go->entries[j], j);
+	}
+	FREE(records);
+}
+
 static bool otfcc_gordNameAFieldShared(otfcc_GlyphOrder *go, glyphid_t gid, sds *field) {
-	otfcc_GlyphOrderEntry *t;
-	HASH_FIND(hhID, go->byGID, &gid, sizeof(glyphid_t), t);
+	otfcc_GlyphOrderEntry *t = gordFindByGID(go, gid);
 	if (t != NULL) {
 		*field = t->name;
 		return true;
@@ -72,46 +200,75 @@ static bool otfcc_gordNameAFieldShared(otfcc_GlyphOrder *go, glyphid_t gid, sds
 	}
 }
 
-static bool otfcc_gordConsolidateHandle(otfcc_GlyphOrder *go, glyph_handle *h) {
+static INLINE bool handleHasName(const glyph_handle *h) {
+	return h->state == HANDLE_STATE_CONSOLIDATED || h->state == HANDLE_STATE_NAME;
+}
+static INLINE otfcc_GlyphOrderEntry *resolveHandle(const otfcc_GlyphOrder *go,
+                                                   const glyph_handle *h, uint32_t hash) {
+	otfcc_GlyphOrderEntry *t = NULL;
 	if (h->state == HANDLE_STATE_CONSOLIDATED) {
-		otfcc_GlyphOrderEntry *t;
-		HASH_FIND(hhName, go->byName, h->name, sdslen(h->name), t);
-		if (t) {
-			Handle.consolidateTo(h, t->gid, t->name);
-			return true;
-		}
-		HASH_FIND(hhName, go->byGID, &(h->index), sizeof(glyphid_t), t);
-		if (t) {
-			Handle.consolidateTo(h, t->gid, t->name);
-			return true;
-		}
+		t = findName(go, h->name, sdslen(h->name), hash);
+		if (!t) t = gordFindByGID(go, h->index);
 	} else if (h->state == HANDLE_STATE_NAME) {
-		otfcc_GlyphOrderEntry *t;
-		HASH_FIND(hhName, go->byName, h->name, sdslen(h->name), t);
-		if (t) {
-			Handle.consolidateTo(h, t->gid, t->name);
-			return true;
-		}
+		t = findName(go, h->name, sdslen(h->name), hash);
 	} else if (h->state == HANDLE_STATE_INDEX) {
-		sds name = NULL;
-		otfcc_gordNameAFieldShared(go, h->index, &name);
-		if (name) {
-			Handle.consolidateTo(h, h->index, name);
-			return true;
+		t = gordFindByGID(go, h->index);
+	}
+	return t;
+}
+
+static bool otfcc_gordConsolidateHandle(otfcc_GlyphOrder *go, glyph_handle *h) {
+	uint32_t hash = handleHasName(h) ? hashName(h->name, sdslen(h->name)) : 0;
+	otfcc_GlyphOrderEntry *t = resolveHandle(go, h, hash);
+	if (!t) return false;
+	Handle.consolidateToInterned(h, t->gid, t->name);
+	return true;
+}
+
+// Handles are resolved in batches: the names of a batch are hashed first and their slots
+// prefetched, so the table probes of one batch overlap instead of missing the cache in turn.
+#define GORD_BATCH 16
+static uint32_t otfcc_gordConsolidateHandles(otfcc_GlyphOrder *go, glyph_handle *handles,
+                                             uint32_t n, OUT uint32_t *missing) {
+	uint32_t nMissing = 0;
+	uint32_t hashes[GORD_BATCH];
+	uint32_t mask = go->nameSlots ? go->nameSlots - 1 : 0;
+	for (uint32_t j0 = 0; j0 < n; j0 += GORD_BATCH) {
+		uint32_t j1 = (n - j0 > GORD_BATCH) ? j0 + GORD_BATCH : n;
+		for (uint32_t j = j0; j < j1; j++) {
+			const glyph_handle *h = &handles[j];
+			hashes[j - j0] = handleHasName(h) ? hashName(h->name, sdslen(h->name)) : 0;
+#ifdef __GNUC__
+			if (go->byName) __builtin_prefetch(&go->byName[hashes[j - j0] & mask]);
+#endif
+		}
+		for (uint32_t j = j0; j < j1; j++) {
+			otfcc_GlyphOrderEntry *t = resolveHandle(go, &handles[j], hashes[j - j0]);
+			if (t) {
+				Handle.consolidateToInterned(&handles[j], t->gid, t->name);
+			} else {
+				if (missing) missing[nMissing] = j;
+				nMissing += 1;
+			}
 		}
 	}
-	return false;
+	return nMissing;
 }
 
 static bool gordLookupName(otfcc_GlyphOrder *go, sds name) {
-	otfcc_GlyphOrderEntry *t;
-	HASH_FIND(hhName, go->byName, name, sdslen(name), t);
-	if (t) return true;
-	return false;
+	return !!gordFindByName(go, name, sdslen(name));
 }
 
 const struct otfcc_GlyphOrderPackage otfcc_pkgGlyphOrder = {
-    caryll_standardRefTypeMethods(otfcc_GlyphOrder),  .setByGID = otfcc_setGlyphOrderByGID,
-    .setByName = otfcc_setGlyphOrderByName,           .nameAField_Shared = otfcc_gordNameAFieldShared,
-    .consolidateHandle = otfcc_gordConsolidateHandle, .lookupName = gordLookupName,
+    caryll_standardRefTypeMethods(otfcc_GlyphOrder),
+    .setByGID = otfcc_setGlyphOrderByGID,
+    .setByName = otfcc_setGlyphOrderByName,
+    .nameAField_Shared = otfcc_gordNameAFieldShared,
+    .consolidateHandle = otfcc_gordConsolidateHandle,
+    .consolidateHandles = otfcc_gordConsolidateHandles,
+    .lookupName = gordLookupName,
+    .findByName = gordFindByName,
+    .findByGID = gordFindByGID,
+    .placeByName = gordPlaceByName,
+    .orderBy = gordOrderBy,
 };
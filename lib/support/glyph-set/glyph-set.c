@@ -0,0 +1,151 @@
+#include "glyph-set.h"
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static INLINE uint32_t popcount64(uint64_t x) {
+	x = x - ((x >> 1) & 0x5555555555555555ULL);
+	x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+}
+static INLINE uint32_t ctz64(uint64_t x) {
+	unsigned long index;
+#ifdef _M_X64
+	_BitScanForward64(&index, x);
+	return (uint32_t)index;
+#else
+	// x86 has no 64-bit scan; x is nonzero, so one of the halves has a bit set.
+	if (_BitScanForward(&index, (unsigned long)x)) return (uint32_t)index;
+	_BitScanForward(&index, (unsigned long)(x >> 32));
+	return (uint32_t)index + 32;
+#endif
+}
+#else
+#define popcount64(x) ((uint32_t)__builtin_popcountll(x))
+#define ctz64(x) ((uint32_t)__builtin_ctzll(x))
+#endif
+
+otfcc_GlyphSet *otfcc_newGlyphSet() {
+	otfcc_GlyphSet *set;
+	NEW(set);
+	return set;
+}
+void otfcc_deleteGlyphSet(MOVE otfcc_GlyphSet *set) {
+	FREE(set);
+}
+void otfcc_glyphsetClear(otfcc_GlyphSet *set) {
+	memset(set->words, 0, sizeof(set->words));
+}
+
+void otfcc_glyphsetAddRange(otfcc_GlyphSet *set, glyphid_t start, glyphid_t end) {
+	if (start > end) return;
+	uint32_t w0 = start >> 6, w1 = end >> 6;
+	uint64_t head = ~(uint64_t)0 << (start & 63);
+	uint64_t tail = ~(uint64_t)0 >> (63 - (end & 63));
+	if (w0 == w1) {
+		set->words[w0] |= head & tail;
+		return;
+	}
+	set->words[w0] |= head;
+	for (uint32_t w = w0 + 1; w < w1; w++) {
+		set->words[w] = ~(uint64_t)0;
+	}
+	set->words[w1] |= tail;
+}
+
+uint32_t otfcc_glyphsetCount(const otfcc_GlyphSet *set) {
+	uint32_t n = 0;
+	for (uint32_t w = 0; w < OTFCC_GLYPHSET_WORDS; w++) {
+		n += popcount64(set->words[w]);
+	}
+	return n;
+}
+
+void otfcc_glyphsetUnion(otfcc_GlyphSet *set, const otfcc_GlyphSet *other) {
+	for (uint32_t w = 0; w < OTFCC_GLYPHSET_WORDS; w++) {
+		set->words[w] |= other->words[w];
+	}
+}
+void otfcc_glyphsetIntersect(otfcc_GlyphSet *set, const otfcc_GlyphSet *other) {
+	for (uint32_t w = 0; w < OTFCC_GLYPHSET_WORDS; w++) {
+		set->words[w] &= other->words[w];
+	}
+}
+void otfcc_glyphsetSubtract(otfcc_GlyphSet *set, const otfcc_GlyphSet *other) {
+	for (uint32_t w = 0; w < OTFCC_GLYPHSET_WORDS; w++) {
+		set->words[w] &= ~other->words[w];
+	}
+}
+bool otfcc_glyphsetEqual(const otfcc_GlyphSet *a, const otfcc_GlyphSet *b) {
+	return memcmp(a->words, b->words, sizeof(a->words)) == 0;
+}
+bool otfcc_glyphsetIsSubset(const otfcc_GlyphSet *a, const otfcc_GlyphSet *b) {
+	for (uint32_t w = 0; w < OTFCC_GLYPHSET_WORDS; w++) {
+		if (a->words[w] & ~b->words[w]) return false;
+	}
+	return true;
+}
+
+bool otfcc_glyphsetNext(const otfcc_GlyphSet *set, uint32_t from, OUT glyphid_t *gid) {
+	if (from > 0xFFFF) return false;
+	uint32_t w = from >> 6;
+	uint64_t word = set->words[w] & (~(uint64_t)0 << (from & 63));
+	while (!word) {
+		w += 1;
+		if (w >= OTFCC_GLYPHSET_WORDS) return false;
+		word = set->words[w];
+	}
+	*gid = (glyphid_t)((w << 6) + ctz64(word));
+	return true;
+}
+
+bool otfcc_glyphsetNextRange(const otfcc_GlyphSet *set, uint32_t from, OUT glyphid_t *start,
+                             OUT glyphid_t *end) {
+	glyphid_t first;
+	if (!otfcc_glyphsetNext(set, from, &first)) return false;
+	// Find the first absent glyph after `first`, by scanning the complement.
+	uint32_t w = first >> 6;
+	uint64_t word = ~set->words[w] & (~(uint64_t)0 << (first & 63));
+	while (!word) {
+		w += 1;
+		if (w >= OTFCC_GLYPHSET_WORDS) {
+			*start = first;
+			*end = 0xFFFF;
+			return true;
+		}
+		word = ~set->words[w];
+	}
+	*start = first;
+	*end = (glyphid_t)((w << 6) + ctz64(word) - 1);
+	return true;
+}
+
+otfcc_GlyphClassMap *otfcc_newGlyphClassMap() {
+	otfcc_GlyphClassMap *map;
+	NEW(map);
+	return map;
+}
+void otfcc_deleteGlyphClassMap(MOVE otfcc_GlyphClassMap *map) {
+	if (!map) return;
+	for (uint32_t p = 0; p < OTFCC_CLASSMAP_PAGES; p++) {
+		FREE(map->pages[p]);
+	}
+	FREE(map);
+}
+
+void otfcc_classmapSet(otfcc_GlyphClassMap *map, glyphid_t gid, glyphclass_t cls) {
+	glyphclass_t **page = &map->pages[gid >> 8];
+	if (!*page) NEW(*page, OTFCC_CLASSMAP_PAGE_SIZE);
+	(*page)[gid & 0xFF] = cls;
+	otfcc_glyphsetAdd(&map->present, gid);
+}
+bool otfcc_classmapAdd(otfcc_GlyphClassMap *map, glyphid_t gid, glyphclass_t cls) {
+	if (otfcc_glyphsetHas(&map->present, gid)) return false;
+	otfcc_classmapSet(map, gid, cls);
+	return true;
+}
+void otfcc_classmapRemove(otfcc_GlyphClassMap *map, glyphid_t gid) {
+	if (!otfcc_glyphsetRemove(&map->present, gid)) return;
+	map->pages[gid >> 8][gid & 0xFF] = 0;
+}
@@ -0,0 +1,88 @@
+#ifndef CARYLL_SUPPORT_GLYPH_SET_H
+#define CARYLL_SUPPORT_GLYPH_SET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "caryll/ownership.h"
+#include "otfcc/primitives.h"
+#include "support/otfcc-alloc.h"
+
+// A set of glyph IDs, stored as a bitmap over the whole 16-bit glyph space (8 KiB).
+// Membership tests and insertions are O(1); set algebra works a word at a time and
+// iteration always yields glyphs in ascending GID order.
+#define OTFCC_GLYPHSET_WORDS 0x400
+
+typedef struct {
+	uint64_t words[OTFCC_GLYPHSET_WORDS];
+} otfcc_GlyphSet;
+
+otfcc_GlyphSet *otfcc_newGlyphSet();
+void otfcc_deleteGlyphSet(MOVE otfcc_GlyphSet *set);
+void otfcc_glyphsetClear(otfcc_GlyphSet *set);
+
+static INLINE bool otfcc_glyphsetHas(const otfcc_GlyphSet *set, glyphid_t gid) {
+	return (set->words[gid >> 6] >> (gid & 63)) & 1;
+}
+// Adds a glyph; returns whether it was absent before.
+static INLINE bool otfcc_glyphsetAdd(otfcc_GlyphSet *set, glyphid_t gid) {
+	uint64_t bit = (uint64_t)1 << (gid & 63);
+	if (set->words[gid >> 6] & bit) return false;
+	set->words[gid >> 6] |= bit;
+	return true;
+}
+// Removes a glyph; returns whether it was present before.
+static INLINE bool otfcc_glyphsetRemove(otfcc_GlyphSet *set, glyphid_t gid) {
+	uint64_t bit = (uint64_t)1 << (gid & 63);
+	if (!(set->words[gid >> 6] & bit)) return false;
+	set->words[gid >> 6] &= ~bit;
+	return true;
+}
+
+void otfcc_glyphsetAddRange(otfcc_GlyphSet *set, glyphid_t start, glyphid_t end);
+uint32_t otfcc_glyphsetCount(const otfcc_GlyphSet *set);
+
+// In-place set algebra: set = set op other.
+void otfcc_glyphsetUnion(otfcc_GlyphSet *set, const otfcc_GlyphSet *other);
+void otfcc_glyphsetIntersect(otfcc_GlyphSet *set, const otfcc_GlyphSet *other);
+void otfcc_glyphsetSubtract(otfcc_GlyphSet *set, const otfcc_GlyphSet *other);
+bool otfcc_glyphsetEqual(const otfcc_GlyphSet *a, const otfcc_GlyphSet *b);
+bool otfcc_glyphsetIsSubset(const otfcc_GlyphSet *a, const otfcc_GlyphSet *b);
+
+// Iteration. otfcc_glyphsetNext finds the smallest member >= from;
+// otfcc_glyphsetNextRange finds the first maximal run of consecutive members
+// starting at or after from. Both return false when nothing is left.
+//     uint32_t gid = 0;
+//     glyphid_t g;
+//     while (otfcc_glyphsetNext(set, gid, &g)) { ...; gid = g + 1; }
+bool otfcc_glyphsetNext(const otfcc_GlyphSet *set, uint32_t from, OUT glyphid_t *gid);
+bool otfcc_glyphsetNextRange(const otfcc_GlyphSet *set, uint32_t from, OUT glyphid_t *start,
+                             OUT glyphid_t *end);
+
+// A dense GID -> class array. Classes are stored in 256-glyph pages which are
+// allocated on first use, so sparse maps stay small; `present` tracks which
+// glyphs carry an entry, including explicit class-0 entries.
+#define OTFCC_CLASSMAP_PAGES 0x100
+#define OTFCC_CLASSMAP_PAGE_SIZE 0x100
+
+typedef struct {
+	otfcc_GlyphSet present;
+	glyphclass_t *pages[OTFCC_CLASSMAP_PAGES];
+} otfcc_GlyphClassMap;
+
+otfcc_GlyphClassMap *otfcc_newGlyphClassMap();
+void otfcc_deleteGlyphClassMap(MOVE otfcc_GlyphClassMap *map);
+
+static INLINE bool otfcc_classmapHas(const otfcc_GlyphClassMap *map, glyphid_t gid) {
+	return otfcc_glyphsetHas(&map->present, gid);
+}
+// Class of a glyph, 0 when it is absent.
+static INLINE glyphclass_t otfcc_classmapGet(const otfcc_GlyphClassMap *map, glyphid_t gid) {
+	const glyphclass_t *page = map->pages[gid >> 8];
+	return page ? page[gid & 0xFF] : 0;
+}
+void otfcc_classmapSet(otfcc_GlyphClassMap *map, glyphid_t gid, glyphclass_t cls);
+// Sets the class of a glyph unless it already has one; returns whether it was added.
+bool otfcc_classmapAdd(otfcc_GlyphClassMap *map, glyphid_t gid, glyphclass_t cls);
+void otfcc_classmapRemove(otfcc_GlyphClassMap *map, glyphid_t gid);
+
+#endif
@@ -6,20 +6,23 @@
 static INLINE void initHandle(otfcc_Handle *h) {
 	h->state = HANDLE_STATE_EMPTY;
 	h->index = 0;
+	h->interned = false;
 	h->name = NULL;
 }
 static INLINE void disposeHandle(struct otfcc_Handle *h) {
-	if (h->name) {
-		sdsfree(h->name);
-		h->name = NULL;
-	}
+	if (h->name && !h->interned) sdsfree(h->name);
+	h->name = NULL;
+	h->interned = false;
 	h->index = 0;
 	h->state = HANDLE_STATE_EMPTY;
 }
 static void copyHandle(otfcc_Handle *dst, const otfcc_Handle *src) {
 	dst->state = src->state;
 	dst->index = src->index;
-	if (src->name) {
+	dst->interned = src->interned;
+	if (src->name && src->interned) {
+		dst->name = src->name;
+	} else if (src->name) {
 		dst->name = sdsdup(src->name);
 	} else {
 		dst->name = NULL;
@@ -30,11 +33,11 @@ caryll_standardValTypeFn(otfcc_Handle, initHandle, copyHandle, disposeHandle);
 
 // custom constructors
 static struct otfcc_Handle handle_fromIndex(glyphid_t id) {
-	struct otfcc_Handle h = {HANDLE_STATE_INDEX, id, NULL};
+	struct otfcc_Handle h = {.state = HANDLE_STATE_INDEX, .index = id};
 	return h;
 }
 static struct otfcc_Handle handle_fromName(MOVE sds s) {
-	struct otfcc_Handle h = {HANDLE_STATE_EMPTY, 0, NULL};
+	struct otfcc_Handle h = {.state = HANDLE_STATE_EMPTY};
 	if (s) {
 		h.state = HANDLE_STATE_NAME;
 		h.name = s;
@@ -42,7 +45,12 @@ static struct otfcc_Handle handle_fromName(MOVE sds s) {
 	return h;
 }
 static struct otfcc_Handle handle_fromConsolidated(glyphid_t id, sds s) {
-	struct otfcc_Handle h = {HANDLE_STATE_CONSOLIDATED, id, sdsdup(s)};
+	struct otfcc_Handle h = {.state = HANDLE_STATE_CONSOLIDATED, .index = id, .name = sdsdup(s)};
+	return h;
+}
+static struct otfcc_Handle handle_fromInterned(glyphid_t id, sds s) {
+	struct otfcc_Handle h = {
+	    .state = HANDLE_STATE_CONSOLIDATED, .index = id, .interned = true, .name = s};
 	return h;
 }
 
@@ -53,6 +61,13 @@ static void handle_consolidateTo(struct otfcc_Handle *h, glyphid_t id, sds name)
 	h->index = id;
 	h->name = sdsdup(name);
 }
+static void handle_consolidateToInterned(struct otfcc_Handle *h, glyphid_t id, sds name) {
+	otfcc_iHandle.dispose(h);
+	h->state = HANDLE_STATE_CONSOLIDATED;
+	h->index = id;
+	h->interned = true;
+	h->name = name;
+}
 
 const struct otfcc_HandlePackage otfcc_iHandle = {
     caryll_standardValTypeMethods(otfcc_Handle), // VT
@@ -60,4 +75,6 @@ const struct otfcc_HandlePackage otfcc_iHandle = {
     .fromName = handle_fromName,                 // custom constructor, from name
     .fromConsolidated = handle_fromConsolidated, // custom constructor, from consolidated
     .consolidateTo = handle_consolidateTo,
+    .fromInterned = handle_fromInterned,
+    .consolidateToInterned = handle_consolidateToInterned,
 };
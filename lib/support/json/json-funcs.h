@@ -10,6 +10,7 @@
 
 #include "caryll/ownership.h"
 #include "otfcc/primitives.h"
+#include "otfcc/allocator.h"
 #include "otfcc/vf/vq.h"
 #include "otfcc/table/fvar.h"
 
@@ -23,6 +24,16 @@
 
 static INLINE json_value *preserialize(MOVE json_value *x);
 
+// Frees a subtree of an input DOM which is dropped while parsing. The DOM is in the JSON
+// allocator, see otfcc/allocator.h.
+static INLINE void json_free_subtree_value(void *ptr, void *userData) {
+	otfcc_deallocateJson(ptr);
+}
+static INLINE void json_value_free_subtree(MOVE json_value *x) {
+	json_settings settings = {.mem_free = json_free_subtree_value};
+	json_value_free_ex(&settings, x);
+}
+
 static INLINE json_value *json_obj_get(const json_value *obj, const char *key) {
 	if (!obj || obj->type != json_object) return NULL;
 	for (uint32_t _k = 0; _k < obj->u.object.length; _k++) {
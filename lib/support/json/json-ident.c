@@ -1,10 +1,6 @@
 #include "json-ident.h"
 #include "support/otfcc-alloc.h"
 
-#ifdef _MSC_VER
-#include "winfns.h"
-#endif
-
 static bool compare_json_arrays(const json_value *a, const json_value *b) {
 	for (uint16_t j = 0; j < a->u.array.length; j++) {
 		if (!json_ident(a->u.array.values[j], b->u.array.values[j])) { return false; }
@@ -26,7 +22,8 @@ static bool compare_json_objects(const json_value *a, const json_value *b) {
 		HASH_FIND_STR(h, k, e);
 		if (!e) {
 			NEW(e);
-			e->key = strdup(k);
+			NEW(e->key, strlen(k) + 1);
+			strcpy(e->key, k);
 			e->val = a->u.object.values[j].value;
 			e->check = false;
 			HASH_ADD_STR(h, key, e);
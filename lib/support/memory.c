@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <inttypes.h>
+#include "otfcc/memory.h"
+#include "support/threads.h"
+
+#define MEM_MAX_DEPTH 32
+
+bool otfcc_memoryAccounting = false;
+
+// Live allocations are kept in an open-addressing table keyed by address, so that a free can
+// be charged back to the subsystem which made the allocation. The table is allocated with
+// the plain C allocator: it must not account for itself.
+typedef struct {
+	void *ptr;
+	size_t size;
+	otfcc_MemoryTag tag;
+} LiveAllocation;
+
+typedef struct {
+	size_t current;
+	size_t peak;
+	size_t allocations;
+} TagStats;
+
+static otfcc_Mutex mutex;
+static size_t nSlots = 0;
+static size_t nLive = 0;
+static LiveAllocation *slots = NULL;
+static TagStats stats[OTFCC_MEM_TAGS];
+static size_t currentTotal = 0;
+static size_t peakTotal = 0;
+
+typedef struct {
+	uint32_t depth;
+	otfcc_MemoryTag tags[MEM_MAX_DEPTH];
+} TagStack;
+static THREAD_LOCAL TagStack currentStack;
+
+static const char *tagNames[OTFCC_MEM_TAGS] = {"other",    "glyf",     "CFF",          "OTL",
+                                               "bk graph", "JSON DOM", "subroutinizer"};
+
+void otfcc_startMemoryAccounting() {
+	if (otfcc_memoryAccounting) return;
+	otfcc_initMutex(&mutex);
+	otfcc_memoryAccounting = true;
+}
+
+void otfcc_enterMemoryTag(otfcc_MemoryTag tag) {
+	TagStack *stack = &currentStack;
+	if (stack->depth < MEM_MAX_DEPTH) stack->tags[stack->depth] = tag;
+	stack->depth += 1;
+}
+void otfcc_leaveMemoryTag() {
+	TagStack *stack = &currentStack;
+	if (stack->depth) stack->depth -= 1;
+}
+otfcc_MemoryTag otfcc_currentMemoryTag() {
+	const TagStack *stack = &currentStack;
+	if (!stack->depth) return OTFCC_MEM_OTHER;
+	return stack->tags[(stack->depth < MEM_MAX_DEPTH ? stack->depth : MEM_MAX_DEPTH) - 1];
+}
+
+static size_t slotOf(const void *ptr) {
+	uint64_t h = (uint64_t)(uintptr_t)ptr;
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	return (size_t)h & (nSlots - 1);
+}
+
+static void insertSlot(void *ptr, size_t size, otfcc_MemoryTag tag) {
+	size_t j = slotOf(ptr);
+	while (slots[j].ptr && slots[j].ptr != ptr)
+		j = (j + 1) & (nSlots - 1);
+	if (!slots[j].ptr) nLive += 1;
+	slots[j].ptr = ptr;
+	slots[j].size = size;
+	slots[j].tag = tag;
+}
+
+static bool growSlots() {
+	if ((nLive + 1) * 2 <= nSlots) return true;
+	size_t oldCount = nSlots;
+	LiveAllocation *old = slots;
+	size_t n = nSlots ? nSlots * 2 : 0x10000;
+	LiveAllocation *grown = calloc(n, sizeof(LiveAllocation));
+	if (!grown) return false;
+	slots = grown;
+	nSlots = n;
+	nLive = 0;
+	for (size_t j = 0; j < oldCount; j++) {
+		if (old[j].ptr) insertSlot(old[j].ptr, old[j].size, old[j].tag);
+	}
+	free(old);
+	return true;
+}
+
+// Removes an entry by shifting the rest of its probe run back, so no tombstones are needed.
+static bool removeSlot(void *ptr, LiveAllocation *removed) {
+	if (!nSlots) return false;
+	size_t mask = nSlots - 1;
+	size_t j = slotOf(ptr);
+	while (slots[j].ptr != ptr) {
+		if (!slots[j].ptr) return false;
+		j = (j + 1) & mask;
+	}
+	*removed = slots[j];
+	for (size_t k = (j + 1) & mask; slots[k].ptr; k = (k + 1) & mask) {
+		size_t home = slotOf(slots[k].ptr);
+		// Move slot k into the hole at j unless its home lies cyclically in (j, k].
+		if ((k > j) ? (home <= j || home > k) : (home <= j && home > k)) {
+			slots[j] = slots[k];
+			j = k;
+		}
+	}
+	slots[j].ptr = NULL;
+	nLive -= 1;
+	return true;
+}
+
+static void charge(otfcc_MemoryTag tag, size_t size) {
+	TagStats *s = &stats[tag];
+	s->current += size;
+	s->allocations += 1;
+	if (s->current > s->peak) s->peak = s->current;
+	currentTotal += size;
+	if (currentTotal > peakTotal) peakTotal = currentTotal;
+}
+static void discharge(otfcc_MemoryTag tag, size_t size) {
+	stats[tag].current -= size;
+	currentTotal -= size;
+}
+
+void otfcc_accountAllocation(void *ptr, size_t n) {
+	if (!ptr) return;
+	otfcc_MemoryTag tag = otfcc_currentMemoryTag();
+	otfcc_lock(&mutex);
+	// A block at the same address which is still listed was released with a plain free().
+	LiveAllocation stale;
+	if (removeSlot(ptr, &stale)) discharge(stale.tag, stale.size);
+	if (growSlots()) {
+		insertSlot(ptr, n, tag);
+		charge(tag, n);
+	}
+	otfcc_unlock(&mutex);
+}
+
+otfcc_MemoryTag otfcc_accountResizeBegin(void *ptr) {
+	otfcc_MemoryTag tag = otfcc_currentMemoryTag();
+	otfcc_lock(&mutex);
+	LiveAllocation removed;
+	if (removeSlot(ptr, &removed)) {
+		// Resizing is not a new allocation; it is counted again once when it ends.
+		discharge(removed.tag, removed.size);
+		stats[removed.tag].allocations -= 1;
+		tag = removed.tag;
+	}
+	otfcc_unlock(&mutex);
+	return tag;
+}
+
+void otfcc_accountResizeEnd(void *ptr, size_t n, otfcc_MemoryTag tag) {
+	otfcc_lock(&mutex);
+	if (growSlots()) {
+		insertSlot(ptr, n, tag);
+		charge(tag, n);
+	}
+	otfcc_unlock(&mutex);
+}
+
+void otfcc_accountFree(void *ptr) {
+	otfcc_lock(&mutex);
+	LiveAllocation removed;
+	if (removeSlot(ptr, &removed)) discharge(removed.tag, removed.size);
+	otfcc_unlock(&mutex);
+}
+
+void otfcc_writeMemoryStats(FILE *file) {
+	if (!otfcc_memoryAccounting) return;
+	otfcc_lock(&mutex);
+	fprintf(file, "%-16s %16s %16s %12s\n", "subsystem", "current bytes", "peak bytes",
+	        "allocations");
+	for (otfcc_MemoryTag tag = 0; tag < OTFCC_MEM_TAGS; tag++) {
+		fprintf(file, "%-16s %16zu %16zu %12zu\n", tagNames[tag], stats[tag].current,
+		        stats[tag].peak, stats[tag].allocations);
+	}
+	fprintf(file, "%-16s %16zu %16zu\n", "total", currentTotal, peakTotal);
+	otfcc_unlock(&mutex);
+}
@@ -1,5 +1,13 @@
+#include <string.h>
 #include "otfcc/options.h"
 #include "support/otfcc-alloc.h"
+#include "dep/sds.h"
+
+static void freeTableList(char **list) {
+	if (!list) return;
+	for (char **name = list; *name; name++) sdsfree(*name);
+	FREE(list);
+}
 
 otfcc_Options *otfcc_newOptions() {
 	otfcc_Options *options;
@@ -9,7 +17,10 @@ otfcc_Options *otfcc_newOptions() {
 void otfcc_deleteOptions(otfcc_Options *options) {
 	if (options) {
 		FREE(options->glyph_name_prefix);
+		freeTableList(options->include_tables);
+		freeTableList(options->exclude_tables);
 		if (options->logger) options->logger->dispose(options->logger);
+		otfcc_deleteTracer(options->tracer);
 	}
 	FREE(options);
 }
@@ -19,6 +30,7 @@ void otfcc_Options_optimizeTo(otfcc_Options *options, uint8_t level) {
 	options->ignore_glyph_order = false;
 	options->cff_short_vmtx = false;
 	options->merge_features = false;
+	options->split_kerning = false;
 	options->force_cid = false;
 	options->cff_doSubroutinize = false;
 
@@ -30,9 +42,64 @@ void otfcc_Options_optimizeTo(otfcc_Options *options, uint8_t level) {
 		options->short_post = true;
 		options->cff_doSubroutinize = true;
 		options->merge_features = true;
+		options->split_kerning = true;
 	}
 	if (level >= 3) {
 		options->ignore_glyph_order = true;
 		options->force_cid = true;
 	}
 }
+
+// Tables as they are named in the JSON dump. hmtx and vmtx stand for the metrics which are
+// merged into the glyphs of glyf, and may be selected without their outlines.
+static const char *knownTables[] = {
+    "fvar", "head", "hhea", "hmtx", "maxp", "vhea", "vmtx",   "post",   "OS_2", "name",
+    "meta", "cmap", "CFF_", "glyf", "fpgm", "prep", "cvt_",   "gasp",   "VDMX", "GSUB",
+    "GPOS", "GDEF", "BASE", "CPAL", "COLR", "SVG_", "TSI5", "TSI_01", "TSI_23", NULL};
+
+static bool isKnownTable(const char *name, size_t len) {
+	for (const char **known = knownTables; *known; known++) {
+		if (strlen(*known) == len && strncmp(*known, name, len) == 0) return true;
+	}
+	return false;
+}
+static bool listHasTable(char **list, const char *name) {
+	for (char **item = list; *item; item++) {
+		if (strcmp(*item, name) == 0) return true;
+	}
+	return false;
+}
+bool otfcc_Options_filterTables(otfcc_Options *options, const char *list, bool exclude) {
+	char ***target = exclude ? &options->exclude_tables : &options->include_tables;
+	size_t n = 0;
+	if (*target) {
+		while ((*target)[n]) n++;
+	}
+	const char *p = list;
+	while (*p) {
+		size_t len = strcspn(p, ", \t");
+		if (len) {
+			if (!isKnownTable(p, len)) return false;
+			RESIZE(*target, n + 2);
+			(*target)[n++] = sdsnewlen(p, len);
+			(*target)[n] = NULL;
+		}
+		p += len;
+		if (*p) p++;
+	}
+	return true;
+}
+bool otfcc_Options_wantsTable(const otfcc_Options *options, const char *name) {
+	if (options->include_tables && !listHasTable(options->include_tables, name)) return false;
+	if (options->exclude_tables && listHasTable(options->exclude_tables, name)) return false;
+	return true;
+}
+
+void otfcc_beginStep(const otfcc_Options *options, MOVE sds name) {
+	if (options->tracer) otfcc_traceBegin(options->tracer, sdsdup(name));
+	options->logger->startSDS(options->logger, name);
+}
+void otfcc_endStep(const otfcc_Options *options) {
+	options->logger->finish(options->logger);
+	otfcc_traceEnd(options->tracer);
+}
@@ -3,6 +3,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "otfcc/memory.h"
+#include "otfcc/allocator.h"
+#include "support/threads.h"
 
 #ifndef INLINE
 #ifdef _MSC_VER
@@ -19,40 +22,53 @@
 #define __caryll_realloc realloc
 #define __caryll_free free
 
+// The allocator installed on the calling thread, NULL for the C library; see otfcc_useAllocator.
+extern THREAD_LOCAL const otfcc_IAllocator *otfcc_threadAllocator;
+
+// The C library is called inline; installed allocators and failures take the slow path.
 static INLINE void *__caryll_allocate_dirty(size_t n, unsigned long line) {
 	if (!n) return NULL;
-	void *p = __caryll_malloc(n);
-	if (!p) {
-		fprintf(stderr, "[%ld]Out of memory(%ld bytes)\n", line, (unsigned long)n);
-		exit(EXIT_FAILURE);
-	}
+	void *p = otfcc_threadAllocator ? NULL : __caryll_malloc(n);
+	if (!p) p = otfcc_allocate(n, false, line);
+	if (otfcc_memoryAccounting) otfcc_accountAllocation(p, n);
 	return p;
 }
 static INLINE void *__caryll_allocate_clean(size_t n, unsigned long line) {
 	if (!n) return NULL;
-	void *p = __caryll_calloc(n, 1);
-	if (!p) {
-		fprintf(stderr, "[%ld]Out of memory(%ld bytes)\n", line, (unsigned long)n);
-		exit(EXIT_FAILURE);
-	}
+	void *p = otfcc_threadAllocator ? NULL : __caryll_calloc(n, 1);
+	if (!p) p = otfcc_allocate(n, true, line);
+	if (otfcc_memoryAccounting) otfcc_accountAllocation(p, n);
 	return p;
 }
+static INLINE void __caryll_deallocate(void *ptr) {
+	if (otfcc_memoryAccounting && ptr) otfcc_accountFree(ptr);
+	if (otfcc_threadAllocator) {
+		otfcc_deallocate(ptr);
+	} else {
+		__caryll_free(ptr);
+	}
+}
 static INLINE void *__caryll_reallocate(void *ptr, size_t n, unsigned long line) {
 	if (!n) {
-		__caryll_free(ptr);
+		__caryll_deallocate(ptr);
 		return NULL;
 	}
 	if (!ptr) {
 		return __caryll_allocate_clean(n, line);
 	} else {
-		void *p = __caryll_realloc(ptr, n);
-		if (!p) {
-			fprintf(stderr, "[%ld]Out of memory(%ld bytes)\n", line, (unsigned long)n);
-			exit(EXIT_FAILURE);
-		}
+		bool accounting = otfcc_memoryAccounting;
+		otfcc_MemoryTag tag = accounting ? otfcc_accountResizeBegin(ptr) : OTFCC_MEM_OTHER;
+		void *p = otfcc_threadAllocator ? NULL : __caryll_realloc(ptr, n);
+		if (!p) p = otfcc_reallocate(ptr, n, line);
+		if (accounting) otfcc_accountResizeEnd(p, n, tag);
 		return p;
 	}
 }
+// Installs the allocator of an entry point's options, unless it is NULL, and returns the
+// allocator to restore with otfcc_useAllocator.
+static INLINE const otfcc_IAllocator *__caryll_enterAllocator(const otfcc_IAllocator *a) {
+	return a ? otfcc_useAllocator(a) : otfcc_currentAllocator();
+}
 #ifdef __cplusplus
 #define NEW_CLEAN_S(ptr, size) ptr = __caryll_allocate_clean((size), __LINE__)
 #define NEW_CLEAN_1(ptr)                                                                           \
@@ -63,7 +79,7 @@ static INLINE void *__caryll_reallocate(void *ptr, size_t n, unsigned long line)
 	ptr = (decltype(ptr))__caryll_allocate_dirty(sizeof(decltype(*ptr)), __LINE__)
 #define NEW_DIRTY_N(ptr, n)                                                                        \
 	ptr = (decltype(ptr))__caryll_allocate_dirty(sizeof(decltype(*ptr)) * (n), __LINE__)
-#define FREE(ptr) (__caryll_free(ptr), ptr = nullptr)
+#define FREE(ptr) (__caryll_deallocate(ptr), ptr = nullptr)
 #define DELETE(fn, ptr) (fn(ptr), ptr = nullptr)
 #define RESIZE(ptr, n) ptr = (decltype(ptr))__caryll_reallocate(ptr, sizeof(*ptr) * (n), __LINE__)
 #else
@@ -72,12 +88,23 @@ static INLINE void *__caryll_reallocate(void *ptr, size_t n, unsigned long line)
 #define NEW_CLEAN_N(ptr, n) ptr = __caryll_allocate_clean(sizeof(*ptr) * (n), __LINE__)
 #define NEW_DIRTY(ptr) ptr = __caryll_allocate_dirty(sizeof(*ptr), __LINE__)
 #define NEW_DIRTY_N(ptr, n) ptr = __caryll_allocate_dirty(sizeof(*ptr) * (n), __LINE__)
-#define FREE(ptr) (__caryll_free(ptr), ptr = NULL)
+#define FREE(ptr) (__caryll_deallocate(ptr), ptr = NULL)
 #define DELETE(fn, ptr) (fn(ptr), ptr = NULL)
 #define RESIZE(ptr, n) ptr = __caryll_reallocate(ptr, sizeof(*ptr) * (n), __LINE__)
 #endif
 
+// Charges the allocations made inside the block to a subsystem, see otfcc/memory.h.
+#define accountedAs(tag)                                                                           \
+	for (bool ___accounted_v = (otfcc_enterMemoryTag(tag), true); ___accounted_v;                  \
+	     ___accounted_v = false, otfcc_leaveMemoryTag())
+
 #define __GET_MACRO_OTFCC_ALLOC_2(_1, _2, NAME, ...) NAME
 #define NEW(...) __GET_MACRO_OTFCC_ALLOC_2(__VA_ARGS__, NEW_CLEAN_N, NEW_CLEAN_1)(__VA_ARGS__)
 
+// Hash tables follow the current allocator too, wherever uthash was included first.
+#undef uthash_malloc
+#undef uthash_free
+#define uthash_malloc(sz) __caryll_allocate_dirty((sz), __LINE__)
+#define uthash_free(ptr, sz) __caryll_deallocate(ptr)
+
 #endif
@@ -0,0 +1,216 @@
+#include <stdint.h>
+#include <string.h>
+#include "otfcc/region.h"
+#include "otfcc/memory.h"
+#include "support/threads.h"
+
+#define REGION_CHUNK_SIZE (1 << 20)
+#define REGION_MAX_SMALL (1 << 16)
+#define REGION_CLASSES 24
+#define REGION_LIVE 1
+#define REGION_LARGE 2
+
+// Every block starts with a header; payloads and headers keep 16-byte alignment.
+typedef struct {
+	size_t capacity;
+	size_t flags;
+} BlockHeader;
+
+// Small blocks are carved from chunks, one after another.
+typedef struct RegionChunk {
+	struct RegionChunk *next;
+	size_t used;
+	size_t size;
+	size_t reserved;
+} RegionChunk;
+
+// Large blocks come from the parent allocator one by one, and are linked for the release.
+typedef struct LargeBlock {
+	struct LargeBlock *prev;
+	struct LargeBlock *next;
+	BlockHeader header;
+} LargeBlock;
+
+struct otfcc_Region {
+	otfcc_IAllocator allocator;
+	const otfcc_IAllocator *parent;
+	otfcc_Mutex mutex;
+	RegionChunk *chunks;
+	LargeBlock *large;
+	void *freeLists[REGION_CLASSES];
+};
+
+// Two classes per power of two: 16, 32, 48, 64, 96, 128, 192, ... 64K.
+static uint32_t sizeClassOf(size_t n, size_t *capacity) {
+	if (n <= 16) {
+		*capacity = 16;
+		return 0;
+	}
+	if (n <= 32) {
+		*capacity = 32;
+		return 1;
+	}
+	size_t m = n - 1;
+	uint32_t b = 5;
+	while (m >> (b + 1))
+		b++;
+	size_t upper = (m >> (b - 1)) & 1;
+	*capacity = upper ? ((size_t)2 << b) : ((size_t)3 << (b - 1));
+	return 2 * (b - 5) + (uint32_t)upper + 2;
+}
+
+// Chunks and large blocks are taken from the parent, which also handles its failures.
+static void *parentAllocate(otfcc_Region *region, size_t n) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(region->parent);
+	void *p = otfcc_allocate(n, false, __LINE__);
+	otfcc_useAllocator(previous);
+	return p;
+}
+static void *parentReallocate(otfcc_Region *region, void *ptr, size_t n) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(region->parent);
+	void *p = otfcc_reallocate(ptr, n, __LINE__);
+	otfcc_useAllocator(previous);
+	return p;
+}
+static void parentDeallocate(otfcc_Region *region, void *ptr) {
+	const otfcc_IAllocator *previous = otfcc_useAllocator(region->parent);
+	otfcc_deallocate(ptr);
+	otfcc_useAllocator(previous);
+}
+
+static void linkLarge(otfcc_Region *region, LargeBlock *b) {
+	otfcc_lock(&region->mutex);
+	b->prev = NULL;
+	b->next = region->large;
+	if (region->large) region->large->prev = b;
+	region->large = b;
+	otfcc_unlock(&region->mutex);
+}
+static void unlinkLarge(otfcc_Region *region, LargeBlock *b) {
+	otfcc_lock(&region->mutex);
+	if (b->prev) {
+		b->prev->next = b->next;
+	} else {
+		region->large = b->next;
+	}
+	if (b->next) b->next->prev = b->prev;
+	otfcc_unlock(&region->mutex);
+}
+
+static void *regionAllocate(void *context, size_t n) {
+	otfcc_Region *region = (otfcc_Region *)context;
+	if (n > REGION_MAX_SMALL) {
+		LargeBlock *b = parentAllocate(region, sizeof(LargeBlock) + n);
+		b->header.capacity = n;
+		b->header.flags = REGION_LIVE | REGION_LARGE;
+		linkLarge(region, b);
+		return b + 1;
+	}
+	size_t capacity;
+	uint32_t cls = sizeClassOf(n, &capacity);
+	otfcc_lock(&region->mutex);
+	void *p = region->freeLists[cls];
+	BlockHeader *h;
+	if (p) {
+		region->freeLists[cls] = *(void **)p;
+		h = (BlockHeader *)p - 1;
+	} else {
+		RegionChunk *c = region->chunks;
+		if (!c || c->used + sizeof(BlockHeader) + capacity > c->size) {
+			c = parentAllocate(region, REGION_CHUNK_SIZE);
+			c->next = region->chunks;
+			c->used = sizeof(RegionChunk);
+			c->size = REGION_CHUNK_SIZE;
+			region->chunks = c;
+		}
+		h = (BlockHeader *)((uint8_t *)c + c->used);
+		c->used += sizeof(BlockHeader) + capacity;
+		h->capacity = capacity;
+		p = h + 1;
+	}
+	h->flags = REGION_LIVE;
+	otfcc_unlock(&region->mutex);
+	return p;
+}
+
+static void regionDeallocate(void *context, void *ptr) {
+	otfcc_Region *region = (otfcc_Region *)context;
+	BlockHeader *h = (BlockHeader *)ptr - 1;
+	if (h->flags & REGION_LARGE) {
+		LargeBlock *b = (LargeBlock *)ptr - 1;
+		unlinkLarge(region, b);
+		parentDeallocate(region, b);
+		return;
+	}
+	size_t capacity;
+	uint32_t cls = sizeClassOf(h->capacity, &capacity);
+	otfcc_lock(&region->mutex);
+	h->flags = 0;
+	*(void **)ptr = region->freeLists[cls];
+	region->freeLists[cls] = ptr;
+	otfcc_unlock(&region->mutex);
+}
+
+static void *regionReallocate(void *context, void *ptr, size_t n) {
+	otfcc_Region *region = (otfcc_Region *)context;
+	BlockHeader *h = (BlockHeader *)ptr - 1;
+	if (n <= h->capacity) return ptr;
+	if (h->flags & REGION_LARGE) {
+		LargeBlock *b = (LargeBlock *)ptr - 1;
+		unlinkLarge(region, b);
+		b = parentReallocate(region, b, sizeof(LargeBlock) + n);
+		b->header.capacity = n;
+		linkLarge(region, b);
+		return b + 1;
+	}
+	void *p = regionAllocate(context, n);
+	memcpy(p, ptr, h->capacity);
+	regionDeallocate(context, ptr);
+	return p;
+}
+
+otfcc_Region *otfcc_newRegion() {
+	otfcc_Region *region = otfcc_allocate(sizeof(otfcc_Region), true, __LINE__);
+	region->parent = otfcc_currentAllocator();
+	region->allocator.context = region;
+	region->allocator.allocate = regionAllocate;
+	region->allocator.reallocate = regionReallocate;
+	region->allocator.deallocate = regionDeallocate;
+	otfcc_initMutex(&region->mutex);
+	return region;
+}
+
+const otfcc_IAllocator *otfcc_regionAllocator(otfcc_Region *region) {
+	return &region->allocator;
+}
+
+// Blocks released with the region were never freed one by one, so accounting needs a walk.
+static void dischargeBlocks(otfcc_Region *region) {
+	for (RegionChunk *c = region->chunks; c; c = c->next) {
+		for (size_t at = sizeof(RegionChunk); at < c->used;) {
+			BlockHeader *h = (BlockHeader *)((uint8_t *)c + at);
+			if (h->flags & REGION_LIVE) otfcc_accountFree(h + 1);
+			at += sizeof(BlockHeader) + h->capacity;
+		}
+	}
+	for (LargeBlock *b = region->large; b; b = b->next) {
+		otfcc_accountFree(b + 1);
+	}
+}
+
+void otfcc_deleteRegion(otfcc_Region *region) {
+	if (!region) return;
+	if (otfcc_memoryAccounting) dischargeBlocks(region);
+	while (region->chunks) {
+		RegionChunk *c = region->chunks;
+		region->chunks = c->next;
+		parentDeallocate(region, c);
+	}
+	while (region->large) {
+		LargeBlock *b = region->large;
+		region->large = b->next;
+		parentDeallocate(region, b);
+	}
+	otfcc_destroyMutex(&region->mutex);
+	parentDeallocate(region, region);
+}
@@ -0,0 +1,123 @@
+#include "thread-pool.h"
+#include <stdbool.h>
+#include "support/otfcc-alloc.h"
+#include "support/threads.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+typedef struct {
+	otfcc_Mutex mutex;
+	size_t next;
+	size_t total;
+	otfcc_ParallelJob job;
+	void *env;
+	otfcc_MemoryTag memoryTag;
+	const otfcc_IAllocator *allocator;
+} ThreadPool;
+
+uint16_t otfcc_hardwareConcurrency() {
+	long n = 1;
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	n = info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	if (n < 1) n = 1;
+	if (n > 0xFF) n = 0xFF;
+	return (uint16_t)n;
+}
+
+static bool claimJob(ThreadPool *pool, size_t *index) {
+	bool claimed = false;
+	otfcc_lock(&pool->mutex);
+	if (pool->next < pool->total) {
+		*index = pool->next;
+		pool->next += 1;
+		claimed = true;
+	}
+	otfcc_unlock(&pool->mutex);
+	return claimed;
+}
+
+static void runWorker(ThreadPool *pool) {
+	size_t index;
+	while (claimJob(pool, &index)) {
+		pool->job(pool->env, index);
+	}
+}
+// Spawned workers charge their allocations to the subsystem of the thread which spawned them.
+static void runSpawnedWorker(ThreadPool *pool) {
+	otfcc_useAllocator(pool->allocator);
+	accountedAs(pool->memoryTag) {
+		runWorker(pool);
+	}
+}
+
+#ifdef _WIN32
+static DWORD WINAPI workerEntry(LPVOID arg) {
+	runSpawnedWorker((ThreadPool *)arg);
+	return 0;
+}
+static bool startWorker(otfcc_Thread *thread, ThreadPool *pool) {
+	*thread = CreateThread(NULL, 0, workerEntry, pool, 0, NULL);
+	return *thread != NULL;
+}
+static void joinWorker(otfcc_Thread thread) {
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+#else
+static void *workerEntry(void *arg) {
+	runSpawnedWorker((ThreadPool *)arg);
+	return NULL;
+}
+static bool startWorker(otfcc_Thread *thread, ThreadPool *pool) {
+	return pthread_create(thread, NULL, workerEntry, pool) == 0;
+}
+static void joinWorker(otfcc_Thread thread) {
+	pthread_join(thread, NULL);
+}
+#endif
+
+void otfcc_parallelFor(size_t n, uint16_t threads, const otfcc_IAllocator *allocator,
+                       otfcc_ParallelJob job, void *env) {
+	if (!n) return;
+	if (!threads) threads = otfcc_hardwareConcurrency();
+	if (threads > n) threads = (uint16_t)n;
+	const otfcc_IAllocator *previous = otfcc_useAllocator(allocator);
+	if (threads <= 1) {
+		for (size_t j = 0; j < n; j++) {
+			job(env, j);
+		}
+		otfcc_useAllocator(previous);
+		return;
+	}
+
+	ThreadPool pool;
+	otfcc_initMutex(&pool.mutex);
+	pool.next = 0;
+	pool.total = n;
+	pool.job = job;
+	pool.env = env;
+	pool.memoryTag = otfcc_currentMemoryTag();
+	pool.allocator = allocator;
+
+	// The calling thread is the first worker; the rest are spawned.
+	otfcc_Thread *workers;
+	NEW(workers, threads - 1);
+	uint16_t started = 0;
+	for (uint16_t j = 0; j < threads - 1; j++) {
+		if (!startWorker(&workers[started], &pool)) break;
+		started += 1;
+	}
+	runWorker(&pool);
+	for (uint16_t j = 0; j < started; j++) {
+		joinWorker(workers[j]);
+	}
+	FREE(workers);
+	otfcc_destroyMutex(&pool.mutex);
+	otfcc_useAllocator(previous);
+}
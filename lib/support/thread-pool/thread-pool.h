@@ -0,0 +1,23 @@
+#ifndef CARYLL_SUPPORT_THREAD_POOL_H
+#define CARYLL_SUPPORT_THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "otfcc/allocator.h"
+
+// A job of a parallel loop. It receives the shared environment and the job index.
+// Jobs must not touch data owned by other jobs; results should be written into
+// per-index slots of the environment and merged by the caller afterwards.
+typedef void (*otfcc_ParallelJob)(void *env, size_t index);
+
+// Number of logical processors available, at least 1.
+uint16_t otfcc_hardwareConcurrency();
+
+// Run job(env, j) for every j in [0, n) on a pool of worker threads and wait for all of
+// them. Jobs are dispatched in index order. When threads is 0 the number of workers
+// follows the hardware concurrency; when it is 1 the loop runs on the calling thread.
+// Every job allocates from allocator, NULL standing for the C library.
+void otfcc_parallelFor(size_t n, uint16_t threads, const otfcc_IAllocator *allocator,
+                       otfcc_ParallelJob job, void *env);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef CARYLL_SUPPORT_THREADS_H
+#define CARYLL_SUPPORT_THREADS_H
+
+// Threads, mutexes and thread-local storage, on Win32 and on POSIX threads.
+#ifdef _WIN32
+#include <Windows.h>
+typedef HANDLE otfcc_Thread;
+typedef CRITICAL_SECTION otfcc_Mutex;
+#define otfcc_initMutex(m) InitializeCriticalSection(m)
+#define otfcc_lock(m) EnterCriticalSection(m)
+#define otfcc_unlock(m) LeaveCriticalSection(m)
+#define otfcc_destroyMutex(m) DeleteCriticalSection(m)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#include <pthread.h>
+typedef pthread_t otfcc_Thread;
+typedef pthread_mutex_t otfcc_Mutex;
+#define otfcc_initMutex(m) pthread_mutex_init(m, NULL)
+#define otfcc_lock(m) pthread_mutex_lock(m)
+#define otfcc_unlock(m) pthread_mutex_unlock(m)
+#define otfcc_destroyMutex(m) pthread_mutex_destroy(m)
+#ifdef __cplusplus
+#define THREAD_LOCAL thread_local
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+#endif
+
+#endif
@@ -1,4 +1,5 @@
 #include "unicodeconv.h"
+#include "support/otfcc-alloc.h"
 
 // Brought from libXML2.
 sds utf16le_to_utf8(const uint8_t *inb, int inlenb) {
@@ -212,7 +213,8 @@ uint8_t *utf8toutf16be(sds _in, size_t *out_bytes) {
 			wordsNeeded += 2;
 		}
 	}
-	uint8_t *_out = malloc(2 * wordsNeeded * sizeof(uint8_t));
+	uint8_t *_out;
+	NEW_DIRTY_N(_out, 2 * wordsNeeded + 1);
 	uint8_t *out = _out;
 	in = _in;
 	while (in < inend) {
@@ -30,7 +30,7 @@
 				(__ti).dispose(&arr->items[j]);                                                    \
 			}                                                                                      \
 		}                                                                                          \
-		__caryll_free(arr->items);                                                                 \
+		__caryll_deallocate(arr->items);                                                           \
 		arr->items = NULL;                                                                         \
 		arr->length = 0;                                                                           \
 		arr->capacity = 0;                                                                         \
@@ -42,7 +42,7 @@
 		for (size_t j = arr->length; j--;) {                                                       \
 			fn(&arr->items[j], enclosure);                                                         \
 		}                                                                                          \
-		__caryll_free(arr->items);                                                                 \
+		__caryll_deallocate(arr->items);                                                           \
 		arr->items = NULL;                                                                         \
 		arr->length = 0;                                                                           \
 		arr->capacity = 0;                                                                         \
@@ -63,30 +63,18 @@
 		while (arr->capacity < target) {                                                           \
 			arr->capacity += arr->capacity / 2;                                                    \
 		}                                                                                          \
-		if (arr->items) {                                                                          \
-			arr->items = __caryll_realloc(arr->items, arr->capacity * sizeof(__T));                \
-		} else {                                                                                   \
-			arr->items = __caryll_calloc(arr->capacity, sizeof(__T));                              \
-		}                                                                                          \
+		RESIZE(arr->items, arr->capacity);                                                         \
 	}                                                                                              \
 	static __CARYLL_INLINE__ void __TV##_growToN(MODIFY __TV *arr, size_t target) {                \
 		if (target <= arr->capacity) return;                                                       \
 		if (arr->capacity < __CARYLL_VECTOR_INITIAL_SIZE)                                          \
 			arr->capacity = __CARYLL_VECTOR_INITIAL_SIZE;                                          \
 		if (arr->capacity < target) { arr->capacity = target + 1; }                                \
-		if (arr->items) {                                                                          \
-			arr->items = __caryll_realloc(arr->items, arr->capacity * sizeof(__T));                \
-		} else {                                                                                   \
-			arr->items = __caryll_calloc(arr->capacity, sizeof(__T));                              \
-		}                                                                                          \
+		RESIZE(arr->items, arr->capacity);                                                         \
 	}                                                                                              \
 	static __CARYLL_INLINE__ void __TV##_resizeTo(MODIFY __TV *arr, size_t target) {               \
 		arr->capacity = target;                                                                    \
-		if (arr->items) {                                                                          \
-			arr->items = __caryll_realloc(arr->items, arr->capacity * sizeof(__T));                \
-		} else {                                                                                   \
-			arr->items = __caryll_calloc(arr->capacity, sizeof(__T));                              \
-		}                                                                                          \
+		RESIZE(arr->items, arr->capacity);                                                         \
 	}                                                                                              \
 	static __CARYLL_INLINE__ void __TV##_shrinkToFit(MODIFY __TV *arr) {                           \
 		__TV##_resizeTo(arr, arr->length);                                                         \
@@ -124,7 +112,8 @@
 		__TV##_growToN(arr, n);                                                                    \
 	}                                                                                              \
 	static __CARYLL_INLINE__ __TV *__TV##_createN(size_t n) {                                      \
-		__TV *t = __caryll_malloc(sizeof(__TV));                                                   \
+		__TV *t;                                                                                   \
+		NEW_DIRTY(t);                                                                              \
 		__TV##_initN(t, n);                                                                        \
 		return t;                                                                                  \
 	}                                                                                              \
@@ -926,11 +926,16 @@ static void cff_make_charstrings(cff_charstring_builder_context *context, caryll
 		cff_CharstringIL *il = cff_compileGlyphToIL(context->glyf->items[j], context->defaultWidth,
 		                                            context->nominalWidthX);
 		cff_optimizeIL(il, context->options);
-		cff_insertILToGraph(&context->graph, il);
+		accountedAs(OTFCC_MEM_SUBR) {
+			cff_insertILToGraph(&context->graph, il);
+		}
 		FREE(il->instr);
 		FREE(il);
 	}
-	cff_ilGraphToBuffers(&context->graph, s, gs, ls, context->options);
+	const otfcc_Options *options = context->options;
+	tracedStep("subroutinize") accountedAs(OTFCC_MEM_SUBR) {
+		cff_ilGraphToBuffers(&context->graph, s, gs, ls, options);
+	}
 }
 
 // String table management
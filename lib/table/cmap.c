@@ -6,18 +6,21 @@
 // PART I, type definition
 
 static INLINE void initCmap(table_cmap *cmap) {
-	cmap->unicodes = NULL;
+	cmap->unicodesCount = 0;
+	memset(cmap->unicodes, 0, sizeof(cmap->unicodes));
 	cmap->uvs = NULL;
 }
 static INLINE void disposeCmap(table_cmap *cmap) {
 	{ // Unicode
-		cmap_Entry *s, *tmp;
-		HASH_ITER(hh, cmap->unicodes, s, tmp) {
-			// delete and free all cmap entries
-			Handle.dispose(&s->glyph);
-			HASH_DEL(cmap->unicodes, s);
-			FREE(s);
+		for (uint32_t p = 0; p < CMAP_PAGE_COUNT; p++) {
+			cmap_Page *page = cmap->unicodes[p];
+			if (!page) continue;
+			for (uint32_t k = 0; k < CMAP_PAGE_SIZE; k++) {
+				if ((page->present[k >> 6] >> (k & 63)) & 1) Handle.dispose(&page->glyphs[k]);
+			}
+			FREE(cmap->unicodes[p]);
 		}
+		cmap->unicodesCount = 0;
 	}
 	{ // UVS
 		cmap_UVS_Entry *s, *tmp;
@@ -31,53 +34,85 @@ static INLINE void disposeCmap(table_cmap *cmap) {
 }
 caryll_standardRefTypeFn(table_cmap, initCmap, disposeCmap);
 
-bool otfcc_encodeCmapByIndex(table_cmap *cmap, int c, uint16_t gid) {
-	cmap_Entry *s;
-	HASH_FIND_INT(cmap->unicodes, &c, s);
-	if (s == NULL) {
-		NEW(s);
-		s->glyph = Handle.fromIndex(gid);
-		s->unicode = c;
-		HASH_ADD_INT(cmap->unicodes, unicode, s);
-		return true;
-	} else {
-		return false;
+static INLINE bool isValidCodePoint(int c) {
+	return c >= 0 && c < (CMAP_PAGE_COUNT << CMAP_PAGE_BITS);
+}
+static INLINE bool pageHas(const cmap_Page *page, uint32_t k) {
+	return (page->present[k >> 6] >> (k & 63)) & 1;
+}
+
+// Finds the slot of a code point, creating its page when needed. Returns NULL if the code
+// point is out of range or already mapped.
+static otfcc_GlyphHandle *claimSlot(table_cmap *cmap, int c) {
+	if (!isValidCodePoint(c)) return NULL;
+	cmap_Page **page = &cmap->unicodes[c >> CMAP_PAGE_BITS];
+	uint32_t k = c & (CMAP_PAGE_SIZE - 1);
+	if (!*page) {
+		NEW(*page);
+	} else if (pageHas(*page, k)) {
+		return NULL;
 	}
+	(*page)->present[k >> 6] |= (uint64_t)1 << (k & 63);
+	(*page)->count += 1;
+	cmap->unicodesCount += 1;
+	return &(*page)->glyphs[k];
+}
+
+bool otfcc_encodeCmapByIndex(table_cmap *cmap, int c, uint16_t gid) {
+	otfcc_GlyphHandle *slot = claimSlot(cmap, c);
+	if (!slot) return false;
+	*slot = Handle.fromIndex(gid);
+	return true;
 }
 bool otfcc_encodeCmapByName(table_cmap *cmap, int c, sds name) {
-	cmap_Entry *s;
-	HASH_FIND_INT(cmap->unicodes, &c, s);
-	if (s == NULL) {
-		NEW(s);
-		s->glyph = Handle.fromName(name);
-		s->unicode = c;
-		HASH_ADD_INT(cmap->unicodes, unicode, s);
-		return true;
-	} else {
-		return false;
-	}
+	otfcc_GlyphHandle *slot = claimSlot(cmap, c);
+	if (!slot) return false;
+	*slot = Handle.fromName(name);
+	return true;
 }
 bool otfcc_unmapCmap(table_cmap *cmap, int c) {
-	cmap_Entry *s;
-	HASH_FIND_INT(cmap->unicodes, &c, s);
-	if (s) {
-		Handle.dispose(&s->glyph);
-		HASH_DEL(cmap->unicodes, s);
-		FREE(s);
-		return true;
-	} else {
-		return false;
-	}
+	if (!isValidCodePoint(c)) return false;
+	cmap_Page *page = cmap->unicodes[c >> CMAP_PAGE_BITS];
+	uint32_t k = c & (CMAP_PAGE_SIZE - 1);
+	if (!page || !pageHas(page, k)) return false;
+	Handle.dispose(&page->glyphs[k]);
+	page->present[k >> 6] &= ~((uint64_t)1 << (k & 63));
+	page->count -= 1;
+	cmap->unicodesCount -= 1;
+	if (!page->count) FREE(cmap->unicodes[c >> CMAP_PAGE_BITS]);
+	return true;
 }
 
 otfcc_GlyphHandle *otfcc_cmapLookup(const table_cmap *cmap, int c) {
-	cmap_Entry *s;
-	HASH_FIND_INT(cmap->unicodes, &c, s);
-	if (s) {
-		return &(s->glyph);
-	} else {
-		return NULL;
+	if (!isValidCodePoint(c)) return NULL;
+	cmap_Page *page = cmap->unicodes[c >> CMAP_PAGE_BITS];
+	uint32_t k = c & (CMAP_PAGE_SIZE - 1);
+	if (!page || !pageHas(page, k)) return NULL;
+	return &page->glyphs[k];
+}
+
+otfcc_GlyphHandle *otfcc_cmapNext(const table_cmap *cmap, int *c) {
+	uint32_t u = (*c < 0) ? 0 : (uint32_t)*c + 1;
+	while (u < (CMAP_PAGE_COUNT << CMAP_PAGE_BITS)) {
+		cmap_Page *page = cmap->unicodes[u >> CMAP_PAGE_BITS];
+		if (!page) {
+			u = (u | (CMAP_PAGE_SIZE - 1)) + 1;
+			continue;
+		}
+		uint32_t k = u & (CMAP_PAGE_SIZE - 1);
+		uint64_t word = page->present[k >> 6] >> (k & 63);
+		if (!word) {
+			u = (u | 63) + 1;
+			continue;
+		}
+		while (!(word & 1)) {
+			word >>= 1;
+			k += 1;
+		}
+		*c = (int)((u & ~(uint32_t)(CMAP_PAGE_SIZE - 1)) | k);
+		return &page->glyphs[k];
 	}
+	return NULL;
 }
 
 bool otfcc_encodeCmapUVSByIndex(table_cmap *cmap, cmap_UVS_key c, uint16_t gid) {
@@ -107,7 +142,7 @@ bool otfcc_encodeCmapUVSByName(table_cmap *cmap, cmap_UVS_key c, sds name) {
 	}
 }
 bool otfcc_unmapCmapUVS(table_cmap *cmap, cmap_UVS_key c) {
-	cmap_Entry *s;
+	cmap_UVS_Entry *s;
 	HASH_FIND(hh, cmap->uvs, &c, sizeof(cmap_UVS_key), s);
 	if (s) {
 		Handle.dispose(&s->glyph);
@@ -120,7 +155,7 @@ bool otfcc_unmapCmapUVS(table_cmap *cmap, cmap_UVS_key c) {
 }
 
 otfcc_GlyphHandle *otfcc_cmapLookupUVS(const table_cmap *cmap, cmap_UVS_key c) {
-	cmap_Entry *s;
+	cmap_UVS_Entry *s;
 	HASH_FIND(hh, cmap->uvs, &c, sizeof(cmap_UVS_key), s);
 	if (s) {
 		return &(s->glyph);
@@ -134,6 +169,7 @@ caryll_ElementInterfaceOf(table_cmap) table_iCmap = {caryll_standardRefTypeMetho
                                                      .encodeByName = otfcc_encodeCmapByName,
                                                      .unmap = otfcc_unmapCmap,
                                                      .lookup = otfcc_cmapLookup,
+                                                     .next = otfcc_cmapNext,
                                                      .encodeUVSByIndex = otfcc_encodeCmapUVSByIndex,
                                                      .encodeUVSByName = otfcc_encodeCmapUVSByName,
                                                      .unmapUVS = otfcc_unmapCmapUVS,
@@ -249,10 +285,6 @@ static void readCmapMappingTableUVS(font_file_pointer start, uint32_t lengthLimi
 	if (format == 14) { readFormat14(start, lengthLimit, cmap); }
 }
 
-static int by_unicode(cmap_Entry *a, cmap_Entry *b) {
-	return (a->unicode - b->unicode);
-}
-
 static int by_uvs_key(cmap_UVS_Entry *a, cmap_UVS_Entry *b) {
 	if (a->key.unicode == b->key.unicode) {
 		return a->key.selector - b->key.selector;
@@ -296,7 +328,6 @@ table_cmap *otfcc_readCmap(const otfcc_Packet packet, const otfcc_Options *optio
 				                     formatPriorities[kSubtableType]);
 			};
 		}
-		HASH_SORT(cmap->unicodes, by_unicode);
 
 		// step 3 : read format 14
 		for (uint16_t j = 0; j < numTables; j++) {
@@ -320,19 +351,20 @@ table_cmap *otfcc_readCmap(const otfcc_Packet packet, const otfcc_Options *optio
 void otfcc_dumpCmap(const table_cmap *table, json_value *root, const otfcc_Options *options) {
 	if (!table) return;
 	loggedStep("cmap") {
-		if (table->unicodes) {
-			json_value *cmap = json_object_new(HASH_COUNT(table->unicodes));
-			cmap_Entry *item;
-			foreach_hash(item, table->unicodes) if (item->glyph.name) {
+		if (table->unicodesCount) {
+			json_value *cmap = json_object_new(table->unicodesCount);
+			int unicode = -1;
+			otfcc_GlyphHandle *glyph;
+			while ((glyph = otfcc_cmapNext(table, &unicode))) {
+				if (!glyph->name) continue;
 				sds key;
 				if (options->decimal_cmap) {
-					key = sdsfromlonglong(item->unicode);
+					key = sdsfromlonglong(unicode);
 				} else {
-					key = sdscatprintf(sdsempty(), "U+%04X", item->unicode);
+					key = sdscatprintf(sdsempty(), "U+%04X", unicode);
 				}
-				json_object_push(
-				    cmap, key,
-				    json_string_new_length((uint32_t)sdslen(item->glyph.name), item->glyph.name));
+				json_object_push(cmap, key,
+				                 json_string_new_length((uint32_t)sdslen(glyph->name), glyph->name));
 				sdsfree(key);
 			}
 			json_object_push(root, "cmap", cmap);
@@ -405,6 +437,7 @@ static void parseCmapUVS(table_cmap *cmap, const json_value *table, const otfcc_
 		sds uvsStr =
 		    sdsnewlen(table->u.object.values[j].name, table->u.object.values[j].name_length);
 		cmap_UVS_key k = parseUVSKey(uvsStr);
+		sdsfree(uvsStr);
 		json_value *item = table->u.object.values[j].value;
 		if (item->type == json_string && k.unicode > 0 && k.unicode <= 0x10FFFF && k.selector > 0 &&
 		    k.selector <= 0x10FFFF) {
@@ -414,6 +447,7 @@ static void parseCmapUVS(table_cmap *cmap, const json_value *table, const otfcc_
 				logWarning(
 				    "UVS U+%04X U+%04X is already mapped to %s. Assignment to %s is ignored.",
 				    k.unicode, k.selector, currentMap->name, gname);
+				sdsfree(gname);
 			}
 		}
 	}
@@ -429,7 +463,6 @@ table_cmap *otfcc_parseCmap(const json_value *root, const otfcc_Options *options
 		parseCmapUVS(cmap, json_obj_get_type(root, "cmap_uvs", json_object), options);
 	}
 
-	HASH_SORT(cmap->unicodes, by_unicode);
 	HASH_SORT(cmap->uvs, by_uvs_key);
 
 	return cmap;
@@ -464,34 +497,35 @@ static caryll_Buffer *otfcc_buildCmap_format4(const table_cmap *cmap) {
 	bool isSequencial = true;
 	uint16_t segmentsCount = 0;
 
-	cmap_Entry *item;
-	foreach_hash(item, cmap->unicodes) if (item->unicode <= 0xFFFF) {
+	// Code points come out of the page table in increasing order, so runs are walked directly.
+	int unicode = -1;
+	otfcc_GlyphHandle *glyph;
+	while ((glyph = otfcc_cmapNext(cmap, &unicode)) && unicode <= 0xFFFF) {
 		if (!started) {
 			started = true;
-			lastUnicodeStart = lastUnicodeEnd = item->unicode;
-			lastGIDStart = lastGIDEnd = item->glyph.index;
+			lastUnicodeStart = lastUnicodeEnd = unicode;
+			lastGIDStart = lastGIDEnd = glyph->index;
 			isSequencial = true;
 		} else {
-			if (item->unicode == lastUnicodeEnd + 1 &&
-			    !(item->glyph.index != lastGIDEnd + 1 && isSequencial &&
-			      lastGIDEnd - lastGIDStart >= 4)) {
-				if (isSequencial && !(item->glyph.index == lastGIDEnd + 1)) {
+			if (unicode == lastUnicodeEnd + 1 &&
+			    !(glyph->index != lastGIDEnd + 1 && isSequencial && lastGIDEnd - lastGIDStart >= 4)) {
+				if (isSequencial && !(glyph->index == lastGIDEnd + 1)) {
 					lastGlyphIdArrayOffset = glyphIdArray->cursor;
 					// oops, sequencial glyphid broken
 					for (int j = lastGIDStart; j <= lastGIDEnd; j++) {
 						bufwrite16b(glyphIdArray, j);
 					}
 				}
-				lastUnicodeEnd = item->unicode;
-				isSequencial = isSequencial && (item->glyph.index == lastGIDEnd + 1);
-				lastGIDEnd = item->glyph.index;
+				lastUnicodeEnd = unicode;
+				isSequencial = isSequencial && (glyph->index == lastGIDEnd + 1);
+				lastGIDEnd = glyph->index;
 				if (!isSequencial) { bufwrite16b(glyphIdArray, lastGIDEnd); }
 			} else {
 				// we have a segment
 				FLUSH_SEQUENCE_FORMAT_4;
 
-				lastUnicodeStart = lastUnicodeEnd = item->unicode;
-				lastGIDStart = lastGIDEnd = item->glyph.index;
+				lastUnicodeStart = lastUnicodeEnd = unicode;
+				lastGIDStart = lastGIDEnd = glyph->index;
 				isSequencial = true;
 			}
 		}
@@ -572,22 +606,23 @@ static caryll_Buffer *otfcc_buildCmap_format12(const table_cmap *cmap) {
 	int lastUnicodeEnd = 0xFFFFFF;
 	int lastGIDStart = 0xFFFFFF;
 	int lastGIDEnd = 0xFFFFFF;
-	cmap_Entry *item;
-	foreach_hash(item, cmap->unicodes) {
+	int unicode = -1;
+	otfcc_GlyphHandle *glyph;
+	while ((glyph = otfcc_cmapNext(cmap, &unicode))) {
 		if (!started) {
 			started = true;
-			lastUnicodeStart = lastUnicodeEnd = item->unicode;
-			lastGIDStart = lastGIDEnd = item->glyph.index;
-		} else if (item->unicode == lastUnicodeEnd + 1 && item->glyph.index == lastGIDEnd + 1) {
-			lastUnicodeEnd = item->unicode;
-			lastGIDEnd = item->glyph.index;
+			lastUnicodeStart = lastUnicodeEnd = unicode;
+			lastGIDStart = lastGIDEnd = glyph->index;
+		} else if (unicode == lastUnicodeEnd + 1 && glyph->index == lastGIDEnd + 1) {
+			lastUnicodeEnd = unicode;
+			lastGIDEnd = glyph->index;
 		} else {
 			bufwrite32b(buf, lastUnicodeStart);
 			bufwrite32b(buf, lastUnicodeEnd);
 			bufwrite32b(buf, lastGIDStart);
 			nGroups += 1;
-			lastUnicodeStart = lastUnicodeEnd = item->unicode;
-			lastGIDStart = lastGIDEnd = item->glyph.index;
+			lastUnicodeStart = lastUnicodeEnd = unicode;
+			lastGIDStart = lastGIDEnd = glyph->index;
 		}
 	}
 	bufwrite32b(buf, lastUnicodeStart);
@@ -603,8 +638,21 @@ static caryll_Buffer *otfcc_buildCmap_format12(const table_cmap *cmap) {
 }
 
 #define MAX_UNICODE 0x110001
-#define HAS_DEFAULT 1
-#define HAS_NON_DEFAULT 2
+
+typedef struct {
+	unicode_t selector;
+	unicode_t unicode;
+	glyphid_t gid;
+	bool isDefault;
+	bool mapped; // whether this entry is written, rather than only declaring its selector
+} UVSRecord;
+
+static int byUVSRecord(const void *_a, const void *_b) {
+	const UVSRecord *a = _a, *b = _b;
+	if (a->selector != b->selector) return a->selector < b->selector ? -1 : 1;
+	if (a->unicode != b->unicode) return a->unicode < b->unicode ? -1 : 1;
+	return 0;
+}
 
 static INLINE void writeDefaultRange(caryll_Buffer *dflt, uint32_t *nRanges, unicode_t start,
                                      unicode_t end) {
@@ -620,73 +668,75 @@ static INLINE void writeDefaultRange(caryll_Buffer *dflt, uint32_t *nRanges, uni
 	*nRanges += 1;
 }
 
-static uint8_t buildFormat14ForSelector(const table_cmap *cmap, unicode_t selector,
-                                        caryll_Buffer *dflt, caryll_Buffer *nondflt) {
-	glyphid_t *defaults, *nonDefaults;
-	NEW_CLEAN_N(defaults, MAX_UNICODE);
-	NEW_CLEAN_N(nonDefaults, MAX_UNICODE);
-	for (unicode_t s = 0; s < MAX_UNICODE; s++) {
-		defaults[s] = 0xFFFF;
-		nonDefaults[s] = 0xFFFF;
-	}
-	cmap_UVS_Entry *item;
-	foreach_hash(item, cmap->uvs) {
-		unicode_t u = item->key.unicode;
-		if (item->key.selector != selector || u >= MAX_UNICODE) continue;
-		if (!item->glyph.name) continue;
-		glyphid_t uvsGID = item->glyph.index;
-		otfcc_GlyphHandle *g = table_iCmap.lookup(cmap, (int)u);
-		if (!g) {
-			nonDefaults[u] = uvsGID;
-		} else if (uvsGID == g->index) {
-			defaults[u] = uvsGID;
-		} else {
-			nonDefaults[u] = uvsGID;
-		}
-	}
-
-	defaults[0] = nonDefaults[0] = 0xFFFF;                             // clear U+0000
-	defaults[MAX_UNICODE - 1] = nonDefaults[MAX_UNICODE - 1] = 0xFFFF; // clear U+110000 *
-
+// Writes the default and non-default tables of one selector from its records, which are
+// sorted by code point. Either buffer is freed and set to NULL if it has no entries.
+static void buildFormat14ForSelector(const UVSRecord *records, size_t n, caryll_Buffer **dflt,
+                                     caryll_Buffer **nondflt) {
 	uint32_t numUnicodeValueRanges = 0;
-	unicode_t startUnicodeValue = 0;
 	uint32_t numUVSMappings = 0;
-	bufwrite32b(dflt, 0);
-	bufwrite32b(nondflt, 0);
-	for (unicode_t u = 1; u < MAX_UNICODE; u++) {
-		if (defaults[u] != 0xFFFF && defaults[u - 1] == 0xFFFF) { startUnicodeValue = u; }
-		if (defaults[u] == 0xFFFF && defaults[u - 1] != 0xFFFF) {
-			writeDefaultRange(dflt, &numUnicodeValueRanges, startUnicodeValue, u - 1);
-		}
-		// non-defaults
-		if (nonDefaults[u] != 0xFFFF) {
-			bufwrite24b(nondflt, u);
-			bufwrite16b(nondflt, nonDefaults[u]);
+	bufwrite32b(*dflt, 0);
+	bufwrite32b(*nondflt, 0);
+
+	bool inRange = false;
+	unicode_t rangeStart = 0, rangeEnd = 0;
+	for (size_t j = 0; j < n; j++) {
+		const UVSRecord *r = &records[j];
+		if (!r->mapped) continue;
+		if (r->isDefault) {
+			if (inRange && r->unicode == rangeEnd + 1) {
+				rangeEnd = r->unicode;
+				continue;
+			}
+			if (inRange) writeDefaultRange(*dflt, &numUnicodeValueRanges, rangeStart, rangeEnd);
+			inRange = true;
+			rangeStart = rangeEnd = r->unicode;
+		} else {
+			bufwrite24b(*nondflt, r->unicode);
+			bufwrite16b(*nondflt, r->gid);
 			numUVSMappings++;
 		}
 	}
-	bufseek(dflt, 0);
-	bufwrite32b(dflt, numUnicodeValueRanges);
-	bufseek(nondflt, 0);
-	bufwrite32b(nondflt, numUVSMappings);
-
-	FREE(defaults);
-	FREE(nonDefaults);
+	if (inRange) writeDefaultRange(*dflt, &numUnicodeValueRanges, rangeStart, rangeEnd);
 
-	return (numUnicodeValueRanges ? HAS_DEFAULT : 0) | (numUVSMappings ? HAS_NON_DEFAULT : 0);
+	bufseek(*dflt, 0);
+	bufwrite32b(*dflt, numUnicodeValueRanges);
+	bufseek(*nondflt, 0);
+	bufwrite32b(*nondflt, numUVSMappings);
+	if (!numUnicodeValueRanges) {
+		buffree(*dflt);
+		*dflt = NULL;
+	}
+	if (!numUVSMappings) {
+		buffree(*nondflt);
+		*nondflt = NULL;
+	}
 }
 
 static caryll_Buffer *otfcc_buildCmap_format14(const table_cmap *cmap) {
-	bool *validSelectors;
-	NEW_CLEAN_N(validSelectors, MAX_UNICODE);
+	// Group the UVS entries by selector once; each selector then owns a sorted run of records.
+	// Entries without a glyph still declare their selector, but write no mapping.
+	UVSRecord *records;
+	size_t nRecords = 0;
+	NEW(records, HASH_COUNT(cmap->uvs));
 	cmap_UVS_Entry *item;
 	foreach_hash(item, cmap->uvs) {
-		if (item->key.selector < MAX_UNICODE) { validSelectors[item->key.selector] = true; }
+		if (item->key.selector >= MAX_UNICODE) continue;
+		UVSRecord *r = &records[nRecords++];
+		r->selector = item->key.selector;
+		r->unicode = item->key.unicode;
+		r->gid = item->glyph.index;
+		r->mapped = item->glyph.name && r->unicode > 0 && r->unicode < MAX_UNICODE - 1;
+		r->isDefault = false;
+		if (r->mapped) {
+			otfcc_GlyphHandle *g = table_iCmap.lookup(cmap, (int)r->unicode);
+			r->isDefault = g && g->index == r->gid;
+		}
 	}
+	if (nRecords) qsort(records, nRecords, sizeof(UVSRecord), byUVSRecord);
+
 	uint32_t nSelectors = 0;
-	for (unicode_t selector = 0; selector < MAX_UNICODE; selector++) {
-		if (!validSelectors[selector]) continue;
-		nSelectors++;
+	for (size_t j = 0; j < nRecords; j++) {
+		if (j == 0 || records[j].selector != records[j - 1].selector) nSelectors++;
 	}
 
 	bk_Block *st = bk_new_Block(b16, 14,         // format
@@ -694,26 +744,23 @@ static caryll_Buffer *otfcc_buildCmap_format14(const table_cmap *cmap) {
 	                            b32, nSelectors, // selector quantity
 	                            bkover);
 
-	for (unicode_t selector = 0; selector < MAX_UNICODE; selector++) {
-		if (!validSelectors[selector]) continue;
+	for (size_t j = 0; j < nRecords;) {
+		unicode_t selector = records[j].selector;
+		size_t k = j;
+		while (k < nRecords && records[k].selector == selector)
+			k++;
 		caryll_Buffer *dflt = bufnew();
 		caryll_Buffer *nondflt = bufnew();
-		uint8_t results = buildFormat14ForSelector(cmap, selector, dflt, nondflt);
-		if (!(results & HAS_DEFAULT)) {
-			buffree(dflt);
-			dflt = NULL;
-		}
-		if (!(results & HAS_NON_DEFAULT)) {
-			buffree(nondflt);
-			nondflt = NULL;
-		}
+		buildFormat14ForSelector(records + j, k - j, &dflt, &nondflt);
 		bk_push(st, b8, (selector >> 16) & 0xFF,     // selector, first byte
 		        b8, (selector >> 8) & 0xFF,          // selector, first byte
 		        b8, (selector >> 0) & 0xFF,          // selector, first byte
 		        p32, bk_newBlockFromBuffer(dflt),    // default offset
 		        p32, bk_newBlockFromBuffer(nondflt), // non-default offset
 		        bkover);
+		j = k;
 	}
+	FREE(records);
 
 	caryll_Buffer *buf = bk_build_Block(st);
 	bufseek(buf, 2);
@@ -722,13 +769,16 @@ static caryll_Buffer *otfcc_buildCmap_format14(const table_cmap *cmap) {
 }
 
 caryll_Buffer *otfcc_buildCmap(const table_cmap *cmap, const otfcc_Options *options) {
-	if (!cmap || !cmap->unicodes) return NULL;
+	if (!cmap || !cmap->unicodesCount) return NULL;
 
-	cmap_Entry *entry;
-	bool requiresFormat12 = false;
 	bool hasUVS = cmap->uvs && (HASH_COUNT(cmap->uvs) > 0);
-	foreach_hash(entry, cmap->unicodes) {
-		if (entry->unicode > 0xFFFF) { requiresFormat12 = true; }
+	// Anything mapped past the BMP lives in a page past 0xFF.
+	bool requiresFormat12 = false;
+	for (uint32_t p = 0x100; p < CMAP_PAGE_COUNT; p++) {
+		if (cmap->unicodes[p]) {
+			requiresFormat12 = true;
+			break;
+		}
 	}
 
 	caryll_Buffer *format4 = NULL;
@@ -13,6 +13,10 @@ static INLINE void disposeFvarInstance(fvar_Instance *inst) {
 }
 caryll_standardType(fvar_Instance, fvar_iInstance, initFvarInstance, disposeFvarInstance);
 caryll_standardVectorImpl(fvar_InstanceList, fvar_Instance, fvar_iInstance, fvar_iInstanceList);
+// avar segment maps
+caryll_standardValType(fvar_AxisValueMap, fvar_iAxisValueMap);
+caryll_standardVectorImpl(fvar_SegmentMap, fvar_AxisValueMap, fvar_iAxisValueMap, fvar_iSegmentMap);
+caryll_standardVectorImpl(fvar_SegmentMaps, fvar_SegmentMap, fvar_iSegmentMap, fvar_iSegmentMaps);
 // table fvar
 
 static INLINE void disposeFvarMaster(fvar_Master *m) {
@@ -24,10 +28,12 @@ static INLINE void initFvar(table_fvar *fvar) {
 	memset(fvar, 0, sizeof(*fvar));
 	vf_iAxes.init(&fvar->axes);
 	fvar_iInstanceList.init(&fvar->instances);
+	fvar_iSegmentMaps.init(&fvar->avar);
 }
 static INLINE void disposeFvar(table_fvar *fvar) {
 	vf_iAxes.dispose(&fvar->axes);
 	fvar_iInstanceList.dispose(&fvar->instances);
+	fvar_iSegmentMaps.dispose(&fvar->avar);
 
 	fvar_Master *current, *tmp;
 	HASH_ITER(hh, fvar->masters, current, tmp) {
@@ -35,28 +41,41 @@ static INLINE void disposeFvar(table_fvar *fvar) {
 		disposeFvarMaster(current);
 		FREE(current);
 	}
+	FREE(fvar->mastersByID);
 }
 
+// Regions are interned: equal regions register as one, and get the next ID when they are new.
 static const vq_Region *fvar_registerRegion(table_fvar *fvar, MOVE vq_Region *region) {
 	fvar_Master *m = NULL;
-	HASH_FIND(hh, fvar->masters, region, VQ_REGION_SIZE(region->dimensions), m);
+	HASH_FIND(hh, fvar->masters, VQ_REGION_KEY(region), VQ_REGION_KEY_SIZE(region->dimensions),
+	          m);
 	if (m) {
 		vq_deleteRegion(region);
 		return m->region;
 	} else {
+		uint32_t id = 1 + HASH_CNT(hh, fvar->masters);
 		NEW_CLEAN_1(m);
-		sds sMasterID = sdsfromlonglong(1 + HASH_CNT(hh, fvar->masters));
+		sds sMasterID = sdsfromlonglong(id);
 		m->name = sdscatsds(sdsnew("m"), sMasterID);
 		sdsfree(sMasterID);
 		m->region = region;
-		HASH_ADD_KEYPTR(hh, fvar->masters, m->region, VQ_REGION_SIZE(region->dimensions), m);
+		m->region->id = id;
+		HASH_ADD_KEYPTR(hh, fvar->masters, VQ_REGION_KEY(m->region),
+		                VQ_REGION_KEY_SIZE(region->dimensions), m);
+		RESIZE(fvar->mastersByID, id);
+		fvar->mastersByID[id - 1] = m;
 		return m->region;
 	}
 }
 
 static const fvar_Master *fvar_findMasterByRegion(const table_fvar *fvar, const vq_Region *region) {
+	if (region->id && region->id <= HASH_CNT(hh, fvar->masters) &&
+	    fvar->mastersByID[region->id - 1]->region == region) {
+		return fvar->mastersByID[region->id - 1];
+	}
 	fvar_Master *m = NULL;
-	HASH_FIND(hh, fvar->masters, region, VQ_REGION_SIZE(region->dimensions), m);
+	HASH_FIND(hh, fvar->masters, VQ_REGION_KEY(region), VQ_REGION_KEY_SIZE(region->dimensions),
+	          m);
 	return m;
 }
 
@@ -94,6 +113,38 @@ struct InstanceRecord {
 };
 #pragma pack()
 
+// avar is kept with the axes of fvar, whose order it follows.
+static void readAvar(const otfcc_Packet packet, const otfcc_Options *options, table_fvar *fvar) {
+	FOR_TABLE('avar', table) {
+		font_file_pointer data = table.data;
+		if (table.length < 8) goto FAIL;
+		if (read_16u(data) != 1 || read_16u(data + 2) != 0) goto FAIL;
+		if (read_16u(data + 6) != fvar->axes.length) goto FAIL;
+		uint32_t offset = 8;
+		for (tableid_t j = 0; j < fvar->axes.length; j++) {
+			if (table.length < offset + 2) goto FAIL;
+			uint16_t nMaps = read_16u(data + offset);
+			offset += 2;
+			if (table.length < offset + 4 * nMaps) goto FAIL;
+			fvar_SegmentMap map;
+			fvar_iSegmentMap.initCapN(&map, nMaps);
+			for (uint16_t k = 0; k < nMaps; k++) {
+				fvar_AxisValueMap pair = {
+				    .fromCoordinate = otfcc_from_f2dot14(read_16s(data + offset)),
+				    .toCoordinate = otfcc_from_f2dot14(read_16s(data + offset + 2))};
+				fvar_iSegmentMap.push(&map, pair);
+				offset += 4;
+			}
+			fvar_iSegmentMaps.push(&fvar->avar, map);
+		}
+		return;
+
+	FAIL:
+		logWarning("table 'avar' corrupted.\n");
+		fvar_iSegmentMaps.clear(&fvar->avar);
+	}
+}
+
 table_fvar *otfcc_readFvar(const otfcc_Packet packet, const otfcc_Options *options) {
 	table_fvar *fvar = NULL;
 	FOR_TABLE('fvar', table) {
@@ -156,6 +207,7 @@ table_fvar *otfcc_readFvar(const otfcc_Packet packet, const otfcc_Options *optio
 		}
 		vf_iAxes.shrinkToFit(&fvar->axes);
 		fvar_iInstanceList.shrinkToFit(&fvar->instances);
+		readAvar(packet, options, fvar);
 
 		return fvar;
 
@@ -220,8 +272,8 @@ json_value *json_new_VQSegment(const vq_Segment *s, const table_fvar *fvar) {
 		case VQ_DELTA:;
 			json_value *d = json_object_new(3);
 			json_object_push(d, "delta", json_new_position(s->val.delta.quantity));
-			if (!s->val.delta.touched) {
-				json_object_push(d, "implicit", json_boolean_new(!s->val.delta.touched));
+			if (!s->touched) {
+				json_object_push(d, "implicit", json_boolean_new(!s->touched));
 			}
 			json_object_push(d, "on", json_new_VQRegion(s->val.delta.region, fvar));
 			return d;
@@ -230,14 +282,15 @@ json_value *json_new_VQSegment(const vq_Segment *s, const table_fvar *fvar) {
 	}
 }
 json_value *json_new_VQ(const VQ z, const table_fvar *fvar) {
-
-	if (!z.shift.length) {
+	uint32_t n = vq_shiftLength(&z);
+	if (!n) {
 		return preserialize(json_new_position(iVQ.getStill(z)));
 	} else {
-		json_value *a = json_array_new(z.shift.length + 1);
+		const vq_Segment *segments = vq_segments(&z);
+		json_value *a = json_array_new(n + 1);
 		json_array_push(a, json_new_position(z.kernel));
-		for (size_t j = 0; j < z.shift.length; j++) {
-			json_array_push(a, json_new_VQSegment(&z.shift.items[j], fvar));
+		for (uint32_t j = 0; j < n; j++) {
+			json_array_push(a, json_new_VQSegment(&segments[j], fvar));
 		}
 		return preserialize(a);
 	}
@@ -11,7 +11,10 @@ typedef struct {
 	glyphid_t numGlyphs;
 	shapeid_t nPhantomPoints;
 	table_fvar *fvar;
+	bool boxesOnly; // read only the bounding boxes of the glyph headers, for the metrics
 	bool hasVerticalMetrics;
+	bool exportOutlines;
+	bool exportHorizontalMetrics;
 	bool exportFDSelect;
 } GlyfIOContext;
 
@@ -29,6 +32,10 @@ typedef struct {
 
 table_GlyfAndLocaBuffers otfcc_buildGlyf(const table_glyf *table, table_head *head,
                                          const otfcc_Options *options);
+// The glyf table in the WOFF2 transform, which the loca table is rebuilt from. Run it after
+// otfcc_buildGlyf, which picks head.indexToLocFormat.
+caryll_Buffer *otfcc_buildGlyfWOFF2(const table_glyf *table, const table_head *head,
+                                    const otfcc_Options *options);
 
 typedef enum {
 	GLYF_FLAG_ON_CURVE = 1,
@@ -109,12 +109,7 @@ static void glyf_build_simple(const glyf_Glyph *g, caryll_Buffer *gbuf) {
 	buffree(xs);
 	buffree(ys);
 }
-static void glyf_build_composite(const glyf_Glyph *g, caryll_Buffer *gbuf) {
-	bufwrite16b(gbuf, (-1));
-	bufwrite16b(gbuf, (int16_t)g->stat.xMin);
-	bufwrite16b(gbuf, (int16_t)g->stat.yMin);
-	bufwrite16b(gbuf, (int16_t)g->stat.xMax);
-	bufwrite16b(gbuf, (int16_t)g->stat.yMax);
+static void glyf_build_references(const glyf_Glyph *g, caryll_Buffer *gbuf) {
 	for (shapeid_t rj = 0; rj < g->references.length; rj++) {
 		glyf_ComponentReference *r = &(g->references.items[rj]);
 		uint16_t flags =
@@ -174,6 +169,14 @@ static void glyf_build_composite(const glyf_Glyph *g, caryll_Buffer *gbuf) {
 			bufwrite16b(gbuf, otfcc_to_f2dot14(r->d));
 		}
 	}
+}
+static void glyf_build_composite(const glyf_Glyph *g, caryll_Buffer *gbuf) {
+	bufwrite16b(gbuf, (-1));
+	bufwrite16b(gbuf, (int16_t)g->stat.xMin);
+	bufwrite16b(gbuf, (int16_t)g->stat.yMin);
+	bufwrite16b(gbuf, (int16_t)g->stat.xMax);
+	bufwrite16b(gbuf, (int16_t)g->stat.yMax);
+	glyf_build_references(g, gbuf);
 	if (g->instructionsLength) {
 		bufwrite16b(gbuf, g->instructionsLength);
 		if (g->instructions) bufwrite_bytes(gbuf, g->instructionsLength, g->instructions);
@@ -220,3 +223,147 @@ table_GlyfAndLocaBuffers otfcc_buildGlyf(const table_glyf *table, table_head *he
 	table_GlyfAndLocaBuffers pair = {bufglyf, bufloca};
 	return pair;
 }
+
+// WOFF2 transformed glyf, version 0. Glyphs are split into streams of contour counts, point
+// counts, point flags, coordinate triplets, composite records, bounding boxes and instructions.
+static void write255UShort(caryll_Buffer *buf, uint16_t value) {
+	if (value < 253) {
+		bufwrite8(buf, value);
+	} else if (value < 506) {
+		bufwrite8(buf, 255);
+		bufwrite8(buf, value - 253);
+	} else if (value < 762) {
+		bufwrite8(buf, 254);
+		bufwrite8(buf, value - 506);
+	} else {
+		bufwrite8(buf, 253);
+		bufwrite16b(buf, value);
+	}
+}
+// A point delta, in the shortest of the 128 triplet encodings which holds it
+static void writeTriplet(caryll_Buffer *flags, caryll_Buffer *glyphs, bool onCurve, int32_t dx,
+                         int32_t dy) {
+	int32_t ax = dx < 0 ? -dx : dx, ay = dy < 0 ? -dy : dy;
+	uint8_t flag = onCurve ? 0 : 128;
+	uint8_t xSign = dx < 0 ? 0 : 1, ySign = dy < 0 ? 0 : 1;
+	uint8_t signs = xSign + 2 * ySign;
+	if (dx == 0 && ay < 1280) {
+		bufwrite8(flags, flag + ((ay & 0xF00) >> 7) + ySign);
+		bufwrite8(glyphs, ay & 0xFF);
+	} else if (dy == 0 && ax < 1280) {
+		bufwrite8(flags, flag + 10 + ((ax & 0xF00) >> 7) + xSign);
+		bufwrite8(glyphs, ax & 0xFF);
+	} else if (ax < 65 && ay < 65) {
+		bufwrite8(flags, flag + 20 + ((ax - 1) & 0x30) + (((ay - 1) & 0x30) >> 2) + signs);
+		bufwrite8(glyphs, (((ax - 1) & 0xF) << 4) | ((ay - 1) & 0xF));
+	} else if (ax < 769 && ay < 769) {
+		bufwrite8(flags,
+		          flag + 84 + 12 * (((ax - 1) & 0x300) >> 8) + (((ay - 1) & 0x300) >> 6) + signs);
+		bufwrite8(glyphs, (ax - 1) & 0xFF);
+		bufwrite8(glyphs, (ay - 1) & 0xFF);
+	} else if (ax < 4096 && ay < 4096) {
+		bufwrite8(flags, flag + 120 + signs);
+		bufwrite8(glyphs, ax >> 4);
+		bufwrite8(glyphs, ((ax & 0xF) << 4) | (ay >> 8));
+		bufwrite8(glyphs, ay & 0xFF);
+	} else {
+		bufwrite8(flags, flag + 124 + signs);
+		bufwrite16b(glyphs, ax);
+		bufwrite16b(glyphs, ay);
+	}
+}
+static void writeBBox(caryll_Buffer *bboxes, uint8_t *bitmap, glyphid_t j, const glyf_Glyph *g) {
+	bitmap[j >> 3] |= 0x80 >> (j & 7);
+	bufwrite16b(bboxes, (int16_t)g->stat.xMin);
+	bufwrite16b(bboxes, (int16_t)g->stat.yMin);
+	bufwrite16b(bboxes, (int16_t)g->stat.xMax);
+	bufwrite16b(bboxes, (int16_t)g->stat.yMax);
+}
+caryll_Buffer *otfcc_buildGlyfWOFF2(const table_glyf *table, const table_head *head,
+                                    const otfcc_Options *options) {
+	caryll_Buffer *buf = bufnew();
+	if (!table || !head) return buf;
+	caryll_Buffer *nContours = bufnew();
+	caryll_Buffer *nPoints = bufnew();
+	caryll_Buffer *flags = bufnew();
+	caryll_Buffer *glyphs = bufnew();
+	caryll_Buffer *composites = bufnew();
+	caryll_Buffer *bboxes = bufnew();
+	caryll_Buffer *instructions = bufnew();
+	size_t bitmapSize = 4 * ((table->length + 31) / 32);
+	uint8_t *bitmap;
+	NEW(bitmap, bitmapSize);
+
+	for (glyphid_t j = 0; j < table->length; j++) {
+		const glyf_Glyph *g = table->items[j];
+		if (g->contours.length > 0) {
+			bufwrite16b(nContours, g->contours.length);
+			// The decoder computes the bounding box from the points unless it is given.
+			int32_t cx = 0, cy = 0;
+			int32_t xMin = 0x7FFFFFFF, yMin = 0x7FFFFFFF, xMax = -0x7FFFFFFF, yMax = -0x7FFFFFFF;
+			for (shapeid_t cj = 0; cj < g->contours.length; cj++) {
+				write255UShort(nPoints, g->contours.items[cj].length);
+				for (shapeid_t k = 0; k < g->contours.items[cj].length; k++) {
+					glyf_Point *p = &(g->contours.items[cj].items[k]);
+					int32_t px = round(iVQ.getStill(p->x));
+					int32_t py = round(iVQ.getStill(p->y));
+					writeTriplet(flags, glyphs, p->onCurve & MASK_ON_CURVE, (int16_t)(px - cx),
+					             (int16_t)(py - cy));
+					cx = px, cy = py;
+					if (px < xMin) xMin = px;
+					if (px > xMax) xMax = px;
+					if (py < yMin) yMin = py;
+					if (py > yMax) yMax = py;
+				}
+			}
+			if (xMin != (int16_t)g->stat.xMin || yMin != (int16_t)g->stat.yMin ||
+			    xMax != (int16_t)g->stat.xMax || yMax != (int16_t)g->stat.yMax) {
+				writeBBox(bboxes, bitmap, j, g);
+			}
+			write255UShort(glyphs, g->instructionsLength);
+			if (g->instructions) bufwrite_bytes(instructions, g->instructionsLength, g->instructions);
+		} else if (g->references.length > 0) {
+			bufwrite16b(nContours, -1);
+			writeBBox(bboxes, bitmap, j, g);
+			glyf_build_references(g, composites);
+			if (g->instructionsLength) {
+				write255UShort(glyphs, g->instructionsLength);
+				if (g->instructions) {
+					bufwrite_bytes(instructions, g->instructionsLength, g->instructions);
+				}
+			}
+		} else {
+			bufwrite16b(nContours, 0);
+		}
+	}
+
+	bufwrite16b(buf, 0); // reserved
+	bufwrite16b(buf, 0); // optionFlags
+	bufwrite16b(buf, table->length);
+	bufwrite16b(buf, head->indexToLocFormat);
+	bufwrite32b(buf, (uint32_t)buflen(nContours));
+	bufwrite32b(buf, (uint32_t)buflen(nPoints));
+	bufwrite32b(buf, (uint32_t)buflen(flags));
+	bufwrite32b(buf, (uint32_t)buflen(glyphs));
+	bufwrite32b(buf, (uint32_t)buflen(composites));
+	bufwrite32b(buf, (uint32_t)(bitmapSize + buflen(bboxes)));
+	bufwrite32b(buf, (uint32_t)buflen(instructions));
+	bufwrite_buf(buf, nContours);
+	bufwrite_buf(buf, nPoints);
+	bufwrite_buf(buf, flags);
+	bufwrite_buf(buf, glyphs);
+	bufwrite_buf(buf, composites);
+	bufwrite_bytes(buf, bitmapSize, bitmap);
+	bufwrite_buf(buf, bboxes);
+	bufwrite_buf(buf, instructions);
+
+	FREE(bitmap);
+	buffree(nContours);
+	buffree(nPoints);
+	buffree(flags);
+	buffree(glyphs);
+	buffree(composites);
+	buffree(bboxes);
+	buffree(instructions);
+	return buf;
+}
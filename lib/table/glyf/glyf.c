@@ -220,15 +220,20 @@ static json_value *glyf_glyph_dump_maskdefs(glyf_MaskList *masks, glyf_StemDefLi
 static json_value *glyf_dump_glyph(glyf_Glyph *g, const otfcc_Options *options,
                                    const GlyfIOContext *ctx) {
 	json_value *glyph = json_object_new(12);
-	json_object_push(glyph, "advanceWidth", json_new_VQ(g->advanceWidth, ctx->fvar));
-	if (iVQ.isStill(g->horizontalOrigin) &&
-	    fabs(iVQ.getStill(g->horizontalOrigin)) > 1.0 / 1000.0) {
-		json_object_push(glyph, "horizontalOrigin", json_new_VQ(g->horizontalOrigin, ctx->fvar));
+	if (ctx->exportHorizontalMetrics) {
+		json_object_push(glyph, "advanceWidth", json_new_VQ(g->advanceWidth, ctx->fvar));
+		if (iVQ.isStill(g->horizontalOrigin) &&
+		    fabs(iVQ.getStill(g->horizontalOrigin)) > 1.0 / 1000.0) {
+			json_object_push(glyph, "horizontalOrigin",
+			                 json_new_VQ(g->horizontalOrigin, ctx->fvar));
+		}
 	}
 	if (ctx->hasVerticalMetrics) {
 		json_object_push(glyph, "advanceHeight", json_new_VQ(g->advanceHeight, ctx->fvar));
 		json_object_push(glyph, "verticalOrigin", json_new_VQ(g->verticalOrigin, ctx->fvar));
 	}
+	// Only the metrics are dumped when glyf itself is not selected.
+	if (!ctx->exportOutlines) return glyph;
 	glyf_glyph_dump_contours(g, glyph, ctx);
 	glyf_glyph_dump_references(g, glyph, ctx);
 	if (ctx->exportFDSelect) {
@@ -461,14 +466,14 @@ table_glyf *otfcc_parseGlyf(const json_value *root, otfcc_GlyphOrder *glyph_orde
 				sds gname = sdsnewlen(table->u.object.values[j].name,
 				                      table->u.object.values[j].name_length);
 				json_value *glyphdump = table->u.object.values[j].value;
-				otfcc_GlyphOrderEntry *order_entry = NULL;
-				HASH_FIND(hhName, glyph_order->byName, gname, sdslen(gname), order_entry);
+				otfcc_GlyphOrderEntry *order_entry =
+				    GlyphOrder.findByName(glyph_order, gname, sdslen(gname));
 				if (glyphdump->type == json_object && order_entry &&
 				    !glyf->items[order_entry->gid]) {
 					glyf->items[order_entry->gid] =
 					    otfcc_glyf_parse_glyph(glyphdump, order_entry, options);
 				}
-				json_value_free(glyphdump);
+				json_value_free_subtree(glyphdump);
 				json_value *v = json_null_new();
 				v->parent = table;
 				table->u.object.values[j].value = v;
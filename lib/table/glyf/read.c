@@ -131,14 +131,12 @@ static glyf_Glyph *otfcc_read_simple_glyph(font_file_pointer start, shapeid_t nu
 	return g;
 }
 
-static glyf_Glyph *otfcc_read_composite_glyph(font_file_pointer start,
-                                              const otfcc_Options *options) {
-	glyf_Glyph *g = otfcc_newGlyf_glyph();
-
-	// pass 1, read references quantity
+// Reads the component records of a composite glyph. Returns their size.
+static uint32_t otfcc_read_references(font_file_pointer start, glyf_Glyph *g,
+                                      bool *glyphHasInstruction, const otfcc_Options *options) {
 	uint16_t flags = 0;
 	uint32_t offset = 0;
-	bool glyphHasInstruction = false;
+	*glyphHasInstruction = false;
 	do {
 		flags = read_16u(start + offset);
 		glyphid_t index = read_16u(start + offset + 2);
@@ -190,9 +188,17 @@ static glyf_Glyph *otfcc_read_composite_glyph(font_file_pointer start,
 		    (flags & WE_HAVE_AN_X_AND_Y_SCALE || flags & WE_HAVE_A_TWO_BY_TWO)) {
 			logWarning("glyf: SCALED_COMPONENT_OFFSET is not supported.")
 		}
-		if (flags & WE_HAVE_INSTRUCTIONS) { glyphHasInstruction = true; }
+		if (flags & WE_HAVE_INSTRUCTIONS) { *glyphHasInstruction = true; }
 		glyf_iReferenceList.push(&g->references, ref);
 	} while (flags & MORE_COMPONENTS);
+	return offset;
+}
+
+static glyf_Glyph *otfcc_read_composite_glyph(font_file_pointer start,
+                                              const otfcc_Options *options) {
+	glyf_Glyph *g = otfcc_newGlyf_glyph();
+	bool glyphHasInstruction;
+	uint32_t offset = otfcc_read_references(start, g, &glyphHasInstruction, options);
 
 	if (glyphHasInstruction) {
 		uint16_t instructionLength = read_16u(start + offset);
@@ -228,6 +234,218 @@ static glyf_Glyph *otfcc_read_glyph(font_file_pointer data, uint32_t offset,
 	return g;
 }
 
+// A glyph without outlines, which keeps the bounding box of its header.
+static glyf_Glyph *otfcc_read_glyph_box(font_file_pointer data, uint32_t offset) {
+	font_file_pointer start = data + offset;
+	glyf_Glyph *g = otfcc_newGlyf_glyph();
+	g->stat.xMin = read_16s(start + 2);
+	g->stat.yMin = read_16s(start + 4);
+	g->stat.xMax = read_16s(start + 6);
+	g->stat.yMax = read_16s(start + 8);
+	return g;
+}
+
+// WOFF2 transformed glyf, version 0. Glyphs are decoded from the streams directly, without
+// rebuilding glyf and loca first.
+typedef struct {
+	font_file_pointer data;
+	uint32_t length;
+	uint32_t cursor;
+} WOFF2Stream;
+
+typedef struct {
+	WOFF2Stream nContours;
+	WOFF2Stream nPoints;
+	WOFF2Stream flags;
+	WOFF2Stream glyphs;
+	WOFF2Stream composites;
+	WOFF2Stream bboxes;
+	WOFF2Stream instructions;
+	font_file_pointer bboxBitmap;
+} WOFF2GlyfStreams;
+
+static INLINE bool streamHas(const WOFF2Stream *s, uint32_t n) {
+	return s->length - s->cursor >= n;
+}
+static bool read255UShort(WOFF2Stream *s, uint16_t *value) {
+	if (!streamHas(s, 1)) return false;
+	uint8_t code = s->data[s->cursor++];
+	if (code == 253) {
+		if (!streamHas(s, 2)) return false;
+		*value = read_16u(s->data + s->cursor);
+		s->cursor += 2;
+	} else if (code >= 254) {
+		if (!streamHas(s, 1)) return false;
+		*value = s->data[s->cursor++] + (code == 255 ? 253 : 506);
+	} else {
+		*value = code;
+	}
+	return true;
+}
+// A point delta. The flag picks one of 128 encodings of its size and signs; the top bit is set
+// for off-curve points.
+static bool readTriplet(WOFF2Stream *s, uint8_t flag, int32_t *dx, int32_t *dy) {
+	flag &= 0x7F;
+	uint8_t size = flag < 84 ? 1 : flag < 120 ? 2 : flag < 124 ? 3 : 4;
+	if (!streamHas(s, size)) return false;
+	const uint8_t *p = s->data + s->cursor;
+	s->cursor += size;
+	int32_t x, y;
+	if (flag < 10) {
+		x = 0, y = ((flag & 14) << 7) + p[0];
+	} else if (flag < 20) {
+		x = (((flag - 10) & 14) << 7) + p[0], y = 0;
+	} else if (flag < 84) {
+		uint8_t b0 = flag - 20;
+		x = 1 + (b0 & 0x30) + (p[0] >> 4), y = 1 + ((b0 & 0x0C) << 2) + (p[0] & 0x0F);
+	} else if (flag < 120) {
+		uint8_t b0 = flag - 84;
+		x = 1 + ((b0 / 12) << 8) + p[0], y = 1 + (((b0 % 12) >> 2) << 8) + p[1];
+	} else if (flag < 124) {
+		x = (p[0] << 4) + (p[1] >> 4), y = ((p[1] & 0x0F) << 8) + p[2];
+	} else {
+		x = (p[0] << 8) + p[1], y = (p[2] << 8) + p[3];
+	}
+	// Deltas along one axis only have their sign in bit 0; the others use bit 0 for x and
+	// bit 1 for y.
+	if (flag < 10) {
+		*dx = 0, *dy = flag & 1 ? y : -y;
+	} else if (flag < 20) {
+		*dx = flag & 1 ? x : -x, *dy = 0;
+	} else {
+		*dx = flag & 1 ? x : -x, *dy = flag & 2 ? y : -y;
+	}
+	return true;
+}
+static bool readWOFF2Instructions(WOFF2GlyfStreams *st, glyf_Glyph *g) {
+	uint16_t length;
+	if (!read255UShort(&st->glyphs, &length) || !streamHas(&st->instructions, length)) {
+		return false;
+	}
+	g->instructionsLength = length;
+	if (length) {
+		NEW(g->instructions, length);
+		memcpy(g->instructions, st->instructions.data + st->instructions.cursor, length);
+		st->instructions.cursor += length;
+	}
+	return true;
+}
+static bool readWOFF2SimpleGlyph(WOFF2GlyfStreams *st, shapeid_t numberOfContours,
+                                 glyf_Glyph *g) {
+	int32_t x = 0, y = 0;
+	int32_t xMin = 0x7FFFFFFF, yMin = 0x7FFFFFFF, xMax = -0x7FFFFFFF, yMax = -0x7FFFFFFF;
+	for (shapeid_t j = 0; j < numberOfContours; j++) {
+		uint16_t nPoints;
+		if (!read255UShort(&st->nPoints, &nPoints) || !streamHas(&st->flags, nPoints)) {
+			return false;
+		}
+		glyf_Contour contour;
+		glyf_iContour.init(&contour);
+		glyf_iContour.fill(&contour, nPoints);
+		glyf_iContourList.push(&g->contours, contour);
+		for (shapeid_t k = 0; k < nPoints; k++) {
+			uint8_t flag = st->flags.data[st->flags.cursor++];
+			int32_t dx, dy;
+			if (!readTriplet(&st->glyphs, flag, &dx, &dy)) return false;
+			x += dx, y += dy;
+			glyf_Point *z = &g->contours.items[j].items[k];
+			z->onCurve = !(flag & 0x80);
+			iVQ.replace(&z->x, iVQ.createStill(x));
+			iVQ.replace(&z->y, iVQ.createStill(y));
+			if (x < xMin) xMin = x;
+			if (x > xMax) xMax = x;
+			if (y < yMin) yMin = y;
+			if (y > yMax) yMax = y;
+		}
+	}
+	if (xMin <= xMax) {
+		g->stat.xMin = xMin, g->stat.yMin = yMin, g->stat.xMax = xMax, g->stat.yMax = yMax;
+	}
+	return readWOFF2Instructions(st, g);
+}
+// Composite records are stored as in glyf; their size is found before they are read.
+static bool readWOFF2CompositeGlyph(WOFF2GlyfStreams *st, glyf_Glyph *g,
+                                    const otfcc_Options *options) {
+	WOFF2Stream *s = &st->composites;
+	uint32_t size = 0;
+	uint16_t flags;
+	do {
+		if (s->length - s->cursor - size < 4) return false;
+		flags = read_16u(s->data + s->cursor + size);
+		size += 4 + (flags & ARG_1_AND_2_ARE_WORDS ? 4 : 2);
+		if (flags & WE_HAVE_A_SCALE) {
+			size += 2;
+		} else if (flags & WE_HAVE_AN_X_AND_Y_SCALE) {
+			size += 4;
+		} else if (flags & WE_HAVE_A_TWO_BY_TWO) {
+			size += 8;
+		}
+		if (s->length - s->cursor < size) return false;
+	} while (flags & MORE_COMPONENTS);
+	bool glyphHasInstruction;
+	s->cursor += otfcc_read_references(s->data + s->cursor, g, &glyphHasInstruction, options);
+	return !glyphHasInstruction || readWOFF2Instructions(st, g);
+}
+static glyf_Glyph *readWOFF2Glyph(WOFF2GlyfStreams *st, glyphid_t j,
+                                  const otfcc_Options *options) {
+	glyf_Glyph *g = otfcc_newGlyf_glyph();
+	if (!streamHas(&st->nContours, 2)) goto FAIL;
+	int16_t numberOfContours = read_16s(st->nContours.data + st->nContours.cursor);
+	st->nContours.cursor += 2;
+	bool hasBBox = st->bboxBitmap[j >> 3] & (0x80 >> (j & 7));
+	if (numberOfContours > 0) {
+		if (!readWOFF2SimpleGlyph(st, numberOfContours, g)) goto FAIL;
+	} else if (numberOfContours == -1) {
+		if (!hasBBox || !readWOFF2CompositeGlyph(st, g, options)) goto FAIL;
+	} else if (numberOfContours < 0 || hasBBox) {
+		goto FAIL;
+	}
+	if (hasBBox) {
+		if (!streamHas(&st->bboxes, 8)) goto FAIL;
+		font_file_pointer bbox = st->bboxes.data + st->bboxes.cursor;
+		g->stat.xMin = read_16s(bbox);
+		g->stat.yMin = read_16s(bbox + 2);
+		g->stat.xMax = read_16s(bbox + 4);
+		g->stat.yMax = read_16s(bbox + 6);
+		st->bboxes.cursor += 8;
+	}
+	return g;
+FAIL:
+	glyf_iGlyphPtr.dispose(&g);
+	return NULL;
+}
+static table_glyf *readWOFF2Glyf(font_file_pointer data, uint32_t length,
+                                 const otfcc_Options *options, const GlyfIOContext *ctx) {
+	if (length < 36 || read_16u(data + 4) != ctx->numGlyphs) return NULL;
+	WOFF2GlyfStreams st;
+	WOFF2Stream *streams[7] = {&st.nContours,  &st.nPoints, &st.flags,       &st.glyphs,
+	                           &st.composites, &st.bboxes,  &st.instructions};
+	uint64_t offset = 36;
+	for (uint8_t j = 0; j < 7; j++) {
+		uint32_t size = read_32u(data + 8 + 4 * j);
+		if (offset + size > length) return NULL;
+		streams[j]->data = data + offset;
+		streams[j]->length = size;
+		streams[j]->cursor = 0;
+		offset += size;
+	}
+	uint32_t bitmapSize = 4 * ((ctx->numGlyphs + 31) / 32);
+	if (!streamHas(&st.bboxes, bitmapSize)) return NULL;
+	st.bboxBitmap = st.bboxes.data;
+	st.bboxes.cursor = bitmapSize;
+
+	table_glyf *glyf = table_iGlyf.create();
+	for (glyphid_t j = 0; j < ctx->numGlyphs; j++) {
+		glyf_Glyph *g = readWOFF2Glyph(&st, j, options);
+		if (!g) {
+			table_iGlyf.free(glyf);
+			return NULL;
+		}
+		table_iGlyf.push(glyf, g);
+	}
+	return glyf;
+}
+
 // common states of tuple polymorphizer
 
 typedef struct {
@@ -311,7 +529,7 @@ static INLINE font_file_pointer parsePointNumbers(font_file_pointer data, shapei
 			}
 			int16_t pointNumber = jPoint;
 			if (run.wide) {
-				pointNumber += *((uint16_t *)data);
+				pointNumber += read_16u(data);
 				data += 2;
 			} else {
 				pointNumber += *data++;
@@ -381,10 +599,10 @@ VQ *getY(glyf_Point *z) {
 static INLINE void fillTheGaps(shapeid_t jMin, shapeid_t jMax, vq_Segment *nudges,
                                glyf_Point **glyphRefs, CoordPartGetter getter) {
 	for (shapeid_t j = jMin; j < jMax; j++) {
-		if (nudges[j].val.delta.touched) continue;
+		if (nudges[j].touched) continue;
 		// get next knot
 		shapeid_t jNext = j;
-		while (!nudges[jNext].val.delta.touched) {
+		while (!nudges[jNext].touched) {
 			if (jNext == jMax - 1) {
 				jNext = jMin;
 			} else {
@@ -394,7 +612,7 @@ static INLINE void fillTheGaps(shapeid_t jMin, shapeid_t jMax, vq_Segment *nudge
 		}
 		// get pre knot
 		shapeid_t jPrev = j;
-		while (!nudges[jPrev].val.delta.touched) {
+		while (!nudges[jPrev].touched) {
 			if (jPrev == jMin) {
 				jPrev = jMax - 1;
 			} else {
@@ -402,7 +620,7 @@ static INLINE void fillTheGaps(shapeid_t jMin, shapeid_t jMax, vq_Segment *nudge
 			}
 			if (jPrev == j) break;
 		}
-		if (nudges[jNext].val.delta.touched && nudges[jPrev].val.delta.touched) {
+		if (nudges[jNext].touched && nudges[jPrev].touched) {
 			f16dot16 untouchJ = otfcc_to_fixed(getter(glyphRefs[j])->kernel);
 			f16dot16 untouchPrev = otfcc_to_fixed(getter(glyphRefs[jPrev])->kernel);
 			f16dot16 untouchNext = otfcc_to_fixed(getter(glyphRefs[jNext])->kernel);
@@ -441,13 +659,13 @@ static void applyCoords(const shapeid_t totalPoints, glyf_Glyph *glyph,
 	NEW_CLEAN_N(nudges, totalPoints);
 	for (shapeid_t j = 0; j < totalPoints; j++) {
 		nudges[j].type = VQ_DELTA;
-		nudges[j].val.delta.touched = false;
+		nudges[j].touched = false;
 		nudges[j].val.delta.quantity = 0;
 		nudges[j].val.delta.region = r;
 	}
 	for (shapeid_t j = 0; j < nTouchedPoints; j++) {
 		if (points[j] >= totalPoints) continue;
-		nudges[points[j]].val.delta.touched = true;
+		nudges[points[j]].touched = true;
 		nudges[points[j]].val.delta.quantity += tupleDelta[j];
 	}
 	// fill the gaps
@@ -457,9 +675,8 @@ static void applyCoords(const shapeid_t totalPoints, glyf_Glyph *glyph,
 		jFirst += c->length;
 	}
 	for (shapeid_t j = 0; j < totalPoints; j++) {
-		if (!nudges[j].val.delta.quantity && nudges[j].val.delta.touched) continue;
-		VQ *coordinatePart = getter(glyphRefs[j]);
-		vq_iSegList.push(&(coordinatePart->shift), nudges[j]);
+		if (!nudges[j].val.delta.quantity && nudges[j].touched) continue;
+		iVQ.addSegment(getter(glyphRefs[j]), nudges[j]);
 	}
 	FREE(nudges);
 }
@@ -616,6 +833,12 @@ static INLINE void polymorphize(const otfcc_Packet packet, const otfcc_Options *
 			logWarning("Axes number in GVAR and FVAR are inequal");
 			return;
 		};
+		size_t offsetSize = (be16(header->flags) & GVAR_OFFSETS_ARE_LONG) ? 4 : 2;
+		if (be16(header->glyphCount) < glyf->length ||
+		    table.length < sizeof(struct GVARHeader) + offsetSize * (glyf->length + 1)) {
+			logWarning("table 'gvar' corrupted.\n");
+			return;
+		}
 		for (glyphid_t j = 0; j < glyf->length; j++) {
 			TuplePolymorphizerCtx tpctx = {.fvar = ctx->fvar,
 			                               .dimensions = ctx->fvar->axes.length,
@@ -626,13 +849,20 @@ static INLINE void polymorphize(const otfcc_Packet packet, const otfcc_Options *
 			                               .coordDimensions = 2,
 			                               .allowIUP = glyf->items[j]->contours.length > 0};
 			uint32_t glyphVariationDataOffset = 0;
+			uint32_t glyphVariationDataEnd = 0;
 			if (be16(header->flags) & GVAR_OFFSETS_ARE_LONG) {
 				glyphVariationDataOffset =
 				    be32(((uint32_t *)(data + sizeof(struct GVARHeader)))[j]);
+				glyphVariationDataEnd =
+				    be32(((uint32_t *)(data + sizeof(struct GVARHeader)))[j + 1]);
 			} else {
 				glyphVariationDataOffset =
 				    2 * be16(((uint16_t *)(data + sizeof(struct GVARHeader)))[j]);
+				glyphVariationDataEnd =
+				    2 * be16(((uint16_t *)(data + sizeof(struct GVARHeader)))[j + 1]);
 			}
+			// A glyph without variation data has an empty range.
+			if (glyphVariationDataEnd <= glyphVariationDataOffset) continue;
 			struct GlyphVariationData *gvd =
 			    (struct GlyphVariationData *)(data + be32(header->glyphVariationDataArrayOffset) +
 			                                  glyphVariationDataOffset);
@@ -646,6 +876,20 @@ table_glyf *otfcc_readGlyf(const otfcc_Packet packet, const otfcc_Options *optio
 	uint32_t *offsets = NULL;
 	table_glyf *glyf = NULL;
 
+	// A WOFF2 font may carry glyf transformed, and loca empty. Its boxes are mostly computed
+	// from the points, so it is always read whole.
+	FOR_TABLE('glyf', table) {
+		if (table.transformed) {
+			glyf = readWOFF2Glyf(table.data, table.length, options, ctx);
+			if (!glyf) {
+				logWarning("table 'glyf' corrupted.\n");
+				return NULL;
+			}
+			polymorphize(packet, options, glyf, ctx);
+			return glyf;
+		}
+	}
+
 	NEW_CLEAN_N(offsets, (ctx->numGlyphs + 1));
 	if (!offsets) goto ABSENT;
 	bool foundLoca = false;
@@ -681,7 +925,9 @@ table_glyf *otfcc_readGlyf(const otfcc_Packet packet, const otfcc_Options *optio
 		glyf = table_iGlyf.create();
 
 		for (glyphid_t j = 0; j < ctx->numGlyphs; j++) {
-			if (offsets[j] < offsets[j + 1]) { // non-space glyph
+			if (ctx->boxesOnly && offsets[j] + 10 <= offsets[j + 1]) {
+				table_iGlyf.push(glyf, otfcc_read_glyph_box(data, offsets[j]));
+			} else if (offsets[j] < offsets[j + 1]) { // non-space glyph
 				table_iGlyf.push(glyf, otfcc_read_glyph(data, offsets[j], options));
 			} else { // space glyph
 				table_iGlyf.push(glyf, otfcc_newGlyf_glyph());
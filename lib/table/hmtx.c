@@ -9,8 +9,41 @@ static INLINE void disposeHmtx(MOVE table_hmtx *table) {
 
 caryll_standardRefType(table_hmtx, table_iHmtx, disposeHmtx);
 
+// WOFF2 transformed hmtx, version 1, leaves out side bearings which equal the xMin of their
+// glyphs; glyphs without outlines count as 0.
+static INLINE int16_t woff2XMin(const table_glyf *glyf, glyphid_t j) {
+	if (j >= glyf->length) return 0;
+	const glyf_Glyph *g = glyf->items[j];
+	return g->contours.length || g->references.length ? (int16_t)g->stat.xMin : 0;
+}
+static table_hmtx *readWOFF2Hmtx(font_file_pointer data, uint32_t length, glyphid_t count_a,
+                                 glyphid_t count_k, const table_glyf *glyf) {
+	if (length < 1 || !glyf) return NULL;
+	uint8_t flags = data[0];
+	bool hasLsb = !(flags & 1), hasLeftSideBearing = !(flags & 2);
+	if (flags & 0xFC || length < 1 + count_a * 2 + (hasLsb ? count_a * 2 : 0) +
+	                                (hasLeftSideBearing ? count_k * 2 : 0)) {
+		return NULL;
+	}
+	table_hmtx *hmtx;
+	NEW(hmtx);
+	NEW(hmtx->metrics, count_a);
+	NEW(hmtx->leftSideBearing, count_k);
+	font_file_pointer lsbs = data + 1 + count_a * 2;
+	for (glyphid_t ia = 0; ia < count_a; ia++) {
+		hmtx->metrics[ia].advanceWidth = read_16u(data + 1 + ia * 2);
+		hmtx->metrics[ia].lsb = hasLsb ? read_16s(lsbs + ia * 2) : woff2XMin(glyf, ia);
+	}
+	font_file_pointer leftSideBearings = lsbs + (hasLsb ? count_a * 2 : 0);
+	for (glyphid_t ik = 0; ik < count_k; ik++) {
+		hmtx->leftSideBearing[ik] = hasLeftSideBearing ? read_16s(leftSideBearings + ik * 2)
+		                                               : woff2XMin(glyf, count_a + ik);
+	}
+	return hmtx;
+}
+
 table_hmtx *otfcc_readHmtx(const otfcc_Packet packet, const otfcc_Options *options,
-                           table_hhea *hhea, table_maxp *maxp) {
+                           table_hhea *hhea, table_maxp *maxp, const table_glyf *glyf) {
 	if (!hhea || !maxp || !hhea->numberOfMetrics || maxp->numGlyphs < hhea->numberOfMetrics) {
 		return NULL;
 	}
@@ -22,6 +55,11 @@ table_hmtx *otfcc_readHmtx(const otfcc_Packet packet, const otfcc_Options *optio
 
 		glyphid_t count_a = hhea->numberOfMetrics;
 		glyphid_t count_k = maxp->numGlyphs - hhea->numberOfMetrics;
+		if (table.transformed) {
+			hmtx = readWOFF2Hmtx(data, length, count_a, count_k, glyf);
+			if (!hmtx) goto HMTX_CORRUPTED;
+			return hmtx;
+		}
 		if (length < count_a * 4 + count_k * 2) goto HMTX_CORRUPTED;
 
 		NEW(hmtx);
@@ -62,3 +100,38 @@ caryll_Buffer *otfcc_buildHmtx(const table_hmtx *hmtx, glyphid_t count_a, glyphi
 	}
 	return buf;
 }
+
+// WOFF2 transformed hmtx, version 1: side bearings equal to the xMin of their glyphs, as the
+// transformed glyf gives it, are left out. Returns NULL when none of them can be.
+caryll_Buffer *otfcc_buildHmtxWOFF2(const table_hmtx *hmtx, glyphid_t count_a, glyphid_t count_k,
+                                    const table_glyf *glyf, const otfcc_Options *options) {
+	if (!hmtx || !hmtx->metrics || !glyf) return NULL;
+	bool proportional = true, monospaced = true;
+	for (glyphid_t j = 0; j < count_a; j++) {
+		if ((int16_t)hmtx->metrics[j].lsb != woff2XMin(glyf, j)) proportional = false;
+	}
+	for (glyphid_t j = 0; j < count_k; j++) {
+		if (!hmtx->leftSideBearing ||
+		    (int16_t)hmtx->leftSideBearing[j] != woff2XMin(glyf, count_a + j)) {
+			monospaced = false;
+		}
+	}
+	if (!proportional && !monospaced) return NULL;
+
+	caryll_Buffer *buf = bufnew();
+	bufwrite8(buf, (proportional ? 1 : 0) | (monospaced ? 2 : 0));
+	for (glyphid_t j = 0; j < count_a; j++) {
+		bufwrite16b(buf, hmtx->metrics[j].advanceWidth);
+	}
+	if (!proportional) {
+		for (glyphid_t j = 0; j < count_a; j++) {
+			bufwrite16b(buf, hmtx->metrics[j].lsb);
+		}
+	}
+	if (!monospaced) {
+		for (glyphid_t j = 0; j < count_k; j++) {
+			bufwrite16b(buf, hmtx->leftSideBearing[j]);
+		}
+	}
+	return buf;
+}
@@ -2,9 +2,14 @@
 #define CARYLL_TABLE_HMTX_H
 
 #include "otfcc/table/hmtx.h"
+#include "otfcc/table/glyf.h"
 
-table_hmtx *otfcc_readHmtx(const otfcc_Packet packet, const otfcc_Options *options, table_hhea *hhea, table_maxp *maxp);
+// The WOFF2 transform of hmtx takes side bearings from glyf, which has to be read before.
+table_hmtx *otfcc_readHmtx(const otfcc_Packet packet, const otfcc_Options *options,
+                           table_hhea *hhea, table_maxp *maxp, const table_glyf *glyf);
 caryll_Buffer *otfcc_buildHmtx(const table_hmtx *table, glyphid_t count_a, glyphid_t count_k,
                                const otfcc_Options *options);
+caryll_Buffer *otfcc_buildHmtxWOFF2(const table_hmtx *table, glyphid_t count_a, glyphid_t count_k,
+                                    const table_glyf *glyf, const otfcc_Options *options);
 
 #endif
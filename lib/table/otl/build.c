@@ -1,4 +1,5 @@
 #include "private.h"
+#include "support/thread-pool/thread-pool.h"
 
 #define LARGE_SUBTABLE_LIMIT 4096
 
@@ -27,115 +28,257 @@ static uint32_t featureNameToTag(const sds name) {
 	return tag;
 }
 
+// Pointer-to-index maps of lookups and features, built once per table, so that
+// serializing references does not rescan the lookup and feature lists.
+typedef struct {
+	const void *ref;
+	tableid_t index;
+	UT_hash_handle hh;
+} otl_IndexMapEntry;
+typedef otl_IndexMapEntry *otl_IndexMap;
+
+static otl_IndexMap buildIndexMap(const void *const *refs, size_t length) {
+	otl_IndexMap map = NULL;
+	for (tableid_t j = 0; j < length; j++) {
+		const void *ref = refs[j];
+		otl_IndexMapEntry *e = NULL;
+		HASH_FIND_PTR(map, &ref, e);
+		if (e) continue; // the first occurrence wins
+		NEW(e);
+		e->ref = ref;
+		e->index = j;
+		HASH_ADD_PTR(map, ref, e);
+	}
+	return map;
+}
+static tableid_t indexOf(otl_IndexMap map, const void *ref) {
+	otl_IndexMapEntry *e = NULL;
+	if (ref) HASH_FIND_PTR(map, &ref, e);
+	return e ? e->index : 0xFFFF;
+}
+static void deleteIndexMap(otl_IndexMap map) {
+	otl_IndexMapEntry *e, *tmp;
+	HASH_ITER(hh, map, e, tmp) {
+		HASH_DEL(map, e);
+		FREE(e);
+	}
+}
+
 typedef caryll_Buffer *(*_otl_Builder)(const otl_Subtable *_subtable,
                                        otl_BuildHeuristics heuristics);
+typedef tableid_t (*_otl_LookupBuilder)(const otl_Lookup *lookup, otl_BuildHeuristics heuristics,
+                                        OUT caryll_Buffer ***subtables);
+typedef tableid_t (*_otl_SplittingBuilder)(const otl_Subtable *_subtable,
+                                           otl_BuildHeuristics heuristics,
+                                           OUT caryll_Buffer ***pieces);
 
-static tableid_t _declare_lookup_writer(otl_LookupType type, _otl_Builder fn,
-                                        const otl_Lookup *lookup, caryll_Buffer ***subtables,
-                                        size_t *lastOffset, bool *preferExtensionForThisLUT,
-                                        otl_BuildHeuristics heuristics) {
-	if (lookup->type == type) {
-		NEW(*subtables, lookup->subtables.length);
-		size_t totalBufSizeShort = 0;
-		size_t totalBufSizeExt = 0;
-		for (tableid_t j = 0; j < lookup->subtables.length; j++) {
-			caryll_Buffer *buf = fn(lookup->subtables.items[j], heuristics);
-			(*subtables)[j] = buf;
-			totalBufSizeShort += buf->size;
-			totalBufSizeExt += 8;
-		}
-		if (totalBufSizeShort > LARGE_SUBTABLE_LIMIT) {
-			*lastOffset += totalBufSizeExt;
-			*preferExtensionForThisLUT = true;
-		} else {
-			*lastOffset += totalBufSizeShort;
-			*preferExtensionForThisLUT = false;
-		}
-		return lookup->subtables.length;
+static bool isChainingLookup(const otl_Lookup *lookup) {
+	return lookup->type == otl_type_gpos_chaining || lookup->type == otl_type_gsub_chaining;
+}
+static tableid_t buildChainingLookup(const otl_Lookup *lookup, otl_BuildHeuristics heuristics,
+                                     OUT caryll_Buffer ***subtables) {
+	return otfcc_classifiedBuildChaining(lookup, subtables);
+}
+
+static _otl_Builder builderOfLookupType(otl_LookupType type) {
+	switch (type) {
+		case otl_type_gsub_single:
+			return otfcc_build_gsub_single_subtable;
+		case otl_type_gsub_multiple:
+		case otl_type_gsub_alternate:
+			return otfcc_build_gsub_multi_subtable;
+		case otl_type_gsub_ligature:
+			return otfcc_build_gsub_ligature_subtable;
+		case otl_type_gsub_reverse:
+			return otfcc_build_gsub_reverse;
+		case otl_type_gpos_single:
+			return otfcc_build_gpos_single;
+		case otl_type_gpos_cursive:
+			return otfcc_build_gpos_cursive;
+		case otl_type_gpos_markToBase:
+		case otl_type_gpos_markToMark:
+			return otfcc_build_gpos_markToSingle;
+		case otl_type_gpos_markToLigature:
+			return otfcc_build_gpos_markToLigature;
+		default:
+			return NULL;
 	}
-	return 0;
 }
 
-#define LOOKUP_WRITER(type, fn)                                                                    \
-	if (!written)                                                                                  \
-		written = _declare_lookup_writer(type, fn, lookup, subtables, lastOffset,                  \
-		                                 preferExtensionForThisLUT, heuristics);
+// Lookups are built on a worker pool. Chaining lookups form a single job, since their
+// subtables are classified together; every other lookup has one job per subtable. A pair
+// subtable may be split into several pieces, which are gathered once the pool is done.
+// Each job only writes into its own buffer slot, so the pool needs no other locking.
+typedef struct {
+	const otl_Lookup *lookup;
+	otl_BuildHeuristics heuristics;
+	_otl_Builder builder;
+	_otl_LookupBuilder lookupBuilder;
+	_otl_SplittingBuilder splittingBuilder;
+	tableid_t *pieceCounts;
+	caryll_Buffer ***pieces;
+	bool preferExtension;
+	tableid_t subtableCount;
+	caryll_Buffer **subtables;
+} LookupBuildState;
+
+typedef struct {
+	tableid_t lookupIndex;
+	tableid_t subtableIndex;
+} LookupBuildJob;
+
+typedef struct {
+	LookupBuildState *lookups;
+	LookupBuildJob *jobs;
+	const otfcc_Options *options;
+} LookupBuildEnv;
 
-static tableid_t _build_lookup(const otl_Lookup *lookup, caryll_Buffer ***subtables,
-                               size_t *lastOffset, bool *preferExtensionForThisLUT,
-                               otl_BuildHeuristics heuristics) {
-	if (lookup->type == otl_type_gpos_chaining || lookup->type == otl_type_gsub_chaining) {
-		return otfcc_classifiedBuildChaining(lookup, subtables, lastOffset);
+static void runLookupBuildJob(void *_env, size_t index) {
+	LookupBuildEnv *env = (LookupBuildEnv *)_env;
+	const otfcc_Options *options = env->options;
+	const LookupBuildJob *job = &(env->jobs[index]);
+	LookupBuildState *state = &(env->lookups[job->lookupIndex]);
+	if (state->builder) {
+		tracedStep("lookup %s #%d", state->lookup->name, job->subtableIndex) {
+			state->subtables[job->subtableIndex] = state->builder(
+			    state->lookup->subtables.items[job->subtableIndex], state->heuristics);
+		}
+	} else if (state->splittingBuilder) {
+		tracedStep("lookup %s #%d", state->lookup->name, job->subtableIndex) {
+			state->pieceCounts[job->subtableIndex] = state->splittingBuilder(
+			    state->lookup->subtables.items[job->subtableIndex], state->heuristics,
+			    &state->pieces[job->subtableIndex]);
+		}
+	} else {
+		tracedStep("lookup %s", state->lookup->name) {
+			state->subtableCount =
+			    state->lookupBuilder(state->lookup, state->heuristics, &state->subtables);
+		}
 	}
+}
 
-	tableid_t written = 0;
-	LOOKUP_WRITER(otl_type_gsub_single, otfcc_build_gsub_single_subtable);
-	LOOKUP_WRITER(otl_type_gsub_multiple, otfcc_build_gsub_multi_subtable);
-	LOOKUP_WRITER(otl_type_gsub_alternate, otfcc_build_gsub_multi_subtable);
-	LOOKUP_WRITER(otl_type_gsub_ligature, otfcc_build_gsub_ligature_subtable);
-	LOOKUP_WRITER(otl_type_gsub_reverse, otfcc_build_gsub_reverse);
-	LOOKUP_WRITER(otl_type_gpos_single, otfcc_build_gpos_single);
-	LOOKUP_WRITER(otl_type_gpos_pair, otfcc_build_gpos_pair);
-	LOOKUP_WRITER(otl_type_gpos_cursive, otfcc_build_gpos_cursive);
-	LOOKUP_WRITER(otl_type_gpos_markToBase, otfcc_build_gpos_markToSingle);
-	LOOKUP_WRITER(otl_type_gpos_markToMark, otfcc_build_gpos_markToSingle);
-	LOOKUP_WRITER(otl_type_gpos_markToLigature, otfcc_build_gpos_markToLigature);
-	return written;
+// Concatenate the pieces of every subtable, in subtable order.
+static void gatherPieces(LookupBuildState *state) {
+	if (!state->splittingBuilder) return;
+	tableid_t subtableCount = state->lookup->subtables.length;
+	state->subtableCount = 0;
+	for (tableid_t k = 0; k < subtableCount; k++) {
+		state->subtableCount += state->pieceCounts[k];
+	}
+	NEW(state->subtables, state->subtableCount);
+	tableid_t n = 0;
+	for (tableid_t k = 0; k < subtableCount; k++) {
+		for (tableid_t p = 0; p < state->pieceCounts[k]; p++) {
+			state->subtables[n++] = state->pieces[k][p];
+		}
+		FREE(state->pieces[k]);
+	}
+	FREE(state->pieces);
+	FREE(state->pieceCounts);
 }
 
-static otl_BuildHeuristics getLookupHeuristics(const table_OTL *table, const otl_Lookup *lut) {
-	otl_BuildHeuristics heu = OTL_BH_NORMAL;
+static void getLookupHeuristics(const table_OTL *table, otl_IndexMap lookupIndex,
+                                LookupBuildState *states) {
 	// GSUB VERT heuristics
 	// GDI have some restrictions on the internal format of the lookup inisde a VERT feature
-	if (lut->type == otl_type_gsub_single) {
-		for (tableid_t j = 0; j < table->features.length; j++) {
-			const otl_Feature *fea = table->features.items[j];
-			if (featureNameToTag(fea->name) != 'vert') continue;
-			for (tableid_t k = 0; k < fea->lookups.length; k++) {
-				if (fea->lookups.items[k] == lut) heu |= OTL_BH_GSUB_VERT;
-			}
+	for (tableid_t j = 0; j < table->features.length; j++) {
+		const otl_Feature *fea = table->features.items[j];
+		if (featureNameToTag(fea->name) != 'vert') continue;
+		for (tableid_t k = 0; k < fea->lookups.length; k++) {
+			const otl_Lookup *lut = fea->lookups.items[k];
+			if (lut->type != otl_type_gsub_single) continue;
+			tableid_t l = indexOf(lookupIndex, lut);
+			if (l < table->lookups.length) states[l].heuristics |= OTL_BH_GSUB_VERT;
 		}
 	}
-	return heu;
 }
 
 // When writing lookups, otfcc will try to maintain everything correctly.
 // That is, we will use extended layout lookups automatically when the
 // offsets are too large.
-static bk_Block *writeOTLLookups(const table_OTL *table, const otfcc_Options *options,
-                                 const char *tag) {
-	caryll_Buffer ***subtables;
-	NEW(subtables, table->lookups.length);
-	bool *preferExtForThisLut;
-	tableid_t *subtableQuantity;
-	NEW(subtableQuantity, table->lookups.length);
-	NEW(preferExtForThisLut, table->lookups.length);
+static bk_Block *writeOTLLookups(const table_OTL *table, otl_IndexMap lookupIndex,
+                                 const otfcc_Options *options, const char *tag) {
+	LookupBuildState *states;
+	NEW(states, table->lookups.length);
+	getLookupHeuristics(table, lookupIndex, states);
+	LookupBuildJob *jobs = NULL;
+	size_t nJobs = 0;
+	size_t jobsCap = 0;
 
-	size_t lastOffset = 0;
 	for (tableid_t j = 0; j < table->lookups.length; j++) {
 		otl_Lookup *lookup = table->lookups.items[j];
-		otl_BuildHeuristics heu = getLookupHeuristics(table, lookup);
+		LookupBuildState *state = &states[j];
+		state->lookup = lookup;
 		logProgress("Building lookup %s (%u/%u)\n", lookup->name, j,
 		            (uint32_t)table->lookups.length);
-		subtableQuantity[j] =
-		    _build_lookup(lookup, &(subtables[j]), &lastOffset, &(preferExtForThisLut[j]), heu);
+
+		tableid_t jobsForThisLut = 0;
+		if (isChainingLookup(lookup)) {
+			state->lookupBuilder = buildChainingLookup;
+			jobsForThisLut = 1;
+		} else if (lookup->type == otl_type_gpos_pair) {
+			state->splittingBuilder = otfcc_splitBuildGposPair;
+			if (options->split_kerning) state->heuristics |= OTL_BH_GPOS_SPLIT_PAIRS;
+			NEW(state->pieceCounts, lookup->subtables.length);
+			NEW(state->pieces, lookup->subtables.length);
+			jobsForThisLut = lookup->subtables.length;
+		} else if ((state->builder = builderOfLookupType(lookup->type))) {
+			state->subtableCount = lookup->subtables.length;
+			NEW(state->subtables, state->subtableCount);
+			jobsForThisLut = state->subtableCount;
+		}
+		if (nJobs + jobsForThisLut > jobsCap) {
+			while (nJobs + jobsForThisLut > jobsCap) {
+				jobsCap += jobsCap / 2 + 0x10;
+			}
+			RESIZE(jobs, jobsCap);
+		}
+		for (tableid_t k = 0; k < jobsForThisLut; k++) {
+			jobs[nJobs].lookupIndex = j;
+			jobs[nJobs].subtableIndex = k;
+			nJobs++;
+		}
+	}
+
+	LookupBuildEnv env = {.lookups = states, .jobs = jobs, .options = options};
+	otfcc_parallelFor(nJobs, options->threads, otfcc_currentAllocator(), runLookupBuildJob, &env);
+	FREE(jobs);
+	for (tableid_t j = 0; j < table->lookups.length; j++) {
+		gatherPieces(&states[j]);
+	}
+
+	// All subtable buffers are ready; decide the extension layout.
+	size_t lastOffset = 0;
+	for (tableid_t j = 0; j < table->lookups.length; j++) {
+		LookupBuildState *state = &states[j];
+		size_t totalBufSizeShort = 0;
+		for (tableid_t k = 0; k < state->subtableCount; k++) {
+			totalBufSizeShort += state->subtables[k]->size;
+		}
+		if (!isChainingLookup(state->lookup) && totalBufSizeShort > LARGE_SUBTABLE_LIMIT) {
+			lastOffset += 8 * state->subtableCount;
+			state->preferExtension = true;
+		} else {
+			lastOffset += totalBufSizeShort;
+		}
 	}
 
 	size_t headerSize = 2 + 2 * table->lookups.length;
 	for (tableid_t j = 0; j < table->lookups.length; j++) {
-		if (subtableQuantity[j]) { headerSize += 6 + 2 * subtableQuantity[j]; }
+		if (states[j].subtableCount) { headerSize += 6 + 2 * states[j].subtableCount; }
 	}
 	bool useExtended = lastOffset >= 0xFF00 - headerSize;
 
 	bk_Block *root = bk_new_Block(b16, table->lookups.length, // LookupCount
 	                              bkover);
 	for (tableid_t j = 0; j < table->lookups.length; j++) {
-		if (!subtableQuantity[j]) {
+		LookupBuildState *state = &states[j];
+		if (!state->subtableCount) {
 			logNotice("Lookup %s is empty.\n", table->lookups.items[j]->name);
 		}
 		otl_Lookup *lookup = table->lookups.items[j];
 		const bool canBeContextual = otfcc_chainingLookupIsContextualLookup(lookup);
-		const bool useExtendedForIt = useExtended || preferExtForThisLut[j];
+		const bool useExtendedForIt = useExtended || state->preferExtension;
 		if (useExtendedForIt) {
 			logNotice("[OTFCC-fea] Using extended OpenType table layout for %s/%s.\n", tag,
 			          lookup->name);
@@ -153,12 +296,12 @@ static bk_Block *writeOTLLookups(const table_OTL *table, const otfcc_Options *op
 		                                                      : 0) -
 		              (canBeContextual ? 1 : 0);
 
-		bk_Block *blk = bk_new_Block(b16, lookupType,          // LookupType
-		                             b16, lookup->flags,       // LookupFlag
-		                             b16, subtableQuantity[j], // SubTableCount
+		bk_Block *blk = bk_new_Block(b16, lookupType,            // LookupType
+		                             b16, lookup->flags,         // LookupFlag
+		                             b16, state->subtableCount, // SubTableCount
 		                             bkover);
 
-		for (tableid_t k = 0; k < subtableQuantity[j]; k++) {
+		for (tableid_t k = 0; k < state->subtableCount; k++) {
 			if (useExtendedForIt) {
 				uint16_t extensionLookupType = (lookup->type > otl_type_gpos_unknown
 				                                    ? lookup->type - otl_type_gpos_unknown
@@ -167,41 +310,35 @@ static bk_Block *writeOTLLookups(const table_OTL *table, const otfcc_Options *op
 				                                          : 0) -
 				                               (canBeContextual ? 1 : 0);
 
-				bk_Block *stub =
-				    bk_new_Block(b16, 1,                                      // format
-				                 b16, extensionLookupType,                    // ExtensionLookupType
-				                 p32, bk_newBlockFromBuffer(subtables[j][k]), // ExtensionOffset
-				                 bkover);
+				bk_Block *stub = bk_new_Block(
+				    b16, 1,                                          // format
+				    b16, extensionLookupType,                        // ExtensionLookupType
+				    p32, bk_newBlockFromBuffer(state->subtables[k]), // ExtensionOffset
+				    bkover);
 				bk_push(blk, p16, stub, bkover);
 			} else {
-				bk_push(blk, p16, bk_newBlockFromBuffer(subtables[j][k]), bkover);
+				bk_push(blk, p16, bk_newBlockFromBuffer(state->subtables[k]), bkover);
 			}
 		}
 		bk_push(blk, b16, 0, // MarkFilteringSet
 		        bkover);
 		bk_push(root, p16, blk, bkover);
-		FREE(subtables[j]);
+		FREE(state->subtables);
 	}
-	FREE(subtables);
-	FREE(subtableQuantity);
-	FREE(preferExtForThisLut);
+	FREE(states);
 	return root;
 }
 
-static bk_Block *writeOTLFeatures(const table_OTL *table, const otfcc_Options *options) {
+static bk_Block *writeOTLFeatures(const table_OTL *table, otl_IndexMap lookupIndex,
+                                  const otfcc_Options *options) {
 	bk_Block *root = bk_new_Block(b16, table->features.length, bkover);
 	for (tableid_t j = 0; j < table->features.length; j++) {
 		bk_Block *fea = bk_new_Block(p16, NULL,                                     // FeatureParams
 		                             b16, table->features.items[j]->lookups.length, // LookupCount
 		                             bkover);
 		for (tableid_t k = 0; k < table->features.items[j]->lookups.length; k++) {
-			// reverse lookup
-			for (tableid_t l = 0; l < table->lookups.length; l++) {
-				if (table->features.items[j]->lookups.items[k] == table->lookups.items[l]) {
-					bk_push(fea, b16, l, bkover);
-					break;
-				}
-			}
+			tableid_t l = indexOf(lookupIndex, table->features.items[j]->lookups.items[k]);
+			if (l < table->lookups.length) bk_push(fea, b16, l, bkover);
 		}
 		bk_push(root, b32, featureNameToTag(table->features.items[j]->name), // FeatureTag
 		        p16, fea,                                                    // Feature
@@ -219,40 +356,36 @@ typedef struct {
 	UT_hash_handle hh;
 } script_stat_hash;
 
-static tableid_t featureIndex(const otl_Feature *feature, const table_OTL *table) {
-	for (tableid_t j = 0; j < table->features.length; j++)
-		if (table->features.items[j] == feature) { return j; }
-	return 0xFFFF;
-}
-static bk_Block *writeLanguage(otl_LanguageSystem *lang, const table_OTL *table) {
+static bk_Block *writeLanguage(otl_LanguageSystem *lang, otl_IndexMap featureIndex) {
 	if (!lang) return NULL;
 	bk_Block *root =
-	    bk_new_Block(p16, NULL,                                       // LookupOrder
-	                 b16, featureIndex(lang->requiredFeature, table), // ReqFeatureIndex
-	                 b16, lang->features.length,                      // FeatureCount
+	    bk_new_Block(p16, NULL,                                         // LookupOrder
+	                 b16, indexOf(featureIndex, lang->requiredFeature), // ReqFeatureIndex
+	                 b16, lang->features.length,                        // FeatureCount
 	                 bkover);
 	for (tableid_t k = 0; k < lang->features.length; k++) {
-		bk_push(root, b16, featureIndex(lang->features.items[k], table), bkover);
+		bk_push(root, b16, indexOf(featureIndex, lang->features.items[k]), bkover);
 	}
 	return root;
 }
 
-static bk_Block *writeScript(script_stat_hash *script, const table_OTL *table) {
-	bk_Block *root = bk_new_Block(p16, writeLanguage(script->dl, table), // DefaultLangSys
-	                              b16, script->lc,                       // LangSysCount
+static bk_Block *writeScript(script_stat_hash *script, otl_IndexMap featureIndex) {
+	bk_Block *root = bk_new_Block(p16, writeLanguage(script->dl, featureIndex), // DefaultLangSys
+	                              b16, script->lc,                              // LangSysCount
 	                              bkover);
 
 	for (tableid_t j = 0; j < script->lc; j++) {
 		sds tag = sdsnewlen(script->ll[j]->name + 5, 4);
 
-		bk_push(root, b32, featureNameToTag(tag),         // LangSysTag
-		        p16, writeLanguage(script->ll[j], table), // LangSys
+		bk_push(root, b32, featureNameToTag(tag),                // LangSysTag
+		        p16, writeLanguage(script->ll[j], featureIndex), // LangSys
 		        bkover);
 		sdsfree(tag);
 	}
 	return root;
 }
-static bk_Block *writeOTLScriptAndLanguages(const table_OTL *table, const otfcc_Options *options) {
+static bk_Block *writeOTLScriptAndLanguages(const table_OTL *table, otl_IndexMap featureIndex,
+                                            const otfcc_Options *options) {
 	script_stat_hash *h = NULL;
 	for (tableid_t j = 0; j < table->languages.length; j++) {
 		otl_LanguageSystem *language = table->languages.items[j];
@@ -291,7 +424,7 @@ static bk_Block *writeOTLScriptAndLanguages(const table_OTL *table, const otfcc_
 	script_stat_hash *s, *tmp;
 	HASH_ITER(hh, h, s, tmp) {
 		bk_push(root, b32, featureNameToTag(s->tag), // ScriptTag
-		        p16, writeScript(s, table),          // Script
+		        p16, writeScript(s, featureIndex),   // Script
 		        bkover);
 		HASH_DEL(h, s);
 		sdsfree(s->tag);
@@ -306,15 +439,23 @@ caryll_Buffer *otfcc_buildOtl(const table_OTL *table, const otfcc_Options *optio
 	if (!table) return NULL;
 	caryll_Buffer *buf;
 	loggedStep("%s", tag) {
-		bk_Block *lookups = writeOTLLookups(table, options, tag);
-		bk_Block *features = writeOTLFeatures(table, options);
-		bk_Block *languages = writeOTLScriptAndLanguages(table, options);
+		otl_IndexMap lookupIndex =
+		    buildIndexMap((const void *const *)table->lookups.items, table->lookups.length);
+		otl_IndexMap featureIndex =
+		    buildIndexMap((const void *const *)table->features.items, table->features.length);
+		bk_Block *lookups = writeOTLLookups(table, lookupIndex, options, tag);
+		bk_Block *features = writeOTLFeatures(table, lookupIndex, options);
+		bk_Block *languages = writeOTLScriptAndLanguages(table, featureIndex, options);
+		deleteIndexMap(lookupIndex);
+		deleteIndexMap(featureIndex);
 		bk_Block *root = bk_new_Block(b32, 0x10000,   // Version
 		                              p16, languages, // ScriptList
 		                              p16, features,  // FeatureList
 		                              p16, lookups,   // LookupList
 		                              bkover);
-		buf = bk_build_Block(root);
+		bool packed;
+		buf = bk_build_Block_checked(root, &packed);
+		if (!packed) logWarning("[OTFCC-fea] Unable to fit all offsets of %s.\n", tag);
 	}
 	return buf;
 }
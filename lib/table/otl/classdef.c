@@ -1,5 +1,6 @@
 #include "support/util.h"
 #include "otfcc/table/otl/classdef.h"
+#include "support/glyph-set/glyph-set.h"
 
 static INLINE void disposeClassDef(otl_ClassDef *cd) {
 	if (cd->glyphs) {
@@ -31,13 +32,15 @@ static void pushClassDef(otl_ClassDef *cd, MOVE otfcc_GlyphHandle h, glyphclass_
 }
 
 typedef struct {
-	int gid;
-	int covIndex;
-	UT_hash_handle hh;
-} coverage_entry;
+	glyphid_t gid;
+	glyphclass_t cls;
+	uint32_t order;
+} classdef_entry;
 
-static int by_covIndex(coverage_entry *a, coverage_entry *b) {
-	return a->covIndex - b->covIndex;
+static int by_cls(const void *_a, const void *_b) {
+	const classdef_entry *a = _a, *b = _b;
+	if (a->cls != b->cls) return a->cls < b->cls ? -1 : 1;
+	return a->order < b->order ? -1 : a->order > b->order ? 1 : 0;
 }
 
 static otl_ClassDef *readClassDef(const uint8_t *data, uint32_t tableLength, uint32_t offset) {
@@ -54,33 +57,35 @@ static otl_ClassDef *readClassDef(const uint8_t *data, uint32_t tableLength, uin
 			return cd;
 		}
 	} else if (format == 2) {
-		// The ranges may overlap.
-		// Use hashtable.
+		// The ranges may overlap; the first range covering a glyph wins.
 		uint16_t rangeCount = read_16u(data + offset + 2);
 		if (tableLength < offset + 4 + rangeCount * 6) return cd;
-		coverage_entry *hash = NULL;
+		otfcc_GlyphSet *seen = otfcc_newGlyphSet();
+		classdef_entry *entries = NULL;
+		uint32_t n = 0;
+		uint32_t capacity = 0;
 		for (uint16_t j = 0; j < rangeCount; j++) {
 			uint16_t start = read_16u(data + offset + 4 + 6 * j);
 			uint16_t end = read_16u(data + offset + 4 + 6 * j + 2);
 			uint16_t cls = read_16u(data + offset + 4 + 6 * j + 4);
-			for (int k = start; k <= end; k++) {
-				coverage_entry *item = NULL;
-				HASH_FIND_INT(hash, &k, item);
-				if (!item) {
-					NEW(item);
-					item->gid = k;
-					item->covIndex = cls;
-					HASH_ADD_INT(hash, gid, item);
+			for (uint32_t k = start; k <= end; k++) {
+				if (!otfcc_glyphsetAdd(seen, k)) continue;
+				if (n >= capacity) {
+					capacity = capacity ? capacity * 2 : 0x10;
+					RESIZE(entries, capacity);
 				}
+				entries[n].gid = k;
+				entries[n].cls = cls;
+				entries[n].order = n;
+				n++;
 			}
 		}
-		HASH_SORT(hash, by_covIndex);
-		coverage_entry *e, *tmp;
-		HASH_ITER(hh, hash, e, tmp) {
-			pushClassDef(cd, Handle.fromIndex(e->gid), e->covIndex);
-			HASH_DEL(hash, e);
-			FREE(e);
+		if (n) qsort(entries, n, sizeof(classdef_entry), by_cls);
+		for (uint32_t j = 0; j < n; j++) {
+			pushClassDef(cd, Handle.fromIndex(entries[j].gid), entries[j].cls);
 		}
+		FREE(entries);
+		otfcc_deleteGlyphSet(seen);
 		return cd;
 	}
 	return cd;
@@ -88,36 +93,16 @@ static otl_ClassDef *readClassDef(const uint8_t *data, uint32_t tableLength, uin
 
 static otl_ClassDef *expandClassDef(otl_Coverage *cov, otl_ClassDef *ocd) {
 	otl_ClassDef *cd = otl_iClassDef.create();
-	coverage_entry *hash = NULL;
+	otfcc_GlyphSet *seen = otfcc_newGlyphSet();
 	for (glyphid_t j = 0; j < ocd->numGlyphs; j++) {
-		int gid = ocd->glyphs[j].index;
-		int cid = ocd->classes[j];
-		coverage_entry *item = NULL;
-		HASH_FIND_INT(hash, &gid, item);
-		if (!item) {
-			NEW(item);
-			item->gid = gid;
-			item->covIndex = cid;
-			HASH_ADD_INT(hash, gid, item);
-		}
+		glyphid_t gid = ocd->glyphs[j].index;
+		if (otfcc_glyphsetAdd(seen, gid)) pushClassDef(cd, Handle.fromIndex(gid), ocd->classes[j]);
 	}
 	for (glyphid_t j = 0; j < cov->numGlyphs; j++) {
-		int gid = cov->glyphs[j].index;
-		coverage_entry *item = NULL;
-		HASH_FIND_INT(hash, &gid, item);
-		if (!item) {
-			NEW(item);
-			item->gid = gid;
-			item->covIndex = 0;
-			HASH_ADD_INT(hash, gid, item);
-		}
-	}
-	coverage_entry *e, *tmp;
-	HASH_ITER(hh, hash, e, tmp) {
-		pushClassDef(cd, Handle.fromIndex(e->gid), e->covIndex);
-		HASH_DEL(hash, e);
-		FREE(e);
+		glyphid_t gid = cov->glyphs[j].index;
+		if (otfcc_glyphsetAdd(seen, gid)) pushClassDef(cd, Handle.fromIndex(gid), 0);
 	}
+	otfcc_deleteGlyphSet(seen);
 	otl_iClassDef.free(ocd);
 	return cd;
 }
@@ -147,14 +132,6 @@ static otl_ClassDef *parseClassDef(const json_value *_cd) {
 	return cd;
 }
 
-typedef struct {
-	glyphid_t gid;
-	glyphclass_t cid;
-} classdef_sortrecord;
-
-static int by_gid(const void *a, const void *b) {
-	return ((classdef_sortrecord *)a)->gid - ((classdef_sortrecord *)b)->gid;
-}
 static caryll_Buffer *buildClassDef(const otl_ClassDef *cd) {
 	caryll_Buffer *buf = bufnew();
 	bufwrite16b(buf, 2);
@@ -163,51 +140,34 @@ static caryll_Buffer *buildClassDef(const otl_ClassDef *cd) {
 		return buf;
 	}
 
-	classdef_sortrecord *r;
-	NEW(r, cd->numGlyphs);
-	glyphid_t jj = 0;
+	// Class 0 is implicit. For repeated glyphs the first class wins.
+	otfcc_GlyphClassMap *map = otfcc_newGlyphClassMap();
 	for (glyphid_t j = 0; j < cd->numGlyphs; j++) {
-		if (cd->classes[j]) {
-			r[jj].gid = cd->glyphs[j].index;
-			r[jj].cid = cd->classes[j];
-			jj++;
-		}
-	}
-	if (!jj) { // The classdef has only class 0
-		FREE(r);
-		bufwrite16b(buf, 0);
-		return buf;
+		if (cd->classes[j]) otfcc_classmapAdd(map, cd->glyphs[j].index, cd->classes[j]);
 	}
-	qsort(r, jj, sizeof(classdef_sortrecord), by_gid);
 
-	glyphid_t startGID = r[0].gid;
-	glyphid_t endGID = startGID;
-	glyphclass_t lastClass = r[0].cid;
 	glyphid_t nRanges = 0;
-	glyphid_t lastGID = startGID;
 	caryll_Buffer *ranges = bufnew();
-	for (glyphid_t j = 1; j < jj; j++) {
-		glyphid_t current = r[j].gid;
-		if (current <= lastGID) continue;
-		if (current == endGID + 1 && r[j].cid == lastClass) {
-			endGID = current;
-		} else {
-			bufwrite16b(ranges, startGID);
-			bufwrite16b(ranges, endGID);
-			bufwrite16b(ranges, lastClass);
+	glyphid_t start, end;
+	for (uint32_t from = 0; otfcc_glyphsetNextRange(&map->present, from, &start, &end);
+	     from = end + 1) {
+		// split the run of present glyphs where the class changes
+		uint32_t runStart = start;
+		glyphclass_t runClass = otfcc_classmapGet(map, start);
+		for (uint32_t gid = start + 1; gid <= end + 1; gid++) {
+			glyphclass_t cls = gid <= end ? otfcc_classmapGet(map, gid) : 0;
+			if (gid <= end && cls == runClass) continue;
+			bufwrite16b(ranges, runStart);
+			bufwrite16b(ranges, gid - 1);
+			bufwrite16b(ranges, runClass);
 			nRanges += 1;
-			startGID = endGID = current;
-			lastClass = r[j].cid;
+			runStart = gid;
+			runClass = cls;
 		}
-		lastGID = current;
 	}
-	bufwrite16b(ranges, startGID);
-	bufwrite16b(ranges, endGID);
-	bufwrite16b(ranges, lastClass);
-	nRanges += 1;
+	otfcc_deleteGlyphClassMap(map);
 	bufwrite16b(buf, nRanges);
 	bufwrite_bufdel(buf, ranges);
-	FREE(r);
 	return buf;
 }
 
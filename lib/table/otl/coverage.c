@@ -1,5 +1,6 @@
 #include "support/util.h"
 #include "otfcc/table/otl/coverage.h"
+#include "support/glyph-set/glyph-set.h"
 
 static INLINE void disposeCoverage(MOVE otl_Coverage *coverage) {
 	for (glyphid_t j = 0; j < coverage->numGlyphs; j++) {
@@ -27,22 +28,24 @@ static void clearCoverage(otl_Coverage *coverage, uint32_t n) {
 	coverage->numGlyphs = n;
 }
 
-typedef struct {
-	int gid;
-	int covIndex;
-	UT_hash_handle hh;
-} coverage_entry;
-
-static int by_covIndex(coverage_entry *a, coverage_entry *b) {
-	return a->covIndex - b->covIndex;
-}
-
 static void pushToCoverage(otl_Coverage *coverage, MOVE otfcc_GlyphHandle h) {
 	coverage->numGlyphs += 1;
 	growCoverage(coverage, coverage->numGlyphs);
 	coverage->glyphs[coverage->numGlyphs - 1] = h;
 }
 
+typedef struct {
+	glyphid_t gid;
+	uint32_t covIndex;
+	uint32_t order;
+} coverage_entry;
+
+static int by_covIndex(const void *_a, const void *_b) {
+	const coverage_entry *a = _a, *b = _b;
+	if (a->covIndex != b->covIndex) return a->covIndex < b->covIndex ? -1 : 1;
+	return a->order < b->order ? -1 : a->order > b->order ? 1 : 0;
+}
+
 static otl_Coverage *readCoverage(const uint8_t *data, uint32_t tableLength, uint32_t offset) {
 	otl_Coverage *coverage = otl_iCoverage.create();
 	if (tableLength < offset + 4) return coverage;
@@ -51,53 +54,44 @@ static otl_Coverage *readCoverage(const uint8_t *data, uint32_t tableLength, uin
 		case 1: {
 			uint16_t glyphCount = read_16u(data + offset + 2);
 			if (tableLength < offset + 4 + glyphCount * 2) return coverage;
-			coverage_entry *hash = NULL;
+			otfcc_GlyphSet *seen = otfcc_newGlyphSet();
 			for (uint16_t j = 0; j < glyphCount; j++) {
-				coverage_entry *item = NULL;
-				int gid = read_16u(data + offset + 4 + j * 2);
-				HASH_FIND_INT(hash, &gid, item);
-				if (!item) {
-					NEW(item);
-					item->gid = gid;
-					item->covIndex = j;
-					HASH_ADD_INT(hash, gid, item);
-				}
-			}
-			HASH_SORT(hash, by_covIndex);
-			coverage_entry *e, *tmp;
-			HASH_ITER(hh, hash, e, tmp) {
-				pushToCoverage(coverage, Handle.fromIndex(e->gid));
-				HASH_DEL(hash, e);
-				FREE(e);
+				glyphid_t gid = read_16u(data + offset + 4 + j * 2);
+				if (otfcc_glyphsetAdd(seen, gid)) pushToCoverage(coverage, Handle.fromIndex(gid));
 			}
+			otfcc_deleteGlyphSet(seen);
 			break;
 		}
 		case 2: {
 			uint16_t rangeCount = read_16u(data + offset + 2);
 			if (tableLength < offset + 4 + rangeCount * 6) return coverage;
-			coverage_entry *hash = NULL;
+			// The ranges may overlap; the first range covering a glyph wins.
+			otfcc_GlyphSet *seen = otfcc_newGlyphSet();
+			coverage_entry *entries = NULL;
+			uint32_t n = 0;
+			uint32_t capacity = 0;
 			for (uint16_t j = 0; j < rangeCount; j++) {
 				uint16_t start = read_16u(data + offset + 4 + 6 * j);
 				uint16_t end = read_16u(data + offset + 4 + 6 * j + 2);
 				uint16_t startCoverageIndex = read_16u(data + offset + 4 + 6 * j + 4);
-				for (int k = start; k <= end; k++) {
-					coverage_entry *item = NULL;
-					HASH_FIND_INT(hash, &k, item);
-					if (!item) {
-						NEW(item);
-						item->gid = k;
-						item->covIndex = startCoverageIndex + k;
-						HASH_ADD_INT(hash, gid, item);
+				for (uint32_t k = start; k <= end; k++) {
+					if (!otfcc_glyphsetAdd(seen, k)) continue;
+					if (n >= capacity) {
+						capacity = capacity ? capacity * 2 : 0x10;
+						RESIZE(entries, capacity);
 					}
+					entries[n].gid = k;
+					entries[n].covIndex = startCoverageIndex + k;
+					entries[n].order = n;
+					n++;
 				}
 			}
-			HASH_SORT(hash, by_covIndex);
-			coverage_entry *e, *tmp;
-			HASH_ITER(hh, hash, e, tmp) {
-				pushToCoverage(coverage, Handle.fromIndex(e->gid));
-				HASH_DEL(hash, e);
-				FREE(e);
+			if (n) qsort(entries, n, sizeof(coverage_entry), by_covIndex);
+			for (uint32_t j = 0; j < n; j++) {
+				pushToCoverage(coverage, Handle.fromIndex(entries[j].gid));
 			}
+			FREE(entries);
+			otfcc_deleteGlyphSet(seen);
 			break;
 		}
 		default:
@@ -128,82 +122,62 @@ static otl_Coverage *parseCoverage(const json_value *cov) {
 	return c;
 }
 
-static int by_gid(const void *a, const void *b) {
-	return *((glyphid_t *)a) - *((glyphid_t *)b);
-}
-
 static caryll_Buffer *buildCoverageFormat(const otl_Coverage *coverage, uint16_t format) {
-	// sort the gids in coverage
 	if (!coverage->numGlyphs) {
 		caryll_Buffer *buf = bufnew();
 		bufwrite16b(buf, 2);
 		bufwrite16b(buf, 0);
 		return buf;
 	}
-	glyphid_t *r;
-	NEW(r, coverage->numGlyphs);
-	glyphid_t jj = 0;
+	// collect the gids into a bitmap: this sorts and dedupes them at once
+	otfcc_GlyphSet *set = otfcc_newGlyphSet();
 	for (glyphid_t j = 0; j < coverage->numGlyphs; j++) {
-		r[jj] = coverage->glyphs[j].index;
-		jj++;
+		otfcc_glyphsetAdd(set, coverage->glyphs[j].index);
 	}
-	qsort(r, jj, sizeof(glyphid_t), by_gid);
+	glyphid_t jj = otfcc_glyphsetCount(set);
 
 	caryll_Buffer *format1 = bufnew();
 	bufwrite16b(format1, 1);
 	bufwrite16b(format1, jj);
-	for (glyphid_t j = 0; j < jj; j++) {
-		bufwrite16b(format1, r[j]);
+	glyphid_t gid;
+	for (uint32_t from = 0; otfcc_glyphsetNext(set, from, &gid); from = gid + 1) {
+		bufwrite16b(format1, gid);
 	}
 	if (jj < 2) {
-		FREE(r);
+		otfcc_deleteGlyphSet(set);
 		return format1;
 	}
 
 	caryll_Buffer *format2 = bufnew();
 	bufwrite16b(format2, 2);
 	caryll_Buffer *ranges = bufnew();
-	glyphid_t startGID = r[0];
-	glyphid_t endGID = startGID;
-	glyphid_t lastGID = startGID;
 	glyphid_t nRanges = 0;
-	for (glyphid_t j = 1; j < jj; j++) {
-		glyphid_t current = r[j];
-		if (current <= lastGID) continue;
-		if (current == endGID + 1) {
-			endGID = current;
-		} else {
-			bufwrite16b(ranges, startGID);
-			bufwrite16b(ranges, endGID);
-			bufwrite16b(ranges, j + startGID - endGID - 1);
-			nRanges += 1;
-			startGID = endGID = current;
-		}
-		lastGID = current;
+	glyphid_t covIndex = 0;
+	glyphid_t startGID, endGID;
+	for (uint32_t from = 0; otfcc_glyphsetNextRange(set, from, &startGID, &endGID);
+	     from = endGID + 1) {
+		bufwrite16b(ranges, startGID);
+		bufwrite16b(ranges, endGID);
+		bufwrite16b(ranges, covIndex);
+		covIndex += endGID - startGID + 1;
+		nRanges += 1;
 	}
-	bufwrite16b(ranges, startGID);
-	bufwrite16b(ranges, endGID);
-	bufwrite16b(ranges, jj + startGID - endGID - 1);
-	nRanges += 1;
 	bufwrite16b(format2, nRanges);
 	bufwrite_bufdel(format2, ranges);
+	otfcc_deleteGlyphSet(set);
 
 	if (format == 1) {
 		buffree(format2);
-		FREE(r);
 		return format1;
 	} else if (format == 2) {
 		buffree(format1);
-		FREE(r);
 		return format2;
 	} else {
 		if (buflen(format1) < buflen(format2)) {
 			buffree(format2);
-			FREE(r);
 			return format1;
 		} else {
 			buffree(format1);
-			FREE(r);
 			return format2;
 		}
 	}
@@ -219,9 +193,12 @@ static int byHandleGID(const void *a, const void *b) {
 
 static void shrinkCoverage(otl_Coverage *coverage, bool dosort) {
 	if (!coverage) return;
+	otfcc_GlyphSet *seen = dosort ? otfcc_newGlyphSet() : NULL;
 	glyphid_t k = 0;
 	for (glyphid_t j = 0; j < coverage->numGlyphs; j++) {
-		if (coverage->glyphs[j].name) {
+		bool keep = coverage->glyphs[j].name &&
+		            (!seen || otfcc_glyphsetAdd(seen, coverage->glyphs[j].index));
+		if (keep) {
 			coverage->glyphs[k++] = coverage->glyphs[j];
 		} else {
 			Handle.dispose(&coverage->glyphs[j]);
@@ -229,16 +206,7 @@ static void shrinkCoverage(otl_Coverage *coverage, bool dosort) {
 	}
 	if (dosort) {
 		qsort(coverage->glyphs, k, sizeof(glyph_handle), byHandleGID);
-		glyphid_t skip = 0;
-		for (glyphid_t rear = 1; rear < k; rear++) {
-			if (coverage->glyphs[rear].index == coverage->glyphs[rear - skip - 1].index) {
-				Handle.dispose(&coverage->glyphs[rear]);
-				skip += 1;
-			} else {
-				coverage->glyphs[rear - skip] = coverage->glyphs[rear];
-			}
-		}
-		k -= skip;
+		otfcc_deleteGlyphSet(seen);
 	}
 	coverage->numGlyphs = k;
 }
@@ -152,7 +152,7 @@ static void feature_merger_activate(json_value *d, const bool sametag, const cha
 			json_value *jthat = d->u.object.values[k].value;
 			char *kthat = d->u.object.values[k].name;
 			if (json_ident(jthis, jthat) && (sametag ? strncmp(kthis, kthat, 4) == 0 : true)) {
-				json_value_free(jthat);
+				json_value_free_subtree(jthat);
 				json_value *v = json_string_new_length(nkthis, kthis);
 				v->parent = d;
 				d->u.object.values[k].value = v;
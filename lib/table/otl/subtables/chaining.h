@@ -20,8 +20,7 @@ caryll_Buffer *otfcc_build_chaining(const otl_Subtable *_subtable);
 caryll_Buffer *otfcc_build_contextual(const otl_Subtable *_subtable);
 
 tableid_t otfcc_classifiedBuildChaining(const otl_Lookup *lookup,
-                                        OUT caryll_Buffer ***subtableBuffers,
-                                        MODIFY size_t *lastOffset);
+                                        OUT caryll_Buffer ***subtableBuffers);
 
 bool otfcc_chainingLookupIsContextualLookup(const otl_Lookup *lookup);
 
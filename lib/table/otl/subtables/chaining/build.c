@@ -60,6 +60,45 @@ caryll_Buffer *otfcc_build_chaining_coverage(const otl_Subtable *_subtable) {
 	return bk_build_Block(root);
 }
 
+// Rules of a classified subtable, bucketed by the class of their first input glyph.
+// Rules of class c are rules[ruleIndex[classStart[c]] .. ruleIndex[classStart[c + 1] - 1]],
+// in their original order.
+typedef struct {
+	tableid_t *classStart;
+	tableid_t *ruleIndex;
+} RuleBuckets;
+
+static RuleBuckets bucketRulesByStartClass(const subtable_chaining *subtable) {
+	RuleBuckets b;
+	glyphclass_t nClasses = subtable->ic->maxclass + 1;
+	NEW(b.classStart, nClasses + 1);
+	NEW(b.ruleIndex, subtable->rulesCount);
+	for (tableid_t j = 0; j < subtable->rulesCount; j++) {
+		const otl_ChainingRule *rule = subtable->rules[j];
+		glyphclass_t startClass = rule->match[rule->inputBegins]->glyphs[0].index;
+		if (startClass < nClasses) b.classStart[startClass + 1] += 1;
+	}
+	for (glyphclass_t j = 0; j < nClasses; j++) {
+		b.classStart[j + 1] += b.classStart[j];
+	}
+	tableid_t *fill;
+	NEW(fill, nClasses);
+	for (tableid_t j = 0; j < subtable->rulesCount; j++) {
+		const otl_ChainingRule *rule = subtable->rules[j];
+		glyphclass_t startClass = rule->match[rule->inputBegins]->glyphs[0].index;
+		if (startClass < nClasses) {
+			b.ruleIndex[b.classStart[startClass] + fill[startClass]] = j;
+			fill[startClass] += 1;
+		}
+	}
+	FREE(fill);
+	return b;
+}
+static void disposeRuleBuckets(RuleBuckets *b) {
+	FREE(b->classStart);
+	FREE(b->ruleIndex);
+}
+
 caryll_Buffer *otfcc_build_chaining_classes(const otl_Subtable *_subtable) {
 	const subtable_chaining *subtable = &(_subtable->chaining);
 
@@ -77,25 +116,14 @@ caryll_Buffer *otfcc_build_chaining_classes(const otl_Subtable *_subtable) {
 	                 b16, subtable->ic->maxclass + 1, // ChainSubClassSetCnt
 	                 bkover);
 
-	glyphclass_t *rcpg;
-	NEW(rcpg, subtable->ic->maxclass + 1);
-	for (glyphclass_t j = 0; j <= subtable->ic->maxclass; j++) {
-		rcpg[j] = 0;
-	}
-	for (tableid_t j = 0; j < subtable->rulesCount; j++) {
-		tableid_t ib = subtable->rules[j]->inputBegins;
-		tableid_t startClass = subtable->rules[j]->match[ib]->glyphs[0].index;
-		if (startClass <= subtable->ic->maxclass) rcpg[startClass] += 1;
-	}
-
+	RuleBuckets buckets = bucketRulesByStartClass(subtable);
 	for (glyphclass_t j = 0; j <= subtable->ic->maxclass; j++) {
-		if (rcpg[j]) {
-			bk_Block *cset = bk_new_Block(b16, rcpg[j], // ChainSubClassRuleCnt
+		tableid_t rulesOfClass = buckets.classStart[j + 1] - buckets.classStart[j];
+		if (rulesOfClass) {
+			bk_Block *cset = bk_new_Block(b16, rulesOfClass, // ChainSubClassRuleCnt
 			                              bkover);
-			for (tableid_t k = 0; k < subtable->rulesCount; k++) {
-				otl_ChainingRule *rule = subtable->rules[k];
-				glyphclass_t startClass = rule->match[rule->inputBegins]->glyphs[0].index;
-				if (startClass != j) { continue; }
+			for (tableid_t k = buckets.classStart[j]; k < buckets.classStart[j + 1]; k++) {
+				otl_ChainingRule *rule = subtable->rules[buckets.ruleIndex[k]];
 				reverseBacktracks(rule);
 				tableid_t nBacktrack = rule->inputBegins;
 				tableid_t nInput = rule->inputEnds - rule->inputBegins;
@@ -129,7 +157,7 @@ caryll_Buffer *otfcc_build_chaining_classes(const otl_Subtable *_subtable) {
 	}
 
 	FREE(coverage);
-	FREE(rcpg);
+	disposeRuleBuckets(&buckets);
 	return bk_build_Block(root);
 }
 
@@ -182,25 +210,14 @@ caryll_Buffer *otfcc_build_contextual_classes(const otl_Subtable *_subtable) {
 	                 b16, subtable->ic->maxclass + 1, // ChainSubClassSetCnt
 	                 bkover);
 
-	glyphclass_t *rcpg;
-	NEW(rcpg, subtable->ic->maxclass + 1);
-	for (glyphclass_t j = 0; j <= subtable->ic->maxclass; j++) {
-		rcpg[j] = 0;
-	}
-	for (tableid_t j = 0; j < subtable->rulesCount; j++) {
-		tableid_t ib = subtable->rules[j]->inputBegins;
-		tableid_t startClass = subtable->rules[j]->match[ib]->glyphs[0].index;
-		if (startClass <= subtable->ic->maxclass) rcpg[startClass] += 1;
-	}
-
+	RuleBuckets buckets = bucketRulesByStartClass(subtable);
 	for (glyphclass_t j = 0; j <= subtable->ic->maxclass; j++) {
-		if (rcpg[j]) {
-			bk_Block *cset = bk_new_Block(b16, rcpg[j], // ChainSubClassRuleCnt
+		tableid_t rulesOfClass = buckets.classStart[j + 1] - buckets.classStart[j];
+		if (rulesOfClass) {
+			bk_Block *cset = bk_new_Block(b16, rulesOfClass, // ChainSubClassRuleCnt
 			                              bkover);
-			for (tableid_t k = 0; k < subtable->rulesCount; k++) {
-				otl_ChainingRule *rule = subtable->rules[k];
-				glyphclass_t startClass = rule->match[rule->inputBegins]->glyphs[0].index;
-				if (startClass != j) { continue; }
+			for (tableid_t k = buckets.classStart[j]; k < buckets.classStart[j + 1]; k++) {
+				otl_ChainingRule *rule = subtable->rules[buckets.ruleIndex[k]];
 				reverseBacktracks(rule);
 				tableid_t nInput = rule->inputEnds - rule->inputBegins;
 				tableid_t nSubst = rule->applyCount;
@@ -226,7 +243,7 @@ caryll_Buffer *otfcc_build_contextual_classes(const otl_Subtable *_subtable) {
 	}
 
 	FREE(coverage);
-	FREE(rcpg);
+	disposeRuleBuckets(&buckets);
 	return bk_build_Block(root);
 }
 
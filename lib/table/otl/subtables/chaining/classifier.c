@@ -1,89 +1,116 @@
 #include "../chaining.h"
+#include "support/glyph-set/glyph-set.h"
 
 // Chaining substitution classifier
 // We will merge similar subtables.
 
+// A classifier for one of the backtrack, input or lookahead sequences. Each coverage met is
+// mapped to a class; classes are stored as a dense GID -> class map, with the number of
+// glyphs in each class kept aside so that class equality is a counting check.
 typedef struct {
-	int gid;
+	glyphid_t gid;
 	sds gname;
-	int cls;
-	UT_hash_handle hh;
-} classifier_hash;
-static int by_gid_clsh(classifier_hash *a, classifier_hash *b) {
+} classifier_entry;
+typedef struct {
+	otfcc_GlyphClassMap *classes;
+	otfcc_GlyphSet *scratch;
+	glyphclass_t past;
+	uint32_t *classSizes;
+	uint32_t classCapacity;
+	uint32_t length;
+	uint32_t capacity;
+	classifier_entry *entries;
+} classifier;
+
+static void initClassifier(classifier *c) {
+	c->classes = otfcc_newGlyphClassMap();
+	c->scratch = otfcc_newGlyphSet();
+	c->past = 0;
+	c->classSizes = NULL;
+	c->classCapacity = 0;
+	c->length = 0;
+	c->capacity = 0;
+	c->entries = NULL;
+}
+static void disposeClassifier(classifier *c) {
+	otfcc_deleteGlyphClassMap(c->classes);
+	otfcc_deleteGlyphSet(c->scratch);
+	FREE(c->classSizes);
+	FREE(c->entries);
+}
+// Forgets every class while keeping the allocated pages, so that one classifier can be
+// reused for each subtable of a lookup.
+static void resetClassifier(classifier *c) {
+	for (uint32_t j = 0; j < c->length; j++) {
+		otfcc_classmapRemove(c->classes, c->entries[j].gid);
+	}
+	if (c->classCapacity) memset(c->classSizes, 0, c->classCapacity * sizeof(uint32_t));
+	c->past = 0;
+	c->length = 0;
+}
+static int by_gid_entry(const void *_a, const void *_b) {
+	const classifier_entry *a = _a, *b = _b;
 	return a->gid - b->gid;
 }
 
-static int classCompatible(classifier_hash **h, otl_Coverage *cov, int *past) {
-	// checks whether a coverage is compatible to a class hash.
-	classifier_hash *s = NULL;
+static void classifierAdd(classifier *c, const otfcc_GlyphHandle *h, glyphclass_t cls) {
+	if (!otfcc_classmapAdd(c->classes, h->index, cls)) return;
+	if (c->length >= c->capacity) {
+		c->capacity = c->capacity ? c->capacity * 2 : 0x10;
+		RESIZE(c->entries, c->capacity);
+	}
+	c->entries[c->length].gid = h->index;
+	c->entries[c->length].gname = h->name;
+	c->length += 1;
+	if (cls >= c->classCapacity) {
+		uint32_t capacity = c->classCapacity ? c->classCapacity : 0x10;
+		while (cls >= capacity)
+			capacity *= 2;
+		RESIZE(c->classSizes, capacity);
+		memset(c->classSizes + c->classCapacity, 0,
+		       (capacity - c->classCapacity) * sizeof(uint32_t));
+		c->classCapacity = capacity;
+	}
+	c->classSizes[cls] += 1;
+}
+
+static int classCompatible(classifier *c, otl_Coverage *cov) {
+	// checks whether a coverage is compatible to the classes defined so far.
 	if (cov->numGlyphs == 0) return 1;
-	int gid = cov->glyphs[0].index;
-	// check pass
-	HASH_FIND_INT(*h, &gid, s);
-	if (s) {
-		// the coverage has been defined into a class
-		classifier_hash *ss, *tmp;
+	glyphid_t gid = cov->glyphs[0].index;
+	if (otfcc_classmapHas(c->classes, gid)) {
+		// the coverage has been defined into a class: it must be that class, exactly.
+		glyphclass_t cls = otfcc_classmapGet(c->classes, gid);
 		for (glyphid_t j = 1; j < cov->numGlyphs; j++) {
-			int gid = cov->glyphs[j].index;
-			HASH_FIND_INT(*h, &gid, ss);
-			if (!ss || ss->cls != s->cls) return 0;
-		}
-		// reverse check: all glyphs classified are there in the coverage
-		classifier_hash *revh = NULL;
-		for (glyphid_t j = 0; j < cov->numGlyphs; j++) {
-			int gid = cov->glyphs[j].index;
-			classifier_hash *rss = NULL;
-			HASH_FIND_INT(revh, &gid, rss);
-			if (!rss) {
-				NEW(rss);
-				rss->gid = gid;
-				rss->gname = cov->glyphs[j].name;
-				rss->cls = s->cls;
-				HASH_ADD_INT(revh, gid, rss);
+			glyphid_t g = cov->glyphs[j].index;
+			if (!otfcc_classmapHas(c->classes, g) || otfcc_classmapGet(c->classes, g) != cls) {
+				return 0;
 			}
 		}
-
-		bool allcheck = true;
-		foreach_hash(ss, *h) if (ss->cls == s->cls) {
-			int gid = ss->gid;
-			classifier_hash *rss;
-			HASH_FIND_INT(revh, &gid, rss);
-			if (!rss) {
-				allcheck = false;
-				break;
-			}
+		// reverse check: all glyphs classified are there in the coverage.
+		// Every glyph of the coverage is in the class, so comparing sizes is enough.
+		uint32_t distinct = 0;
+		for (glyphid_t j = 0; j < cov->numGlyphs; j++) {
+			if (otfcc_glyphsetAdd(c->scratch, cov->glyphs[j].index)) distinct += 1;
 		}
-		HASH_ITER(hh, revh, ss, tmp) {
-			HASH_DEL(revh, ss);
-			FREE(ss);
+		for (glyphid_t j = 0; j < cov->numGlyphs; j++) {
+			otfcc_glyphsetRemove(c->scratch, cov->glyphs[j].index);
 		}
-		return allcheck ? s->cls : 0;
+		return distinct == c->classSizes[cls] ? cls : 0;
 	} else {
 		// the coverage is not defined into a class.
-		classifier_hash *ss;
 		for (glyphid_t j = 1; j < cov->numGlyphs; j++) {
-			int gid = cov->glyphs[j].index;
-			HASH_FIND_INT(*h, &gid, ss);
-			if (ss) return 0;
+			if (otfcc_classmapHas(c->classes, cov->glyphs[j].index)) return 0;
 		}
+		c->past += 1;
 		for (glyphid_t j = 0; j < cov->numGlyphs; j++) {
-			int gid = cov->glyphs[j].index;
-			classifier_hash *s = NULL;
-			HASH_FIND_INT(*h, &gid, s);
-			if (!s) {
-				NEW(s);
-				s->gid = cov->glyphs[j].index;
-				s->gname = cov->glyphs[j].name;
-				s->cls = *past + 1;
-				HASH_ADD_INT(*h, gid, s);
-			}
+			classifierAdd(c, &cov->glyphs[j], c->past);
 		}
-		*past += 1;
 		return 1;
 	}
 }
-static otl_ChainingRule *buildRule(otl_ChainingRule *rule, classifier_hash *hb, classifier_hash *hi,
-                                   classifier_hash *hf) {
+static otl_ChainingRule *buildRule(otl_ChainingRule *rule, classifier *cb, classifier *ci,
+                                   classifier *cf) {
 	otl_ChainingRule *newRule;
 	NEW(newRule);
 	newRule->matchCount = rule->matchCount;
@@ -95,11 +122,9 @@ static otl_ChainingRule *buildRule(otl_ChainingRule *rule, classifier_hash *hb,
 		newRule->match[m]->numGlyphs = 1;
 		NEW(newRule->match[m]->glyphs);
 		if (rule->match[m]->numGlyphs > 0) {
-			classifier_hash *h = (m < rule->inputBegins ? hb : m < rule->inputEnds ? hi : hf);
-			classifier_hash *s;
-			int gid = rule->match[m]->glyphs[0].index;
-			HASH_FIND_INT(h, &gid, s);
-			newRule->match[m]->glyphs[0] = Handle.fromIndex(s->cls);
+			classifier *c = (m < rule->inputBegins ? cb : m < rule->inputEnds ? ci : cf);
+			glyphid_t gid = rule->match[m]->glyphs[0].index;
+			newRule->match[m]->glyphs[0] = Handle.fromIndex(otfcc_classmapGet(c->classes, gid));
 		} else {
 			newRule->match[m]->glyphs[0] = Handle.fromIndex(0);
 		}
@@ -112,36 +137,32 @@ static otl_ChainingRule *buildRule(otl_ChainingRule *rule, classifier_hash *hb,
 	}
 	return newRule;
 }
-static otl_ClassDef *toClass(classifier_hash **h) {
+static otl_ClassDef *toClass(classifier *c) {
 	otl_ClassDef *cd = ClassDef.create();
-	classifier_hash *item;
-	HASH_SORT(*h, by_gid_clsh);
-	foreach_hash(item, *h) {
-		ClassDef.push(cd, Handle.fromConsolidated(item->gid, item->gname), item->cls);
+	if (c->length) qsort(c->entries, c->length, sizeof(classifier_entry), by_gid_entry);
+	for (uint32_t j = 0; j < c->length; j++) {
+		glyphid_t gid = c->entries[j].gid;
+		ClassDef.push(cd, Handle.fromConsolidated(gid, c->entries[j].gname),
+		              otfcc_classmapGet(c->classes, gid));
 	}
 	return cd;
 }
-tableid_t tryClassifyAround(const otl_Lookup *lookup, tableid_t j,
-                            OUT subtable_chaining **classifiedST) {
+static tableid_t tryClassifyAround(const otl_Lookup *lookup, tableid_t j, classifier *cs,
+                                   OUT subtable_chaining **classifiedST) {
 	tableid_t compatibleCount = 0;
-	classifier_hash *hb = NULL;
-	classifier_hash *hi = NULL;
-	classifier_hash *hf = NULL;
-	// initialize the class hash
+	classifier *cb = &cs[0], *ci = &cs[1], *cf = &cs[2];
+	// initialize the classes
 	subtable_chaining *subtable0 = &(lookup->subtables.items[j]->chaining);
-	int classno_b = 0;
-	int classno_i = 0;
-	int classno_f = 0;
 
 	otl_ChainingRule *rule0 = &subtable0->rule;
 	for (tableid_t m = 0; m < rule0->matchCount; m++) {
 		int check = 0;
 		if (m < rule0->inputBegins) {
-			check = classCompatible(&hb, rule0->match[m], &classno_b);
+			check = classCompatible(cb, rule0->match[m]);
 		} else if (m < rule0->inputEnds) {
-			check = classCompatible(&hi, rule0->match[m], &classno_i);
+			check = classCompatible(ci, rule0->match[m]);
 		} else {
-			check = classCompatible(&hf, rule0->match[m], &classno_f);
+			check = classCompatible(cf, rule0->match[m]);
 		}
 		if (!check) { goto FAIL; }
 	}
@@ -151,11 +172,11 @@ tableid_t tryClassifyAround(const otl_Lookup *lookup, tableid_t j,
 		for (tableid_t m = 0; m < rule->matchCount; m++) {
 			int check = 0;
 			if (m < rule->inputBegins) {
-				check = classCompatible(&hb, rule->match[m], &classno_b);
+				check = classCompatible(cb, rule->match[m]);
 			} else if (m < rule->inputEnds) {
-				check = classCompatible(&hi, rule->match[m], &classno_i);
+				check = classCompatible(ci, rule->match[m]);
 			} else {
-				check = classCompatible(&hf, rule->match[m], &classno_f);
+				check = classCompatible(cf, rule->match[m]);
 			}
 			if (!check) {
 				allcheck = false;
@@ -171,43 +192,25 @@ endcheck:
 		subtable0->rulesCount = compatibleCount + 1;
 		NEW(subtable0->rules, compatibleCount + 1);
 
-		subtable0->rules[0] = buildRule(rule0, hb, hi, hf);
+		subtable0->rules[0] = buildRule(rule0, cb, ci, cf);
 		// write other rules
 		tableid_t kk = 1;
 		for (tableid_t k = j + 1; k < lookup->subtables.length && kk < compatibleCount + 1; k++) {
 			otl_ChainingRule *rule = &lookup->subtables.items[k]->chaining.rule;
-			subtable0->rules[kk] = buildRule(rule, hb, hi, hf);
+			subtable0->rules[kk] = buildRule(rule, cb, ci, cf);
 			kk++;
 		}
 
 		subtable0->type = otl_chaining_classified;
-		subtable0->bc = toClass(&hb);
-		subtable0->ic = toClass(&hi);
-		subtable0->fc = toClass(&hf);
+		subtable0->bc = toClass(cb);
+		subtable0->ic = toClass(ci);
+		subtable0->fc = toClass(cf);
 		*classifiedST = subtable0;
 	}
 FAIL:;
-	if (hb) {
-		classifier_hash *s, *tmp;
-		HASH_ITER(hh, hb, s, tmp) {
-			HASH_DEL(hb, s);
-			FREE(s);
-		}
-	}
-	if (hi) {
-		classifier_hash *s, *tmp;
-		HASH_ITER(hh, hi, s, tmp) {
-			HASH_DEL(hi, s);
-			FREE(s);
-		}
-	}
-	if (hf) {
-		classifier_hash *s, *tmp;
-		HASH_ITER(hh, hf, s, tmp) {
-			HASH_DEL(hf, s);
-			FREE(s);
-		}
-	}
+	resetClassifier(cb);
+	resetClassifier(ci);
+	resetClassifier(cf);
 
 	if (compatibleCount > 1) {
 		return compatibleCount;
@@ -216,23 +219,28 @@ FAIL:;
 	}
 }
 tableid_t otfcc_classifiedBuildChaining(const otl_Lookup *lookup,
-                                        OUT caryll_Buffer ***subtableBuffers,
-                                        MODIFY size_t *lastOffset) {
+                                        OUT caryll_Buffer ***subtableBuffers) {
 	bool isContextual = otfcc_chainingLookupIsContextualLookup(lookup);
 	tableid_t subtablesWritten = 0;
 	NEW(*subtableBuffers, lookup->subtables.length);
+	classifier cs[3];
+	for (uint8_t k = 0; k < 3; k++) {
+		initClassifier(&cs[k]);
+	}
 	for (tableid_t j = 0; j < lookup->subtables.length; j++) {
 		subtable_chaining *st0 = &(lookup->subtables.items[j]->chaining);
 		if (st0->type) continue;
 		subtable_chaining *st = st0;
 		// Try to classify subtables after j into j
-		j += tryClassifyAround(lookup, j, &st);
+		j += tryClassifyAround(lookup, j, cs, &st);
 		caryll_Buffer *buf = isContextual ? otfcc_build_contextual((otl_Subtable *)st)
 		                                  : otfcc_build_chaining((otl_Subtable *)st);
 		if (st != st0) { iSubtable_chaining.free(st); }
 		(*subtableBuffers)[subtablesWritten] = buf;
-		*lastOffset += buf->size;
 		subtablesWritten += 1;
 	}
+	for (uint8_t k = 0; k < 3; k++) {
+		disposeClassifier(&cs[k]);
+	}
 	return subtablesWritten;
 }
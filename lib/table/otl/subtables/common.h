@@ -7,7 +7,8 @@
 
 typedef enum {
 	OTL_BH_NORMAL = 0,
-	OTL_BH_GSUB_VERT = 1
+	OTL_BH_GSUB_VERT = 1,
+	OTL_BH_GPOS_SPLIT_PAIRS = 2
 } otl_BuildHeuristics;
 
 #define checkLength(offset) if (tableLength < offset) { goto FAIL; }
@@ -263,144 +263,741 @@ static otl_Coverage *covFromCD(otl_ClassDef *cd) {
 	return cov;
 }
 
+// Glyph reference sorted by glyph ID; `item` indexes the owning ClassDef.
 typedef struct {
 	glyphid_t gid;
-	otl_PositionValue *fv;
-	otl_PositionValue *sv;
-} IndividualGposPair;
+	glyphid_t item;
+} PairGlyphRef;
 
-static int by_pairSecondGlyph(const void *a, const void *b) {
-	return ((IndividualGposPair *)a)->gid - ((IndividualGposPair *)b)->gid;
+static int byPairGlyphRef(const void *_a, const void *_b) {
+	const PairGlyphRef *a = _a;
+	const PairGlyphRef *b = _b;
+	return a->gid != b->gid ? a->gid - b->gid : a->item - b->item;
 }
 
-bk_Block *otfcc_build_gpos_pair_individual(const otl_Subtable *_subtable) {
-	const subtable_gpos_pair *subtable = &(_subtable->gpos_pair);
-	uint16_t format1 = 0;
-	uint16_t format2 = 0;
-	glyphclass_t class1Count = subtable->first->maxclass + 1;
-	glyphclass_t class2Count = subtable->second->maxclass + 1;
+static PairGlyphRef *sortedGlyphRefs(const otl_ClassDef *cd) {
+	PairGlyphRef *refs;
+	NEW(refs, cd->numGlyphs);
+	for (glyphid_t j = 0; j < cd->numGlyphs; j++) {
+		refs[j].gid = cd->glyphs[j].index;
+		refs[j].item = j;
+	}
+	qsort(refs, cd->numGlyphs, sizeof(PairGlyphRef), byPairGlyphRef);
+	return refs;
+}
 
-	for (glyphclass_t j = 0; j < class1Count; j++) {
-		for (glyphclass_t k = 0; k < class2Count; k++) {
-			format1 |= required_position_format(subtable->firstValues[j][k]);
-			format2 |= required_position_format(subtable->secondValues[j][k]);
+// Everything both pair formats derive from the class matrix, computed once.
+typedef struct {
+	uint16_t format1;
+	uint16_t format2;
+	glyphclass_t class1Count;
+	glyphclass_t class2Count;
+	bool *nonzero;          // [c1 * class2Count + c2]: whether the class pair carries a value
+	glyphid_t *pairsPerRow; // number of second glyphs paired with each first class
+	PairGlyphRef *seconds;  // second glyphs, sorted by glyph ID
+} PairMatrixStat;
+
+static PairMatrixStat statPairMatrix(const subtable_gpos_pair *subtable) {
+	PairMatrixStat stat;
+	stat.format1 = 0;
+	stat.format2 = 0;
+	stat.class1Count = subtable->first->maxclass + 1;
+	stat.class2Count = subtable->second->maxclass + 1;
+	NEW(stat.nonzero, stat.class1Count * stat.class2Count);
+	for (glyphclass_t j = 0; j < stat.class1Count; j++) {
+		for (glyphclass_t k = 0; k < stat.class2Count; k++) {
+			uint8_t f1 = required_position_format(subtable->firstValues[j][k]);
+			uint8_t f2 = required_position_format(subtable->secondValues[j][k]);
+			stat.format1 |= f1;
+			stat.format2 |= f2;
+			stat.nonzero[j * stat.class2Count + k] = f1 | f2;
 		}
 	}
-	glyphid_t *pairCounts;
-	NEW(pairCounts, subtable->first->numGlyphs);
-	for (glyphid_t j = 0; j < subtable->first->numGlyphs; j++) {
-		pairCounts[j] = 0;
-		for (glyphid_t k = 0; k < subtable->second->numGlyphs; k++) {
-			glyphclass_t c1 = subtable->first->classes[j];
-			glyphclass_t c2 = subtable->second->classes[k];
-			if (required_position_format(subtable->firstValues[c1][c2]) |
-			    required_position_format(subtable->secondValues[c1][c2])) {
-				pairCounts[j] += 1;
-			}
+	glyphid_t *secondsPerClass;
+	NEW(secondsPerClass, stat.class2Count);
+	for (glyphid_t k = 0; k < subtable->second->numGlyphs; k++) {
+		secondsPerClass[subtable->second->classes[k]] += 1;
+	}
+	NEW(stat.pairsPerRow, stat.class1Count);
+	for (glyphclass_t j = 0; j < stat.class1Count; j++) {
+		for (glyphclass_t k = 0; k < stat.class2Count; k++) {
+			if (stat.nonzero[j * stat.class2Count + k]) stat.pairsPerRow[j] += secondsPerClass[k];
 		}
 	}
-	otl_Coverage *cov = covFromCD(subtable->first);
-	Coverage.shrink(cov, true);
-	bk_Block *root = bk_new_Block(b16, 1,                                          // PosFormat
-	                              p16, bk_newBlockFromBuffer(Coverage.build(cov)), // Coverage
-	                              b16, format1,                                    // ValueFormat1
-	                              b16, format2,                                    // ValueFormat2
-	                              b16, subtable->first->numGlyphs,                 // PairSetCount
-	                              bkover);
+	FREE(secondsPerClass);
+	stat.seconds = sortedGlyphRefs(subtable->second);
+	return stat;
+}
+static void disposePairMatrixStat(PairMatrixStat *stat) {
+	FREE(stat->nonzero);
+	FREE(stat->pairsPerRow);
+	FREE(stat->seconds);
+}
 
-	for (glyphid_t j = 0; j < cov->numGlyphs; j++) {
-		tableid_t currentPairCount = 0;
-		glyphclass_t c1 = 0;
-		for (glyphid_t k = 0; k < subtable->first->numGlyphs; k++) {
-			if (subtable->first->glyphs[k].index == cov->glyphs[j].index) {
-				// The coverage is sorted, not direct correspondence with subtable->first.
-				c1 = subtable->first->classes[k];
-				currentPairCount = pairCounts[k];
-			}
+// First glyphs of format 1, in coverage order, with the class of each.
+typedef struct {
+	otl_Coverage *cov;
+	glyphclass_t *classes;
+} PairFirstGlyphs;
+
+static PairFirstGlyphs collectFirstGlyphs(const subtable_gpos_pair *subtable) {
+	PairFirstGlyphs fg;
+	fg.cov = covFromCD(subtable->first);
+	Coverage.shrink(fg.cov, true);
+	NEW(fg.classes, fg.cov->numGlyphs);
+	// Both sides are sorted by glyph ID; when a glyph is listed more than once, the last
+	// occurrence in the ClassDef wins.
+	PairGlyphRef *firsts = sortedGlyphRefs(subtable->first);
+	glyphid_t k = 0;
+	for (glyphid_t j = 0; j < fg.cov->numGlyphs; j++) {
+		glyphid_t gid = fg.cov->glyphs[j].index;
+		while (k < subtable->first->numGlyphs && firsts[k].gid < gid) {
+			k++;
+		}
+		while (k < subtable->first->numGlyphs && firsts[k].gid == gid) {
+			fg.classes[j] = subtable->first->classes[firsts[k].item];
+			k++;
 		}
-		bk_Block *pairSet = bk_new_Block(b16, currentPairCount, // PairValueCount
+	}
+	FREE(firsts);
+	return fg;
+}
+static void disposeFirstGlyphs(PairFirstGlyphs *fg) {
+	DELETE(Coverage.free, fg->cov);
+	FREE(fg->classes);
+}
+
+// Byte size of each format, counted the way bk_estimateSizeOfGraph counts an unpacked
+// graph: every block once per reference, before sharing identical blocks.
+static size_t estimateIndividualSize(const PairMatrixStat *stat, const PairFirstGlyphs *fg,
+                                     const caryll_Buffer *coverage) {
+	size_t pairSize = 2 + position_format_length(stat->format1) +
+	                  position_format_length(stat->format2); // SecondGlyph, Value1, Value2
+	size_t size = 10 + 2 * fg->cov->numGlyphs + buflen((caryll_Buffer *)coverage);
+	for (glyphid_t j = 0; j < fg->cov->numGlyphs; j++) {
+		size += 2 + pairSize * stat->pairsPerRow[fg->classes[j]];
+	}
+	return size;
+}
+static size_t estimateClassesSize(const PairMatrixStat *stat, const caryll_Buffer *coverage,
+                                  const caryll_Buffer *cd1, const caryll_Buffer *cd2) {
+	size_t valueSize =
+	    position_format_length(stat->format1) + position_format_length(stat->format2);
+	return 16 + buflen((caryll_Buffer *)coverage) + buflen((caryll_Buffer *)cd1) +
+	       buflen((caryll_Buffer *)cd2) +
+	       valueSize * (size_t)stat->class1Count * (size_t)stat->class2Count;
+}
+
+static bk_Block *buildPairIndividual(const subtable_gpos_pair *subtable,
+                                     const PairMatrixStat *stat, const PairFirstGlyphs *fg,
+                                     MOVE caryll_Buffer *coverage) {
+	bk_Block *root = bk_new_Block(b16, 1,                               // PosFormat
+	                              p16, bk_newBlockFromBuffer(coverage), // Coverage
+	                              b16, stat->format1,                   // ValueFormat1
+	                              b16, stat->format2,                   // ValueFormat2
+	                              b16, fg->cov->numGlyphs,              // PairSetCount
+	                              bkover);
+
+	for (glyphid_t j = 0; j < fg->cov->numGlyphs; j++) {
+		glyphclass_t c1 = fg->classes[j];
+		bk_Block *pairSet = bk_new_Block(b16, stat->pairsPerRow[c1], // PairValueCount
 		                                 bkover);
-		IndividualGposPair *pairs;
-		NEW_CLEAN_N(pairs, currentPairCount);
-		size_t n = 0;
 		for (glyphid_t k = 0; k < subtable->second->numGlyphs; k++) {
-			glyphclass_t c2 = subtable->second->classes[k];
-			if (required_position_format(subtable->firstValues[c1][c2]) |
-			    required_position_format(subtable->secondValues[c1][c2])) {
-				pairs[n].gid = subtable->second->glyphs[k].index;
-				pairs[n].fv = &subtable->firstValues[c1][c2];
-				pairs[n].sv = &subtable->secondValues[c1][c2];
-				n++;
-			}
-		}
-		qsort(pairs, currentPairCount, sizeof(IndividualGposPair), by_pairSecondGlyph);
-		for (size_t n = 0; n < currentPairCount; n++) {
-			bk_push(pairSet, b16, pairs[n].gid,                      // SecondGlyph
-			        bkembed, bk_gpos_value(*(pairs[n].fv), format1), // Value1
-			        bkembed, bk_gpos_value(*(pairs[n].sv), format2), // Value2
+			glyphclass_t c2 = subtable->second->classes[stat->seconds[k].item];
+			if (!stat->nonzero[c1 * stat->class2Count + c2]) continue;
+			bk_push(pairSet, b16, stat->seconds[k].gid, // SecondGlyph
+			        bkembed,
+			        bk_gpos_value(subtable->firstValues[c1][c2], stat->format1), // Value1
+			        bkembed,
+			        bk_gpos_value(subtable->secondValues[c1][c2], stat->format2), // Value2
 			        bkover);
 		}
-		FREE(pairs);
 		bk_push(root, p16, pairSet, bkover);
 	}
-	DELETE(Coverage.free, cov);
-	FREE(pairCounts);
 	return root;
 }
-bk_Block *otfcc_build_gpos_pair_classes(const otl_Subtable *_subtable) {
-	const subtable_gpos_pair *subtable = &(_subtable->gpos_pair);
-	uint16_t format1 = 0;
-	uint16_t format2 = 0;
-	glyphclass_t class1Count = subtable->first->maxclass + 1;
-	glyphclass_t class2Count = subtable->second->maxclass + 1;
-
-	for (glyphclass_t j = 0; j < class1Count; j++) {
-		for (glyphclass_t k = 0; k < class2Count; k++) {
-			format1 |= required_position_format(subtable->firstValues[j][k]);
-			format2 |= required_position_format(subtable->secondValues[j][k]);
-		}
-	}
-	otl_Coverage *cov = covFromCD(subtable->first);
-	bk_Block *root =
-	    bk_new_Block(b16, 2,                                                       // PosFormat
-	                 p16, bk_newBlockFromBuffer(Coverage.build(cov)),              // Coverage
-	                 b16, format1,                                                 // ValueFormat1
-	                 b16, format2,                                                 // ValueFormat2
-	                 p16, bk_newBlockFromBuffer(ClassDef.build(subtable->first)),  // ClassDef1
-	                 p16, bk_newBlockFromBuffer(ClassDef.build(subtable->second)), // ClassDef2
-	                 b16, class1Count,                                             // Class1Count
-	                 b16, class2Count,                                             // Class2Count
-	                 bkover);
-	for (glyphclass_t j = 0; j < class1Count; j++) {
-		for (glyphclass_t k = 0; k < class2Count; k++) {
-			bk_push(root, bkembed, bk_gpos_value(subtable->firstValues[j][k], format1), // Value1
-			        bkembed, bk_gpos_value(subtable->secondValues[j][k], format2),      // Value2
+static bk_Block *buildPairClasses(const subtable_gpos_pair *subtable, const PairMatrixStat *stat,
+                                  MOVE caryll_Buffer *coverage, MOVE caryll_Buffer *cd1,
+                                  MOVE caryll_Buffer *cd2) {
+	bk_Block *root = bk_new_Block(b16, 2,                               // PosFormat
+	                              p16, bk_newBlockFromBuffer(coverage), // Coverage
+	                              b16, stat->format1,                   // ValueFormat1
+	                              b16, stat->format2,                   // ValueFormat2
+	                              p16, bk_newBlockFromBuffer(cd1),      // ClassDef1
+	                              p16, bk_newBlockFromBuffer(cd2),      // ClassDef2
+	                              b16, stat->class1Count,               // Class1Count
+	                              b16, stat->class2Count,               // Class2Count
+	                              bkover);
+	for (glyphclass_t j = 0; j < stat->class1Count; j++) {
+		for (glyphclass_t k = 0; k < stat->class2Count; k++) {
+			bk_push(root, bkembed,
+			        bk_gpos_value(subtable->firstValues[j][k], stat->format1), // Value1
+			        bkembed,
+			        bk_gpos_value(subtable->secondValues[j][k], stat->format2), // Value2
 			        bkover);
 		}
 	}
-	DELETE(Coverage.free, cov);
 	return root;
 }
-caryll_Buffer *otfcc_build_gpos_pair(const otl_Subtable *_subtable, otl_BuildHeuristics heuristics) {
-	bk_Block *format1 = otfcc_build_gpos_pair_individual(_subtable);
-	bk_Block *format2 = otfcc_build_gpos_pair_classes(_subtable);
-	bk_Graph *g1 = bk_newGraphFromRootBlock(format1);
-	bk_Graph *g2 = bk_newGraphFromRootBlock(format2);
-	bk_minimizeGraph(g1);
-	bk_minimizeGraph(g2);
-	if (bk_estimateSizeOfGraph(g1) > bk_estimateSizeOfGraph(g2)) {
+
+static caryll_Buffer *buildPairSubtable(const subtable_gpos_pair *subtable, OUT bool *packed) {
+	PairMatrixStat stat = statPairMatrix(subtable);
+	PairFirstGlyphs fg = collectFirstGlyphs(subtable);
+
+	// Only the smaller format is materialized.
+	caryll_Buffer *cov1 = Coverage.build(fg.cov);
+	otl_Coverage *cov = covFromCD(subtable->first);
+	caryll_Buffer *cov2 = Coverage.build(cov);
+	DELETE(Coverage.free, cov);
+	caryll_Buffer *cd1 = ClassDef.build(subtable->first);
+	caryll_Buffer *cd2 = ClassDef.build(subtable->second);
+
+	bk_Block *root;
+	if (estimateIndividualSize(&stat, &fg, cov1) > estimateClassesSize(&stat, cov2, cd1, cd2)) {
 		// Choose pair adjustment by classes
-		bk_delete_Graph(g1);
-		bk_untangleGraph(g2);
-		caryll_Buffer *buf = bk_build_Graph(g2);
-		bk_delete_Graph(g2);
-		return buf;
+		buffree(cov1);
+		root = buildPairClasses(subtable, &stat, cov2, cd1, cd2);
 	} else {
 		// Choose pair adjustment by individuals
-		bk_delete_Graph(g2);
-		bk_untangleGraph(g1);
-		caryll_Buffer *buf = bk_build_Graph(g1);
-		bk_delete_Graph(g1);
-		return buf;
+		buffree(cov2), buffree(cd1), buffree(cd2);
+		root = buildPairIndividual(subtable, &stat, &fg, cov1);
+	}
+	disposeFirstGlyphs(&fg);
+	disposePairMatrixStat(&stat);
+	return bk_build_Block_checked(root, packed);
+}
+
+caryll_Buffer *otfcc_build_gpos_pair(const otl_Subtable *_subtable, otl_BuildHeuristics heuristics) {
+	bool packed;
+	return buildPairSubtable(&(_subtable->gpos_pair), &packed);
+}
+
+// Class-kerning subtable splitting.
+// A format 2 subtable stores a dense Class1Count * Class2Count matrix, which is mostly zero
+// in real kerning. The first classes are partitioned into clusters, each built as its own
+// subtable: a cluster only keeps the second classes where one of its rows differs from
+// class 0, and otfcc_build_gpos_pair still picks format 1 for a sparse cluster. Every first
+// glyph lands in exactly one cluster, so splitting preserves the positioning.
+
+static bool positionValueEqual(otl_PositionValue a, otl_PositionValue b) {
+	return a.dx == b.dx && a.dy == b.dy && a.dWidth == b.dWidth && a.dHeight == b.dHeight;
+}
+
+// Per-class statistics of the pair matrix, shared by all clusters of a subtable.
+typedef struct {
+	glyphclass_t class1Count;
+	glyphclass_t class2Count;
+	size_t columnWords;
+	glyphid_t *rowGlyphs;    // first glyphs of each first class
+	glyphid_t *rowRanges;    // glyph ID ranges of each first class
+	uint16_t *rowFormat1;    // ValueFormat1 each first class requires
+	uint16_t *rowFormat2;    // ValueFormat2 each first class requires
+	size_t *rowPairs;        // format 1 pair records of each first class
+	uint64_t *rowColumns;    // [c1 * columnWords]: second classes differing from class 0
+	glyphid_t *columnRanges; // glyph ID ranges of each second class
+} PairSplitStat;
+
+typedef struct {
+	bool alive;
+	glyphclass_t rows;
+	glyphid_t glyphs;
+	glyphid_t ranges;
+	glyphid_t maxRanges; // ranges of the class which becomes class 0, omitted from ClassDef1
+	uint16_t format1;
+	uint16_t format2;
+	size_t pairs;
+	uint64_t *columns;
+	size_t size;
+	uint32_t version; // bumped by every merge, to recognize stale candidates
+} PairCluster;
+
+static PairSplitStat statPairSplit(const subtable_gpos_pair *subtable, const PairMatrixStat *stat,
+                                   const PairFirstGlyphs *fg) {
+	PairSplitStat s;
+	s.class1Count = stat->class1Count;
+	s.class2Count = stat->class2Count;
+	s.columnWords = (s.class2Count + 63) / 64;
+	NEW(s.rowGlyphs, s.class1Count);
+	NEW(s.rowRanges, s.class1Count);
+	NEW(s.rowFormat1, s.class1Count);
+	NEW(s.rowFormat2, s.class1Count);
+	NEW(s.rowPairs, s.class1Count);
+	NEW(s.rowColumns, s.class1Count * s.columnWords);
+	NEW(s.columnRanges, s.class2Count);
+
+	for (glyphid_t j = 0; j < fg->cov->numGlyphs; j++) {
+		glyphclass_t c1 = fg->classes[j];
+		s.rowGlyphs[c1] += 1;
+		if (!j || fg->classes[j - 1] != c1 ||
+		    fg->cov->glyphs[j - 1].index + 1 != fg->cov->glyphs[j].index) {
+			s.rowRanges[c1] += 1;
+		}
 	}
+	for (glyphid_t k = 0; k < subtable->second->numGlyphs; k++) {
+		glyphclass_t c2 = subtable->second->classes[stat->seconds[k].item];
+		if (!k || subtable->second->classes[stat->seconds[k - 1].item] != c2 ||
+		    stat->seconds[k - 1].gid + 1 != stat->seconds[k].gid) {
+			s.columnRanges[c2] += 1;
+		}
+	}
+	for (glyphclass_t j = 0; j < s.class1Count; j++) {
+		s.rowPairs[j] = (size_t)s.rowGlyphs[j] * stat->pairsPerRow[j];
+		uint64_t *columns = s.rowColumns + j * s.columnWords;
+		for (glyphclass_t k = 0; k < s.class2Count; k++) {
+			s.rowFormat1[j] |= required_position_format(subtable->firstValues[j][k]);
+			s.rowFormat2[j] |= required_position_format(subtable->secondValues[j][k]);
+			if (k && s.columnRanges[k] &&
+			    !(positionValueEqual(subtable->firstValues[j][k], subtable->firstValues[j][0]) &&
+			      positionValueEqual(subtable->secondValues[j][k], subtable->secondValues[j][0]))) {
+				columns[k / 64] |= (uint64_t)1 << (k % 64);
+			}
+		}
+	}
+	return s;
+}
+static void disposePairSplitStat(PairSplitStat *s) {
+	FREE(s->rowGlyphs);
+	FREE(s->rowRanges);
+	FREE(s->rowFormat1);
+	FREE(s->rowFormat2);
+	FREE(s->rowPairs);
+	FREE(s->rowColumns);
+	FREE(s->columnRanges);
+}
+
+// Estimated bytes of a cluster built as its own subtable, including its offset in the lookup.
+// Coverage and ClassDef sizes follow Coverage.build and ClassDef.build: the coverage takes the
+// smaller format, and ClassDefs are written as ranges.
+static size_t estimatePairClusterSize(const PairSplitStat *s, const PairCluster *a,
+                                      const PairCluster *b) {
+	glyphclass_t rows = a->rows + (b ? b->rows : 0);
+	glyphid_t glyphs = a->glyphs + (b ? b->glyphs : 0);
+	size_t ranges = a->ranges + (b ? b->ranges : 0);
+	size_t maxRanges = (b && b->maxRanges > a->maxRanges) ? b->maxRanges : a->maxRanges;
+	size_t pairs = a->pairs + (b ? b->pairs : 0);
+	uint16_t format1 = a->format1 | (b ? b->format1 : 0);
+	uint16_t format2 = a->format2 | (b ? b->format2 : 0);
+
+	size_t columns = 1;
+	size_t columnRanges = 0;
+	for (size_t w = 0; w < s->columnWords; w++) {
+		uint64_t word = a->columns[w] | (b ? b->columns[w] : 0);
+		for (uint8_t bit = 0; word; bit++, word >>= 1) {
+			if (!(word & 1)) continue;
+			columns += 1;
+			columnRanges += s->columnRanges[w * 64 + bit];
+		}
+	}
+
+	size_t valueSize = position_format_length(format1) + position_format_length(format2);
+	size_t coverage = 4 + (2 * glyphs < 6 * ranges ? 2 * glyphs : 6 * ranges);
+	size_t individual = 10 + 4 * (size_t)glyphs + coverage + (2 + valueSize) * pairs;
+	size_t classes = 16 + coverage + (4 + 6 * (ranges - maxRanges)) + (4 + 6 * columnRanges) +
+	                 valueSize * rows * columns;
+	return 2 + (individual < classes ? individual : classes);
+}
+
+static void mergePairCluster(const PairSplitStat *s, PairCluster *a, PairCluster *b) {
+	a->rows += b->rows;
+	a->glyphs += b->glyphs;
+	a->ranges += b->ranges;
+	if (b->maxRanges > a->maxRanges) a->maxRanges = b->maxRanges;
+	a->format1 |= b->format1;
+	a->format2 |= b->format2;
+	a->pairs += b->pairs;
+	for (size_t w = 0; w < s->columnWords; w++) {
+		a->columns[w] |= b->columns[w];
+	}
+	b->alive = false;
+}
+
+// A candidate merge of two neighbouring clusters, valid while neither has changed.
+typedef struct {
+	size_t gain;
+	glyphclass_t left;
+	glyphclass_t right;
+	uint32_t leftVersion;
+	uint32_t rightVersion;
+} PairMerge;
+
+typedef struct {
+	size_t length;
+	size_t capacity;
+	PairMerge *items;
+} PairMergeHeap;
+
+static bool pairMergeBefore(const PairMerge *a, const PairMerge *b) {
+	return a->gain > b->gain || (a->gain == b->gain && a->left < b->left);
+}
+static void pushPairMerge(PairMergeHeap *heap, PairMerge m) {
+	if (heap->length >= heap->capacity) {
+		heap->capacity += heap->capacity / 2 + 0x10;
+		RESIZE(heap->items, heap->capacity);
+	}
+	size_t j = heap->length++;
+	while (j && pairMergeBefore(&m, &heap->items[(j - 1) / 2])) {
+		heap->items[j] = heap->items[(j - 1) / 2];
+		j = (j - 1) / 2;
+	}
+	heap->items[j] = m;
+}
+static PairMerge popPairMerge(PairMergeHeap *heap) {
+	PairMerge top = heap->items[0];
+	PairMerge last = heap->items[--heap->length];
+	size_t j = 0;
+	while (2 * j + 1 < heap->length) {
+		size_t k = 2 * j + 1;
+		if (k + 1 < heap->length && pairMergeBefore(&heap->items[k + 1], &heap->items[k])) k++;
+		if (!pairMergeBefore(&heap->items[k], &last)) break;
+		heap->items[j] = heap->items[k];
+		j = k;
+	}
+	heap->items[j] = last;
+	return top;
+}
+
+static void proposePairMerge(const PairSplitStat *s, PairCluster *clusters, PairMergeHeap *heap,
+                             glyphclass_t left, glyphclass_t right) {
+	PairCluster *a = &clusters[left];
+	PairCluster *b = &clusters[right];
+	size_t merged = estimatePairClusterSize(s, a, b);
+	if (merged >= a->size + b->size) return;
+	pushPairMerge(heap, (PairMerge){.gain = a->size + b->size - merged,
+	                                .left = left,
+	                                .right = right,
+	                                .leftVersion = a->version,
+	                                .rightVersion = b->version});
+}
+
+#define PAIR_MERGE_WINDOW 16
+
+typedef struct {
+	const uint64_t *columns;
+	size_t columnWords;
+	glyphclass_t row;
+} PairRowKey;
+static int byPairRowColumns(const void *_a, const void *_b) {
+	const PairRowKey *a = _a, *b = _b;
+	for (size_t w = 0; w < a->columnWords; w++) {
+		if (a->columns[w] != b->columns[w]) return a->columns[w] < b->columns[w] ? -1 : 1;
+	}
+	return a->row < b->row ? -1 : a->row > b->row ? 1 : 0;
+}
+
+// Greedy agglomerative clustering of the non-empty first classes. The classes are sorted by
+// the second classes they need, which puts similar rows side by side, and a cluster is only
+// merged with one of its PAIR_MERGE_WINDOW nearest neighbours on either side: the merge
+// saving the most bytes goes first, until no merge saves anything. Candidates live in a heap,
+// so the clustering takes O(n log n) size estimates instead of O(n^3).
+// Returns the cluster of each first class (class1Count for empty classes), or NULL when
+// splitting would not beat a single subtable.
+static glyphclass_t *clusterPairRows(const PairSplitStat *s, OUT glyphclass_t *clusterCount) {
+	glyphclass_t n = 0;
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (s->rowGlyphs[r]) n++;
+	}
+	if (n < 2) return NULL;
+
+	PairRowKey *order;
+	NEW(order, n);
+	for (glyphclass_t r = 0, j = 0; r < s->class1Count; r++) {
+		if (!s->rowGlyphs[r]) continue;
+		order[j++] = (PairRowKey){
+		    .columns = s->rowColumns + r * s->columnWords, .columnWords = s->columnWords, .row = r};
+	}
+	qsort(order, n, sizeof(PairRowKey), byPairRowColumns);
+
+	PairCluster *clusters;
+	NEW(clusters, n);
+	uint64_t *columns;
+	NEW(columns, n * s->columnWords);
+	glyphclass_t *next, *owner;
+	NEW(next, n);
+	NEW(owner, n);
+	for (glyphclass_t j = 0; j < n; j++) {
+		glyphclass_t r = order[j].row;
+		PairCluster *c = &clusters[j];
+		c->alive = true;
+		c->rows = 1;
+		c->glyphs = s->rowGlyphs[r];
+		c->ranges = s->rowRanges[r];
+		c->maxRanges = s->rowRanges[r];
+		c->format1 = s->rowFormat1[r];
+		c->format2 = s->rowFormat2[r];
+		c->pairs = s->rowPairs[r];
+		c->columns = columns + j * s->columnWords;
+		memcpy(c->columns, order[j].columns, s->columnWords * sizeof(uint64_t));
+		c->size = estimatePairClusterSize(s, c, NULL);
+		next[j] = j + 1;
+		owner[j] = j;
+	}
+
+	// Size of the unsplit subtable, for the final comparison
+	PairCluster whole = clusters[0];
+	NEW(whole.columns, s->columnWords);
+	memcpy(whole.columns, clusters[0].columns, s->columnWords * sizeof(uint64_t));
+	for (glyphclass_t j = 1; j < n; j++) {
+		PairCluster c = clusters[j];
+		mergePairCluster(s, &whole, &c);
+	}
+	size_t wholeSize = estimatePairClusterSize(s, &whole, NULL);
+	FREE(whole.columns);
+
+	PairMergeHeap heap = {0, 0, NULL};
+	glyphclass_t *prev;
+	NEW(prev, n);
+	for (glyphclass_t j = 0; j < n; j++) {
+		prev[j] = j ? j - 1 : n;
+		for (glyphclass_t k = j + 1; k < n && k <= j + PAIR_MERGE_WINDOW; k++) {
+			proposePairMerge(s, clusters, &heap, j, k);
+		}
+	}
+	while (heap.length) {
+		PairMerge m = popPairMerge(&heap);
+		PairCluster *a = &clusters[m.left];
+		PairCluster *b = &clusters[m.right];
+		if (!a->alive || !b->alive || a->version != m.leftVersion ||
+		    b->version != m.rightVersion) {
+			continue;
+		}
+		mergePairCluster(s, a, b);
+		a->size = estimatePairClusterSize(s, a, NULL);
+		a->version++;
+		owner[m.right] = m.left;
+		if (prev[m.right] < n) next[prev[m.right]] = next[m.right];
+		if (next[m.right] < n) prev[next[m.right]] = prev[m.right];
+		// The merged cluster needs new candidates among its neighbours
+		glyphclass_t k = m.left;
+		for (uint8_t w = 0; w < PAIR_MERGE_WINDOW && prev[k] < n; w++) {
+			k = prev[k];
+			proposePairMerge(s, clusters, &heap, k, m.left);
+		}
+		k = m.left;
+		for (uint8_t w = 0; w < PAIR_MERGE_WINDOW && next[k] < n; w++) {
+			k = next[k];
+			proposePairMerge(s, clusters, &heap, m.left, k);
+		}
+	}
+	FREE(heap.items);
+	FREE(prev);
+
+	// Number the surviving clusters in the order of their first rows
+	glyphclass_t *clusterOfRow;
+	NEW(clusterOfRow, s->class1Count);
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		clusterOfRow[r] = s->class1Count;
+	}
+	for (glyphclass_t j = 0; j < n; j++) {
+		glyphclass_t root = j;
+		while (owner[root] != root) {
+			root = owner[root];
+		}
+		owner[j] = root;
+		clusterOfRow[order[j].row] = root;
+	}
+	glyphclass_t *renumber;
+	NEW(renumber, n);
+	for (glyphclass_t j = 0; j < n; j++) {
+		renumber[j] = n;
+	}
+	glyphclass_t m = 0;
+	size_t totalSize = 0;
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		glyphclass_t c = clusterOfRow[r];
+		if (c == s->class1Count) continue;
+		if (renumber[c] == n) {
+			renumber[c] = m++;
+			totalSize += clusters[c].size;
+		}
+		clusterOfRow[r] = renumber[c];
+	}
+	FREE(renumber);
+	FREE(owner);
+	FREE(next);
+	FREE(order);
+	FREE(columns);
+	FREE(clusters);
+	if (m < 2 || totalSize >= wholeSize) {
+		FREE(clusterOfRow);
+		return NULL;
+	}
+	*clusterCount = m;
+	return clusterOfRow;
+}
+
+// Derive the subtable of one cluster. The class with the most ranges becomes class 0 and is
+// left out of ClassDef1; second classes the cluster does not need fold into class 0 but stay
+// listed, so that format 1 still sees their glyphs.
+static subtable_gpos_pair *derivePairCluster(const subtable_gpos_pair *subtable,
+                                             const PairSplitStat *s, const PairFirstGlyphs *fg,
+                                             const glyphclass_t *clusterOfRow,
+                                             glyphclass_t cluster) {
+	glyphclass_t zeroRow = s->class1Count;
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (clusterOfRow[r] != cluster) continue;
+		if (zeroRow == s->class1Count || s->rowRanges[r] > s->rowRanges[zeroRow]) zeroRow = r;
+	}
+	glyphclass_t *newRow;
+	NEW(newRow, s->class1Count);
+	glyphclass_t rows = 1;
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (clusterOfRow[r] == cluster && r != zeroRow) newRow[r] = rows++;
+	}
+	uint64_t *needed;
+	NEW(needed, s->columnWords);
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (clusterOfRow[r] != cluster) continue;
+		for (size_t w = 0; w < s->columnWords; w++) {
+			needed[w] |= s->rowColumns[r * s->columnWords + w];
+		}
+	}
+	glyphclass_t *newColumn;
+	NEW(newColumn, s->class2Count);
+	glyphclass_t columns = 1;
+	for (glyphclass_t k = 1; k < s->class2Count; k++) {
+		if (needed[k / 64] & ((uint64_t)1 << (k % 64))) newColumn[k] = columns++;
+	}
+	FREE(needed);
+
+	subtable_gpos_pair *derived = iSubtable_gpos_pair.create();
+	derived->first = ClassDef.create();
+	for (glyphid_t j = 0; j < fg->cov->numGlyphs; j++) {
+		if (clusterOfRow[fg->classes[j]] != cluster) continue;
+		ClassDef.push(derived->first, Handle.dup(fg->cov->glyphs[j]), newRow[fg->classes[j]]);
+	}
+	derived->first->maxclass = rows - 1;
+	derived->second = ClassDef.create();
+	for (glyphid_t k = 0; k < subtable->second->numGlyphs; k++) {
+		ClassDef.push(derived->second, Handle.dup(subtable->second->glyphs[k]),
+		              newColumn[subtable->second->classes[k]]);
+	}
+	derived->second->maxclass = columns - 1;
+
+	NEW(derived->firstValues, rows);
+	NEW(derived->secondValues, rows);
+	for (glyphclass_t j = 0; j < rows; j++) {
+		NEW(derived->firstValues[j], columns);
+		NEW(derived->secondValues[j], columns);
+	}
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (clusterOfRow[r] != cluster) continue;
+		glyphclass_t j = (r == zeroRow) ? 0 : newRow[r];
+		for (glyphclass_t k = 0; k < s->class2Count; k++) {
+			if (k && !newColumn[k]) continue;
+			derived->firstValues[j][newColumn[k]] = subtable->firstValues[r][k];
+			derived->secondValues[j][newColumn[k]] = subtable->secondValues[r][k];
+		}
+	}
+	FREE(newRow);
+	FREE(newColumn);
+	return derived;
+}
+
+// Split the non-empty first classes into two halves of about the same weight, for a
+// subtable too large to be packed. Returns NULL when there is a single class.
+static glyphclass_t *bisectPairRows(const PairSplitStat *s) {
+	size_t total = 0;
+	glyphclass_t rows = 0;
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (!s->rowGlyphs[r]) continue;
+		total += s->rowPairs[r] + s->class2Count;
+		rows += 1;
+	}
+	if (rows < 2) return NULL;
+	glyphclass_t *halfOfRow;
+	NEW(halfOfRow, s->class1Count);
+	size_t weight = 0;
+	glyphclass_t seen = 0;
+	for (glyphclass_t r = 0; r < s->class1Count; r++) {
+		if (!s->rowGlyphs[r]) {
+			halfOfRow[r] = s->class1Count;
+			continue;
+		}
+		bool firstHalf = seen == 0 || (seen < rows - 1 && 2 * weight < total);
+		halfOfRow[r] = firstHalf ? 0 : 1;
+		weight += s->rowPairs[r] + s->class2Count;
+		seen += 1;
+	}
+	return halfOfRow;
+}
+
+typedef struct {
+	tableid_t length;
+	tableid_t capacity;
+	caryll_Buffer **items;
+} PairBufferList;
+
+static void pushPairBuffer(PairBufferList *list, caryll_Buffer *buf) {
+	if (list->length >= list->capacity) {
+		list->capacity += list->capacity / 2 + 4;
+		RESIZE(list->items, list->capacity);
+	}
+	list->items[list->length++] = buf;
+}
+
+// Build a subtable. As a last resort, when its offsets cannot be packed, its first classes
+// are bisected and each half is built as a subtable of its own.
+static void buildPairSubtableSplitting(const subtable_gpos_pair *subtable, PairBufferList *out) {
+	bool packed;
+	caryll_Buffer *buf = buildPairSubtable(subtable, &packed);
+	if (packed) {
+		pushPairBuffer(out, buf);
+		return;
+	}
+	PairMatrixStat stat = statPairMatrix(subtable);
+	PairFirstGlyphs fg = collectFirstGlyphs(subtable);
+	PairSplitStat s = statPairSplit(subtable, &stat, &fg);
+	glyphclass_t *halfOfRow = bisectPairRows(&s);
+	if (halfOfRow) {
+		buffree(buf);
+		for (glyphclass_t half = 0; half < 2; half++) {
+			subtable_gpos_pair *derived = derivePairCluster(subtable, &s, &fg, halfOfRow, half);
+			buildPairSubtableSplitting(derived, out);
+			iSubtable_gpos_pair.free(derived);
+		}
+		FREE(halfOfRow);
+	} else {
+		pushPairBuffer(out, buf);
+	}
+	disposePairSplitStat(&s);
+	disposeFirstGlyphs(&fg);
+	disposePairMatrixStat(&stat);
+}
+
+static void splitBuildGposPair(const subtable_gpos_pair *subtable, otl_BuildHeuristics heuristics,
+                               PairBufferList *out) {
+	glyphclass_t *clusterOfRow = NULL;
+	glyphclass_t clusterCount = 0;
+	PairMatrixStat stat;
+	PairFirstGlyphs fg;
+	PairSplitStat s;
+	if (heuristics & OTL_BH_GPOS_SPLIT_PAIRS) {
+		stat = statPairMatrix(subtable);
+		fg = collectFirstGlyphs(subtable);
+		s = statPairSplit(subtable, &stat, &fg);
+		clusterOfRow = clusterPairRows(&s, &clusterCount);
+	}
+	if (clusterOfRow) {
+		for (glyphclass_t c = 0; c < clusterCount; c++) {
+			subtable_gpos_pair *derived = derivePairCluster(subtable, &s, &fg, clusterOfRow, c);
+			buildPairSubtableSplitting(derived, out);
+			iSubtable_gpos_pair.free(derived);
+		}
+		FREE(clusterOfRow);
+	} else {
+		buildPairSubtableSplitting(subtable, out);
+	}
+	if (heuristics & OTL_BH_GPOS_SPLIT_PAIRS) {
+		disposePairSplitStat(&s);
+		disposeFirstGlyphs(&fg);
+		disposePairMatrixStat(&stat);
+	}
+}
+
+tableid_t otfcc_splitBuildGposPair(const otl_Subtable *_subtable, otl_BuildHeuristics heuristics,
+                                   OUT caryll_Buffer ***pieces) {
+	PairBufferList out = {0, 0, NULL};
+	splitBuildGposPair(&(_subtable->gpos_pair), heuristics, &out);
+	*pieces = out.items;
+	return out.length;
 }
@@ -9,5 +9,9 @@ otl_Subtable *otl_read_gpos_pair(const font_file_pointer data, uint32_t tableLen
 json_value *otl_gpos_dump_pair(const otl_Subtable *_subtable);
 otl_Subtable *otl_gpos_parse_pair(const json_value *_subtable, const otfcc_Options *options);
 caryll_Buffer *otfcc_build_gpos_pair(const otl_Subtable *_subtable, otl_BuildHeuristics heuristics);
+// Build a pair subtable into one or more pieces. A subtable too large to be packed is split;
+// with OTL_BH_GPOS_SPLIT_PAIRS, class kerning is also split to minimize the total size.
+tableid_t otfcc_splitBuildGposPair(const otl_Subtable *_subtable, otl_BuildHeuristics heuristics,
+                                   OUT caryll_Buffer ***pieces);
 
 #endif
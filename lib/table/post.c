@@ -124,14 +124,14 @@ caryll_Buffer *otfcc_buildPost(const table_post *post, otfcc_GlyphOrder *glyphor
 	bufwrite32b(buf, post->minMemType1);
 	bufwrite32b(buf, post->maxMemType1);
 	if (post->version == 0x20000) {
-		bufwrite16b(buf, HASH_CNT(hhName, glyphorder->byName));
+		bufwrite16b(buf, glyphorder->length);
 		// Since the glyphorder is already sorted using the "real" glyph order
 		// we can simply write down the glyph names.
-		otfcc_GlyphOrderEntry *s, *tmp;
-		HASH_ITER(hhName, glyphorder->byName, s, tmp) {
-			bufwrite16b(buf, 258 + s->gid);
+		for (uint32_t j = 0; j < glyphorder->length; j++) {
+			bufwrite16b(buf, 258 + glyphorder->entries[j]->gid);
 		}
-		HASH_ITER(hhName, glyphorder->byName, s, tmp) {
+		for (uint32_t j = 0; j < glyphorder->length; j++) {
+			otfcc_GlyphOrderEntry *s = glyphorder->entries[j];
 			bufwrite8(buf, sdslen(s->name));
 			bufwrite_sds(buf, s->name);
 		}
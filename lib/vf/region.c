@@ -19,9 +19,11 @@ vq_Region *vq_copyRegion(const vq_Region *region) {
 }
 
 int vq_compareRegion(const vq_Region *a, const vq_Region *b) {
+	if (a == b) return 0;
+	if (a->id && b->id) return a->id < b->id ? -1 : a->id > b->id ? 1 : 0;
 	if (a->dimensions < b->dimensions) return -1;
 	if (a->dimensions > b->dimensions) return 1;
-	return strncmp((const char *)a, (const char *)b, VQ_REGION_SIZE(a->dimensions));
+	return memcmp(VQ_REGION_KEY(a), VQ_REGION_KEY(b), VQ_REGION_KEY_SIZE(a->dimensions));
 }
 
 bool vq_AxisSpanIsOne(const vq_AxisSpan *s) {
@@ -51,9 +53,9 @@ static pos_t INLINE weightAxisRegion(const vq_AxisSpan *as, const pos_t x) {
 		return (z - x) / (z - p);
 	}
 }
-pos_t vqRegionGetWeight(const vq_Region *r, const VV *v) {
+pos_t vq_regionGetWeight(const vq_Region *r, const VV *v) {
 	pos_t w = 1;
-	for (size_t j = 0; j < r->dimensions && v->length; j++) {
+	for (size_t j = 0; j < r->dimensions && j < v->length; j++) {
 		w *= weightAxisRegion(&r->spans[j], v->items[j]);
 	}
 	return w;
@@ -21,25 +21,13 @@ caryll_VectorInterfaceTypeName(VV) iVV = {
 // VQS
 static INLINE void initVQSegment(vq_Segment *vqs) {
 	vqs->type = VQ_STILL;
+	vqs->touched = false;
 	vqs->val.still = 0;
 }
 static INLINE void copyVQSegment(vq_Segment *dst, const vq_Segment *src) {
-	dst->type = src->type;
-	switch (dst->type) {
-		case VQ_STILL:
-			dst->val.still = src->val.still;
-			break;
-		case VQ_DELTA:
-			dst->val.delta.quantity = src->val.delta.quantity;
-			dst->val.delta.region = src->val.delta.region;
-	}
+	*dst = *src;
 }
 static INLINE void disposeVQSegment(vq_Segment *vqs) {
-	switch (vqs->type) {
-		case VQ_DELTA:
-			break;
-		default:;
-	}
 	initVQSegment(vqs);
 }
 
@@ -59,6 +47,10 @@ static vq_Segment vqsCreateDelta(pos_t delta, vq_Region *region) {
 	return vqs;
 }
 
+// Regions of a font are interned, so the same region is mostly the same pointer.
+static INLINE int compareRegion(const vq_Region *a, const vq_Region *b) {
+	return a == b ? 0 : vq_compareRegion(a, b);
+}
 static int vqsCompare(const vq_Segment a, const vq_Segment b) {
 	if (a.type < b.type) return -1;
 	if (a.type > b.type) return 1;
@@ -69,13 +61,14 @@ static int vqsCompare(const vq_Segment a, const vq_Segment b) {
 			return 0;
 		}
 		case VQ_DELTA: {
-			int vqrc = vq_compareRegion(a.val.delta.region, b.val.delta.region);
+			int vqrc = compareRegion(a.val.delta.region, b.val.delta.region);
 			if (vqrc) return vqrc;
 			if (a.val.delta.quantity < b.val.delta.quantity) return -1;
 			if (a.val.delta.quantity > b.val.delta.quantity) return 1;
 			return 0;
 		}
 	}
+	return 0;
 }
 caryll_OrdEqFns(vq_Segment, vqsCompare);
 static void showVQS(const vq_Segment x) {
@@ -84,7 +77,7 @@ static void showVQS(const vq_Segment x) {
 			fprintf(stderr, "%g", x.val.still);
 			return;
 		case VQ_DELTA:
-			fprintf(stderr, "{%g%s", x.val.delta.quantity, x.val.delta.touched ? " " : "* ");
+			fprintf(stderr, "{%g%s", x.val.delta.quantity, x.touched ? " " : "* ");
 			vq_showRegion(x.val.delta.region);
 			fprintf(stderr, "}\n");
 			return;
@@ -104,19 +97,70 @@ caryll_ElementInterfaceOf(vq_Segment) vq_iSegment = {
 
 caryll_standardVectorImpl(vq_SegList, vq_Segment, vq_iSegment, vq_iSegList);
 
+// Shift storage
+
+static INLINE bool onHeap(const VQ *v) {
+	return v->shift.heap.form == VQ_SHIFT_HEAP;
+}
+static INLINE vq_Segment *segmentsOf(VQ *v) {
+	return onHeap(v) ? v->shift.heap.items : &v->shift.inlined;
+}
+// Sets the length of the shift, whose segments are in place. An inline segment marks itself by
+// its type, so only the other forms are written.
+static INLINE void setShiftLength(MODIFY VQ *v, uint32_t n) {
+	if (onHeap(v)) {
+		v->shift.heap.length = n;
+	} else if (!n) {
+		v->shift.heap.form = VQ_SHIFT_EMPTY;
+	}
+}
+// Makes room for n segments, moving them to the heap once they outgrow the VQ.
+static void reserveSegments(MODIFY VQ *v, uint32_t n) {
+	uint32_t capacity = onHeap(v) ? v->shift.heap.capacity : 1;
+	if (n <= capacity) return;
+	while (capacity < n)
+		capacity *= 2;
+	if (onHeap(v)) {
+		RESIZE(v->shift.heap.items, capacity);
+	} else {
+		uint32_t length = vq_shiftLength(v);
+		vq_Segment *items;
+		NEW_DIRTY_N(items, capacity);
+		if (length) items[0] = v->shift.inlined;
+		v->shift.heap.form = VQ_SHIFT_HEAP;
+		v->shift.heap.length = length;
+		v->shift.heap.items = items;
+	}
+	v->shift.heap.capacity = capacity;
+}
+static INLINE void pushSegment(MODIFY VQ *v, const vq_Segment s) {
+	uint32_t length = vq_shiftLength(v);
+	reserveSegments(v, length + 1);
+	segmentsOf(v)[length] = s;
+	setShiftLength(v, length + 1);
+}
+
 // Monoid
 
 static INLINE void vqInit(VQ *a) {
 	a->kernel = 0;
-	vq_iSegList.init(&a->shift);
+	a->shift.heap.form = VQ_SHIFT_EMPTY;
 }
 static INLINE void vqCopy(VQ *a, const VQ *b) {
+	vqInit(a);
 	a->kernel = b->kernel;
-	vq_iSegList.copy(&a->shift, &b->shift);
+	if (!onHeap(b)) {
+		a->shift = b->shift;
+		return;
+	}
+	uint32_t length = vq_shiftLength(b);
+	reserveSegments(a, length);
+	memcpy(segmentsOf(a), vq_segments(b), sizeof(vq_Segment) * length);
+	setShiftLength(a, length);
 }
 static INLINE void vqDispose(VQ *a) {
-	a->kernel = 0;
-	vq_iSegList.dispose(&a->shift);
+	if (onHeap(a)) FREE(a->shift.heap.items);
+	vqInit(a);
 }
 
 caryll_standardValTypeFn(VQ, vqInit, vqCopy, vqDispose);
@@ -129,43 +173,65 @@ static bool vqsCompatible(const vq_Segment a, const vq_Segment b) {
 		case VQ_STILL:
 			return true;
 		case VQ_DELTA:
-			return 0 == vq_compareRegion(a.val.delta.region, b.val.delta.region);
+			return 0 == compareRegion(a.val.delta.region, b.val.delta.region);
 	}
+	return false;
 }
+// Sorts the shift and sums up the segments on each region. Shifts are short, so insertion sort
+// does better than qsort for them.
 static void simplifyVq(MODIFY VQ *x) {
-	if (!x->shift.length) return;
-	vq_iSegList.sort(&x->shift, vq_iSegment.compareRef);
-	size_t k = 0;
-	for (size_t j = 1; j < x->shift.length; j++) {
-		if (vqsCompatible(x->shift.items[k], x->shift.items[j])) {
-			switch (x->shift.items[k].type) {
+	uint32_t n = vq_shiftLength(x);
+	if (n < 2) return;
+	vq_Segment *s = segmentsOf(x);
+	if (n > 16) {
+		qsort(s, n, sizeof(vq_Segment), (int (*)(const void *, const void *))vq_iSegment.compareRef);
+	} else {
+		for (uint32_t j = 1; j < n; j++) {
+			vq_Segment t = s[j];
+			uint32_t k = j;
+			for (; k > 0 && vqsCompare(s[k - 1], t) > 0; k--) {
+				s[k] = s[k - 1];
+			}
+			s[k] = t;
+		}
+	}
+	uint32_t k = 0;
+	for (uint32_t j = 1; j < n; j++) {
+		if (vqsCompatible(s[k], s[j])) {
+			switch (s[k].type) {
 				case VQ_STILL:
-					x->shift.items[k].val.still += x->shift.items[j].val.still;
+					s[k].val.still += s[j].val.still;
 					break;
 				case VQ_DELTA:
-					x->shift.items[k].val.delta.quantity += x->shift.items[j].val.delta.quantity;
+					s[k].val.delta.quantity += s[j].val.delta.quantity;
 					break;
 			}
-			vq_iSegment.dispose(&x->shift.items[j]);
 		} else {
-			x->shift.items[k] = x->shift.items[j];
 			k++;
+			s[k] = s[j];
 		}
 	}
-	x->shift.length = k + 1;
+	setShiftLength(x, k + 1);
 }
-static void vqInplacePlus(MODIFY VQ *a, const VQ b) {
-	a->kernel += b.kernel;
-	for (size_t p = 0; p < b.shift.length; p++) {
-		vq_Segment *k = &b.shift.items[p];
-		if (k->type == VQ_STILL) {
-			a->kernel += k->val.still;
+// Adds b scaled by k to a, leaving a to be simplified.
+static void vqInplacePlusScaled(MODIFY VQ *a, pos_t k, const VQ *b) {
+	a->kernel += k * b->kernel;
+	uint32_t n = vq_shiftLength(b);
+	if (!n) return;
+	reserveSegments(a, vq_shiftLength(a) + n);
+	const vq_Segment *segments = vq_segments(b);
+	for (uint32_t p = 0; p < n; p++) {
+		if (segments[p].type == VQ_STILL) {
+			a->kernel += k * segments[p].val.still;
 		} else {
-			vq_Segment s;
-			vq_iSegment.copy(&s, k);
-			vq_iSegList.push(&a->shift, s);
+			vq_Segment s = segments[p];
+			s.val.delta.quantity *= k;
+			pushSegment(a, s);
 		}
 	}
+}
+static void vqInplacePlus(MODIFY VQ *a, const VQ b) {
+	vqInplacePlusScaled(a, 1, &b);
 	simplifyVq(a);
 }
 
@@ -174,8 +240,9 @@ caryll_MonoidFns(VQ, vqNeutral, vqInplacePlus);
 // Module
 static void vqInplaceScale(MODIFY VQ *a, pos_t b) {
 	a->kernel *= b;
-	for (size_t j = 0; j < a->shift.length; j++) {
-		vq_Segment *s = &a->shift.items[j];
+	vq_Segment *segments = segmentsOf(a);
+	for (uint32_t j = 0; j < vq_shiftLength(a); j++) {
+		vq_Segment *s = &segments[j];
 		switch (s->type) {
 			case VQ_STILL:
 				s->val.still *= b;
@@ -197,10 +264,13 @@ caryll_ModuleFns(VQ, pos_t, vqInplaceScale);
 
 // Ord
 static int vqCompare(const VQ a, const VQ b) {
-	if (a.shift.length < b.shift.length) return -1;
-	if (a.shift.length > b.shift.length) return 1;
-	for (size_t j = 0; j < a.shift.length; j++) {
-		int cr = vqsCompare(a.shift.items[j], b.shift.items[j]);
+	uint32_t n = vq_shiftLength(&a);
+	if (n < vq_shiftLength(&b)) return -1;
+	if (n > vq_shiftLength(&b)) return 1;
+	const vq_Segment *sa = vq_segments(&a);
+	const vq_Segment *sb = vq_segments(&b);
+	for (uint32_t j = 0; j < n; j++) {
+		int cr = vqsCompare(sa[j], sb[j]);
 		if (cr) return cr;
 	}
 	return a.kernel - b.kernel;
@@ -210,9 +280,10 @@ caryll_OrdEqFns(VQ, vqCompare);
 // Show
 static void showVQ(const VQ x) {
 	fprintf(stderr, "%g + {", x.kernel);
-	for (size_t j = 0; j < x.shift.length; j++) {
+	const vq_Segment *segments = vq_segments(&x);
+	for (uint32_t j = 0; j < vq_shiftLength(&x); j++) {
 		if (j) fprintf(stderr, " ");
-		vq_iSegment.show(x.shift.items[j]);
+		vq_iSegment.show(segments[j]);
 	}
 	fprintf(stderr, "}\n");
 }
@@ -221,10 +292,11 @@ caryll_ShowFns(VQ, showVQ);
 // Still instances
 static pos_t vqGetStill(const VQ v) {
 	pos_t result = v.kernel;
-	for (size_t j = 0; j < v.shift.length; j++) {
-		switch (v.shift.items[j].type) {
+	const vq_Segment *segments = vq_segments(&v);
+	for (uint32_t j = 0; j < vq_shiftLength(&v); j++) {
+		switch (segments[j].type) {
 			case VQ_STILL:
-				result += v.shift.items[j].val.still;
+				result += segments[j].val.still;
 			default:;
 		}
 	}
@@ -237,8 +309,9 @@ static VQ vqCreateStill(pos_t x) {
 	return vq;
 }
 static bool vqIsStill(const VQ v) {
-	for (size_t j = 0; j < v.shift.length; j++) {
-		switch (v.shift.items[j].type) {
+	const vq_Segment *segments = vq_segments(&v);
+	for (uint32_t j = 0; j < vq_shiftLength(&v); j++) {
+		switch (segments[j].type) {
 			case VQ_STILL:
 				break;
 			default:
@@ -255,17 +328,22 @@ static void vqAddDelta(MODIFY VQ *v, const bool touched, const vq_Region *const
 	if (!quantity) return;
 	vq_Segment nudge;
 	nudge.type = VQ_DELTA;
+	nudge.touched = touched;
 	nudge.val.delta.region = r;
-	nudge.val.delta.touched = touched;
 	nudge.val.delta.quantity = quantity;
-	vq_iSegList.push(&v->shift, nudge);
+	pushSegment(v, nudge);
+}
+static void vqAddSegment(MODIFY VQ *v, MOVE vq_Segment s) {
+	pushSegment(v, s);
 }
 
 // pointLinearTfm
 static VQ vqPointLinearTfm(const VQ ax, pos_t a, const VQ x, pos_t b, const VQ y) {
-	VQ targetX = iVQ.dup(ax);
-	iVQ.inplacePlusScale(&targetX, a, x);
-	iVQ.inplacePlusScale(&targetX, b, y);
+	VQ targetX;
+	vqCopy(&targetX, &ax);
+	vqInplacePlusScaled(&targetX, a, &x);
+	vqInplacePlusScaled(&targetX, b, &y);
+	simplifyVq(&targetX);
 	return targetX;
 }
 
@@ -281,5 +359,6 @@ caryll_VectorInterfaceTypeName(VQ) iVQ = {
     caryll_OrdEqAssigns(VQ),            // Eq-Ord
     caryll_ShowAssigns(VQ),             // Show
     .pointLinearTfm = vqPointLinearTfm, // pointLinearTfm
-    .addDelta = vqAddDelta              // addDelta
+    .addDelta = vqAddDelta,             // addDelta
+    .addSegment = vqAddSegment,
 };
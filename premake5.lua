@@ -26,6 +26,8 @@ function cbuildoptions()
 		buildoptions { '-std=gnu11', '-Wall', '-Wno-multichar', '-fPIC' }
 		linkoptions  { '-fPIC' }
 		links "m"
+	filter {"system:not windows", "action:gmake or action:xcode4 or action:ninja"}
+		links "pthread"
 	filter {}
 end
 
@@ -184,3 +186,17 @@ project "otfccdll"
 		"src/otfccdump.c",
 		"src/otfccbuild.c"
 	}
+
+project "cffbench"
+	kind "ConsoleApp"
+	language "C"
+	cbuildoptions()
+	targetdir "bin/%{cfg.buildcfg}-%{cfg.platform}"
+
+	links { "libotfcc", "deps" }
+	includedirs { "lib" }
+
+	files {
+		"bench/**.c",
+		"bench/**.h"
+	}
@@ -2,9 +2,8 @@
 #define CARYLL_SRC_ALIASES_H
 
 #define loggedStep(...)                                                                                                \
-	for (bool ___loggedstep_v =                                                                                        \
-	              (options->logger->startSDS(options->logger, sdscatprintf(sdsempty(), __VA_ARGS__)), true);           \
-	     ___loggedstep_v; ___loggedstep_v = false, options->logger->finish(options->logger))
+	for (bool ___loggedstep_v = (otfcc_beginStep(options, sdscatprintf(sdsempty(), __VA_ARGS__)), true);             \
+	     ___loggedstep_v; ___loggedstep_v = false, otfcc_endStep(options))
 #define logError(...)                                                                                                  \
 	options->logger->logSDS(options->logger, log_vl_critical, log_type_error, sdscatprintf(sdsempty(), __VA_ARGS__));
 #define logWarning(...)                                                                                                \
@@ -1,6 +1,9 @@
+#include <errno.h>
+
 #include "otfcc/sfnt.h"
 #include "otfcc/font.h"
 #include "otfcc/sfnt-builder.h"
+#include "otfcc/memory.h"
 
 #include "aliases.h"
 #include "platform.h"
@@ -40,6 +43,7 @@ void printHelp() {
 	        "                               --merge-features\n"
 	        "                               --short-post\n"
 	        "                               --subroutinize\n"
+	        "                               --split-kerning\n"
 	        "     -O3                     Most aggressive opptimization strategy will be\n"
 	        "                             used. In this level, these options will be set:\n"
 	        "                               --force-cid\n"
@@ -64,10 +68,39 @@ void printHelp() {
 	        " --dont-merge-lookups      : Keep duplicate OpenType lookups.\n"
 	        " --force-cid               : Convert name-keyed CFF OTF into CID-keyed.\n"
 	        " --subroutinize            : Subroutinize CFF table.\n"
+	        " --split-kerning           : Split class kerning into smaller GPOS subtables.\n"
+	        " --dont-split-kerning      : Keep each class kerning subtable as-is.\n"
 	        " --stub-cmap4              : Create a stub `cmap` format 4 subtable if format\n"
 	        "                             12 subtable is present.\n"
+	        " --threads <n>             : Use <n> worker threads when building. Default is\n"
+	        "                             the number of processors.\n"
+	        " --trace <file>            : Write a Chrome trace of the pipeline stages to\n"
+	        "                             <file>, for chrome://tracing or Perfetto.\n"
+	        " --memory-stats            : Report memory used by each subsystem at exit.\n"
+	        " --font-region             : Keep the font in a region of its own, released at\n"
+	        "                             once instead of object by object.\n"
+	        " --subset <list>           : Keep only the glyphs needed for <list>, like\n"
+	        "                             \"U+41-5A,U+E9,/ampersand\": code points in hex,\n"
+	        "                             ranges of them and glyph names after a slash.\n"
+	        "                             AGLFN names also match by code point.\n"
+	        " --woff                    : Write a WOFF web font instead of a bare OpenType\n"
+	        "                             font. Tables are compressed in parallel.\n"
+	        " --woff2                   : Write a WOFF2 web font, with glyf, loca and hmtx\n"
+	        "                             transformed and the tables Brotli-compressed.\n"
+	        " --include-tables <list>   : Read and build only the tables of <list>, like\n"
+	        "                             \"cmap,hmtx\", named as in the JSON dump.\n"
+	        " --exclude-tables <list>   : Neither read nor build the tables of <list>.\n"
 	        "\n");
 }
+// The parsed DOM goes to the JSON allocator, where the reader expects it; this also lets it
+// show up in --memory-stats.
+static void *jsonAlloc(size_t size, int zero, void *userData) {
+	return otfcc_allocateJson(size, zero);
+}
+static void jsonFree(void *ptr, void *userData) {
+	otfcc_deallocateJson(ptr);
+}
+
 void readEntireFile(char *inPath, char **_buffer, long *_length) {
 	char *buffer = NULL;
 	long length = 0;
@@ -129,8 +162,13 @@ int main(int argc, char *argv[]) {
 
 	bool show_help = false;
 	bool show_version = false;
+	bool show_memory_stats = false;
+	bool write_woff = false;
+	bool write_woff2 = false;
 	sds outputPath = NULL;
 	sds inPath = NULL;
+	sds tracePath = NULL;
+	sds subsetList = NULL;
 	int option_index = 0;
 	int c;
 
@@ -156,6 +194,8 @@ int main(int argc, char *argv[]) {
 	                            {"short-post", no_argument, NULL, 0},
 	                            {"force-cid", no_argument, NULL, 0},
 	                            {"subroutinize", no_argument, NULL, 0},
+	                            {"split-kerning", no_argument, NULL, 0},
+	                            {"dont-split-kerning", no_argument, NULL, 0},
 	                            {"stub-cmap4", no_argument, NULL, 0},
 	                            {"dummy-dsig", no_argument, NULL, 's'},
 	                            {"ship", no_argument, NULL, 0},
@@ -163,6 +203,15 @@ int main(int argc, char *argv[]) {
 	                            {"quiet", no_argument, NULL, 0},
 	                            {"optimize", required_argument, NULL, 'O'},
 	                            {"output", required_argument, NULL, 'o'},
+	                            {"threads", required_argument, NULL, 0},
+	                            {"trace", required_argument, NULL, 0},
+	                            {"memory-stats", no_argument, NULL, 0},
+	                            {"font-region", no_argument, NULL, 0},
+	                            {"subset", required_argument, NULL, 0},
+	                            {"woff", no_argument, NULL, 0},
+	                            {"woff2", no_argument, NULL, 0},
+	                            {"include-tables", required_argument, NULL, 0},
+	                            {"exclude-tables", required_argument, NULL, 0},
 	                            {0, 0, 0, 0}};
 
 	while ((c = getopt_long(argc, argv, "vhqskiO:o:", longopts, &option_index)) != (-1)) {
@@ -200,6 +249,10 @@ int main(int argc, char *argv[]) {
 					options->force_cid = true;
 				} else if (strcmp(longopts[option_index].name, "subroutinize") == 0) {
 					options->cff_doSubroutinize = true;
+				} else if (strcmp(longopts[option_index].name, "split-kerning") == 0) {
+					options->split_kerning = true;
+				} else if (strcmp(longopts[option_index].name, "dont-split-kerning") == 0) {
+					options->split_kerning = false;
 				} else if (strcmp(longopts[option_index].name, "stub-cmap4") == 0) {
 					options->stub_cmap4 = true;
 				} else if (strcmp(longopts[option_index].name, "ship") == 0) {
@@ -210,6 +263,34 @@ int main(int argc, char *argv[]) {
 					options->verbose = true;
 				} else if (strcmp(longopts[option_index].name, "quiet") == 0) {
 					options->quiet = true;
+				} else if (strcmp(longopts[option_index].name, "threads") == 0) {
+					char *end = NULL;
+					errno = 0;
+					long threads = strtol(optarg, &end, 10);
+					if (errno || end == optarg || *end || threads < 0 || threads > UINT16_MAX) {
+						logError("Invalid thread count \"%s\". Exit.\n", optarg);
+						exit(EXIT_FAILURE);
+					}
+					options->threads = (uint16_t)threads;
+				} else if (strcmp(longopts[option_index].name, "trace") == 0) {
+					tracePath = sdsnew(optarg);
+				} else if (strcmp(longopts[option_index].name, "memory-stats") == 0) {
+					show_memory_stats = true;
+				} else if (strcmp(longopts[option_index].name, "font-region") == 0) {
+					options->font_region = true;
+				} else if (strcmp(longopts[option_index].name, "woff") == 0) {
+					write_woff = true;
+				} else if (strcmp(longopts[option_index].name, "woff2") == 0) {
+					write_woff2 = true;
+				} else if (strcmp(longopts[option_index].name, "subset") == 0) {
+					subsetList = sdscat(sdscat(subsetList ? subsetList : sdsempty(), ","), optarg);
+				} else if (strcmp(longopts[option_index].name, "include-tables") == 0 ||
+				           strcmp(longopts[option_index].name, "exclude-tables") == 0) {
+					bool exclude = longopts[option_index].name[0] == 'e';
+					if (!otfcc_Options_filterTables(options, optarg, exclude)) {
+						logError("Invalid table list \"%s\". Exit.\n", optarg);
+						exit(EXIT_FAILURE);
+					}
 				}
 				break;
 			case 'v':
@@ -240,6 +321,8 @@ int main(int argc, char *argv[]) {
 	}
 	options->logger->setVerbosity(options->logger,
 	                              options->quiet ? 0 : options->verbose ? 0xFF : 1);
+	if (tracePath) options->tracer = otfcc_newTracer();
+	if (show_memory_stats) otfcc_startMemoryAccounting();
 	if (show_help) {
 		printInfo();
 		printHelp();
@@ -249,6 +332,15 @@ int main(int argc, char *argv[]) {
 		printInfo();
 		return 0;
 	}
+	otfcc_RetainSet *retain = NULL;
+	if (subsetList) {
+		retain = otfcc_iRetainSet.create();
+		if (!otfcc_iRetainSet.parse(retain, subsetList)) {
+			logError("Invalid subset list \"%s\". Exit.\n", subsetList);
+			exit(EXIT_FAILURE);
+		}
+		sdsfree(subsetList);
+	}
 
 	if (optind >= argc) {
 		inPath = NULL; // read from STDIN
@@ -279,8 +371,11 @@ int main(int argc, char *argv[]) {
 	}
 
 	json_value *jsonRoot = NULL;
+	json_settings jsonSettings = {.mem_alloc = jsonAlloc, .mem_free = jsonFree};
 	loggedStep("Parse into JSON") {
-		jsonRoot = json_parse(buffer, length);
+		otfcc_enterMemoryTag(OTFCC_MEM_JSON);
+		jsonRoot = json_parse_ex(&jsonSettings, buffer, length, NULL);
+		otfcc_leaveMemoryTag();
 		free(buffer);
 		logStepTime;
 		if (!jsonRoot) {
@@ -298,16 +393,26 @@ int main(int argc, char *argv[]) {
 			exit(EXIT_FAILURE);
 		}
 		parser->free(parser);
-		json_value_free(jsonRoot);
+		json_value_free_ex(&jsonSettings, jsonRoot);
 		logStepTime;
 	}
 	loggedStep("Consolidate") {
 		otfcc_iFont.consolidate(font, options);
 		logStepTime;
 	}
+	if (retain) loggedStep("Subset") {
+		otfcc_iFont.subset(font, retain, options);
+		otfcc_iRetainSet.free(retain);
+		logStepTime;
+	}
 	loggedStep("Build") {
-		otfcc_IFontSerializer *writer = otfcc_newOTFWriter();
+		otfcc_IFontSerializer *writer = write_woff2  ? otfcc_newWOFF2Writer()
+		                                : write_woff ? otfcc_newWOFFWriter() : otfcc_newOTFWriter();
 		caryll_Buffer *otf = (caryll_Buffer *)writer->serialize(font, options);
+		if (!otf) {
+			logError("Cannot build the font. Exit.\n");
+			exit(EXIT_FAILURE);
+		}
 		loggedStep("Write to file") {
 			FILE *outfile = u8fopen(outputPath, "wb");
 			if (!outfile) {
@@ -320,6 +425,15 @@ int main(int argc, char *argv[]) {
 		logStepTime;
 		buffree(otf), writer->free(writer), otfcc_iFont.free(font), sdsfree(outputPath);
 	}
+	if (tracePath) {
+		FILE *tracefile = u8fopen(tracePath, "wb");
+		if (!tracefile || !otfcc_writeTrace(options->tracer, tracefile)) {
+			logWarning("Cannot write trace to file \"%s\".\n", tracePath);
+		}
+		if (tracefile) fclose(tracefile);
+		sdsfree(tracePath);
+	}
+	if (show_memory_stats) otfcc_writeMemoryStats(stderr);
 	otfcc_deleteOptions(options);
 
 	return 0;
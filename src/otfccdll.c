@@ -8,8 +8,11 @@
 #define OTFCC_DLL_EXPORT
 #endif
 
-OTFCC_DLL_EXPORT caryll_Buffer *otfccbuild_json_otf(uint32_t inlen, const char *injson, uint8_t olevel,
-                                                    bool for_webfont) {
+// Like otfccbuild_json_otf, keeping only the glyphs needed for `retain` (see otfcc/subset.h);
+// no subsetting is done when it is NULL.
+OTFCC_DLL_EXPORT caryll_Buffer *otfccbuild_json_otf_subset(uint32_t inlen, const char *injson,
+                                                           uint8_t olevel, bool for_webfont,
+                                                           const char *retain) {
 	otfcc_Options *options = otfcc_newOptions();
 	options->logger = otfcc_newLogger(otfcc_newEmptyTarget());
 	options->logger->indent(options->logger, "otfccbuild");
@@ -21,18 +24,37 @@ OTFCC_DLL_EXPORT caryll_Buffer *otfccbuild_json_otf(uint32_t inlen, const char *
 		options->force_cid = true;
 	}
 
+	otfcc_RetainSet *retainSet = NULL;
+	if (retain) {
+		retainSet = otfcc_iRetainSet.create();
+		if (!otfcc_iRetainSet.parse(retainSet, retain)) {
+			otfcc_iRetainSet.free(retainSet);
+			return NULL;
+		}
+	}
+
 	// json parsing
 	json_value *jsonRoot = json_parse(injson, inlen);
-	if (!jsonRoot) { return NULL; }
+	if (!jsonRoot) {
+		otfcc_iRetainSet.free(retainSet);
+		return NULL;
+	}
 	// font parsing
 	otfcc_IFontBuilder *parser = otfcc_newJsonReader();
 	otfcc_Font *font = parser->read(jsonRoot, 0, options);
 	parser->free(parser);
 	json_value_free(jsonRoot);
-	if (!font) { return NULL; }
+	if (!font) {
+		otfcc_iRetainSet.free(retainSet);
+		return NULL;
+	}
 
-	// consolidation and build
+	// consolidation, subsetting and build
 	otfcc_iFont.consolidate(font, options);
+	if (retainSet) {
+		otfcc_iFont.subset(font, retainSet, options);
+		otfcc_iRetainSet.free(retainSet);
+	}
 	otfcc_IFontSerializer *writer = otfcc_newOTFWriter();
 	caryll_Buffer *otf = (caryll_Buffer *)writer->serialize(font, options);
 
@@ -40,6 +62,10 @@ OTFCC_DLL_EXPORT caryll_Buffer *otfccbuild_json_otf(uint32_t inlen, const char *
 	otfcc_iFont.free(font);
 	return otf;
 }
+OTFCC_DLL_EXPORT caryll_Buffer *otfccbuild_json_otf(uint32_t inlen, const char *injson, uint8_t olevel,
+                                                    bool for_webfont) {
+	return otfccbuild_json_otf_subset(inlen, injson, olevel, for_webfont, NULL);
+}
 
 OTFCC_DLL_EXPORT size_t otfcc_get_buf_len(caryll_Buffer *buf) {
 	return buf->size;
@@ -1,6 +1,7 @@
 #include "dep/json-builder.h"
 #include "otfcc/sfnt.h"
 #include "otfcc/font.h"
+#include "otfcc/memory.h"
 
 #include "aliases.h"
 #include "platform.h"
@@ -43,6 +44,20 @@ void printHelp() {
 	        " --add-bom               : Add BOM mark in the output. (It is default on Windows\n"
 	        "                           when redirecting to another program. Use --no-bom to\n"
 	        "                           turn it off.)\n"
+	        " --trace <file>          : Write a Chrome trace of the pipeline stages to\n"
+	        "                           <file>, for chrome://tracing or Perfetto.\n"
+	        " --memory-stats          : Report memory used by each subsystem at exit.\n"
+	        " --font-region           : Keep the font in a region of its own, released at\n"
+	        "                           once instead of object by object.\n"
+	        " --subset <list>         : Keep only the glyphs needed for <list>, like\n"
+	        "                           \"U+41-5A,U+E9,/ampersand\": code points in hex,\n"
+	        "                           ranges of them and glyph names after a slash.\n"
+	        "                           AGLFN names also match by code point.\n"
+	        " --instance <location>   : Fix a variable font at <location>, like\n"
+	        "                           \"wght=700,wdth=87.5\", in the units of its axes.\n"
+	        " --include-tables <list> : Read and export only the tables of <list>, like\n"
+	        "                           \"cmap,glyf\", named as in the JSON dump.\n"
+	        " --exclude-tables <list> : Neither read nor export the tables of <list>.\n"
 	        "\n");
 }
 #ifdef _WIN32
@@ -58,6 +73,7 @@ int main(int argc, char *argv[]) {
 	bool show_version = false;
 	bool show_pretty = false;
 	bool show_ugly = false;
+	bool show_memory_stats = false;
 	bool add_bom = false;
 	bool no_bom = false;
 	uint32_t ttcindex = 0;
@@ -81,6 +97,13 @@ int main(int argc, char *argv[]) {
 	                            {"output", required_argument, NULL, 'o'},
 	                            {"ttc-index", required_argument, NULL, 'n'},
 	                            {"debug-wait-on-start", no_argument, NULL, 0},
+	                            {"trace", required_argument, NULL, 0},
+	                            {"memory-stats", no_argument, NULL, 0},
+	                            {"font-region", no_argument, NULL, 0},
+	                            {"subset", required_argument, NULL, 0},
+	                            {"instance", required_argument, NULL, 0},
+	                            {"include-tables", required_argument, NULL, 0},
+	                            {"exclude-tables", required_argument, NULL, 0},
 	                            {0, 0, 0, 0}};
 
 	otfcc_Options *options = otfcc_newOptions();
@@ -93,6 +116,9 @@ int main(int argc, char *argv[]) {
 
 	sds outputPath = NULL;
 	sds inPath = NULL;
+	sds tracePath = NULL;
+	sds subsetList = NULL;
+	sds instanceList = NULL;
 
 	while ((c = getopt_long(argc, argv, "vhqpio:n:", longopts, &option_index)) != (-1)) {
 		switch (c) {
@@ -129,6 +155,24 @@ int main(int argc, char *argv[]) {
 					options->glyph_name_prefix = strdup(optarg);
 				} else if (strcmp(longopts[option_index].name, "debug-wait-on-start") == 0) {
 					options->debug_wait_on_start = true;
+				} else if (strcmp(longopts[option_index].name, "trace") == 0) {
+					tracePath = sdsnew(optarg);
+				} else if (strcmp(longopts[option_index].name, "memory-stats") == 0) {
+					show_memory_stats = true;
+				} else if (strcmp(longopts[option_index].name, "font-region") == 0) {
+					options->font_region = true;
+				} else if (strcmp(longopts[option_index].name, "subset") == 0) {
+					subsetList = sdscat(sdscat(subsetList ? subsetList : sdsempty(), ","), optarg);
+				} else if (strcmp(longopts[option_index].name, "instance") == 0) {
+					instanceList =
+					    sdscat(sdscat(instanceList ? instanceList : sdsempty(), ","), optarg);
+				} else if (strcmp(longopts[option_index].name, "include-tables") == 0 ||
+				           strcmp(longopts[option_index].name, "exclude-tables") == 0) {
+					bool exclude = longopts[option_index].name[0] == 'e';
+					if (!otfcc_Options_filterTables(options, optarg, exclude)) {
+						logError("Invalid table list \"%s\". Exit.\n", optarg);
+						exit(EXIT_FAILURE);
+					}
 				}
 				break;
 			case 'v':
@@ -160,6 +204,8 @@ int main(int argc, char *argv[]) {
 	options->logger->setVerbosity(options->logger,
 	                              options->quiet ? 0 : options->verbose ? 0xFF : 1);
 
+	if (tracePath) options->tracer = otfcc_newTracer();
+	if (show_memory_stats) otfcc_startMemoryAccounting();
 	if (show_help) {
 		printInfo();
 		printHelp();
@@ -169,6 +215,24 @@ int main(int argc, char *argv[]) {
 		printInfo();
 		return 0;
 	}
+	otfcc_RetainSet *retain = NULL;
+	if (subsetList) {
+		retain = otfcc_iRetainSet.create();
+		if (!otfcc_iRetainSet.parse(retain, subsetList)) {
+			logError("Invalid subset list \"%s\". Exit.\n", subsetList);
+			exit(EXIT_FAILURE);
+		}
+		sdsfree(subsetList);
+	}
+	otfcc_Location *location = NULL;
+	if (instanceList) {
+		location = otfcc_iLocation.create();
+		if (!otfcc_iLocation.parse(location, instanceList)) {
+			logError("Invalid instance location \"%s\". Exit.\n", instanceList);
+			exit(EXIT_FAILURE);
+		}
+		sdsfree(instanceList);
+	}
 
 	if (optind >= argc) {
 		logError("Expected argument for input file name.\n");
@@ -211,10 +275,20 @@ int main(int argc, char *argv[]) {
 		if (sfnt) otfcc_deleteSFNT(sfnt);
 		logStepTime;
 	}
+	if (location) loggedStep("Instance") {
+		otfcc_iFont.instantiate(font, location, options);
+		otfcc_iLocation.free(location);
+		logStepTime;
+	}
 	loggedStep("Consolidate") {
 		otfcc_iFont.consolidate(font, options);
 		logStepTime;
 	}
+	if (retain) loggedStep("Subset") {
+		otfcc_iFont.subset(font, retain, options);
+		otfcc_iRetainSet.free(retain);
+		logStepTime;
+	}
 	json_value *root;
 	loggedStep("Dump") {
 		otfcc_IFontSerializer *dumper = otfcc_newJsonWriter();
@@ -305,6 +379,15 @@ int main(int argc, char *argv[]) {
 		if (outputPath) sdsfree(outputPath);
 		logStepTime;
 	}
+	if (tracePath) {
+		FILE *tracefile = u8fopen(tracePath, "wb");
+		if (!tracefile || !otfcc_writeTrace(options->tracer, tracefile)) {
+			logWarning("Cannot write trace to file \"%s\".\n", tracePath);
+		}
+		if (tracefile) fclose(tracefile);
+		sdsfree(tracePath);
+	}
+	if (show_memory_stats) otfcc_writeMemoryStats(stderr);
 	otfcc_deleteOptions(options);
 
 	return 0;
@@ -0,0 +1,131 @@
+// Pipeline benchmark.
+// Times every stage of otfccdump and otfccbuild, as recorded by --trace, over the payload
+// fonts and over synthetic fonts of growing size, and prints the median of each stage as CSV.
+// Usage : node tests/bench.js [--bin dir] [--reps R] [--sizes N1,N2,...] [--no-payload]
+var path = require('path');
+var fs = require('fs');
+var os = require('os');
+var childProcess = require('child_process');
+var syntheticFont = require('./synthetic-font');
+
+var args = { bin: 'bin/release-x64', reps: 5, sizes: '1000,4000,16000', payload: true };
+for (var j = 2; j < process.argv.length; j++) {
+	var a = process.argv[j];
+	if (a === '--bin') args.bin = process.argv[++j];
+	else if (a === '--reps') args.reps = +process.argv[++j];
+	else if (a === '--sizes') args.sizes = process.argv[++j];
+	else if (a === '--no-payload') args.payload = false;
+}
+var otfccdump = path.join(args.bin, 'otfccdump');
+var otfccbuild = path.join(args.bin, 'otfccbuild');
+var sizes = args.sizes ? args.sizes.split(',').map(function (x) { return +x; }) : [];
+
+// Total milliseconds spent in each span name, over the spans of every thread.
+function spanTimes(traceFile) {
+	var events = JSON.parse(fs.readFileSync(traceFile, 'utf-8')).traceEvents;
+	var stacks = {};
+	var times = {};
+	events.forEach(function (e) {
+		var stack = stacks[e.tid] || (stacks[e.tid] = []);
+		if (e.ph === 'B') {
+			stack.push(e);
+		} else if (e.ph === 'E') {
+			var b = stack.pop();
+			times[b.name] = (times[b.name] || 0) + (e.ts - b.ts) / 1000;
+		}
+	});
+	return times;
+}
+function span(times, name) {
+	return times[name] || 0;
+}
+
+var dumpStages = {
+	'dump:read': function (t) {
+		return span(t, 'Read SFNT') + span(t, 'Read Font') - span(t, 'unconsolidate');
+	},
+	'dump:unconsolidate': function (t) { return span(t, 'unconsolidate'); },
+	'dump:consolidate': function (t) { return span(t, 'Consolidate'); },
+	'dump:dump': function (t) { return span(t, 'Dump'); },
+	'dump:serialize': function (t) { return span(t, 'Serialize to JSON'); }
+};
+var buildStages = {
+	'build:json-parse': function (t) { return span(t, 'Parse into JSON'); },
+	'build:parse': function (t) { return span(t, 'Parse'); },
+	'build:consolidate': function (t) { return span(t, 'Consolidate'); },
+	'build:build': function (t) { return span(t, 'Build') - span(t, 'Write to file'); }
+};
+
+function run(program, argv) {
+	var result = childProcess.spawnSync(program, argv.concat(['-q']));
+	if (result.status !== 0) {
+		process.stderr.write(program + ' ' + argv.join(' ') + ' failed\n' + result.stderr + '\n');
+		process.exit(1);
+	}
+}
+
+function median(xs) {
+	var s = xs.slice().sort(function (a, b) { return a - b; });
+	var m = s.length >> 1;
+	return s.length & 1 ? s[m] : (s[m - 1] + s[m]) / 2;
+}
+
+var samples = {};
+function record(font, stages, times) {
+	for (var stage in stages) {
+		var key = font + '\t' + stage;
+		(samples[key] || (samples[key] = [])).push(stages[stage](times));
+	}
+}
+
+var tmpdir = fs.mkdtempSync(path.join(os.tmpdir(), 'otfcc-bench-'));
+var trace = path.join(tmpdir, 'trace.json');
+
+function benchBinary(font, input, isCFF) {
+	var json = path.join(tmpdir, 'font.json');
+	var output = path.join(tmpdir, isCFF ? 'font.otf' : 'font.ttf');
+	for (var r = 0; r < args.reps; r++) {
+		run(otfccdump, [input, '-o', json, '--trace', trace]);
+		record(font, dumpStages, spanTimes(trace));
+		run(otfccbuild, [json, '-o', output, '-O3', '--trace', trace]);
+		record(font, buildStages, spanTimes(trace));
+	}
+	fs.unlinkSync(json);
+	fs.unlinkSync(output);
+}
+
+function benchJSON(font, input, isCFF) {
+	var output = path.join(tmpdir, isCFF ? 'font.otf' : 'font.ttf');
+	var json = path.join(tmpdir, 'font.json');
+	for (var r = 0; r < args.reps; r++) {
+		run(otfccbuild, [input, '-o', output, '-O3', '--trace', trace]);
+		record(font, buildStages, spanTimes(trace));
+		run(otfccdump, [output, '-o', json, '--trace', trace]);
+		record(font, dumpStages, spanTimes(trace));
+	}
+	fs.unlinkSync(json);
+	fs.unlinkSync(output);
+}
+
+if (args.payload) {
+	fs.readdirSync('tests/payload').sort().forEach(function (f) {
+		if (/\.(ttf|otf)$/.test(f)) benchBinary(f, path.join('tests/payload', f), /\.otf$/.test(f));
+	});
+}
+sizes.forEach(function (n) {
+	['ttf', 'cff'].forEach(function (kind) {
+		var input = path.join(tmpdir, 'synthetic.json');
+		fs.writeFileSync(input, JSON.stringify(syntheticFont(n, { cff: kind === 'cff' })));
+		benchJSON('synthetic-' + kind + '-' + n, input, kind === 'cff');
+		fs.unlinkSync(input);
+	});
+});
+if (fs.existsSync(trace)) fs.unlinkSync(trace);
+fs.rmdirSync(tmpdir);
+
+process.stdout.write('font,stage,median_ms,reps\n');
+for (var key in samples) {
+	var parts = key.split('\t');
+	process.stdout.write(parts[0] + ',' + parts[1] + ',' + median(samples[key]).toFixed(3) + ',' +
+	                     samples[key].length + '\n');
+}
@@ -1,16 +1,7 @@
 var path = require("path");
 var fs = require("fs");
-var util = require("util");
+var check = require("./check");
 
-function check (demand,fn, desc) {
-	if (fn) {
-		process.stderr.write("\x1b[32;1m[PASS]\x1b[39;49m " + desc + "\n");
-	} else {
-		process.stderr.write("\x1b[31;1m[FAIL]\x1b[39;49m " + desc + "\n");
-		process.stderr.write(util.inspect(demand, {depth: null}));
-		process.exit(1);
-	}
-}
 function near (x, y) {
 	return Math.abs(x - y) < 0.01;
 }
@@ -0,0 +1,15 @@
+// Shared assertion of the checker scripts: prints a PASS or FAIL line for desc, and on failure
+// dumps demand, down to depth levels (all of them by default), and exits.
+// Usage : var check = require("./check");
+//         check(demand, condition, "What should hold.", depth)
+var util = require("util");
+
+module.exports = function check (demand, fn, desc, depth) {
+	if (fn) {
+		process.stderr.write("\x1b[32;1m[PASS]\x1b[39;49m " + desc + "\n");
+	} else {
+		process.stderr.write("\x1b[31;1m[FAIL]\x1b[39;49m " + desc + "\n");
+		process.stderr.write(util.inspect(demand, {depth: depth === undefined ? null : depth}));
+		process.exit(1);
+	}
+};
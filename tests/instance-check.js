@@ -0,0 +1,35 @@
+// Checks an instance of the font made by make-variable-font.js against the static font: every
+// point and advance width moved by the deltas of its masters, weighted at the normalized
+// coordinate of the instance, and fvar is gone.
+// Usage : node tests/instance-check.js static.json instance.json coordinate
+var fs = require("fs");
+var check = require("./check");
+
+var still = JSON.parse(fs.readFileSync(process.argv[2], "utf-8"));
+var instance = JSON.parse(fs.readFileSync(process.argv[3], "utf-8"));
+var n = +process.argv[4];
+var dx = n > 0 ? 20 * n : 8 * n;
+var dy = n > 0 ? -10 * n : -4 * n;
+var dAdvance = n > 0 ? 30 * n : 12 * n;
+
+check(instance.fvar, !instance.fvar, "fvar is dropped.");
+var wrong = [];
+Object.keys(still.glyf).forEach(function (name) {
+	var a = still.glyf[name], b = instance.glyf[name];
+	function expect (what, x, y) {
+		if (typeof y !== "number" || Math.abs(x - y) > 1e-6) wrong.push([name, what, x, y]);
+	}
+	expect("advanceWidth", a.advanceWidth + dAdvance, b.advanceWidth);
+	(a.contours || []).forEach(function (c, j) {
+		c.forEach(function (z, k) {
+			expect("x", z.x + dx, b.contours[j][k].x);
+			expect("y", z.y + dy, b.contours[j][k].y);
+		});
+	});
+	(a.references || []).forEach(function (r, j) {
+		expect("reference x", r.x + dx, b.references[j].x);
+		expect("reference y", r.y + dy, b.references[j].y);
+	});
+});
+check(wrong.slice(0, 5), wrong.length === 0,
+	Object.keys(still.glyf).length + " glyphs are instanced at " + n + ".");
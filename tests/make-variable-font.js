@@ -0,0 +1,98 @@
+// Turns a TrueType font into a variable one for the instancing test, adding fvar with a 'wght'
+// axis from 100 through 400 to 900, and gvar with two masters. At wght=900 every point of every
+// glyph moves by (20, -10) and the advance width grows by 30; at wght=100 the points move by
+// (-8, 4) and the advance width grows by -12. With "avar", it also adds avar, which maps the
+// normalized coordinate 0.5 to 0.75 and leaves the rest of the axis linear.
+// Usage : node tests/make-variable-font.js font.ttf font.json variable.ttf [avar]
+var fs = require("fs");
+
+var font = fs.readFileSync(process.argv[2]);
+var dump = JSON.parse(fs.readFileSync(process.argv[3], "utf-8"));
+
+function u16 (x) { var b = Buffer.alloc(2); b.writeUInt16BE(x & 0xFFFF); return b; }
+function i16 (x) { var b = Buffer.alloc(2); b.writeInt16BE(x); return b; }
+function u32 (x) { var b = Buffer.alloc(4); b.writeUInt32BE(x >>> 0); return b; }
+function fixed (x) { return u32(Math.round(x * 65536)); }
+
+var fvar = Buffer.concat([
+	u16(1), u16(0), u16(16), u16(2), u16(1), u16(20), u16(0), u16(8),
+	Buffer.from("wght"), fixed(100), fixed(400), fixed(900), u16(0), u16(256)
+]);
+
+function f2dot14 (x) { return i16(Math.round(x * 16384)); }
+var avar = Buffer.concat([
+	u16(1), u16(0), u16(0), u16(1), u16(4),
+	f2dot14(-1), f2dot14(-1), f2dot14(0), f2dot14(0), f2dot14(0.5), f2dot14(0.75), f2dot14(1), f2dot14(1)
+]);
+
+// Deltas of all points, in runs of at most 64 words
+function packedDeltas (deltas) {
+	var parts = [];
+	for (var j = 0; j < deltas.length; j += 64) {
+		var run = deltas.slice(j, j + 64);
+		parts.push(Buffer.from([0x40 | (run.length - 1)]));
+		run.forEach(function (d) { parts.push(i16(d)); });
+	}
+	return Buffer.concat(parts);
+}
+function tupleData (n, dx, dy, dAdvance) {
+	var xs = [], ys = [];
+	for (var j = 0; j < n; j++) { xs.push(dx); ys.push(dy); }
+	xs.push(0, dAdvance, 0, 0);
+	ys.push(0, 0, 0, 0);
+	return Buffer.concat([packedDeltas(xs), packedDeltas(ys)]);
+}
+function glyphVariationData (g) {
+	var n = (g.references || []).length;
+	(g.contours || []).forEach(function (c) { n += c.length; });
+	var heavy = tupleData(n, 20, -10, 30);
+	var light = tupleData(n, -8, 4, -12);
+	return Buffer.concat([
+		u16(0x8000 | 2), u16(4 + 2 * 6),
+		u16(heavy.length), u16(0x8000), i16(0x4000),
+		u16(light.length), u16(0x8000), i16(-0x4000),
+		Buffer.from([0]), heavy, light
+	]);
+}
+
+var order = dump.glyph_order;
+var datas = order.map(function (name) { return glyphVariationData(dump.glyf[name]); });
+var arrayOffset = 20 + 4 * (order.length + 1);
+var offsets = [u32(0)], sum = 0;
+datas.forEach(function (d) { sum += d.length; offsets.push(u32(sum)); });
+var gvar = Buffer.concat([
+	u16(1), u16(0), u16(1), u16(0), u32(arrayOffset), u16(order.length), u16(1), u32(arrayOffset)
+].concat(offsets, datas));
+
+// Rebuild the table directory with the new tables added
+var tables = [];
+var numTables = font.readUInt16BE(4);
+for (var j = 0; j < numTables; j++) {
+	var record = 12 + 16 * j;
+	var offset = font.readUInt32BE(record + 8);
+	tables.push({
+		tag: font.toString("latin1", record, record + 4),
+		data: font.slice(offset, offset + font.readUInt32BE(record + 12))
+	});
+}
+tables.push({tag: "fvar", data: fvar}, {tag: "gvar", data: gvar});
+if (process.argv[5] === "avar") tables.push({tag: "avar", data: avar});
+tables.sort(function (a, b) { return a.tag < b.tag ? -1 : a.tag > b.tag ? 1 : 0; });
+
+function padded (b) { return Buffer.concat([b, Buffer.alloc((4 - b.length % 4) % 4)]); }
+function checksum (b) {
+	var p = padded(b), s = 0;
+	for (var j = 0; j < p.length; j += 4) s = (s + p.readUInt32BE(j)) >>> 0;
+	return s;
+}
+var entrySelector = Math.floor(Math.log2(tables.length));
+var header = [font.slice(0, 4), u16(tables.length), u16(16 << entrySelector), u16(entrySelector),
+	u16(16 * tables.length - (16 << entrySelector))];
+var position = 12 + 16 * tables.length;
+var records = [], bodies = [];
+tables.forEach(function (t) {
+	records.push(Buffer.from(t.tag, "latin1"), u32(checksum(t.data)), u32(position), u32(t.data.length));
+	bodies.push(padded(t.data));
+	position += padded(t.data).length;
+});
+fs.writeFileSync(process.argv[4], Buffer.concat(header.concat(records, bodies)));
@@ -0,0 +1,23 @@
+// Checks the table written by --memory-stats: every subsystem has a row, and the named
+// subsystems have allocated something.
+// Usage : otfccbuild ... --memory-stats 2>&1 | node tests/memory-stats-check.js glyf OTL ...
+var check = require("./check");
+
+var input = "";
+process.stdin.resume();
+process.stdin.on("data", function (buf) { input += buf.toString(); });
+process.stdin.on("end", function () {
+	var rows = {};
+	input.split("\n").forEach(function (line) {
+		var m = line.match(/^(.*?)\s+(\d+)\s+(\d+)(?:\s+(\d+))?\s*$/);
+		if (m) rows[m[1]] = { current: +m[2], peak: +m[3], allocations: +(m[4] || 0) };
+	});
+	check(rows, rows.total && rows.total.peak > 0, "The total peak is reported.");
+	["other", "glyf", "CFF", "OTL", "bk graph", "JSON DOM", "subroutinizer"].forEach(function (name) {
+		check(rows, rows[name], "Subsystem \"" + name + "\" has a row.");
+		check(rows, rows[name].current <= rows[name].peak, "Subsystem \"" + name + "\" stays under its peak.");
+	});
+	process.argv.slice(2).forEach(function (name) {
+		check(rows, rows[name].peak > 0 && rows[name].allocations > 0, "Subsystem \"" + name + "\" allocated memory.");
+	});
+});
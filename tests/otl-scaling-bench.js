@@ -0,0 +1,31 @@
+// Scaling benchmark for OTL serialization.
+// Times otfccbuild on synthetic fonts with about N lookups and N features, from
+// tests/synthetic-font.js.
+// Usage : node tests/otl-scaling-bench.js [path/to/otfccbuild] [N1,N2,...]
+var path = require('path');
+var fs = require('fs');
+var os = require('os');
+var childProcess = require('child_process');
+var syntheticFont = require('./synthetic-font');
+
+var otfccbuild = process.argv[2] || 'bin/release-x64/otfccbuild';
+var sizes = (process.argv[3] || '1000,2500,5000,10000').split(',').map(function (x) { return +x; });
+
+var tmpdir = fs.mkdtempSync(path.join(os.tmpdir(), 'otfcc-otl-bench-'));
+process.stdout.write('lookups,features,seconds\n');
+sizes.forEach(function (n) {
+	var input = path.join(tmpdir, 'otl-' + n + '.json');
+	var output = path.join(tmpdir, 'otl-' + n + '.ttf');
+	fs.writeFileSync(input, JSON.stringify(syntheticFont(n, { features: true })));
+	var start = process.hrtime();
+	var result = childProcess.spawnSync(otfccbuild, [input, '-o', output, '-q']);
+	var elapsed = process.hrtime(start);
+	if (result.status !== 0) {
+		process.stderr.write('otfccbuild failed on N = ' + n + '\n' + result.stderr + '\n');
+		process.exit(1);
+	}
+	process.stdout.write(n + ',' + n + ',' + (elapsed[0] + elapsed[1] / 1e9).toFixed(3) + '\n');
+	fs.unlinkSync(input);
+	fs.unlinkSync(output);
+});
+fs.rmdirSync(tmpdir);
@@ -0,0 +1,82 @@
+// Checks a font subset with --subset against the full font: the subset maps exactly the
+// requested code points the full font maps, to the same glyphs, keeps every glyph it refers
+// to, and links its OTL lookups to lookups it keeps.
+// Usage : node tests/subset-check.js full.json subset.json U+20-7E U+E9 ...
+var fs = require("fs");
+var check = require("./check");
+
+var full = JSON.parse(fs.readFileSync(process.argv[2], "utf-8"));
+var subset = JSON.parse(fs.readFileSync(process.argv[3], "utf-8"));
+var requested = {};
+process.argv.slice(4).forEach(function (item) {
+	var m = item.match(/^U\+([0-9A-Fa-f]+)(?:-([0-9A-Fa-f]+))?$/);
+	for (var u = parseInt(m[1], 16); u <= parseInt(m[2] || m[1], 16); u++) requested[u] = true;
+});
+
+var glyphs = subset.glyf;
+check(Object.keys(glyphs).length, Object.keys(glyphs).length < Object.keys(full.glyf).length,
+	"The subset has fewer glyphs.");
+check(subset.glyph_order[0], subset.glyph_order[0] === full.glyph_order[0], ".notdef stays first.");
+
+// cmap keys are decimal in dumps and may be written U+XXXX in source JSON.
+function codePoint (key) {
+	return /^U\+/i.test(key) ? parseInt(key.slice(2), 16) : parseInt(key, 10);
+}
+var expected = {};
+for (var u in full.cmap) if (requested[codePoint(u)]) expected[codePoint(u)] = full.cmap[u];
+check({ expected: expected, actual: subset.cmap },
+	JSON.stringify(expected) === JSON.stringify(subset.cmap),
+	"cmap maps the requested code points to the same glyphs.");
+
+var missing = [];
+function need (name, where) {
+	if (!glyphs[name]) missing.push(where + " /" + name);
+}
+for (var u in subset.cmap) need(subset.cmap[u], "cmap");
+for (var g in glyphs) (glyphs[g].references || []).forEach(function (r) { need(r.glyph, g); });
+(subset.COLR || []).forEach(function (e) {
+	need(e.from, "COLR");
+	e.to.forEach(function (layer) { need(layer.layer, "COLR " + e.from); });
+});
+var lookups = (subset.GSUB || {}).lookups || {};
+for (var name in lookups) lookups[name].subtables.forEach(function (st) {
+	switch (lookups[name].type) {
+		case "gsub_single":
+		case "gsub_multiple":
+		case "gsub_alternate":
+			for (var from in st) {
+				need(from, name);
+				[].concat(st[from]).forEach(function (to) { need(to, name); });
+			}
+			break;
+		case "gsub_ligature":
+			st.substitutions.forEach(function (s) {
+				s.from.forEach(function (g) { need(g, name); });
+				need(s.to, name);
+			});
+			break;
+	}
+});
+check(missing, missing.length === 0, "Every glyph the subset refers to is kept.");
+
+// Pruned lookups move the indices of the rest: every reference must still land on a kept
+// lookup, and a chaining rule on another lookup than its own.
+var broken = [];
+["GSUB", "GPOS"].forEach(function (tag) {
+	var table = subset[tag];
+	if (!table) return;
+	for (var f in table.features) table.features[f].forEach(function (l) {
+		if (!table.lookups[l]) broken.push(tag + " feature " + f + " -> " + l);
+	});
+	for (var name in table.lookups) {
+		if (!/_chaining$/.test(table.lookups[name].type)) continue;
+		table.lookups[name].subtables.forEach(function (st) {
+			(st.apply || []).forEach(function (a) {
+				if (!table.lookups[a.lookup] || a.lookup === name) {
+					broken.push(tag + " " + name + " -> " + a.lookup);
+				}
+			});
+		});
+	}
+});
+check(broken, broken.length === 0, "Every lookup reference lands on another kept lookup.");
@@ -0,0 +1,151 @@
+// Synthetic font generator for benchmarks.
+// Builds an otfcc JSON font with N glyphs, about N class kerning pairs, N chaining rules and,
+// for CFF fonts, N distinct charstrings which share enough pieces to give the subroutinizer
+// real work. With { features: true }, every glyph also gets a single substitution lookup under
+// a feature of its own, to stress lookup and feature serialization.
+// Usage : node tests/synthetic-font.js N [ttf|cff] > font.json
+//         require('./synthetic-font')(n, { cff: true, features: true })
+
+function glyphName(j) {
+	return j === 0 ? '.notdef' : 'g' + j;
+}
+
+// A rectangle frame, plus a row of "teeth" picked from a small repertoire by the bits of j.
+// Equal teeth produce equal charstring fragments, different j produce different glyphs.
+function glyphContours(j, cff) {
+	var frame = [
+		{ x: 50, y: 0, on: true },
+		{ x: 50, y: 700, on: true },
+		{ x: 550, y: 700, on: true },
+		{ x: 550, y: 0, on: true }
+	];
+	var teeth = [];
+	var x = 80;
+	for (var k = 0; k < 8; k++) {
+		var shape = (j >> (2 * k)) & 3;
+		var y = 100 + 60 * (k & 1);
+		teeth.push({ x: x, y: y, on: true });
+		if (shape === 0) {
+			teeth.push({ x: x + 25, y: y + 50, on: true });
+		} else if (shape === 1) {
+			teeth.push({ x: x + 10, y: y + 40, on: false });
+			if (cff) teeth.push({ x: x + 40, y: y + 40, on: false });
+		} else if (shape === 2) {
+			teeth.push({ x: x + 5, y: y + 80, on: true });
+			teeth.push({ x: x + 45, y: y + 80, on: true });
+		} else {
+			teeth.push({ x: x + 25, y: y + 20, on: false });
+			if (cff) teeth.push({ x: x + 30, y: y + 70, on: false });
+			teeth.push({ x: x + 40, y: y + 60, on: true });
+		}
+		x += 55;
+	}
+	teeth.push({ x: x, y: 100, on: true });
+	teeth.push({ x: x, y: 40, on: true });
+	teeth.push({ x: 80, y: 40, on: true });
+	return [frame, teeth];
+}
+
+function syntheticFont(n, opts) {
+	opts = opts || {};
+	var cff = !!opts.cff;
+	var nGlyphs = Math.max(n, 4);
+	var font = {
+		head: { version: 1, unitsPerEm: 1000, created: 0, modified: 0, fontRevision: 1 },
+		hhea: { version: 1, ascender: 800, descender: -200, lineGap: 0 },
+		maxp: { version: 1 },
+		post: { version: 2, italicAngle: 0, underlinePosition: -100, underlineThickness: 50 },
+		OS_2: { version: 4, usWeightClass: 400, usWidthClass: 5 },
+		name: [],
+		cmap: {},
+		glyph_order: [],
+		glyf: {},
+		GSUB: { languages: {}, features: {}, lookups: {}, lookupOrder: [] },
+		GPOS: { languages: {}, features: {}, lookups: {}, lookupOrder: [] }
+	};
+	if (cff) {
+		font.CFF_ = { version: '1.0', fontName: 'Synthetic-Regular', fullName: 'Synthetic Regular' };
+	}
+	for (var j = 0; j < nGlyphs; j++) {
+		var g = glyphName(j);
+		font.glyph_order.push(g);
+		font.glyf[g] = { advanceWidth: 600, contours: j ? glyphContours(j, cff) : [] };
+		if (j) font.cmap[0xE000 + j] = g;
+	}
+
+	// Class kerning: a sqrt(N) x sqrt(N) class matrix, every cell non-zero.
+	var nClasses = Math.max(1, Math.ceil(Math.sqrt(n)));
+	var first = {}, second = {};
+	for (var j = 1; j < nGlyphs; j++) {
+		first[glyphName(j)] = j % nClasses;
+		second[glyphName(j)] = (j * 7) % nClasses;
+	}
+	var matrix = [];
+	for (var a = 0; a < nClasses; a++) {
+		var row = [];
+		for (var b = 0; b < nClasses; b++) {
+			row.push(-((a * 31 + b * 17) % 97) - 1);
+		}
+		matrix.push(row);
+	}
+	font.GPOS.lookups.lookup_kern = {
+		type: 'gpos_pair',
+		flags: {},
+		subtables: [{ first: first, second: second, matrix: matrix }]
+	};
+	font.GPOS.lookupOrder.push('lookup_kern');
+	font.GPOS.features.kern_00000 = ['lookup_kern'];
+	font.GPOS.languages.DFLT_DFLT = { features: ['kern_00000'] };
+
+	// Chaining: N rules, each applying one of a handful of single substitutions.
+	var nSingles = 8;
+	for (var k = 0; k < nSingles; k++) {
+		var single = {};
+		for (var j = 1 + k; j + 1 < nGlyphs; j += nSingles) {
+			single[glyphName(j)] = glyphName(j + 1);
+		}
+		font.GSUB.lookups['lookup_single_' + k] = { type: 'gsub_single', flags: {}, subtables: [single] };
+	}
+	var rules = [];
+	for (var j = 0; j < n; j++) {
+		var p = 1 + (j % (nGlyphs - 2));
+		var q = 1 + ((j * 13) % (nGlyphs - 2));
+		rules.push({
+			match: [[glyphName(q)], [glyphName(p)], [glyphName(p + 1)]],
+			apply: [{ at: 1, lookup: 'lookup_single_' + (j % nSingles) }],
+			inputBegins: 1,
+			inputEnds: 2
+		});
+	}
+	font.GSUB.lookups.lookup_chaining = { type: 'gsub_chaining', flags: {}, subtables: rules };
+	font.GSUB.lookupOrder.push('lookup_chaining');
+	font.GSUB.features.calt_00000 = ['lookup_chaining'];
+	font.GSUB.languages.DFLT_DFLT = { features: ['calt_00000'] };
+
+	if (opts.features) {
+		var features = [];
+		for (var j = 1; j + 1 < nGlyphs; j++) {
+			var lookupName = 'lookup_feature_' + j;
+			var subtable = {};
+			subtable[glyphName(j)] = glyphName(j + 1);
+			font.GSUB.lookups[lookupName] = { type: 'gsub_single', flags: {}, subtables: [subtable] };
+			font.GSUB.lookupOrder.push(lookupName);
+			var featureName = 'ss01_' + ('0000' + j).slice(-5);
+			font.GSUB.features[featureName] = [lookupName];
+			features.push(featureName);
+		}
+		var all = features.concat(['calt_00000']);
+		font.GSUB.languages.DFLT_DFLT = { features: all };
+		font.GSUB.languages.latn_DFLT = { features: all };
+		font.GSUB.languages.latn_TRK = { features: all.slice(0, all.length >> 1) };
+	}
+	return font;
+}
+
+module.exports = syntheticFont;
+
+if (require.main === module) {
+	var n = +(process.argv[2] || 1000);
+	var cff = process.argv[3] === 'cff';
+	process.stdout.write(JSON.stringify(syntheticFont(n, { cff: cff })));
+}
@@ -0,0 +1,42 @@
+// Checks a dump made with --include-tables or --exclude-tables against the full dump: it has
+// exactly the tables asked for, and each of them is the same as in the full dump. The glyphs keep
+// only the fields of the tables asked for.
+// Usage : node tests/table-filter-check.js full.json filtered.json cmap GSUB ...
+//         node tests/table-filter-check.js full.json filtered.json -GSUB -GPOS ...
+var fs = require("fs");
+var check = require("./check");
+
+var full = JSON.parse(fs.readFileSync(process.argv[2], "utf-8"));
+var filtered = JSON.parse(fs.readFileSync(process.argv[3], "utf-8"));
+var tables = process.argv.slice(4);
+var excluded = tables.filter(function (t) { return t[0] === "-"; }).map(function (t) { return t.slice(1); });
+var included = tables.filter(function (t) { return t[0] !== "-"; });
+
+function wants (table) {
+	return (!included.length || included.indexOf(table) >= 0) && excluded.indexOf(table) < 0;
+}
+// hmtx and vmtx are dumped as fields of the glyphs, with glyph_order along with them
+var metrics = { advanceWidth: "hmtx", horizontalOrigin: "hmtx", advanceHeight: "vmtx", verticalOrigin: "vmtx" };
+function wanted (key) {
+	if (key === "glyf" || key === "glyph_order") return wants("glyf") || wants("hmtx") || wants("vmtx");
+	return wants(key);
+}
+function project (glyf) {
+	var result = {};
+	for (var name in glyf) {
+		result[name] = {};
+		for (var field in glyf[name]) {
+			if (wants(metrics[field] || "glyf")) result[name][field] = glyf[name][field];
+		}
+	}
+	return result;
+}
+var expected = Object.keys(full).filter(wanted).sort();
+var actual = Object.keys(filtered).sort();
+check({ expected: expected, actual: actual }, JSON.stringify(expected) === JSON.stringify(actual),
+	"The dump has the tables asked for.", 2);
+var differ = actual.filter(function (key) {
+	var table = key === "glyf" ? project(full.glyf) : full[key];
+	return JSON.stringify(table) !== JSON.stringify(filtered[key]);
+});
+check(differ, differ.length === 0, "Each table is the same as in the full dump.", 2);
@@ -0,0 +1,35 @@
+// Checks a trace written by --trace: every span is closed on the thread which opened it,
+// timestamps never go backwards on one thread, and the named spans exist.
+// Usage : node tests/trace-check.js trace.json span1 span2 ...
+var fs = require("fs");
+var check = require("./check");
+
+var trace = JSON.parse(fs.readFileSync(process.argv[2], "utf-8"));
+var events = trace.traceEvents;
+check(trace, Array.isArray(events) && events.length > 0, "The trace has events.");
+
+var stacks = {};
+var lastTs = {};
+var names = {};
+var balanced = true;
+var monotonic = true;
+events.forEach(function (e) {
+	var stack = stacks[e.tid] || (stacks[e.tid] = []);
+	if (lastTs[e.tid] !== undefined && e.ts < lastTs[e.tid]) monotonic = false;
+	lastTs[e.tid] = e.ts;
+	if (e.ph === "B") {
+		stack.push(e.name);
+		names[e.name] = true;
+	} else if (e.ph === "E") {
+		if (!stack.length) balanced = false;
+		stack.pop();
+	}
+});
+for (var tid in stacks) {
+	if (stacks[tid].length) balanced = false;
+}
+check(stacks, balanced, "Every span is closed on its own thread.");
+check(lastTs, monotonic, "Timestamps are monotonic on each thread.");
+process.argv.slice(3).forEach(function (name) {
+	check(Object.keys(names), names[name], "Span \"" + name + "\" is present.");
+});
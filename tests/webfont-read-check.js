@@ -0,0 +1,26 @@
+// Checks the dump of a WOFF or WOFF2 file against the dump of the OpenType font it was built
+// from: every table reads back the same. WOFF2 fonts with transformed glyf may only differ in
+// head.flags.fontIsLossless, which the transform sets.
+// Usage : node tests/webfont-read-check.js font.json webfont.json
+var fs = require("fs");
+var util = require("util");
+var check = require("./check");
+
+var font = JSON.parse(fs.readFileSync(process.argv[2], "utf-8"));
+var web = JSON.parse(fs.readFileSync(process.argv[3], "utf-8"));
+
+if (web.head && web.head.flags && font.head && font.head.flags) {
+	delete web.head.flags.fontIsLossless;
+	delete font.head.flags.fontIsLossless;
+}
+
+check(Object.keys(web).sort(), util.isDeepStrictEqual(Object.keys(font).sort(), Object.keys(web).sort()),
+	"Same tables are read.", 3);
+var different = Object.keys(font).filter(function (t) {
+	return !util.isDeepStrictEqual(font[t], web[t]);
+});
+check(different, different.length === 0, "Every table reads the same.", 3);
+if (font.glyf) {
+	check(Object.keys(web.glyf).length, Object.keys(web.glyf).length === Object.keys(font.glyf).length,
+		Object.keys(font.glyf).length + " glyphs are read.", 3);
+}
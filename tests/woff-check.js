@@ -0,0 +1,44 @@
+// Checks a WOFF file against the OpenType font built from the same source: the WOFF header and
+// directory are well-formed, and decoding the tables gives back the font byte by byte.
+// Usage : node tests/woff-check.js font.woff font.otf
+var fs = require("fs");
+var zlib = require("zlib");
+var check = require("./check");
+
+var woff = fs.readFileSync(process.argv[2]);
+var otf = fs.readFileSync(process.argv[3]);
+
+check(woff.readUInt32BE(0).toString(16), woff.readUInt32BE(0) === 0x774F4646, "Signature is wOFF.");
+check(woff.readUInt32BE(4).toString(16), woff.readUInt32BE(4) === otf.readUInt32BE(0),
+	"Flavor is the sfnt version.");
+check(woff.readUInt32BE(8), woff.readUInt32BE(8) === woff.length, "Length is the file size.");
+var numTables = woff.readUInt16BE(12);
+check(numTables, numTables === otf.readUInt16BE(4), "Table count matches.");
+check(woff.readUInt32BE(16), woff.readUInt32BE(16) === otf.length, "totalSfntSize matches.");
+
+var sfnt = Buffer.alloc(woff.readUInt32BE(16));
+otf.copy(sfnt, 0, 0, 12);
+var offset = 12 + numTables * 16;
+var problems = [];
+var saved = 0;
+for (var j = 0; j < numTables; j++) {
+	var entry = 44 + j * 20;
+	var tag = woff.toString("latin1", entry, entry + 4);
+	var dataOffset = woff.readUInt32BE(entry + 4);
+	var compLength = woff.readUInt32BE(entry + 8);
+	var origLength = woff.readUInt32BE(entry + 12);
+	if (dataOffset % 4) problems.push(tag + " is not aligned");
+	var data = woff.slice(dataOffset, dataOffset + compLength);
+	if (compLength < origLength) data = zlib.inflateSync(data);
+	if (data.length !== origLength) problems.push(tag + " decodes to the wrong length");
+	saved += origLength - compLength;
+	sfnt.writeUInt32BE(woff.readUInt32BE(entry), 12 + j * 16);
+	sfnt.writeUInt32BE(woff.readUInt32BE(entry + 16), 12 + j * 16 + 4);
+	sfnt.writeUInt32BE(offset, 12 + j * 16 + 8);
+	sfnt.writeUInt32BE(origLength, 12 + j * 16 + 12);
+	data.copy(sfnt, offset);
+	offset += (origLength + 3) & ~3;
+}
+check(problems, problems.length === 0, "Every table decodes.");
+check(saved, saved > 0, "Compression saves " + saved + " bytes.");
+check("", sfnt.equals(otf), "The decoded font is the same as the OpenType font.");
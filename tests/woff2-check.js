@@ -0,0 +1,288 @@
+// Checks a WOFF2 file against the OpenType font built from the same source: the header and
+// directory are well-formed, the Brotli stream decodes, tables without a transform are the same
+// byte by byte, and the transformed glyf and hmtx decode into the same glyphs and metrics.
+// Usage : node tests/woff2-check.js font.woff2 font.otf
+var fs = require("fs");
+var zlib = require("zlib");
+var check = require("./check");
+
+var woff2 = fs.readFileSync(process.argv[2]);
+var otf = fs.readFileSync(process.argv[3]);
+
+var knownTags = ["cmap", "head", "hhea", "hmtx", "maxp", "name", "OS/2", "post", "cvt ", "fpgm",
+	"glyf", "loca", "prep", "CFF ", "VORG", "EBDT", "EBLC", "gasp", "hdmx", "kern", "LTSH", "PCLT",
+	"VDMX", "vhea", "vmtx", "BASE", "GDEF", "GPOS", "GSUB", "EBSC", "JSTF", "MATH", "CBDT", "CBLC",
+	"COLR", "CPAL", "SVG ", "sbix", "acnt", "avar", "bdat", "bloc", "bsln", "cvar", "fdsc", "feat",
+	"fmtx", "fvar", "gvar", "hsty", "just", "lcar", "mort", "morx", "opbd", "prop", "trak", "Zapf",
+	"Silf", "Glat", "Gloc", "Feat", "Sill"];
+
+check(woff2.readUInt32BE(0).toString(16), woff2.readUInt32BE(0) === 0x774F4632,
+	"Signature is wOF2.");
+check(woff2.readUInt32BE(4).toString(16), woff2.readUInt32BE(4) === otf.readUInt32BE(0),
+	"Flavor is the sfnt version.");
+check(woff2.readUInt32BE(8), woff2.readUInt32BE(8) === woff2.length, "Length is the file size.");
+var numTables = woff2.readUInt16BE(12);
+check(numTables, numTables === otf.readUInt16BE(4), "Table count matches.");
+check(woff2.readUInt32BE(16), woff2.readUInt32BE(16) === otf.length, "totalSfntSize matches.");
+
+// The tables of the OpenType font
+var expected = {};
+for (var j = 0; j < numTables; j++) {
+	var rec = 12 + j * 16;
+	expected[otf.toString("latin1", rec, rec + 4)] =
+		otf.slice(otf.readUInt32BE(rec + 8), otf.readUInt32BE(rec + 8) + otf.readUInt32BE(rec + 12));
+}
+
+// Table directory
+var cursor = 48;
+function readBase128 () {
+	var value = 0;
+	for (var k = 0; k < 5; k++) {
+		var b = woff2[cursor++];
+		value = value * 128 + (b & 0x7F);
+		if (!(b & 0x80)) return value;
+	}
+	throw new Error("Bad UIntBase128");
+}
+var entries = [];
+for (var j = 0; j < numTables; j++) {
+	var flags = woff2[cursor++];
+	var tag = (flags & 0x3F) === 63 ? woff2.toString("latin1", cursor, (cursor += 4)) : knownTags[flags & 0x3F];
+	var version = flags >> 6;
+	var origLength = readBase128();
+	var transformed = (tag === "glyf" || tag === "loca") ? version === 0 : version !== 0;
+	var length = transformed ? readBase128() : origLength;
+	entries.push({ tag: tag, version: version, origLength: origLength, transformed: transformed, length: length });
+}
+var compressedLength = woff2.readUInt32BE(20);
+var stream = zlib.brotliDecompressSync(woff2.slice(cursor, cursor + compressedLength));
+check(stream.length, stream.length === entries.reduce(function (s, e) { return s + e.length; }, 0),
+	"The Brotli stream decodes to the tables.");
+check(compressedLength, compressedLength < otf.length,
+	"Compression takes " + otf.length + " bytes down to " + compressedLength + ".");
+
+var tables = {};
+var offset = 0;
+entries.forEach(function (e) {
+	e.data = stream.slice(offset, offset + e.length);
+	offset += e.length;
+	tables[e.tag] = e;
+});
+
+// Glyphs, as parsed from glyf and loca or decoded from the transform
+function compositeLength (data, p) {
+	var start = p, more = true, instructions = false;
+	while (more) {
+		var flags = data.readUInt16BE(p);
+		p += 4 + ((flags & 1) ? 4 : 2);
+		if (flags & 8) p += 2; else if (flags & 0x40) p += 4; else if (flags & 0x80) p += 8;
+		more = !!(flags & 0x20);
+		instructions = instructions || !!(flags & 0x100);
+	}
+	return { length: p - start, instructions: instructions };
+}
+function parseGlyf (glyf, loca, longLoca, numGlyphs) {
+	var glyphs = [];
+	for (var g = 0; g < numGlyphs; g++) {
+		var start = longLoca ? loca.readUInt32BE(g * 4) : loca.readUInt16BE(g * 2) * 2;
+		var end = longLoca ? loca.readUInt32BE(g * 4 + 4) : loca.readUInt16BE(g * 2 + 2) * 2;
+		if (start === end) { glyphs.push({}); continue; }
+		var n = glyf.readInt16BE(start);
+		var glyph = { bbox: [1, 2, 3, 4].map(function (k) { return glyf.readInt16BE(start + 2 * k); }) };
+		var p = start + 10;
+		if (n < 0) {
+			var c = compositeLength(glyf, p);
+			glyph.composite = glyf.slice(p, p + c.length).toString("hex");
+			p += c.length;
+			if (c.instructions) {
+				var len = glyf.readUInt16BE(p);
+				glyph.instructions = glyf.slice(p + 2, p + 2 + len).toString("hex");
+			}
+		} else {
+			var ends = [];
+			for (var k = 0; k < n; k++, p += 2) ends.push(glyf.readUInt16BE(p));
+			var len = glyf.readUInt16BE(p);
+			glyph.instructions = glyf.slice(p + 2, p + 2 + len).toString("hex");
+			p += 2 + len;
+			var nPoints = n ? ends[n - 1] + 1 : 0, flags = [];
+			while (flags.length < nPoints) {
+				var f = glyf[p++];
+				flags.push(f);
+				if (f & 8) for (var r = glyf[p++]; r > 0; r--) flags.push(f);
+			}
+			var xs = [], ys = [], x = 0, y = 0;
+			flags.forEach(function (f) {
+				if (f & 2) { x += (f & 16) ? glyf[p] : -glyf[p]; p += 1; }
+				else if (!(f & 16)) { x += glyf.readInt16BE(p); p += 2; }
+				xs.push(x);
+			});
+			flags.forEach(function (f) {
+				if (f & 4) { y += (f & 32) ? glyf[p] : -glyf[p]; p += 1; }
+				else if (!(f & 32)) { y += glyf.readInt16BE(p); p += 2; }
+				ys.push(y);
+			});
+			glyph.contours = [];
+			var first = 0;
+			ends.forEach(function (last) {
+				var contour = [];
+				for (var k = first; k <= last; k++) contour.push([xs[k], ys[k], flags[k] & 1]);
+				glyph.contours.push(contour);
+				first = last + 1;
+			});
+		}
+		glyphs.push(glyph);
+	}
+	return glyphs;
+}
+function decodeGlyf (data) {
+	var numGlyphs = data.readUInt16BE(4);
+	var streams = [], p = 36;
+	for (var k = 0; k < 7; k++) {
+		var size = data.readUInt32BE(8 + 4 * k);
+		streams.push({ data: data.slice(p, p + size), p: 0 });
+		p += size;
+	}
+	var nContours = streams[0], nPoints = streams[1], flagStream = streams[2], glyphStream = streams[3];
+	var composites = streams[4], bboxes = streams[5], instructions = streams[6];
+	var bitmap = bboxes.data.slice(0, 4 * ((numGlyphs + 31) >> 5));
+	bboxes.p = bitmap.length;
+	function u8 (s) { return s.data[s.p++]; }
+	function read255 (s) {
+		var code = u8(s);
+		if (code === 253) { var v = s.data.readUInt16BE(s.p); s.p += 2; return v; }
+		if (code === 255) return u8(s) + 253;
+		if (code === 254) return u8(s) + 506;
+		return code;
+	}
+	function readBBox () {
+		var b = [0, 1, 2, 3].map(function (k) { return bboxes.data.readInt16BE(bboxes.p + 2 * k); });
+		bboxes.p += 8;
+		return b;
+	}
+	function withSign (flag, v) { return (flag & 1) ? v : -v; }
+	var glyphs = [];
+	for (var g = 0; g < numGlyphs; g++) {
+		var n = nContours.data.readInt16BE(nContours.p); nContours.p += 2;
+		var hasBBox = !!(bitmap[g >> 3] & (0x80 >> (g & 7)));
+		var glyph = {};
+		if (n === 0) { glyphs.push(glyph); continue; }
+		if (n < 0) {
+			var c = compositeLength(composites.data, composites.p);
+			glyph.bbox = readBBox();
+			glyph.composite = composites.data.slice(composites.p, composites.p + c.length).toString("hex");
+			composites.p += c.length;
+			if (c.instructions) {
+				var len = read255(glyphStream);
+				glyph.instructions = instructions.data.slice(instructions.p, instructions.p + len).toString("hex");
+				instructions.p += len;
+			}
+		} else {
+			var counts = [];
+			for (var k = 0; k < n; k++) counts.push(read255(nPoints));
+			var x = 0, y = 0;
+			glyph.contours = counts.map(function (count) {
+				var contour = [];
+				for (var k = 0; k < count; k++) {
+					var flagByte = u8(flagStream), flag = flagByte & 0x7F, dx, dy;
+					var b = glyphStream.data, q = glyphStream.p;
+					if (flag < 10) {
+						dx = 0; dy = withSign(flag, ((flag & 14) << 7) + b[q]); glyphStream.p += 1;
+					} else if (flag < 20) {
+						dx = withSign(flag, (((flag - 10) & 14) << 7) + b[q]); dy = 0; glyphStream.p += 1;
+					} else if (flag < 84) {
+						var b0 = flag - 20;
+						dx = withSign(flag, 1 + (b0 & 0x30) + (b[q] >> 4));
+						dy = withSign(flag >> 1, 1 + ((b0 & 0x0C) << 2) + (b[q] & 0x0F));
+						glyphStream.p += 1;
+					} else if (flag < 120) {
+						var b0 = flag - 84;
+						dx = withSign(flag, 1 + (Math.floor(b0 / 12) << 8) + b[q]);
+						dy = withSign(flag >> 1, 1 + (((b0 % 12) >> 2) << 8) + b[q + 1]);
+						glyphStream.p += 2;
+					} else if (flag < 124) {
+						dx = withSign(flag, (b[q] << 4) + (b[q + 1] >> 4));
+						dy = withSign(flag >> 1, ((b[q + 1] & 0x0F) << 8) + b[q + 2]);
+						glyphStream.p += 3;
+					} else {
+						dx = withSign(flag, (b[q] << 8) + b[q + 1]);
+						dy = withSign(flag >> 1, (b[q + 2] << 8) + b[q + 3]);
+						glyphStream.p += 4;
+					}
+					x = ((x + dx) << 16) >> 16;
+					y = ((y + dy) << 16) >> 16;
+					contour.push([x, y, (flagByte & 0x80) ? 0 : 1]);
+				}
+				return contour;
+			});
+			var len = read255(glyphStream);
+			glyph.instructions = instructions.data.slice(instructions.p, instructions.p + len).toString("hex");
+			instructions.p += len;
+			if (hasBBox) {
+				glyph.bbox = readBBox();
+			} else {
+				var points = [].concat.apply([], glyph.contours);
+				glyph.bbox = [
+					Math.min.apply(null, points.map(function (pt) { return pt[0]; })),
+					Math.min.apply(null, points.map(function (pt) { return pt[1]; })),
+					Math.max.apply(null, points.map(function (pt) { return pt[0]; })),
+					Math.max.apply(null, points.map(function (pt) { return pt[1]; }))];
+			}
+		}
+		// Keep the key order of parseGlyf
+		glyphs.push(n < 0 ? glyph : { bbox: glyph.bbox, instructions: glyph.instructions, contours: glyph.contours });
+	}
+	return glyphs;
+}
+
+var problems = [];
+var numGlyphs = expected["maxp"].readUInt16BE(4);
+var glyphs = null;
+entries.forEach(function (e) {
+	if (e.origLength !== expected[e.tag].length) problems.push(e.tag + " has the wrong original length");
+	if (e.tag === "head") {
+		var head = Buffer.from(e.data);
+		var transformedGlyf = tables["glyf"] && tables["glyf"].transformed;
+		if (transformedGlyf && !(head.readUInt16BE(16) & 0x800)) problems.push("head.flags misses bit 11");
+		head.writeUInt16BE(head.readUInt16BE(16) & ~0x800, 16);
+		head.writeUInt32BE(0, 8);
+		var want = Buffer.from(expected["head"]);
+		want.writeUInt32BE(0, 8);
+		if (!head.equals(want)) problems.push("head differs");
+	} else if (e.tag === "glyf" && e.transformed) {
+		glyphs = decodeGlyf(e.data);
+		var want = parseGlyf(expected["glyf"], expected["loca"], expected["head"].readInt16BE(50), numGlyphs);
+		if (e.data.readUInt16BE(6) !== expected["head"].readInt16BE(50)) problems.push("glyf has the wrong indexFormat");
+		for (var g = 0; g < numGlyphs; g++) {
+			if (JSON.stringify(glyphs[g]) !== JSON.stringify(want[g])) {
+				problems.push("glyph " + g + " differs: " + JSON.stringify(glyphs[g]) + " vs " + JSON.stringify(want[g]));
+				break;
+			}
+		}
+	} else if (e.tag === "loca" && e.transformed) {
+		if (e.length !== 0) problems.push("transformed loca is not empty");
+	} else if (e.tag === "hmtx" && e.transformed) {
+		var numberOfHMetrics = expected["hhea"].readUInt16BE(34);
+		var flags = e.data[0], p = 1;
+		var hmtx = Buffer.alloc(expected["hmtx"].length);
+		function xMin (g) { return glyphs[g].bbox ? glyphs[g].bbox[0] : 0; }
+		for (var g = 0; g < numberOfHMetrics; g++, p += 2) hmtx.writeUInt16BE(e.data.readUInt16BE(p), 4 * g);
+		for (var g = 0; g < numberOfHMetrics; g++) {
+			if (flags & 1) hmtx.writeInt16BE(xMin(g), 4 * g + 2);
+			else hmtx.writeInt16BE(e.data.readInt16BE(p), 4 * g + 2), p += 2;
+		}
+		for (var g = numberOfHMetrics; g < numGlyphs; g++) {
+			var at = 4 * numberOfHMetrics + 2 * (g - numberOfHMetrics);
+			if (flags & 2) hmtx.writeInt16BE(xMin(g), at);
+			else hmtx.writeInt16BE(e.data.readInt16BE(p), at), p += 2;
+		}
+		if (!(flags & 3)) problems.push("hmtx is transformed without leaving anything out");
+		if (!hmtx.equals(expected["hmtx"])) problems.push("hmtx differs");
+	} else if (!e.data.equals(expected[e.tag])) {
+		problems.push(e.tag + " differs");
+	}
+});
+check(problems, problems.length === 0, "Every table decodes into the one of the OpenType font.");
+if (tables["glyf"]) {
+	check(entries.filter(function (e) { return e.transformed; }).map(function (e) { return e.tag; }),
+		tables["glyf"].transformed && tables["loca"].transformed, "glyf and loca are transformed.");
+}
@@ -0,0 +1,155 @@
+// Generates lib/support/aglfn/aglfn.c from the AGLFN list: the entries, and the two perfect hash
+// tables which index them by code point and by name.
+// Usage : node tools/aglfn/generate.js [tools/aglfn/aglfn.txt] [lib/support/aglfn/aglfn.c]
+var fs = require("fs");
+var path = require("path");
+
+var input = process.argv[2] || path.join(__dirname, "aglfn.txt");
+var output = process.argv[3] || path.join(__dirname, "../../lib/support/aglfn/aglfn.c");
+
+var BUCKETS = 128;
+var SLOTS = 1024;
+var EMPTY = 0xFFFF;
+
+var entries = [];
+fs.readFileSync(input, "utf-8").split(/\r?\n/).forEach(function (line) {
+	if (!line || line[0] === "#") return;
+	var fields = line.split(";");
+	entries.push({ unicode: parseInt(fields[0], 16), name: fields[1] });
+});
+
+// Keep these in sync with the hashes of aglfn.c.
+function fmix (h) {
+	h ^= h >>> 16;
+	h = Math.imul(h, 0x85EBCA6B);
+	h ^= h >>> 13;
+	h = Math.imul(h, 0xC2B2AE35);
+	h ^= h >>> 16;
+	return h >>> 0;
+}
+function hashUnicode (u, seed) {
+	return fmix(u ^ Math.imul(seed, 0x9E3779B9));
+}
+function hashName (name, seed) {
+	var h = (2166136261 ^ Math.imul(seed, 0x9E3779B9)) >>> 0;
+	var bytes = Buffer.from(name, "latin1");
+	for (var j = 0; j < bytes.length; j++) {
+		h = Math.imul(h ^ bytes[j], 16777619);
+	}
+	return fmix(h);
+}
+
+// Places the largest buckets first, each with the first seed which sends its keys to free and
+// distinct slots.
+function perfectHash (keys, hash) {
+	var buckets = [];
+	for (var b = 0; b < BUCKETS; b++) buckets.push([]);
+	keys.forEach(function (key, j) { buckets[hash(key, 0) % BUCKETS].push(j); });
+	var seeds = [], slots = [];
+	for (var b = 0; b < BUCKETS; b++) seeds.push(0);
+	for (var s = 0; s < SLOTS; s++) slots.push(EMPTY);
+	var order = buckets.map(function (_, b) { return b; });
+	order.sort(function (a, b) { return buckets[b].length - buckets[a].length; });
+	order.forEach(function (b) {
+		if (!buckets[b].length) return;
+		for (var seed = 1; seed < 256; seed++) {
+			var taken = buckets[b].map(function (j) { return hash(keys[j], seed) % SLOTS; });
+			var free = taken.every(function (slot, k) {
+				return slots[slot] === EMPTY && taken.indexOf(slot) === k;
+			});
+			if (!free) continue;
+			taken.forEach(function (slot, k) { slots[slot] = buckets[b][k]; });
+			seeds[b] = seed;
+			return;
+		}
+		throw new Error("No seed places bucket " + b + "; try more slots.");
+	});
+	return { seeds: seeds, slots: slots };
+}
+
+function table (type, name, values, format, perLine) {
+	var lines = [];
+	for (var j = 0; j < values.length; j += perLine) {
+		lines.push("\t" + values.slice(j, j + perLine).map(format).join(", ") + ",");
+	}
+	return "static const " + type + " " + name + "[" + values.length + "] = {\n" +
+		lines.join("\n") + "\n};\n";
+}
+function hex4 (x) {
+	return "0x" + ("000" + x.toString(16).toUpperCase()).slice(-4);
+}
+
+var byUnicode = perfectHash(entries.map(function (e) { return e.unicode; }), hashUnicode);
+var byName = perfectHash(entries.map(function (e) { return e.name; }), hashName);
+
+var source = [
+	'#include "aglfn.h"',
+	"#include <string.h>",
+	'#include "support/otfcc-alloc.h"',
+	"",
+	"// This table contains standard AGLFN 1.7 glyph names, mapped to Unicode. It is generated by",
+	"// tools/aglfn/generate.js from tools/aglfn/aglfn.txt; edit those instead.",
+	"//",
+	"// Both directions are looked up through two-level perfect hashes: a key is first hashed with",
+	"// seed 0 into one of AGLFN_BUCKETS buckets, then hashed again with its bucket's seed into one",
+	"// of AGLFN_SLOTS slots, which holds the index of its entry (0xFFFF when empty). The seeds are",
+	"// searched so that no two entries share a slot; since any key may be looked up, the entry",
+	"// found is still compared against the key.",
+	"",
+	"#define AGLFN_ENTRIES " + entries.length,
+	"#define AGLFN_BUCKETS " + BUCKETS,
+	"#define AGLFN_SLOTS " + SLOTS,
+	"#define AGLFN_EMPTY 0xFFFF",
+	"",
+	"typedef struct {",
+	"\tuint16_t unicode;",
+	"\tconst char *name;",
+	"} aglfn_Entry;",
+	"",
+	"static const aglfn_Entry aglfnEntries[AGLFN_ENTRIES] = {",
+	entries.map(function (e) { return '\t{' + hex4(e.unicode) + ', "' + e.name + '"},'; }).join("\n"),
+	"};",
+	"",
+	table("uint8_t", "byUnicodeSeeds", byUnicode.seeds, String, 16),
+	table("uint16_t", "byUnicodeSlots", byUnicode.slots, hex4, 12),
+	table("uint8_t", "byNameSeeds", byName.seeds, String, 16),
+	table("uint16_t", "byNameSlots", byName.slots, hex4, 12) + "\n" +
+	"static INLINE uint32_t fmix(uint32_t h) {\n" +
+	"\th ^= h >> 16;\n" +
+	"\th *= 0x85EBCA6Bu;\n" +
+	"\th ^= h >> 13;\n" +
+	"\th *= 0xC2B2AE35u;\n" +
+	"\th ^= h >> 16;\n" +
+	"\treturn h;\n" +
+	"}\n" +
+	"static INLINE uint32_t hashUnicode(uint32_t u, uint32_t seed) {\n" +
+	"\treturn fmix(u ^ (seed * 0x9E3779B9u));\n" +
+	"}\n" +
+	"static INLINE uint32_t hashName(const char *name, size_t len, uint32_t seed) {\n" +
+	"\tuint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);\n" +
+	"\tfor (size_t j = 0; j < len; j++) {\n" +
+	"\t\th ^= (uint8_t)name[j];\n" +
+	"\t\th *= 16777619u;\n" +
+	"\t}\n" +
+	"\treturn fmix(h);\n" +
+	"}\n" +
+	"\n" +
+	"const char *aglfn_nameOf(unicode_t u) {\n" +
+	"\tif (u > 0xFFFF) return NULL;\n" +
+	"\tuint32_t seed = byUnicodeSeeds[hashUnicode(u, 0) % AGLFN_BUCKETS];\n" +
+	"\tuint16_t k = byUnicodeSlots[hashUnicode(u, seed) % AGLFN_SLOTS];\n" +
+	"\tif (k == AGLFN_EMPTY || aglfnEntries[k].unicode != u) return NULL;\n" +
+	"\treturn aglfnEntries[k].name;\n" +
+	"}\n" +
+	"\n" +
+	"int32_t aglfn_unicodeOf(const char *name, size_t len) {\n" +
+	"\tuint32_t seed = byNameSeeds[hashName(name, len, 0) % AGLFN_BUCKETS];\n" +
+	"\tuint16_t k = byNameSlots[hashName(name, len, seed) % AGLFN_SLOTS];\n" +
+	"\tif (k == AGLFN_EMPTY) return -1;\n" +
+	"\tconst char *candidate = aglfnEntries[k].name;\n" +
+	"\tif (strncmp(candidate, name, len) || candidate[len]) return -1;\n" +
+	"\treturn aglfnEntries[k].unicode;\n" +
+	"}"
+].join("\n") + "\n";
+
+fs.writeFileSync(output, source);